@@ -427,6 +427,7 @@ private:
   mutable double m_endChildProgress; ///< Keeps value for algorithm's progress
   /// at Child Algorithm's finish
   AlgorithmID m_algorithmID; ///< Algorithm ID for managed algorithms
+  size_t m_nestingDepth; ///< Nesting depth reported to the AlgorithmProfiler
   std::vector<boost::weak_ptr<IAlgorithm>> m_ChildAlgorithms; ///< A list of
   /// weak pointers
   /// to any child
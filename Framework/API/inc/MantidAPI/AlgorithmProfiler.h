@@ -0,0 +1,166 @@
+#ifndef MANTID_API_ALGORITHMPROFILER_H_
+#define MANTID_API_ALGORITHMPROFILER_H_
+
+#include "MantidAPI/DllConfig.h"
+#include "MantidKernel/Memory.h"
+#include "MantidKernel/SingletonHolder.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Mantid {
+namespace API {
+
+/// The timings of one execution of an algorithm recorded by the profiler
+struct AlgorithmProfile {
+  /// Name of the algorithm
+  std::string name;
+  /// Version of the algorithm
+  int version;
+  /// Nesting depth: 0 for an algorithm run directly, 1 for its children, ...
+  size_t depth;
+  /// Index of the thread that ran the algorithm, in order of first use
+  size_t thread;
+  /// Start time in seconds since the profiler was started
+  double start;
+  /// Elapsed (wall clock) time of the whole execution in seconds
+  double wallTime;
+  /// Time spent checking the properties and inputs, in seconds
+  double validationTime;
+  /// Time spent in exec(), in seconds
+  double execTime;
+  /// Time spent recording the history and storing the outputs, in seconds
+  double finaliseTime;
+  /// Change of the resident memory of the process, in kiB
+  int64_t memoryChange;
+  /// Increase of the peak resident memory of the process, in kiB
+  int64_t peakMemoryIncrease;
+  /// Number of shared arrays copied by copy-on-write pointers before being
+  /// modified, on all threads, during the execution
+  size_t cowCopies;
+  /// Number of bytes copied by those copies
+  size_t cowCopiedBytes;
+};
+
+/** AlgorithmProfilerImpl : Records the execution of algorithms while it is
+  running, including child algorithms, so that the time spent by a workflow
+  can be broken down.
+
+  For each execution it keeps the wall clock time, split into the validation,
+  exec() and finalisation phases of Algorithm::execute, the nesting depth and
+  thread, and the change in memory. The records can be retrieved, e.g. from
+  Python, or saved as a Chrome trace file that can be viewed in
+  chrome://tracing or similar tools. Recording costs nothing while the
+  profiler is stopped.
+
+  Only wall clock times are recorded: the CPU time of a process or a thread
+  cannot be attributed to one of several algorithms running at the same time.
+
+  Copyright &copy; 2017 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_API_DLL AlgorithmProfilerImpl {
+public:
+  /** Records the execution of an algorithm from its construction until its
+   * destruction if the profiler is running.
+   */
+  class MANTID_API_DLL Recording {
+  public:
+    Recording(const std::string &name, int version, size_t depth);
+    ~Recording();
+    Recording(const Recording &) = delete;
+    Recording &operator=(const Recording &) = delete;
+
+    /// @return the nesting depth of the execution
+    size_t depth() const { return m_profile.depth; }
+    void validated();
+    void executed();
+
+  private:
+    bool m_active;
+    AlgorithmProfile m_profile;
+    size_t m_enclosingDepth;
+    std::chrono::steady_clock::time_point m_startTime;
+    std::chrono::steady_clock::time_point m_validatedTime;
+    std::chrono::steady_clock::time_point m_executedTime;
+    size_t m_startMemory;
+    size_t m_startPeakMemory;
+    size_t m_startCowCopies;
+    size_t m_startCowCopiedBytes;
+  };
+
+  void start();
+  void stop();
+  void clear();
+  /// @return true if algorithm executions are being recorded
+  bool isRunning() const { return m_running; }
+
+  std::vector<AlgorithmProfile> profiles() const;
+  void writeChromeTrace(std::ostream &out) const;
+  void saveChromeTrace(const std::string &filename) const;
+
+private:
+  friend struct Mantid::Kernel::CreateUsingNew<AlgorithmProfilerImpl>;
+
+  AlgorithmProfilerImpl();
+  ~AlgorithmProfilerImpl() = default;
+  AlgorithmProfilerImpl(const AlgorithmProfilerImpl &) = delete;
+  AlgorithmProfilerImpl &operator=(const AlgorithmProfilerImpl &) = delete;
+
+  size_t threadIndex(std::thread::id id);
+  void add(const AlgorithmProfile &profile,
+           const std::chrono::steady_clock::time_point &startTime);
+
+  /// Whether executions are recorded
+  std::atomic<bool> m_running;
+  /// When the profiler was started
+  std::chrono::steady_clock::time_point m_startTime;
+  /// Gives the memory used by the process
+  Kernel::MemoryStats m_memory;
+  /// The recorded executions, in order of completion
+  std::vector<AlgorithmProfile> m_profiles;
+  /// Index of each thread that has run an algorithm
+  std::map<std::thread::id, size_t> m_threads;
+  /// Protects the records
+  mutable std::mutex m_mutex;
+};
+
+typedef Mantid::Kernel::SingletonHolder<AlgorithmProfilerImpl>
+    AlgorithmProfiler;
+
+} // namespace API
+} // namespace Mantid
+
+namespace Mantid {
+namespace Kernel {
+EXTERN_MANTID_API template class MANTID_API_DLL
+    Mantid::Kernel::SingletonHolder<Mantid::API::AlgorithmProfilerImpl>;
+}
+}
+
+#endif /* MANTID_API_ALGORITHMPROFILER_H_ */
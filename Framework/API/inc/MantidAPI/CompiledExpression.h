@@ -0,0 +1,155 @@
+#ifndef MANTID_API_COMPILEDEXPRESSION_H_
+#define MANTID_API_COMPILEDEXPRESSION_H_
+
+#include "MantidAPI/DllConfig.h"
+
+#include <string>
+#include <vector>
+
+namespace Mantid {
+namespace API {
+
+/** CompiledExpression : A formula compiled for evaluation over whole arrays.
+
+  The formula is parsed, with the precedence rules of muParser, into a tree
+  of arithmetic operations, which is evaluated one block of points at a time:
+  every operation is a simple loop over the block, which the compiler can
+  vectorize, and the parts of the formula that do not depend on any array,
+  such as expressions of the fitting parameters, are computed only once per
+  block. The derivatives of the formula with respect to its variables are
+  found symbolically.
+
+  The supported formulas use numbers, the variables, the constants _pi and _e,
+  the operators + - * / ^, unary minus and the functions sin, cos, tan, asin,
+  acos, atan, sinh, cosh, tanh, exp, ln, log2, log10, sqrt, abs, sign, erf and
+  erfc with the same meaning as in muParser. The constructor throws
+  std::invalid_argument for anything else so that the callers can fall back to
+  muParser.
+
+  Copyright &copy; 2017 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_API_DLL CompiledExpression {
+public:
+  /// The value of a variable
+  struct Argument {
+    /// The values at every point, or nullptr if value is used at all points
+    const double *values;
+    /// The value at all points when values is nullptr
+    double value;
+  };
+
+  CompiledExpression(const std::string &formula,
+                     const std::vector<std::string> &variables);
+  /// The derivative with respect to a variable
+  CompiledExpression derivative(size_t variable) const;
+  /// Evaluate the expression at n points
+  void evaluate(const std::vector<Argument> &arguments, double *out,
+                size_t n) const;
+
+private:
+  enum class Function {
+    Sin,
+    Cos,
+    Tan,
+    Asin,
+    Acos,
+    Atan,
+    Sinh,
+    Cosh,
+    Tanh,
+    Exp,
+    Ln,
+    Log2,
+    Log10,
+    Sqrt,
+    Abs,
+    Sign,
+    Erf,
+    Erfc
+  };
+
+  /// A node of the expression tree
+  struct Node {
+    enum class Code {
+      Constant,
+      Variable,
+      Negate,
+      Apply,
+      Add,
+      Subtract,
+      Multiply,
+      Divide,
+      Power
+    };
+    Code code;
+    /// The value of a Constant
+    double value;
+    /// The index of a Variable or the Function to Apply
+    size_t index;
+    /// The first operand
+    size_t left;
+    /// The second operand of binary operations
+    size_t right;
+  };
+
+  /// The values of a node for a block of points
+  struct Block {
+    /// The values, or nullptr if the node has the same value at all points
+    const double *values;
+    double value;
+  };
+
+  explicit CompiledExpression(size_t nVariables) : m_nVariables(nVariables) {}
+  struct Tokens;
+  size_t parseSum(Tokens &tokens, const std::vector<std::string> &variables);
+  size_t parseProduct(Tokens &tokens,
+                      const std::vector<std::string> &variables);
+  size_t parseSigned(Tokens &tokens,
+                     const std::vector<std::string> &variables);
+  size_t parsePrimary(Tokens &tokens,
+                      const std::vector<std::string> &variables);
+  size_t differentiate(size_t node, size_t variable);
+
+  size_t constant(double value);
+  size_t variable(size_t index);
+  size_t negate(size_t operand);
+  size_t apply(Function function, size_t operand);
+  size_t binary(Node::Code code, size_t left, size_t right);
+  bool isConstant(size_t node, double value) const;
+
+  size_t bufferCount(size_t node, size_t level) const;
+  Block evaluate(size_t node, size_t level,
+                 const std::vector<Argument> &arguments, size_t offset,
+                 size_t n, std::vector<std::vector<double>> &buffers) const;
+
+  /// The nodes of the expression and of the subexpressions it shares
+  std::vector<Node> m_nodes;
+  /// The top node
+  size_t m_root = 0;
+  /// Number of variables the expression can use
+  size_t m_nVariables;
+};
+
+} // namespace API
+} // namespace Mantid
+
+#endif /* MANTID_API_COMPILEDEXPRESSION_H_ */
@@ -78,6 +78,8 @@ public:
                 FunctionValues &values) const override;
   /// Derivatives of function with respect to active parameters
   void functionDeriv(const FunctionDomain &domain, Jacobian &jacobian) override;
+  /// Thread safe if all the member functions are
+  bool isThreadSafe() const override;
 
   /// Set i-th parameter
   void setParameter(size_t, const double &value,
@@ -225,6 +227,8 @@ protected:
       const std::string &parentLocalAttributesStr = "") const override;
 
   size_t paramOffset(size_t i) const { return m_paramOffsets[i]; }
+  /// Stamp of the latest change to this function or any of its members
+  size_t evaluationStamp() const override;
 
 private:
   /// Extract function index and parameter name from a variable name
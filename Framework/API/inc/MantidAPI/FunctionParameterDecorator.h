@@ -147,6 +147,9 @@ protected:
   virtual void beforeDecoratedFunctionSet(const IFunction_sptr &fn);
   void setDecoratedFunctionPrivate(const IFunction_sptr &fn);
 
+  /// Stamp of the latest change to this or the decorated function
+  size_t evaluationStamp() const override;
+
   IFunction_sptr m_wrappedFunction;
 };
 
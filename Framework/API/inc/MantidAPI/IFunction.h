@@ -313,7 +313,9 @@ public:
   //---------------------------------------------------------//
 
   /// Constructor
-  IFunction() : m_isParallel(false), m_handler(nullptr), m_chiSquared(0.0) {}
+  IFunction()
+      : m_isParallel(false), m_handler(nullptr), m_chiSquared(0.0),
+        m_evaluationStamp(0), m_evaluationCopiesStamp(0) {}
   /// Virtual destructor
   virtual ~IFunction();
   /// No copying
@@ -526,6 +528,8 @@ public:
   createEquivalentFunctions() const;
   /// Calculate numerical derivatives
   void calNumericalDeriv(const FunctionDomain &domain, Jacobian &jacobian);
+  /// Create a copy with exactly the same parameter values
+  boost::shared_ptr<IFunction> copyForEvaluation() const;
   /// Set the covariance matrix
   void setCovarianceMatrix(boost::shared_ptr<Kernel::Matrix<double>> covar);
   /// Get the covariance matrix
@@ -541,6 +545,13 @@ public:
   void setParallel(bool on) { m_isParallel = on; }
   /// Get the parallel hint
   bool isParallel() const { return m_isParallel; }
+  /// Can independent copies of this function be evaluated concurrently?
+  /// Functions returning true let calNumericalDeriv evaluate the columns
+  /// of the Jacobian on several threads, each using its own clone().
+  virtual bool isThreadSafe() const { return false; }
+  /// The number of function values times the number of active parameters
+  /// below which derivatives are calculated on a single thread
+  static constexpr size_t MIN_WORK_FOR_PARALLEL_DERIVATIVES = 10000;
 
   /// Set a function handler
   void setHandler(FunctionHandler *handler);
@@ -595,6 +606,11 @@ protected:
   virtual std::string
   writeToString(const std::string &parentLocalAttributesStr = "") const;
 
+  /// Discard the copies used to calculate derivatives in parallel
+  void invalidateEvaluationCopies();
+  /// Stamp of the latest change that invalidates the evaluation copies
+  virtual size_t evaluationStamp() const;
+
   friend class ParameterTie;
   friend class CompositeFunction;
   friend class FunctionParameterDecorator;
@@ -610,6 +626,9 @@ protected:
   boost::shared_ptr<Kernel::ProgressBase> m_progReporter;
 
 private:
+  /// Refresh the copies used to calculate derivatives in parallel
+  void updateEvaluationCopies(size_t n);
+
   /// The declared attributes
   std::map<std::string, API::IFunction::Attribute> m_attrs;
   /// The covariance matrix of the fitting parameters
@@ -620,6 +639,12 @@ private:
   std::vector<std::unique_ptr<ParameterTie>> m_ties;
   /// Holds the constraints added to function
   std::vector<std::unique_ptr<IConstraint>> m_constraints;
+  /// Copies of this function used by calNumericalDeriv's threads
+  std::vector<boost::shared_ptr<IFunction>> m_evaluationCopies;
+  /// Stamp of the latest invalidation of this function's copies
+  size_t m_evaluationStamp;
+  /// Value of evaluationStamp() when the copies were made
+  size_t m_evaluationCopiesStamp;
 };
 
 /// shared pointer to the function base class
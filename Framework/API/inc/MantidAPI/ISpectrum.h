@@ -213,6 +213,14 @@ public:
     checkIsYAndEWritable();
     return mutableHistogramRef().mutableE();
   }
+  template <class UnaryOperation> void transformY(UnaryOperation op) & {
+    checkIsYAndEWritable();
+    mutableHistogramRef().transformY(op);
+  }
+  template <class UnaryOperation> void transformE(UnaryOperation op) & {
+    checkIsYAndEWritable();
+    mutableHistogramRef().transformE(op);
+  }
   Kernel::cow_ptr<HistogramData::HistogramX> sharedX() const {
     return histogramRef().sharedX();
   }
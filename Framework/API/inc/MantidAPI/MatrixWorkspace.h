@@ -275,6 +275,14 @@ public:
   HistogramData::HistogramE &mutableE(const size_t index) & {
     return getSpectrum(index).mutableE();
   }
+  template <class UnaryOperation>
+  void transformY(const size_t index, UnaryOperation op) & {
+    getSpectrum(index).transformY(op);
+  }
+  template <class UnaryOperation>
+  void transformE(const size_t index, UnaryOperation op) & {
+    getSpectrum(index).transformE(op);
+  }
   Kernel::cow_ptr<HistogramData::HistogramX> sharedX(const size_t index) const {
     return getSpectrum(index).sharedX();
   }
@@ -1,6 +1,7 @@
 #include "MantidAPI/Algorithm.h"
 #include "MantidAPI/AlgorithmHistory.h"
 #include "MantidAPI/AlgorithmManager.h"
+#include "MantidAPI/AlgorithmProfiler.h"
 #include "MantidAPI/AlgorithmProxy.h"
 #include "MantidAPI/AnalysisDataService.h"
 #include "MantidAPI/DeprecatedAlgorithm.h"
@@ -91,8 +92,8 @@ Algorithm::Algorithm()
       m_recordHistoryForChild(false), m_alwaysStoreInADS(false),
       m_runningAsync(false), m_running(false), m_rethrow(false),
       m_isAlgStartupLoggingEnabled(true), m_startChildProgress(0.),
-      m_endChildProgress(0.), m_algorithmID(this), m_singleGroup(-1),
-      m_groupsHaveSimilarNames(false),
+      m_endChildProgress(0.), m_algorithmID(this), m_nestingDepth(0),
+      m_singleGroup(-1), m_groupsHaveSimilarNames(false),
       m_communicator(Kernel::make_unique<Parallel::Communicator>()) {}
 
 /// Virtual destructor
@@ -441,6 +442,10 @@ bool Algorithm::execute() {
     throw std::runtime_error("Algorithm is not initialised:" + this->name());
   }
 
+  // Record the execution if the profiler is running
+  AlgorithmProfilerImpl::Recording recording(name(), version(), m_nestingDepth);
+  m_nestingDepth = recording.depth();
+
   // Cache the workspace in/out properties for later use
   cacheWorkspaceProperties();
 
@@ -515,6 +520,7 @@ bool Algorithm::execute() {
       }
     }
   }
+  recording.validated();
 
   if (trackingHistory()) {
     // count used for defining the algorithm execution order
@@ -551,6 +557,7 @@ bool Algorithm::execute() {
       Timer timer;
       // Call the concrete algorithm's exec method
       this->exec(getExecutionMode());
+      recording.executed();
       registerFeatureUsage();
       // Check for a cancellation request in case the concrete algorithm doesn't
       interruption_point();
@@ -735,6 +742,8 @@ Algorithm_sptr Algorithm::createChildAlgorithm(const std::string &name,
   // set as a child
   alg->setChild(true);
   alg->setLogging(enableLogging);
+  // The child may be run on another thread, so pass on the nesting depth
+  alg->m_nestingDepth = m_nestingDepth + 1;
 
   // Initialise the Child Algorithm
   try {
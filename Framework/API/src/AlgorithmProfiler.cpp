@@ -0,0 +1,231 @@
+#include "MantidAPI/AlgorithmProfiler.h"
+#include "MantidKernel/CowPtrStatistics.h"
+#include "MantidKernel/Exception.h"
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <ostream>
+#include <utility>
+
+namespace Mantid {
+namespace API {
+
+namespace {
+/// Nesting depth of an algorithm started next on the current thread
+thread_local size_t nextDepth = 0;
+
+/// @return the duration in seconds
+double seconds(const std::chrono::steady_clock::duration &duration) {
+  return std::chrono::duration<double>(duration).count();
+}
+
+/// Write a string as a quoted JSON string
+void writeJSONString(std::ostream &out, const std::string &value) {
+  out << '"';
+  for (const char c : value) {
+    if (c == '"' || c == '\\')
+      out << '\\';
+    out << c;
+  }
+  out << '"';
+}
+
+/// @return true if a phase end time has been set
+bool isSet(const std::chrono::steady_clock::time_point &time) {
+  return time != std::chrono::steady_clock::time_point();
+}
+
+/// Write a Chrome trace "complete" event, leaving the JSON object open for
+/// more fields
+void writeCompleteEvent(std::ostream &out, const std::string &name,
+                        const std::string &category, size_t thread,
+                        double start, double duration) {
+  out << "\n{\"name\":";
+  writeJSONString(out, name);
+  out << ",\"cat\":\"" << category << "\",\"ph\":\"X\",\"pid\":0"
+      << ",\"tid\":" << thread
+      << ",\"ts\":" << static_cast<int64_t>(start * 1e6)
+      << ",\"dur\":" << static_cast<int64_t>(duration * 1e6);
+}
+}
+
+//----------------------------------------------------------------------------------------------
+/** Start recording an algorithm execution if the profiler is running.
+ * @param name :: name of the algorithm
+ * @param version :: version of the algorithm
+ * @param depth :: nesting depth known from the parent algorithm, which may
+ * run on another thread. The depth of the algorithms already running on this
+ * thread is used if it is larger.
+ */
+AlgorithmProfilerImpl::Recording::Recording(const std::string &name,
+                                            int version, size_t depth)
+    : m_active(AlgorithmProfiler::Instance().isRunning()),
+      m_enclosingDepth(nextDepth) {
+  m_profile.depth = depth;
+  if (!m_active)
+    return;
+  m_profile.name = name;
+  m_profile.version = version;
+  m_profile.depth = std::max(depth, m_enclosingDepth);
+  nextDepth = m_profile.depth + 1;
+  const auto &memory = AlgorithmProfiler::Instance().m_memory;
+  m_startMemory = memory.getCurrentRSS();
+  m_startPeakMemory = memory.getPeakRSS();
+  m_startCowCopies = Kernel::CowPtrStatistics::copies();
+  m_startCowCopiedBytes = Kernel::CowPtrStatistics::copiedBytes();
+  m_startTime = std::chrono::steady_clock::now();
+}
+
+/// Mark the end of the validation of the properties and inputs
+void AlgorithmProfilerImpl::Recording::validated() {
+  if (m_active)
+    m_validatedTime = std::chrono::steady_clock::now();
+}
+
+/// Mark the end of exec()
+void AlgorithmProfilerImpl::Recording::executed() {
+  if (m_active)
+    m_executedTime = std::chrono::steady_clock::now();
+}
+
+/// Store the record of the execution. Phases that were not reached, e.g.
+/// because an exception was thrown, take no time.
+AlgorithmProfilerImpl::Recording::~Recording() {
+  if (!m_active)
+    return;
+  const auto endTime = std::chrono::steady_clock::now();
+  nextDepth = m_enclosingDepth;
+
+  const auto validatedTime = isSet(m_validatedTime) ? m_validatedTime : endTime;
+  const auto executedTime = isSet(m_executedTime) ? m_executedTime : endTime;
+  m_profile.wallTime = seconds(endTime - m_startTime);
+  m_profile.validationTime = seconds(validatedTime - m_startTime);
+  m_profile.execTime = seconds(executedTime - validatedTime);
+  m_profile.finaliseTime = seconds(endTime - executedTime);
+
+  auto &profiler = AlgorithmProfiler::Instance();
+  // Memory is reported in bytes
+  m_profile.memoryChange =
+      (static_cast<int64_t>(profiler.m_memory.getCurrentRSS()) -
+       static_cast<int64_t>(m_startMemory)) /
+      1024;
+  m_profile.peakMemoryIncrease =
+      (static_cast<int64_t>(profiler.m_memory.getPeakRSS()) -
+       static_cast<int64_t>(m_startPeakMemory)) /
+      1024;
+  m_profile.cowCopies = Kernel::CowPtrStatistics::copies() - m_startCowCopies;
+  m_profile.cowCopiedBytes =
+      Kernel::CowPtrStatistics::copiedBytes() - m_startCowCopiedBytes;
+  profiler.add(m_profile, m_startTime);
+}
+
+//----------------------------------------------------------------------------------------------
+/// Private constructor for singleton class
+AlgorithmProfilerImpl::AlgorithmProfilerImpl()
+    : m_running(false), m_startTime(std::chrono::steady_clock::now()),
+      m_memory(Kernel::MEMORY_STATS_IGNORE_SYSTEM) {}
+
+/** Start recording algorithm executions. The start times of the records are
+ * measured from the first start after the records were cleared.
+ */
+void AlgorithmProfilerImpl::start() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (m_profiles.empty())
+    m_startTime = std::chrono::steady_clock::now();
+  m_running = true;
+}
+
+/// Stop recording algorithm executions. Algorithms running now are recorded.
+void AlgorithmProfilerImpl::stop() { m_running = false; }
+
+/// Discard all the records
+void AlgorithmProfilerImpl::clear() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_profiles.clear();
+  m_threads.clear();
+  m_startTime = std::chrono::steady_clock::now();
+}
+
+/// @return the records of the executions, in order of completion
+std::vector<AlgorithmProfile> AlgorithmProfilerImpl::profiles() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_profiles;
+}
+
+//----------------------------------------------------------------------------------------------
+/** Write the records in the Chrome trace event format: a JSON object with an
+ * event of type "complete" for each execution, and one for each of its
+ * phases nested inside it.
+ * @param out :: stream to write to
+ */
+void AlgorithmProfilerImpl::writeChromeTrace(std::ostream &out) const {
+  const auto records = profiles();
+  out << "{\"traceEvents\":[";
+  bool first = true;
+  for (const auto &record : records) {
+    if (!first)
+      out << ",";
+    first = false;
+    writeCompleteEvent(out, record.name, "algorithm", record.thread,
+                       record.start, record.wallTime);
+    out << ",\"args\":{\"version\":" << record.version
+        << ",\"depth\":" << record.depth
+        << ",\"memory_change_kib\":" << record.memoryChange
+        << ",\"peak_memory_increase_kib\":" << record.peakMemoryIncrease
+        << ",\"cow_copies\":" << record.cowCopies
+        << ",\"cow_copied_bytes\":" << record.cowCopiedBytes << "}}";
+
+    const std::array<std::pair<const char *, double>, 3> phases{
+        {{"validation", record.validationTime},
+         {"exec", record.execTime},
+         {"finalise", record.finaliseTime}}};
+    double phaseStart = record.start;
+    for (const auto &phase : phases) {
+      out << ",";
+      writeCompleteEvent(out, record.name + " " + phase.first, "phase",
+                         record.thread, phaseStart, phase.second);
+      out << "}";
+      phaseStart += phase.second;
+    }
+  }
+  out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+}
+
+/** Save the records as a Chrome trace file
+ * @param filename :: path of the file to write
+ * @throw FileError if the file cannot be written
+ */
+void AlgorithmProfilerImpl::saveChromeTrace(const std::string &filename) const {
+  std::ofstream out(filename.c_str());
+  if (!out)
+    throw Kernel::Exception::FileError("Unable to open file", filename);
+  writeChromeTrace(out);
+  if (!out)
+    throw Kernel::Exception::FileError("Failed to write file", filename);
+}
+
+//----------------------------------------------------------------------------------------------
+/** Store a record. The caller must not hold the mutex.
+ * @param profile :: the record, whose start and thread are filled in here
+ * @param startTime :: when the execution started
+ */
+void AlgorithmProfilerImpl::add(
+    const AlgorithmProfile &profile,
+    const std::chrono::steady_clock::time_point &startTime) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_profiles.push_back(profile);
+  m_profiles.back().start = seconds(startTime - m_startTime);
+  m_profiles.back().thread = threadIndex(std::this_thread::get_id());
+}
+
+/** @return the index of a thread, in the order in which threads were first
+ * seen. The caller must hold the mutex.
+ * @param id :: ID of the thread
+ */
+size_t AlgorithmProfilerImpl::threadIndex(std::thread::id id) {
+  return m_threads.emplace(id, m_threads.size()).first->second;
+}
+
+} // namespace API
+} // namespace Mantid
@@ -0,0 +1,668 @@
+#include "MantidAPI/CompiledExpression.h"
+
+#include <boost/lexical_cast.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+namespace Mantid {
+namespace API {
+
+namespace {
+/// Number of points evaluated at a time, chosen so that the intermediate
+/// results stay in the cache
+constexpr size_t BLOCK_SIZE = 256;
+
+/// Functions of one argument known to muParser and their derivatives
+const std::vector<std::string> FUNCTION_NAMES = {
+    "sin",  "cos", "tan",  "asin", "acos",  "atan", "sinh", "cosh", "tanh",
+    "exp",  "ln",  "log2", "log10", "sqrt", "abs",  "sign", "erf",  "erfc"};
+
+/// The sign of a number as defined by muParser
+double sign(double x) { return x < 0.0 ? -1.0 : (x > 0.0 ? 1.0 : 0.0); }
+
+/// Apply an operation of one argument to a block of values
+template <typename Op>
+const double *transform(const double *in, double *out, size_t n, Op op) {
+  for (size_t i = 0; i < n; ++i) {
+    out[i] = op(in[i]);
+  }
+  return out;
+}
+
+/// Apply a binary operation to two blocks, either of which may be a single
+/// value
+template <typename Op>
+const double *combine(const double *left, double leftValue,
+                      const double *right, double rightValue, double *out,
+                      size_t n, Op op) {
+  if (left && right) {
+    for (size_t i = 0; i < n; ++i) {
+      out[i] = op(left[i], right[i]);
+    }
+  } else if (left) {
+    for (size_t i = 0; i < n; ++i) {
+      out[i] = op(left[i], rightValue);
+    }
+  } else {
+    for (size_t i = 0; i < n; ++i) {
+      out[i] = op(leftValue, right[i]);
+    }
+  }
+  return out;
+}
+} // namespace
+
+/// The tokens of a formula: numbers, names, operators and brackets
+struct CompiledExpression::Tokens {
+  explicit Tokens(const std::string &formula);
+  /// The next token, or an empty string at the end of the formula
+  const std::string &peek() const {
+    return next < items.size() ? items[next] : end;
+  }
+  /// Remove the next token
+  std::string take() { return next < items.size() ? items[next++] : end; }
+  std::vector<std::string> items;
+  size_t next = 0;
+  const std::string end;
+};
+
+/// Split a formula into tokens
+CompiledExpression::Tokens::Tokens(const std::string &formula) {
+  const auto isName = [](char c) {
+    return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+  };
+  size_t i = 0;
+  while (i < formula.size()) {
+    const char c = formula[i];
+    if (std::isspace(static_cast<unsigned char>(c))) {
+      ++i;
+      continue;
+    }
+    size_t j = i + 1;
+    if (std::isdigit(static_cast<unsigned char>(c)) || c == '.') {
+      // A number with an optional exponent such as 1.5e-3
+      while (j < formula.size() &&
+             (std::isalnum(static_cast<unsigned char>(formula[j])) ||
+              formula[j] == '.' ||
+              ((formula[j] == '-' || formula[j] == '+') &&
+               (formula[j - 1] == 'e' || formula[j - 1] == 'E')))) {
+        ++j;
+      }
+    } else if (isName(c)) {
+      while (j < formula.size() && isName(formula[j])) {
+        ++j;
+      }
+    }
+    items.push_back(formula.substr(i, j - i));
+    i = j;
+  }
+}
+
+/**
+ * Compile a formula.
+ * @param formula :: The formula in the syntax of muParser.
+ * @param variables :: The names of the variables the formula may use. They
+ * are referred to by their index in this list.
+ * @throw std::invalid_argument if the formula cannot be compiled.
+ */
+CompiledExpression::CompiledExpression(
+    const std::string &formula, const std::vector<std::string> &variables)
+    : m_nVariables(variables.size()) {
+  Tokens tokens(formula);
+  m_root = parseSum(tokens, variables);
+  if (!tokens.peek().empty()) {
+    throw std::invalid_argument("Unexpected " + tokens.peek() +
+                                " in formula " + formula);
+  }
+}
+
+/**
+ * Find the derivative of the expression with respect to a variable.
+ * @param variable :: The index of the variable.
+ * @return The derivative, which shares the nodes of this expression.
+ */
+CompiledExpression CompiledExpression::derivative(size_t variable) const {
+  if (variable >= m_nVariables) {
+    throw std::out_of_range("Variable index out of range.");
+  }
+  CompiledExpression result(m_nVariables);
+  result.m_nodes = m_nodes;
+  result.m_root = result.differentiate(m_root, variable);
+  return result;
+}
+
+/**
+ * Evaluate the expression.
+ * @param arguments :: The values of the variables in the order they were
+ * given to the constructor.
+ * @param out :: An array of n values receiving the result.
+ * @param n :: The number of points.
+ */
+void CompiledExpression::evaluate(const std::vector<Argument> &arguments,
+                                  double *out, size_t n) const {
+  if (arguments.size() != m_nVariables) {
+    throw std::invalid_argument("Wrong number of arguments of an expression.");
+  }
+  std::vector<std::vector<double>> buffers(bufferCount(m_root, 0));
+  for (auto &buffer : buffers) {
+    buffer.resize(std::min(n, BLOCK_SIZE));
+  }
+  for (size_t offset = 0; offset < n; offset += BLOCK_SIZE) {
+    const size_t size = std::min(BLOCK_SIZE, n - offset);
+    const auto block = evaluate(m_root, 0, arguments, offset, size, buffers);
+    if (block.values) {
+      std::copy(block.values, block.values + size, out + offset);
+    } else {
+      std::fill(out + offset, out + offset + size, block.value);
+    }
+  }
+}
+
+/**
+ * Add the nodes of a sum or difference of products.
+ * @param tokens :: The formula.
+ * @param variables :: The names of the variables.
+ * @return The index of the top node.
+ */
+size_t CompiledExpression::parseSum(Tokens &tokens,
+                                    const std::vector<std::string> &variables) {
+  auto result = parseProduct(tokens, variables);
+  while (tokens.peek() == "+" || tokens.peek() == "-") {
+    const auto code =
+        tokens.take() == "+" ? Node::Code::Add : Node::Code::Subtract;
+    result = binary(code, result, parseProduct(tokens, variables));
+  }
+  return result;
+}
+
+/// Add the nodes of a product or quotient of signed powers
+size_t
+CompiledExpression::parseProduct(Tokens &tokens,
+                                 const std::vector<std::string> &variables) {
+  auto result = parseSigned(tokens, variables);
+  while (tokens.peek() == "*" || tokens.peek() == "/") {
+    const auto code =
+        tokens.take() == "*" ? Node::Code::Multiply : Node::Code::Divide;
+    result = binary(code, result, parseSigned(tokens, variables));
+  }
+  return result;
+}
+
+/**
+ * Add the nodes of a power with optional signs. As in muParser, the signs
+ * bind less tightly than ^, so -x^2 is -(x^2).
+ */
+size_t
+CompiledExpression::parseSigned(Tokens &tokens,
+                                const std::vector<std::string> &variables) {
+  if (tokens.peek() == "-") {
+    tokens.take();
+    return negate(parseSigned(tokens, variables));
+  }
+  if (tokens.peek() == "+") {
+    tokens.take();
+    return parseSigned(tokens, variables);
+  }
+  const auto base = parsePrimary(tokens, variables);
+  if (tokens.peek() != "^") {
+    return base;
+  }
+  tokens.take();
+  size_t exponent = 0;
+  if (tokens.peek() == "-" || tokens.peek() == "+") {
+    const bool isNegative = tokens.take() == "-";
+    exponent = parsePrimary(tokens, variables);
+    if (isNegative) {
+      exponent = negate(exponent);
+    }
+  } else {
+    exponent = parsePrimary(tokens, variables);
+  }
+  // The associativity of ^ differs between versions of muParser
+  if (tokens.peek() == "^") {
+    throw std::invalid_argument("Repeated powers need brackets.");
+  }
+  return binary(Node::Code::Power, base, exponent);
+}
+
+/// Add the nodes of a number, a variable, a function call or an expression
+/// in brackets
+size_t
+CompiledExpression::parsePrimary(Tokens &tokens,
+                                 const std::vector<std::string> &variables) {
+  const auto token = tokens.take();
+  if (token == "(") {
+    const auto result = parseSum(tokens, variables);
+    if (tokens.take() != ")") {
+      throw std::invalid_argument("Missing closing bracket.");
+    }
+    return result;
+  }
+  if (token.empty()) {
+    throw std::invalid_argument("Unexpected end of formula.");
+  }
+  if (std::isdigit(static_cast<unsigned char>(token.front())) ||
+      token.front() == '.') {
+    try {
+      return constant(boost::lexical_cast<double>(token));
+    } catch (boost::bad_lexical_cast &) {
+      throw std::invalid_argument("Invalid number " + token);
+    }
+  }
+  if (tokens.peek() == "(") {
+    const auto function =
+        std::find(FUNCTION_NAMES.cbegin(), FUNCTION_NAMES.cend(), token);
+    if (function == FUNCTION_NAMES.cend()) {
+      throw std::invalid_argument("Unsupported function " + token);
+    }
+    const auto argument = parsePrimary(tokens, variables);
+    return apply(static_cast<Function>(
+                     std::distance(FUNCTION_NAMES.cbegin(), function)),
+                 argument);
+  }
+  const auto known = std::find(variables.cbegin(), variables.cend(), token);
+  if (known != variables.cend()) {
+    return variable(std::distance(variables.cbegin(), known));
+  }
+  if (token == "_pi") {
+    return constant(M_PI);
+  }
+  if (token == "_e") {
+    return constant(M_E);
+  }
+  throw std::invalid_argument("Unsupported name " + token);
+}
+
+/**
+ * Add the nodes of the derivative of a node.
+ * @param node :: The index of the node.
+ * @param variable :: The index of the variable.
+ * @return The index of the node of the derivative.
+ */
+size_t CompiledExpression::differentiate(size_t node, size_t variable) {
+  // The nodes vector grows below, so take a copy
+  const Node n = m_nodes[node];
+  switch (n.code) {
+  case Node::Code::Constant:
+    return constant(0.0);
+  case Node::Code::Variable:
+    return constant(n.index == variable ? 1.0 : 0.0);
+  case Node::Code::Negate:
+    return negate(differentiate(n.left, variable));
+  case Node::Code::Add:
+  case Node::Code::Subtract:
+    return binary(n.code, differentiate(n.left, variable),
+                  differentiate(n.right, variable));
+  case Node::Code::Multiply: {
+    const auto dLeft = differentiate(n.left, variable);
+    const auto dRight = differentiate(n.right, variable);
+    return binary(Node::Code::Add, binary(Node::Code::Multiply, dLeft, n.right),
+                  binary(Node::Code::Multiply, n.left, dRight));
+  }
+  case Node::Code::Divide: {
+    // (u/v)' = u'/v - (u/v)*v'/v
+    const auto dLeft = differentiate(n.left, variable);
+    const auto dRight = differentiate(n.right, variable);
+    return binary(
+        Node::Code::Subtract, binary(Node::Code::Divide, dLeft, n.right),
+        binary(Node::Code::Divide, binary(Node::Code::Multiply, node, dRight),
+               n.right));
+  }
+  case Node::Code::Power: {
+    const auto dBase = differentiate(n.left, variable);
+    const auto dExponent = differentiate(n.right, variable);
+    if (isConstant(dExponent, 0.0)) {
+      // (u^c)' = c*u^(c-1)*u'
+      const auto lower = binary(Node::Code::Subtract, n.right, constant(1.0));
+      return binary(Node::Code::Multiply,
+                    binary(Node::Code::Multiply, n.right,
+                           binary(Node::Code::Power, n.left, lower)),
+                    dBase);
+    }
+    // (u^v)' = u^v*(v'*ln(u) + v*u'/u)
+    const auto logTerm = binary(Node::Code::Multiply, dExponent,
+                                apply(Function::Ln, n.left));
+    const auto baseTerm =
+        binary(Node::Code::Divide,
+               binary(Node::Code::Multiply, n.right, dBase), n.left);
+    return binary(Node::Code::Multiply, node,
+                  binary(Node::Code::Add, logTerm, baseTerm));
+  }
+  case Node::Code::Apply:
+    break;
+  }
+
+  const auto u = n.left;
+  const auto dOperand = differentiate(u, variable);
+  if (isConstant(dOperand, 0.0)) {
+    return dOperand;
+  }
+  const auto square = [this, u]() {
+    return binary(Node::Code::Multiply, u, u);
+  };
+  size_t outer = 0;
+  switch (static_cast<Function>(n.index)) {
+  case Function::Sin:
+    outer = apply(Function::Cos, u);
+    break;
+  case Function::Cos:
+    outer = negate(apply(Function::Sin, u));
+    break;
+  case Function::Tan:
+    outer = binary(Node::Code::Add, constant(1.0),
+                   binary(Node::Code::Multiply, node, node));
+    break;
+  case Function::Asin:
+  case Function::Acos:
+    outer = binary(Node::Code::Divide, constant(1.0),
+                   apply(Function::Sqrt, binary(Node::Code::Subtract,
+                                                constant(1.0), square())));
+    if (static_cast<Function>(n.index) == Function::Acos) {
+      outer = negate(outer);
+    }
+    break;
+  case Function::Atan:
+    outer = binary(Node::Code::Divide, constant(1.0),
+                   binary(Node::Code::Add, constant(1.0), square()));
+    break;
+  case Function::Sinh:
+    outer = apply(Function::Cosh, u);
+    break;
+  case Function::Cosh:
+    outer = apply(Function::Sinh, u);
+    break;
+  case Function::Tanh:
+    outer = binary(Node::Code::Subtract, constant(1.0),
+                   binary(Node::Code::Multiply, node, node));
+    break;
+  case Function::Exp:
+    outer = node;
+    break;
+  case Function::Ln:
+    outer = binary(Node::Code::Divide, constant(1.0), u);
+    break;
+  case Function::Log2:
+    outer = binary(Node::Code::Divide, constant(1.0 / M_LN2), u);
+    break;
+  case Function::Log10:
+    outer = binary(Node::Code::Divide, constant(1.0 / M_LN10), u);
+    break;
+  case Function::Sqrt:
+    outer = binary(Node::Code::Divide, constant(0.5), node);
+    break;
+  case Function::Abs:
+    outer = apply(Function::Sign, u);
+    break;
+  case Function::Sign:
+    return constant(0.0);
+  case Function::Erf:
+  case Function::Erfc:
+    outer = binary(Node::Code::Multiply, constant(M_2_SQRTPI),
+                   apply(Function::Exp, negate(square())));
+    if (static_cast<Function>(n.index) == Function::Erfc) {
+      outer = negate(outer);
+    }
+    break;
+  }
+  return binary(Node::Code::Multiply, outer, dOperand);
+}
+
+/// Add a constant node
+size_t CompiledExpression::constant(double value) {
+  m_nodes.push_back({Node::Code::Constant, value, 0, 0, 0});
+  return m_nodes.size() - 1;
+}
+
+/// Add a variable node
+size_t CompiledExpression::variable(size_t index) {
+  m_nodes.push_back({Node::Code::Variable, 0.0, index, 0, 0});
+  return m_nodes.size() - 1;
+}
+
+/// Add a node changing the sign of its operand
+size_t CompiledExpression::negate(size_t operand) {
+  if (m_nodes[operand].code == Node::Code::Constant) {
+    return constant(-m_nodes[operand].value);
+  }
+  m_nodes.push_back({Node::Code::Negate, 0.0, 0, operand, 0});
+  return m_nodes.size() - 1;
+}
+
+/// Add a node applying a function to its operand
+size_t CompiledExpression::apply(Function function, size_t operand) {
+  m_nodes.push_back(
+      {Node::Code::Apply, 0.0, static_cast<size_t>(function), operand, 0});
+  if (m_nodes[operand].code != Node::Code::Constant) {
+    return m_nodes.size() - 1;
+  }
+  std::vector<std::vector<double>> noBuffers;
+  const auto folded = evaluate(m_nodes.size() - 1, 0, {}, 0, 1, noBuffers);
+  m_nodes.pop_back();
+  return constant(folded.value);
+}
+
+/**
+ * Add a node of a binary operation. Operations of constants are computed
+ * right away and the operations with 0 and 1 that do not change the other
+ * operand are left out, which keeps the derivatives short.
+ */
+size_t CompiledExpression::binary(Node::Code code, size_t left, size_t right) {
+  switch (code) {
+  case Node::Code::Add:
+    if (isConstant(left, 0.0))
+      return right;
+    if (isConstant(right, 0.0))
+      return left;
+    break;
+  case Node::Code::Subtract:
+    if (isConstant(right, 0.0))
+      return left;
+    if (isConstant(left, 0.0))
+      return negate(right);
+    break;
+  case Node::Code::Multiply:
+    if (isConstant(left, 0.0) || isConstant(right, 1.0))
+      return left;
+    if (isConstant(right, 0.0) || isConstant(left, 1.0))
+      return right;
+    break;
+  case Node::Code::Divide:
+    if (isConstant(left, 0.0) || isConstant(right, 1.0))
+      return left;
+    break;
+  case Node::Code::Power:
+    if (isConstant(right, 1.0))
+      return left;
+    if (isConstant(right, 0.0))
+      return constant(1.0);
+    break;
+  default:
+    throw std::logic_error("Not a binary operation.");
+  }
+  m_nodes.push_back({code, 0.0, 0, left, right});
+  if (m_nodes[left].code != Node::Code::Constant ||
+      m_nodes[right].code != Node::Code::Constant) {
+    return m_nodes.size() - 1;
+  }
+  std::vector<std::vector<double>> noBuffers;
+  const auto folded = evaluate(m_nodes.size() - 1, 0, {}, 0, 1, noBuffers);
+  m_nodes.pop_back();
+  return constant(folded.value);
+}
+
+/// Check if a node is a constant with the given value
+bool CompiledExpression::isConstant(size_t node, double value) const {
+  return m_nodes[node].code == Node::Code::Constant &&
+         m_nodes[node].value == value;
+}
+
+/**
+ * The number of buffers needed to evaluate a node. A node evaluated at a
+ * level stores its values in the buffer of that level and its operands use
+ * the buffers of the following levels.
+ * @param node :: The index of the node.
+ * @param level :: The level of the node.
+ */
+size_t CompiledExpression::bufferCount(size_t node, size_t level) const {
+  const auto &n = m_nodes[node];
+  switch (n.code) {
+  case Node::Code::Constant:
+  case Node::Code::Variable:
+    return 0;
+  case Node::Code::Negate:
+  case Node::Code::Apply:
+    return std::max(level + 1, bufferCount(n.left, level + 1));
+  default:
+    return std::max({level + 1, bufferCount(n.left, level + 1),
+                     bufferCount(n.right, level + 2)});
+  }
+}
+
+/**
+ * Evaluate a node for a block of points.
+ * @param node :: The index of the node.
+ * @param level :: The level of the node, which selects its buffer.
+ * @param arguments :: The values of the variables.
+ * @param offset :: The index of the first point of the block.
+ * @param n :: The number of points in the block.
+ * @param buffers :: Storage for the intermediate results.
+ * @return The values of the node.
+ */
+CompiledExpression::Block CompiledExpression::evaluate(
+    size_t node, size_t level, const std::vector<Argument> &arguments,
+    size_t offset, size_t n, std::vector<std::vector<double>> &buffers) const {
+  const auto &nd = m_nodes[node];
+  switch (nd.code) {
+  case Node::Code::Constant:
+    return {nullptr, nd.value};
+  case Node::Code::Variable: {
+    const auto &argument = arguments[nd.index];
+    if (argument.values) {
+      return {argument.values + offset, 0.0};
+    }
+    return {nullptr, argument.value};
+  }
+  default:
+    break;
+  }
+
+  const auto operand =
+      evaluate(nd.left, level + 1, arguments, offset, n, buffers);
+  if (nd.code == Node::Code::Negate || nd.code == Node::Code::Apply) {
+    const double *in = operand.values ? operand.values : &operand.value;
+    double single = 0.0;
+    double *out = operand.values ? buffers[level].data() : &single;
+    const size_t size = operand.values ? n : 1;
+    if (nd.code == Node::Code::Negate) {
+      transform(in, out, size, [](double x) { return -x; });
+    } else {
+      switch (static_cast<Function>(nd.index)) {
+      case Function::Sin:
+        transform(in, out, size, [](double x) { return std::sin(x); });
+        break;
+      case Function::Cos:
+        transform(in, out, size, [](double x) { return std::cos(x); });
+        break;
+      case Function::Tan:
+        transform(in, out, size, [](double x) { return std::tan(x); });
+        break;
+      case Function::Asin:
+        transform(in, out, size, [](double x) { return std::asin(x); });
+        break;
+      case Function::Acos:
+        transform(in, out, size, [](double x) { return std::acos(x); });
+        break;
+      case Function::Atan:
+        transform(in, out, size, [](double x) { return std::atan(x); });
+        break;
+      case Function::Sinh:
+        transform(in, out, size, [](double x) { return std::sinh(x); });
+        break;
+      case Function::Cosh:
+        transform(in, out, size, [](double x) { return std::cosh(x); });
+        break;
+      case Function::Tanh:
+        transform(in, out, size, [](double x) { return std::tanh(x); });
+        break;
+      case Function::Exp:
+        transform(in, out, size, [](double x) { return std::exp(x); });
+        break;
+      case Function::Ln:
+        transform(in, out, size, [](double x) { return std::log(x); });
+        break;
+      case Function::Log2:
+        transform(in, out, size, [](double x) { return std::log2(x); });
+        break;
+      case Function::Log10:
+        transform(in, out, size, [](double x) { return std::log10(x); });
+        break;
+      case Function::Sqrt:
+        transform(in, out, size, [](double x) { return std::sqrt(x); });
+        break;
+      case Function::Abs:
+        transform(in, out, size, [](double x) { return std::fabs(x); });
+        break;
+      case Function::Sign:
+        transform(in, out, size, sign);
+        break;
+      case Function::Erf:
+        transform(in, out, size, [](double x) { return std::erf(x); });
+        break;
+      case Function::Erfc:
+        transform(in, out, size, [](double x) { return std::erfc(x); });
+        break;
+      }
+    }
+    return operand.values ? Block{out, 0.0} : Block{nullptr, single};
+  }
+
+  const auto other =
+      evaluate(nd.right, level + 2, arguments, offset, n, buffers);
+  const bool isArray = operand.values || other.values;
+  double single = 0.0;
+  double *out = isArray ? buffers[level].data() : &single;
+  const size_t size = isArray ? n : 1;
+  const double *left = operand.values;
+  const double *right = other.values;
+  if (!isArray) {
+    // Two single values go through the loops as arrays of size one
+    left = &operand.value;
+    right = &other.value;
+  }
+  switch (nd.code) {
+  case Node::Code::Add:
+    combine(left, operand.value, right, other.value, out, size,
+            [](double x, double y) { return x + y; });
+    break;
+  case Node::Code::Subtract:
+    combine(left, operand.value, right, other.value, out, size,
+            [](double x, double y) { return x - y; });
+    break;
+  case Node::Code::Multiply:
+    combine(left, operand.value, right, other.value, out, size,
+            [](double x, double y) { return x * y; });
+    break;
+  case Node::Code::Divide:
+    combine(left, operand.value, right, other.value, out, size,
+            [](double x, double y) { return x / y; });
+    break;
+  case Node::Code::Power:
+    if (left && !right && other.value == 2.0) {
+      transform(left, out, size, [](double x) { return x * x; });
+    } else {
+      combine(left, operand.value, right, other.value, out, size,
+              [](double x, double y) { return std::pow(x, y); });
+    }
+    break;
+  default:
+    break;
+  }
+  return isArray ? Block{out, 0.0} : Block{nullptr, single};
+}
+
+} // namespace API
+} // namespace Mantid
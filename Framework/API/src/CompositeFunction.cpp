@@ -7,12 +7,14 @@
 #include "MantidAPI/FunctionFactory.h"
 #include "MantidKernel/Exception.h"
 #include "MantidKernel/Logger.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/Strings.h"
 
 #include <boost/lexical_cast.hpp>
 #include <boost/shared_array.hpp>
 #include <sstream>
 #include <algorithm>
+#include <exception>
 
 namespace Mantid {
 namespace API {
@@ -164,13 +166,45 @@ void CompositeFunction::functionDeriv(const FunctionDomain &domain,
   if (getAttribute("NumDeriv").asBool()) {
     calNumericalDeriv(domain, jacobian);
   } else {
-    for (size_t iFun = 0; iFun < nFunctions(); ++iFun) {
-      PartialJacobian J(&jacobian, paramOffset(iFun));
-      getFunction(iFun)->functionDeriv(domain, J);
+    // The members fill separate columns of the Jacobian and, if they are
+    // all thread safe and there is enough work, can do it at the same time.
+    const int n = static_cast<int>(nFunctions());
+    const size_t work = getValuesSize(domain) * nParams();
+    const bool parallel = n > 1 && work >= MIN_WORK_FOR_PARALLEL_DERIVATIVES &&
+                          PARALLEL_GET_MAX_THREADS > 1 &&
+                          PARALLEL_NUMBER_OF_THREADS == 1 && isThreadSafe();
+    std::exception_ptr error;
+    PARALLEL_FOR_IF(parallel)
+    for (int iFun = 0; iFun < n; ++iFun) {
+      try {
+        const auto i = static_cast<size_t>(iFun);
+        PartialJacobian J(&jacobian, paramOffset(i));
+        getFunction(i)->functionDeriv(domain, J);
+      } catch (...) {
+        PARALLEL_CRITICAL(composite_deriv_error) {
+          if (!error) {
+            error = std::current_exception();
+          }
+        }
+      }
+    }
+    if (error) {
+      std::rethrow_exception(error);
     }
   }
 }
 
+/**
+ * A composite function can be evaluated concurrently with its copies if
+ * all its members can.
+ */
+bool CompositeFunction::isThreadSafe() const {
+  return std::all_of(m_functions.cbegin(), m_functions.cend(),
+                     [](const IFunction_sptr &fun) {
+                       return fun->isThreadSafe();
+                     });
+}
+
 /** Sets a new value to the i-th parameter.
  *  @param i :: The parameter index
  *  @param value :: The new value
@@ -385,6 +419,7 @@ void CompositeFunction::checkFunction() {
  * Remove all member functions
  */
 void CompositeFunction::clear() {
+  invalidateEvaluationCopies();
   m_nParams = 0;
   m_paramOffsets.clear();
   m_IFunction.clear();
@@ -396,6 +431,7 @@ void CompositeFunction::clear() {
  * @return The function index
  */
 size_t CompositeFunction::addFunction(IFunction_sptr f) {
+  invalidateEvaluationCopies();
   m_IFunction.insert(m_IFunction.end(), f->nParams(), m_functions.size());
   m_functions.push_back(f);
   //?f->init();
@@ -419,6 +455,7 @@ void CompositeFunction::removeFunction(size_t i) {
                             ").");
   }
 
+  invalidateEvaluationCopies();
   IFunction_sptr fun = getFunction(i);
   // Reduction in parameters
   size_t dnp = fun->nParams();
@@ -483,6 +520,7 @@ void CompositeFunction::replaceFunction(size_t i, IFunction_sptr f) {
                             ").");
   }
 
+  invalidateEvaluationCopies();
   IFunction_sptr fun = getFunction(i);
   size_t np_old = fun->nParams();
 
@@ -519,6 +557,19 @@ void CompositeFunction::replaceFunction(size_t i, IFunction_sptr f) {
   m_functions[i] = f;
 }
 
+/**
+ * The evaluation copies of a composite function also hold copies of its
+ * members, so they are out of date after a change to any of them.
+ * @return The latest stamp of this function and its members
+ */
+size_t CompositeFunction::evaluationStamp() const {
+  auto stamp = IFunction::evaluationStamp();
+  for (const auto &fun : m_functions) {
+    stamp = std::max(stamp, fun->evaluationStamp());
+  }
+  return stamp;
+}
+
 /**
  * @param i :: The index of the function
  * @return function at the requested index
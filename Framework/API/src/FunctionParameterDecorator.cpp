@@ -5,6 +5,8 @@
 #include "MantidAPI/ParameterReference.h"
 #include "MantidAPI/ParameterTie.h"
 
+#include <algorithm>
+
 namespace Mantid {
 namespace API {
 
@@ -321,8 +323,18 @@ void FunctionParameterDecorator::beforeDecoratedFunctionSet(
 
 void FunctionParameterDecorator::setDecoratedFunctionPrivate(
     const IFunction_sptr &fn) {
+  invalidateEvaluationCopies();
   m_wrappedFunction = fn;
 }
 
+/// Includes the changes to the decorated function, which the evaluation
+/// copies of the decorator hold copies of.
+size_t FunctionParameterDecorator::evaluationStamp() const {
+  const auto stamp = IFunction::evaluationStamp();
+  if (!m_wrappedFunction)
+    return stamp;
+  return std::max(stamp, m_wrappedFunction->evaluationStamp());
+}
+
 } // namespace API
 } // namespace Mantid
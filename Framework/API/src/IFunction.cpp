@@ -33,6 +33,8 @@
 #include <limits>
 #include <sstream>
 #include <algorithm>
+#include <atomic>
+#include <exception>
 
 namespace Mantid {
 namespace API {
@@ -41,6 +43,8 @@ using namespace Geometry;
 namespace {
 /// static logger
 Kernel::Logger g_log("IFunction");
+/// Source of the stamps marking changes that invalidate evaluation copies
+std::atomic<size_t> g_evaluationStamp(0);
 }
 
 /**
@@ -235,6 +239,7 @@ std::string IFunction::writeTies() const {
  * @param tie :: A pointer to a new tie
  */
 void IFunction::addTie(std::unique_ptr<ParameterTie> tie) {
+  invalidateEvaluationCopies();
 
   auto iPar = getParameterIndex(*tie);
   bool found = false;
@@ -287,6 +292,7 @@ public:
  * @return True if successfull
  */
 bool IFunction::removeTie(size_t i) {
+  invalidateEvaluationCopies();
   if (i >= nParams()) {
     throw std::out_of_range("Function parameter index out of range.");
   }
@@ -317,6 +323,7 @@ ParameterTie *IFunction::getTie(size_t i) const {
 /** Remove all ties
  */
 void IFunction::clearTies() {
+  invalidateEvaluationCopies();
   for (size_t i = 0; i < nParams(); ++i) {
     setParameterStatus(i, Active);
   }
@@ -327,6 +334,7 @@ void IFunction::clearTies() {
  *  @param ic :: Pointer to a constraint.
  */
 void IFunction::addConstraint(std::unique_ptr<IConstraint> ic) {
+  invalidateEvaluationCopies();
   size_t iPar = ic->parameterIndex();
   bool found = false;
   for (auto &constraint : m_constraints) {
@@ -358,6 +366,7 @@ IConstraint *IFunction::getConstraint(size_t i) const {
  * @param parName :: The name of a parameter which constarint to remove.
  */
 void IFunction::removeConstraint(const std::string &parName) {
+  invalidateEvaluationCopies();
   size_t iPar = parameterIndex(parName);
   for (auto it = m_constraints.begin(); it != m_constraints.end(); ++it) {
     if (iPar == (**it).getLocalIndex()) {
@@ -368,9 +377,13 @@ void IFunction::removeConstraint(const std::string &parName) {
 }
 
 /// Remove all constraints.
-void IFunction::clearConstraints() { m_constraints.clear(); }
+void IFunction::clearConstraints() {
+  invalidateEvaluationCopies();
+  m_constraints.clear();
+}
 
 void IFunction::setUpForFit() {
+  invalidateEvaluationCopies();
   for (auto &constraint : m_constraints) {
     constraint->setParamToSatisfyConstraint();
   }
@@ -890,6 +903,9 @@ std::string IFunction::descriptionOfActive(size_t i) const {
 }
 
 /** Calculate numerical derivatives.
+ * If the function is thread safe the columns of the Jacobian are calculated
+ * in parallel, each thread perturbing the parameters of its own copy of the
+ * function.
  * @param domain :: The domain of the function
  * @param jacobian :: A Jacobian matrix. It is expected to have dimensions of
  * domain.size() by nParams().
@@ -898,43 +914,55 @@ void IFunction::calNumericalDeriv(const FunctionDomain &domain,
                                   Jacobian &jacobian) {
   const double minDouble = std::numeric_limits<double>::min();
   const double epsilon = std::numeric_limits<double>::epsilon() * 100;
-  double stepPercentage = 0.001; // step percentage
-  double step;                   // real step
-  double cutoff = 100.0 * minDouble / stepPercentage;
-  size_t nParam = nParams();
+  const double stepPercentage = 0.001; // step percentage
+  const double cutoff = 100.0 * minDouble / stepPercentage;
   size_t nData = getValuesSize(domain);
 
   FunctionValues minusStep(nData);
-  FunctionValues plusStep(nData);
-
-  // PARALLEL_CRITICAL(numeric_deriv)
-  {
-    applyTies(); // just in case
-    function(domain, minusStep);
-  }
+  applyTies(); // just in case
+  function(domain, minusStep);
 
   if (nData == 0) {
     nData = minusStep.size();
   }
 
-  for (size_t iP = 0; iP < nParam; iP++) {
+  std::vector<size_t> activeParameters;
+  for (size_t iP = 0; iP < nParams(); iP++) {
     if (isActive(iP)) {
-      const double val = activeParameter(iP);
-      if (fabs(val) < cutoff) {
-        step = epsilon;
-      } else {
-        step = val * stepPercentage;
-      }
+      activeParameters.push_back(iP);
+    }
+  }
+  const int nActive = static_cast<int>(activeParameters.size());
 
-      double paramPstep = val + step;
+  // Nested parallel regions are not used: a function evaluated by a thread
+  // of an outer loop (such as ParDomain's) calculates its columns serially.
+  // Small problems are not worth starting the threads for.
+  const bool parallel =
+      isThreadSafe() && nActive > 1 &&
+      nData * activeParameters.size() >= MIN_WORK_FOR_PARALLEL_DERIVATIVES &&
+      PARALLEL_GET_MAX_THREADS > 1 && PARALLEL_NUMBER_OF_THREADS == 1;
+  if (parallel) {
+    updateEvaluationCopies(PARALLEL_GET_MAX_THREADS);
+  }
+  std::exception_ptr error;
 
-      // PARALLEL_CRITICAL(numeric_deriv)
-      {
-        setActiveParameter(iP, paramPstep);
-        applyTies();
-        function(domain, plusStep);
-        setActiveParameter(iP, val);
-      }
+  PARALLEL_FOR_IF(parallel)
+  for (int k = 0; k < nActive; ++k) {
+    try {
+      IFunction *fun =
+          parallel ? m_evaluationCopies[PARALLEL_THREAD_NUMBER].get() : this;
+      const size_t iP = activeParameters[k];
+      const double val = fun->activeParameter(iP);
+      double step =
+          fabs(val) < cutoff ? epsilon : val * stepPercentage; // real step
+      const double paramPstep = val + step;
+
+      FunctionValues plusStep(nData);
+      fun->setActiveParameter(iP, paramPstep);
+      fun->applyTies();
+      fun->function(domain, plusStep);
+      fun->setActiveParameter(iP, val);
+      fun->applyTies();
 
       step = paramPstep - val;
       for (size_t i = 0; i < nData; i++) {
@@ -942,8 +970,80 @@ void IFunction::calNumericalDeriv(const FunctionDomain &domain,
                      (plusStep.getCalculated(i) - minusStep.getCalculated(i)) /
                          step);
       }
+    } catch (...) {
+      PARALLEL_CRITICAL(numeric_deriv_error) {
+        if (!error) {
+          error = std::current_exception();
+        }
+      }
+    }
+  }
+
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+/**
+ * Create a copy of this function with exactly the same parameter values,
+ * which may be evaluated independently of this function.
+ */
+boost::shared_ptr<IFunction> IFunction::copyForEvaluation() const {
+  auto copy = clone();
+  if (copy->nParams() != nParams()) {
+    throw std::runtime_error("Copy of function " + name() +
+                             " has a different number of parameters.");
+  }
+  // The string representation used by clone() may round the values
+  for (size_t i = 0; i < nParams(); ++i) {
+    copy->setParameter(i, getParameter(i), false);
+  }
+  return copy;
+}
+
+/**
+ * Discard the copies used to calculate numerical derivatives in parallel.
+ * Called whenever a change is made that a refresh of the parameter values
+ * would not carry over to the copies.
+ */
+void IFunction::invalidateEvaluationCopies() {
+  m_evaluationCopies.clear();
+  m_evaluationStamp = ++g_evaluationStamp;
+}
+
+/**
+ * The stamp of the latest change that invalidates the evaluation copies.
+ * Functions made of other functions include the stamps of their members.
+ * @return The stamp of the latest change
+ */
+size_t IFunction::evaluationStamp() const { return m_evaluationStamp; }
+
+/**
+ * Make sure there are at least n copies of this function for calculating
+ * numerical derivatives in parallel, with the same parameter values and
+ * statuses as this function. The copies are kept between calls and only the
+ * values are refreshed; they are recreated when evaluationStamp() changes,
+ * i.e. after the ties, constraints, attributes or member functions change or
+ * the function is set up for a fit.
+ * @param n :: The number of copies needed
+ */
+void IFunction::updateEvaluationCopies(size_t n) {
+  const auto stamp = evaluationStamp();
+  if (m_evaluationCopiesStamp != stamp ||
+      (!m_evaluationCopies.empty() &&
+       m_evaluationCopies.front()->nParams() != nParams())) {
+    m_evaluationCopies.clear();
+    m_evaluationCopiesStamp = stamp;
+  }
+  for (auto &copy : m_evaluationCopies) {
+    for (size_t i = 0; i < nParams(); ++i) {
+      copy->setParameter(i, getParameter(i), false);
+      copy->setParameterStatus(i, getParameterStatus(i));
     }
   }
+  while (m_evaluationCopies.size() < n) {
+    m_evaluationCopies.push_back(copyForEvaluation());
+  }
 }
 
 /** Initialize the function providing it the workspace
@@ -1292,6 +1392,7 @@ IFunction::getAttribute(const std::string &name) const {
 */
 void IFunction::setAttribute(const std::string &name,
                              const API::IFunction::Attribute &value) {
+  invalidateEvaluationCopies();
   storeAttributeValue(name, value);
 }
 
@@ -87,8 +87,7 @@ void LogFilterGenerator::filterByStatus(LogFilter *filter) const {
     return;
   }
   filter->addFilter(*status);
-  const auto &time_value_map = filter->data()->valueAsCorrectMap();
-  const auto &firstTime = time_value_map.begin()->first;
+  const auto firstTime = filter->data()->firstTime();
   // If filter records start later than the data we add a value at the
   // filter's front
   if (status->firstTime() > firstTime) {
@@ -270,6 +270,7 @@ void MultiDomainFunction::setLocalAttribute(size_t i,
   if (i >= nFunctions()) {
     throw std::out_of_range("Function index is out of range.");
   }
+  invalidateEvaluationCopies();
   std::string value = att.asString();
   auto it = m_domains.find(i);
 
@@ -0,0 +1,208 @@
+#ifndef MANTID_API_ALGORITHMPROFILERTEST_H_
+#define MANTID_API_ALGORITHMPROFILERTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidAPI/Algorithm.h"
+#include "MantidAPI/AlgorithmFactory.h"
+#include "MantidAPI/AlgorithmProfiler.h"
+#include "MantidKernel/cow_ptr.h"
+
+#include <Poco/File.h>
+#include <Poco/Path.h>
+
+#include <sstream>
+#include <thread>
+
+using namespace Mantid::API;
+
+namespace AlgorithmProfilerTestHelpers {
+/// Algorithm that copies one array
+class ProfiledChildAlgorithm : public Algorithm {
+public:
+  const std::string name() const override { return "ProfiledChildAlgorithm"; }
+  int version() const override { return 2; }
+  const std::string category() const override { return "Test"; }
+  const std::string summary() const override { return "Test"; }
+  void init() override {}
+  void exec() override {
+    // Modify a shared array so that a copy is made
+    Mantid::Kernel::cow_ptr<std::vector<double>> original(
+        boost::make_shared<std::vector<double>>(100, 1.0));
+    auto copy = original;
+    copy.access()[0] = 2.0;
+  }
+};
+
+/// Algorithm that runs two child algorithms
+class ProfiledParentAlgorithm : public Algorithm {
+public:
+  const std::string name() const override { return "ProfiledParentAlgorithm"; }
+  int version() const override { return 1; }
+  const std::string category() const override { return "Test"; }
+  const std::string summary() const override { return "Test"; }
+  void init() override {}
+  void exec() override {
+    for (int i = 0; i < 2; ++i) {
+      ProfiledChildAlgorithm child;
+      child.initialize();
+      child.setChild(true);
+      child.execute();
+    }
+  }
+};
+
+/// Algorithm that runs a child algorithm on another thread
+class ProfiledThreadedParentAlgorithm : public Algorithm {
+public:
+  const std::string name() const override {
+    return "ProfiledThreadedParentAlgorithm";
+  }
+  int version() const override { return 1; }
+  const std::string category() const override { return "Test"; }
+  const std::string summary() const override { return "Test"; }
+  void init() override {}
+  void exec() override {
+    auto child =
+        createChildAlgorithm("ProfiledChildAlgorithm", -1, -1, true, 2);
+    std::thread worker([&child]() { child->execute(); });
+    worker.join();
+  }
+};
+}
+
+using namespace AlgorithmProfilerTestHelpers;
+
+class AlgorithmProfilerTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static AlgorithmProfilerTest *createSuite() {
+    return new AlgorithmProfilerTest();
+  }
+  static void destroySuite(AlgorithmProfilerTest *suite) { delete suite; }
+
+  AlgorithmProfilerTest() {
+    AlgorithmFactory::Instance().subscribe<ProfiledChildAlgorithm>();
+  }
+
+  ~AlgorithmProfilerTest() override {
+    AlgorithmFactory::Instance().unsubscribe("ProfiledChildAlgorithm", 2);
+  }
+
+  void setUp() override { AlgorithmProfiler::Instance().clear(); }
+
+  void tearDown() override {
+    AlgorithmProfiler::Instance().stop();
+    AlgorithmProfiler::Instance().clear();
+  }
+
+  void test_nothing_is_recorded_when_stopped() {
+    runParent();
+    TS_ASSERT(!AlgorithmProfiler::Instance().isRunning());
+    TS_ASSERT(AlgorithmProfiler::Instance().profiles().empty());
+  }
+
+  void test_nested_algorithms_are_recorded() {
+    AlgorithmProfiler::Instance().start();
+    TS_ASSERT(AlgorithmProfiler::Instance().isRunning());
+    runParent();
+    AlgorithmProfiler::Instance().stop();
+
+    const auto profiles = AlgorithmProfiler::Instance().profiles();
+    TS_ASSERT_EQUALS(profiles.size(), 3);
+    // Children complete before their parent
+    for (size_t i = 0; i < 2; ++i) {
+      TS_ASSERT_EQUALS(profiles[i].name, "ProfiledChildAlgorithm");
+      TS_ASSERT_EQUALS(profiles[i].version, 2);
+      TS_ASSERT_EQUALS(profiles[i].depth, 1);
+    }
+    const auto &parent = profiles[2];
+    TS_ASSERT_EQUALS(parent.name, "ProfiledParentAlgorithm");
+    TS_ASSERT_EQUALS(parent.depth, 0);
+    TS_ASSERT_EQUALS(parent.thread, 0);
+    TS_ASSERT_LESS_THAN_EQUALS(0.0, parent.start);
+    TS_ASSERT_LESS_THAN_EQUALS(parent.start, profiles[0].start);
+    TS_ASSERT_LESS_THAN_EQUALS(profiles[1].start + profiles[1].wallTime,
+                               parent.start + parent.wallTime);
+    TS_ASSERT_LESS_THAN_EQUALS(0.0, parent.validationTime);
+    TS_ASSERT_LESS_THAN_EQUALS(0.0, parent.finaliseTime);
+    TS_ASSERT_DELTA(parent.validationTime + parent.execTime +
+                        parent.finaliseTime,
+                    parent.wallTime, 1e-9);
+    // The children run inside the parent's exec()
+    TS_ASSERT_LESS_THAN_EQUALS(profiles[0].wallTime + profiles[1].wallTime,
+                               parent.execTime);
+    TS_ASSERT_LESS_THAN_EQUALS(0, parent.peakMemoryIncrease);
+    // The copies made by the children are included
+    TS_ASSERT_LESS_THAN_EQUALS(1, profiles[0].cowCopies);
+    TS_ASSERT_LESS_THAN_EQUALS(100 * sizeof(double),
+                               profiles[0].cowCopiedBytes);
+    TS_ASSERT_LESS_THAN_EQUALS(2, parent.cowCopies);
+  }
+
+  void test_child_on_another_thread_is_nested_in_its_parent() {
+    AlgorithmProfiler::Instance().start();
+    ProfiledThreadedParentAlgorithm parent;
+    parent.initialize();
+    parent.execute();
+    AlgorithmProfiler::Instance().stop();
+
+    const auto profiles = AlgorithmProfiler::Instance().profiles();
+    TS_ASSERT_EQUALS(profiles.size(), 2);
+    TS_ASSERT_EQUALS(profiles[0].name, "ProfiledChildAlgorithm");
+    TS_ASSERT_EQUALS(profiles[0].depth, 1);
+    TS_ASSERT_EQUALS(profiles[1].name, "ProfiledThreadedParentAlgorithm");
+    TS_ASSERT_EQUALS(profiles[1].depth, 0);
+    TS_ASSERT_DIFFERS(profiles[0].thread, profiles[1].thread);
+  }
+
+  void test_clear_discards_records() {
+    AlgorithmProfiler::Instance().start();
+    runParent();
+    TS_ASSERT_EQUALS(AlgorithmProfiler::Instance().profiles().size(), 3);
+    AlgorithmProfiler::Instance().clear();
+    TS_ASSERT(AlgorithmProfiler::Instance().profiles().empty());
+  }
+
+  void test_writeChromeTrace() {
+    AlgorithmProfiler::Instance().start();
+    runParent();
+    AlgorithmProfiler::Instance().stop();
+
+    std::ostringstream trace;
+    AlgorithmProfiler::Instance().writeChromeTrace(trace);
+    const std::string json = trace.str();
+    TS_ASSERT_EQUALS(json.find("{\"traceEvents\":["), 0);
+    TS_ASSERT_DIFFERS(json.find("\"name\":\"ProfiledParentAlgorithm\""),
+                      std::string::npos);
+    TS_ASSERT_DIFFERS(json.find("\"ph\":\"X\""), std::string::npos);
+    TS_ASSERT_DIFFERS(json.find("\"depth\":1"), std::string::npos);
+    TS_ASSERT_DIFFERS(json.find("\"cow_copies\":"), std::string::npos);
+    TS_ASSERT_DIFFERS(json.find("\"name\":\"ProfiledParentAlgorithm exec\""),
+                      std::string::npos);
+    TS_ASSERT_DIFFERS(json.find("\"cat\":\"phase\""), std::string::npos);
+  }
+
+  void test_saveChromeTrace() {
+    AlgorithmProfiler::Instance().start();
+    runParent();
+    const std::string filename =
+        Poco::Path::temp() + "AlgorithmProfilerTest.json";
+    TS_ASSERT_THROWS_NOTHING(
+        AlgorithmProfiler::Instance().saveChromeTrace(filename));
+    Poco::File file(filename);
+    TS_ASSERT(file.exists());
+    TS_ASSERT(file.getSize() > 0);
+    file.remove();
+  }
+
+private:
+  void runParent() {
+    ProfiledParentAlgorithm parent;
+    parent.initialize();
+    parent.execute();
+  }
+};
+
+#endif /* MANTID_API_ALGORITHMPROFILERTEST_H_ */
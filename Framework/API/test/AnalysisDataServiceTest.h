@@ -6,6 +6,8 @@
 #include "MantidAPI/AnalysisDataService.h"
 #include "MantidAPI/WorkspaceGroup.h"
 
+#include <boost/make_shared.hpp>
+
 using namespace Mantid::Kernel;
 using namespace Mantid::API;
 
@@ -507,4 +509,64 @@ private:
   }
 };
 
+class AnalysisDataServiceTestPerformance : public CxxTest::TestSuite {
+public:
+  static AnalysisDataServiceTestPerformance *createSuite() {
+    return new AnalysisDataServiceTestPerformance();
+  }
+  static void destroySuite(AnalysisDataServiceTestPerformance *suite) {
+    delete suite;
+  }
+
+  AnalysisDataServiceTestPerformance()
+      : ads(AnalysisDataService::Instance()), m_names(10000) {
+    for (size_t i = 0; i < m_names.size(); ++i)
+      m_names[i] = "perf_ws_" + std::to_string(i);
+  }
+
+  void setUp() override {
+    ads.clear();
+    for (const auto &name : m_names)
+      ads.add(name, boost::make_shared<MockWorkspace>());
+  }
+
+  void tearDown() override { ads.clear(); }
+
+  void test_add_and_remove() {
+    ads.clear();
+    for (const auto &name : m_names)
+      ads.add(name, boost::make_shared<MockWorkspace>());
+    for (const auto &name : m_names)
+      ads.remove(name);
+    TS_ASSERT_EQUALS(ads.size(), 0);
+  }
+
+  void test_retrieve() {
+    size_t found = 0;
+    for (int repeat = 0; repeat < 10; ++repeat)
+      for (const auto &name : m_names)
+        if (ads.retrieve(name))
+          ++found;
+    TS_ASSERT_EQUALS(found, 10 * m_names.size());
+  }
+
+  void test_rename() {
+    for (const auto &name : m_names)
+      ads.rename(name, name + "_renamed");
+    TS_ASSERT(ads.doesExist(m_names.front() + "_renamed"));
+  }
+
+  void test_add_to_group() {
+    auto group = boost::make_shared<WorkspaceGroup>();
+    ads.add("perf_group", group);
+    for (const auto &name : m_names)
+      ads.addToGroup("perf_group", name);
+    TS_ASSERT_EQUALS(group->size(), m_names.size());
+  }
+
+private:
+  AnalysisDataServiceImpl &ads;
+  std::vector<std::string> m_names;
+};
+
 #endif /*ANALYSISDATASERVICETEST_H_*/
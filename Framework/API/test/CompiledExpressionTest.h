@@ -0,0 +1,139 @@
+#ifndef MANTID_API_COMPILEDEXPRESSIONTEST_H_
+#define MANTID_API_COMPILEDEXPRESSIONTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidAPI/CompiledExpression.h"
+
+#include <cmath>
+
+using Mantid::API::CompiledExpression;
+
+namespace {
+const std::vector<std::string> VARIABLES = {"x", "a", "b"};
+const double A = 1.3;
+const double B = 0.7;
+}
+
+class CompiledExpressionTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static CompiledExpressionTest *createSuite() {
+    return new CompiledExpressionTest();
+  }
+  static void destroySuite(CompiledExpressionTest *suite) { delete suite; }
+
+  CompiledExpressionTest() : m_x(1000), m_arguments(3) {
+    for (size_t i = 0; i < m_x.size(); ++i) {
+      m_x[i] = 0.1 + 0.001 * static_cast<double>(i);
+    }
+    m_arguments[0] = {m_x.data(), 0.0};
+    m_arguments[1] = {nullptr, A};
+    m_arguments[2] = {nullptr, B};
+  }
+
+  void test_arithmetic() {
+    checkValues("a*x+b", [](double x) { return A * x + B; });
+    checkValues("a-b+x-2*x/a", [](double x) { return A - B + x - 2 * x / A; });
+    checkValues("a/(x*b)/2", [](double x) { return A / (x * B) / 2; });
+    checkValues("a*-x", [](double x) { return -A * x; });
+    checkValues("1.5E+2*x+.5e-1", [](double x) { return 150 * x + 0.05; });
+  }
+
+  void test_unary_minus_binds_less_tightly_than_power() {
+    checkValues("-x^2+a", [](double x) { return A - x * x; });
+    checkValues("(-x)^3", [](double x) { return -x * x * x; });
+    checkValues("2^-x", [](double x) { return std::pow(2.0, -x); });
+  }
+
+  void test_functions_and_constants() {
+    checkValues("a*exp(-(x-b)^2/2)", [](double x) {
+      return A * std::exp(-(x - B) * (x - B) / 2);
+    });
+    checkValues("sin(a*x)*cos(b)+tan(x)", [](double x) {
+      return std::sin(A * x) * std::cos(B) + std::tan(x);
+    });
+    checkValues("sqrt(x)+ln(a*x)+log10(x)+log2(b)", [](double x) {
+      return std::sqrt(x) + std::log(A * x) + std::log10(x) + std::log2(B);
+    });
+    checkValues("erf(x-a)+erfc(b*x)+abs(x-0.5)", [](double x) {
+      return std::erf(x - A) + std::erfc(B * x) + std::fabs(x - 0.5);
+    });
+    checkValues("2*_pi*a/x + _e",
+                [](double x) { return 2 * M_PI * A / x + M_E; });
+  }
+
+  void test_expressions_of_constants_fill_the_output() {
+    checkValues("a*b*3", [](double) { return A * B * 3; });
+  }
+
+  void test_derivatives() {
+    checkDerivatives("a*x+b");
+    checkDerivatives("-x^2+a");
+    checkDerivatives("a*exp(-(x-b)^2/2)");
+    checkDerivatives("a/(x*b)/2");
+    checkDerivatives("x^a*b^x");
+    checkDerivatives("sin(a*x)*cos(b)+tan(x)");
+    checkDerivatives("sqrt(x)+ln(a*x)+log10(x)+log2(b)");
+    checkDerivatives("asin(x/2)+acos(x/3)+atan(a*x)");
+    checkDerivatives("sinh(x)*cosh(a)-tanh(b*x)");
+    checkDerivatives("erf(x-a)+erfc(b*x)+abs(x-0.5)");
+  }
+
+  void test_unsupported_formulas_throw() {
+    for (const auto formula :
+         {"x>1", "log(x)", "x^2^3", "c*x", "min(x,a)", "sin(x,a)", "(x", "x)",
+          "", "x y", "if(x,a,b)"}) {
+      TS_ASSERT_THROWS(CompiledExpression(formula, VARIABLES),
+                       std::invalid_argument);
+    }
+  }
+
+private:
+  template <typename F> void checkValues(const std::string &formula, F f) {
+    CompiledExpression expression(formula, VARIABLES);
+    std::vector<double> out(m_x.size());
+    expression.evaluate(m_arguments, out.data(), out.size());
+    for (size_t i = 0; i < m_x.size(); ++i) {
+      TS_ASSERT_DELTA(out[i], f(m_x[i]), 1e-12);
+    }
+  }
+
+  /// Compare the derivatives with central differences
+  void checkDerivatives(const std::string &formula) {
+    CompiledExpression expression(formula, VARIABLES);
+    const double step = 1e-6;
+    for (size_t variable = 0; variable < VARIABLES.size(); ++variable) {
+      std::vector<double> derivative(m_x.size());
+      expression.derivative(variable).evaluate(m_arguments, derivative.data(),
+                                               derivative.size());
+      std::vector<double> plus(m_x.size());
+      std::vector<double> minus(m_x.size());
+      auto shifted = m_arguments;
+      auto shiftedX = m_x;
+      for (double *values : {plus.data(), minus.data()}) {
+        const double shift = values == plus.data() ? step : -step;
+        if (variable == 0) {
+          for (size_t i = 0; i < m_x.size(); ++i) {
+            shiftedX[i] = m_x[i] + shift;
+          }
+          shifted[0].values = shiftedX.data();
+        } else {
+          shifted[variable].value = m_arguments[variable].value + shift;
+        }
+        expression.evaluate(shifted, values, m_x.size());
+      }
+      for (size_t i = 0; i < m_x.size(); ++i) {
+        const double numerical = (plus[i] - minus[i]) / (2 * step);
+        TS_ASSERT_DELTA(derivative[i], numerical,
+                        1e-6 * (1.0 + std::fabs(numerical)));
+      }
+    }
+  }
+
+  std::vector<double> m_x;
+  std::vector<CompiledExpression::Argument> m_arguments;
+};
+
+#endif /* MANTID_API_COMPILEDEXPRESSIONTEST_H_ */
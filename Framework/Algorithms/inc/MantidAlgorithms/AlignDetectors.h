@@ -76,6 +76,9 @@ private:
   // Implement abstract Algorithm methods
   void init() override;
   void exec() override;
+  Parallel::ExecutionMode getParallelExecutionMode(
+      const std::map<std::string, Parallel::StorageMode> &storageModes)
+      const override;
 
   void align(const ConversionFactors &converter, API::Progress &progress,
              API::MatrixWorkspace &outputWS);
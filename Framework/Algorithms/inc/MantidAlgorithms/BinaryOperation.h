@@ -153,6 +153,40 @@ protected:
                                       const double rhsE, MantidVec &YOut,
                                       MantidVec &EOut) = 0;
 
+  /** Whether, with the given single number as the right hand operand, each
+   *output Y and E value depends only on the lhs Y or E value it replaces. If so
+   *transformWithSingleValue is used instead of performBinaryOperation, which
+   *avoids copying lhs data that are shared with other spectra or workspaces.
+   *
+   *  @param rhsY :: The rhs data value
+   *  @param rhsE :: The rhs error value
+   */
+  virtual bool canTransformWithSingleValue(const double rhsY,
+                                           const double rhsE) const {
+    (void)rhsY; // Avoid compiler warning
+    (void)rhsE;
+    return false;
+  }
+
+  /** Carries out the binary operation with a single number as the right hand
+   *operand on a spectrum of the output holding the lhs data, using
+   *MatrixWorkspace::transformY and transformE. Only called if
+   *canTransformWithSingleValue returns true.
+   *
+   *  @param out :: The output workspace
+   *  @param index :: The workspace index of the spectrum
+   *  @param rhsY :: The rhs data value
+   *  @param rhsE :: The rhs error value
+   */
+  virtual void transformWithSingleValue(API::MatrixWorkspace &out,
+                                        const size_t index, const double rhsY,
+                                        const double rhsE) {
+    (void)out; // Avoid compiler warning
+    (void)index;
+    (void)rhsY;
+    (void)rhsE;
+  }
+
   // ===================================== EVENT LIST BINARY OPERATIONS
   // ==========================================
 
@@ -99,6 +99,9 @@ protected:
   // Overridden Algorithm methods
   void init() override;
   void exec() override;
+  Parallel::ExecutionMode getParallelExecutionMode(
+      const std::map<std::string, Parallel::StorageMode> &storageModes)
+      const override;
 
   void setupMemberVariables(const API::MatrixWorkspace_const_sptr inputWS);
   virtual void storeEModeOnWorkspace(API::MatrixWorkspace_sptr outputWS);
@@ -119,9 +122,9 @@ protected:
   /// Internal function to gather detector specific L2, theta and efixed values
   bool getDetectorValues(const API::SpectrumInfo &spectrumInfo,
                          const Kernel::Unit &outputUnit, int emode,
-                         const API::MatrixWorkspace &ws, const bool signedTheta,
-                         int64_t wsIndex, double &efixed, double &l2,
-                         double &twoTheta);
+                         const std::vector<double> &detectorEfixed,
+                         const bool signedTheta, int64_t wsIndex,
+                         double &efixed, double &l2, double &twoTheta);
 
   /// Convert the workspace units using TOF as an intermediate step in the
   /// conversion
@@ -134,6 +137,7 @@ protected:
   alignBins(const API::MatrixWorkspace_sptr workspace);
   const std::vector<double>
   calculateRebinParams(const API::MatrixWorkspace_const_sptr workspace) const;
+  bool isDistributed(const API::MatrixWorkspace &workspace) const;
 
   void putBackBinWidth(const API::MatrixWorkspace_sptr outputWS);
 
@@ -7,6 +7,7 @@
 #include "MantidGeometry/IDetector.h"
 
 #include <list>
+#include <vector>
 
 namespace Mantid {
 namespace Algorithms {
@@ -128,8 +129,10 @@ private:
   API::MatrixWorkspace_const_sptr m_inputWS;
   /// output workspace, maybe the same as the input one
   API::MatrixWorkspace_sptr m_outputWS;
-  /// points the map that stores additional properties for detectors in that map
-  const Geometry::ParameterMap *m_paraMap;
+  /// the gas pressure of each detector, by detector index
+  std::vector<double> m_pressures;
+  /// the wall thickness of each detector, by detector index
+  std::vector<double> m_wallThicknesses;
 
   /// stores the user selected value for incidient energy of the neutrons
   double m_Ei;
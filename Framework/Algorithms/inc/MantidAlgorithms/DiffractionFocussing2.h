@@ -99,6 +99,9 @@ private:
   // Overridden Algorithm methods
   void init() override;
   void exec() override;
+  Parallel::ExecutionMode getParallelExecutionMode(
+      const std::map<std::string, Parallel::StorageMode> &storageModes)
+      const override;
   void cleanup();
 
   std::size_t setupGroupToWSIndices();
@@ -106,6 +109,18 @@ private:
   // For events
   void execEvent();
 
+  void addGroupSpectra(const std::vector<size_t> &indices,
+                       const HistogramData::BinEdges &Xout, MantidVec &Yout,
+                       MantidVec &Eout, MantidVec &groupWgt,
+                       const double eventXMin, const double eventXMax,
+                       API::Progress &prog) const;
+  void normaliseGroup(const HistogramData::BinEdges &Xout, MantidVec &Yout,
+                      MantidVec &Eout, const MantidVec &groupWgt,
+                      const size_t groupSize) const;
+  void focusDistributed(const double eventXMin, const double eventXMax,
+                        const size_t totalHistProcess);
+  bool isDistributed() const;
+
   /// Loop over the workspace and determine the rebin parameters
   /// (Xmin,Xmax,step) for each group.
   /// The result is stored in group2params
@@ -0,0 +1,98 @@
+#ifndef MANTID_ALGORITHMS_EVALUATEWORKSPACEEXPRESSION_H_
+#define MANTID_ALGORITHMS_EVALUATEWORKSPACEEXPRESSION_H_
+
+#include "MantidAPI/Algorithm.h"
+#include "MantidAPI/MatrixWorkspace_fwd.h"
+#include "MantidAlgorithms/DllConfig.h"
+
+#include <vector>
+
+namespace Mantid {
+namespace HistogramData {
+class Histogram;
+}
+namespace API {
+class Expression;
+}
+namespace Algorithms {
+
+/** EvaluateWorkspaceExpression : Evaluates an arithmetic expression of
+  workspaces and numbers, such as "(sample - background) / vanadium * 2", in a
+  single parallel pass over the spectra.
+
+  Running Plus, Minus, Multiply and Divide in turn reads and writes a full
+  temporary workspace for every operator. Here each spectrum of the result is
+  computed from the operand spectra in buffers that stay in the cache, which
+  makes a long expression about as fast as a single operation on workspaces
+  too large for the cache. Uncertainties are propagated exactly as in the
+  individual binary operations.
+
+  Copyright &copy; 2017 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_ALGORITHMS_DLL EvaluateWorkspaceExpression
+    : public API::Algorithm {
+public:
+  const std::string name() const override;
+  int version() const override;
+  const std::string category() const override;
+  const std::string summary() const override;
+
+private:
+  /// A step of the evaluation, which works on a stack of spectra
+  struct Instruction {
+    enum class Code { Load, Constant, Negate, Add, Subtract, Multiply, Divide };
+    Code code;
+    /// Index of the workspace to load
+    size_t operand;
+    /// Value of a constant
+    double value;
+  };
+
+  void init() override;
+  void exec() override;
+
+  void compile(const API::Expression &expression);
+  void compileOperation(const std::string &op);
+  size_t addOperand(const std::string &name);
+  void checkOperands() const;
+  struct Stack;
+  void evaluate(Stack &stack,
+                const std::vector<HistogramData::Histogram> &histograms,
+                const size_t begin, const size_t n) const;
+
+  /// The workspaces of the expression
+  std::vector<API::MatrixWorkspace_const_sptr> m_operands;
+  /// The names of the workspaces of the expression
+  std::vector<std::string> m_operandNames;
+  /// The operand that defines the shape of the output
+  size_t m_shapeOperand = 0;
+  /// The program computing the expression, in postfix order
+  std::vector<Instruction> m_program;
+  /// The current and maximum depth of the stack while running the program
+  size_t m_depth = 0;
+  size_t m_maxDepth = 0;
+};
+
+} // namespace Algorithms
+} // namespace Mantid
+
+#endif /* MANTID_ALGORITHMS_EVALUATEWORKSPACEEXPRESSION_H_ */
@@ -78,6 +78,8 @@ private:
   void init() override;
   // Implement abstract Algorithm methods
   void exec() override;
+  /// Cross-check the properties
+  std::map<std::string, std::string> validateInputs() override;
 
   /// Process user input properties
   void processAlgorithmProperties();
@@ -96,6 +98,21 @@ private:
   /// create output workspaces in the case of using MatrixWorkspace for
   /// splitters
   void createOutputWorkspacesMatrixCase();
+  /// register an output workspace as an output property or a file to save
+  void addOutputWorkspace(const int wsgroup, const std::string &propertyName,
+                          const std::string &wsName,
+                          const DataObjects::EventWorkspace_sptr &workspace);
+  /// save the output workspaces of the current pass to files and release them
+  void saveOutputWorkspaces();
+  /// whether the output workspace of a target is created in the current pass
+  bool isInCurrentPass(const int wsgroup) const;
+  /// overall progress of a fraction of the current pass
+  double passProgress(const double fraction) const;
+  /// output event lists of a spectrum, including the scratch list
+  std::map<int, DataObjects::EventList *>
+  getOutputEventLists(const size_t wsIndex);
+  /// empty the scratch event list of the calling thread
+  void clearScratchEventList();
 
   /// Set up detector calibration parameters
   void setupDetectorTOFCalibration();
@@ -143,6 +160,19 @@ private:
   std::map<int, DataObjects::EventWorkspace_sptr> m_outputWorkspacesMap;
   std::vector<std::string> m_wsNames;
 
+  /// Directory to save the output workspaces to, instead of the ADS
+  std::string m_outputDirectory;
+  /// Targets whose output workspaces are created in the current pass over the
+  /// input. All targets if empty.
+  std::set<int> m_currentPassTargets;
+  /// Names of the output workspaces of the current pass to save
+  std::map<int, std::string> m_outputFileNames;
+  /// Index of the current pass and the number of passes over the input
+  size_t m_pass;
+  size_t m_numberOfPasses;
+  /// Event list of each thread for the events of targets of other passes
+  std::vector<DataObjects::EventList> m_scratchEventLists;
+
   std::vector<double> m_detTofOffsets;
   std::vector<double> m_detTofFactors;
 
@@ -156,7 +186,7 @@ private:
   /// DOC! TODO
   std::vector<std::string> getTimeSeriesLogNames();
 
-  Kernel::TimeSplitterType generateSplitters(int wsindex);
+  std::map<int, Kernel::TimeSplitterType> generateSplittersByTarget() const;
 
   void generateSplitterTSP(
       std::vector<Kernel::TimeSeriesProperty<int> *> &split_tsp_vec);
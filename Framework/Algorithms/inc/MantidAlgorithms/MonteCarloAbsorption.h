@@ -67,7 +67,7 @@ private:
   doSimulation(const API::MatrixWorkspace &inputWS, const size_t nevents,
                int nlambda, const int seed,
                const InterpolationOption &interpolateOpt,
-               const bool useSparseInstrument);
+               const bool useSparseInstrument, const bool independentStreams);
   API::MatrixWorkspace_uptr
   createOutputWorkspace(const API::MatrixWorkspace &inputWS) const;
   std::unique_ptr<IBeamProfile>
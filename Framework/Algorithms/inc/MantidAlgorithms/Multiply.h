@@ -67,6 +67,10 @@ private:
                               const MantidVec &lhsE, const double rhsY,
                               const double rhsE, MantidVec &YOut,
                               MantidVec &EOut) override;
+  bool canTransformWithSingleValue(const double rhsY,
+                                   const double rhsE) const override;
+  void transformWithSingleValue(API::MatrixWorkspace &out, const size_t index,
+                                const double rhsY, const double rhsE) override;
 
   void setOutputUnits(const API::MatrixWorkspace_const_sptr lhs,
                       const API::MatrixWorkspace_const_sptr rhs,
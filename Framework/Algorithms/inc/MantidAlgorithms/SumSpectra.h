@@ -82,11 +82,27 @@ private:
   /// Handle logic for Workspace2D workspaces
   void doWorkspace2D(API::ISpectrum &outSpec, API::Progress &progress,
                      size_t &numSpectra, size_t &numMasked, size_t &numZeros);
+  /// Check whether a spectrum is a skipped monitor or a masked spectrum
+  bool skipSpectrum(const API::SpectrumInfo &spectrumInfo,
+                    const size_t wsIndex, size_t &numMasked) const;
+  /// Add one spectrum of a Workspace2D to the running sums
+  void addSpectrum(const HistogramData::HistogramY &yValues,
+                   const HistogramData::HistogramE &yErrors, double *ySum,
+                   double *eSum, double *weight, double *nZeros) const;
+  /// Turn the running sums into the weighted sum
+  size_t normalizeWeightedSum(double *ySum, const double *weight,
+                              const double *nZeros,
+                              const size_t numSpectra) const;
 
   // Overridden Algorithm methods
   void init() override;
   std::map<std::string, std::string> validateInputs() override;
   void exec() override;
+  void execDistributed() override;
+  Parallel::ExecutionMode getParallelExecutionMode(
+      const std::map<std::string, Parallel::StorageMode> &storageModes)
+      const override;
+  void setupIndices(const API::MatrixWorkspace &localworkspace);
   void execEvent(DataObjects::EventWorkspace_const_sptr localworkspace,
                  std::set<int> &indices);
   specnum_t getOutputSpecNo(API::MatrixWorkspace_const_sptr localworkspace);
@@ -46,10 +46,18 @@ public:
 
   std::function<double(double)>
   getConversionFunc(const std::set<detid_t> &detIds) const {
+    double difc, difa, tzero;
+    this->getDiffConstants(detIds, difc, difa, tzero);
+    return Kernel::Diffraction::getTofToDConversionFunc(difc, difa, tzero);
+  }
+
+  /// Get the average calibration constants of a group of detectors
+  void getDiffConstants(const std::set<detid_t> &detIds, double &difc,
+                        double &difa, double &tzero) const {
     const std::set<size_t> rows = this->getRow(detIds);
-    double difc = 0.;
-    double difa = 0.;
-    double tzero = 0.;
+    difc = 0.;
+    difa = 0.;
+    tzero = 0.;
     for (auto row : rows) {
       difc += m_difcCol->toDouble(row);
       difa += m_difaCol->toDouble(row);
@@ -61,8 +69,6 @@ public:
       difa = norm * difa;
       tzero = norm * tzero;
     }
-
-    return Kernel::Diffraction::getTofToDConversionFunc(difc, difa, tzero);
   }
 
 private:
@@ -299,9 +305,17 @@ void AlignDetectors::align(const ConversionFactors &converter,
   for (int64_t i = 0; i < m_numberOfSpectra; ++i) {
     PARALLEL_START_INTERUPT_REGION
 
-    auto toDspacing = converter.getConversionFunc(
-        outputWS.getSpectrum(size_t(i)).getDetectorIDs());
-    outputWS.getSpectrum(i).convertTof(toDspacing);
+    auto &spectrum = outputWS.getSpectrum(size_t(i));
+    double difc, difa, tzero;
+    converter.getDiffConstants(spectrum.getDetectorIDs(), difc, difa, tzero);
+    if (difa == 0.) {
+      // Linear in TOF, d = (TOF - tzero) / difc, so avoid a function call
+      // per event
+      spectrum.convertTof(1. / difc, -1. * tzero / difc);
+    } else {
+      spectrum.convertTof(
+          Kernel::Diffraction::getTofToDConversionFunc(difc, difa, tzero));
+    }
 
     progress.report();
     PARALLEL_END_INTERUPT_REGION
@@ -318,5 +332,16 @@ void AlignDetectors::align(const ConversionFactors &converter,
   outputWS.clearMRU();
 }
 
+Parallel::ExecutionMode AlignDetectors::getParallelExecutionMode(
+    const std::map<std::string, Parallel::StorageMode> &storageModes) const {
+  // Every rank needs the calibration of all of its detectors
+  for (const auto &mode : storageModes)
+    if (mode.first != "InputWorkspace" &&
+        mode.second != Parallel::StorageMode::Cloned)
+      return Parallel::ExecutionMode::Invalid;
+  return Parallel::getCorrespondingExecutionMode(
+      storageModes.at("InputWorkspace"));
+}
+
 } // namespace Algorithms
 } // namespace Mantid
@@ -485,6 +485,23 @@ void BinaryOperation::doSingleValue() {
       PARALLEL_END_INTERUPT_REGION
     }
     PARALLEL_CHECK_INTERUPT_REGION
+  } else if (canTransformWithSingleValue(rhsY, rhsE)) {
+    // ---- Histogram Output, Y and E transformed separately -----
+    PARALLEL_FOR_IF(Kernel::threadSafe(*m_lhs, *m_rhs, *m_out))
+    for (int64_t i = 0; i < numHists; ++i) {
+      PARALLEL_START_INTERUPT_REGION
+      if (m_out != m_lhs) {
+        // Share the lhs data. The transforms write the results to new arrays
+        // in a single pass.
+        m_out->setX(i, m_lhs->refX(i));
+        m_out->setSharedY(i, m_lhs->sharedY(i));
+        m_out->setSharedE(i, m_lhs->sharedE(i));
+      }
+      transformWithSingleValue(*m_out, i, rhsY, rhsE);
+      m_progress->report(this->name());
+      PARALLEL_END_INTERUPT_REGION
+    }
+    PARALLEL_CHECK_INTERUPT_REGION
   } else {
     // ---- Histogram Output -----
     PARALLEL_FOR_IF(Kernel::threadSafe(*m_lhs, *m_rhs, *m_out))
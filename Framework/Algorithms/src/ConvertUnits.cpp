@@ -9,11 +9,15 @@
 #include "MantidDataObjects/EventWorkspace.h"
 #include "MantidDataObjects/Workspace2D.h"
 #include "MantidGeometry/Instrument.h"
+#include "MantidGeometry/Instrument/ParameterMap.h"
 #include "MantidKernel/BoundedValidator.h"
 #include "MantidKernel/CompositeValidator.h"
 #include "MantidKernel/ListValidator.h"
 #include "MantidKernel/UnitFactory.h"
+#include "MantidParallel/Collectives.h"
+#include "MantidTypes/SpectrumDefinition.h"
 
+#include <cmath>
 #include <numeric>
 
 namespace Mantid {
@@ -230,9 +234,12 @@ ConvertUnits::executeUnitConversion(const API::MatrixWorkspace_sptr inputWS) {
   if (m_outputUnit->unitID().find("Delta") == 0 && !m_inputEvents)
     outputWS = this->removeUnphysicalBins(outputWS);
 
-  // Rebin the data to common bins if requested, and if necessary
+  // Rebin the data to common bins if requested, and if necessary. The bins of
+  // a distributed workspace are aligned across all ranks, so every rank has to
+  // take part even if its own spectra already have common boundaries.
   bool alignBins = getProperty("AlignBins");
-  if (alignBins && !WorkspaceHelpers::commonBoundaries(*outputWS))
+  if (alignBins && (isDistributed(*outputWS) ||
+                    !WorkspaceHelpers::commonBoundaries(*outputWS)))
     outputWS = this->alignBins(outputWS);
 
   // If appropriate, put back the bin width division into Y/E.
@@ -405,7 +412,7 @@ ConvertUnits::convertQuickly(API::MatrixWorkspace_const_sptr inputWS,
 */
 bool ConvertUnits::getDetectorValues(const API::SpectrumInfo &spectrumInfo,
                                      const Kernel::Unit &outputUnit, int emode,
-                                     const MatrixWorkspace &ws,
+                                     const std::vector<double> &detectorEfixed,
                                      const bool signedTheta, int64_t wsIndex,
                                      double &efixed, double &l2,
                                      double &twoTheta) {
@@ -424,12 +431,11 @@ bool ConvertUnits::getDetectorValues(const API::SpectrumInfo &spectrumInfo,
     if (emode == 2 && efixed == EMPTY_DBL()) // indirect
     {
       if (spectrumInfo.hasUniqueDetector(wsIndex)) {
-        const auto &det = spectrumInfo.detector(wsIndex);
-        auto par = ws.constInstrumentParameters().getRecursive(&det, "Efixed");
-        if (par) {
-          efixed = par->value<double>();
-          g_log.debug() << "Detector: " << det.getID() << " EFixed: " << efixed
-                        << "\n";
+        const auto detIndex = spectrumInfo.spectrumDefinition(wsIndex)[0].first;
+        if (!std::isnan(detectorEfixed[detIndex])) {
+          efixed = detectorEfixed[detIndex];
+          g_log.debug() << "Detector index: " << detIndex
+                        << " EFixed: " << efixed << "\n";
         }
       }
       // Non-unique detector (i.e., DetectorGroup): use single provided value
@@ -508,6 +514,12 @@ ConvertUnits::convertViaTOF(Kernel::Unit_const_sptr fromUnit,
     efixedProp = 0.0;
   }
 
+  // For an indirect instrument look up the Efixed of all detectors at once
+  std::vector<double> detectorEfixed;
+  if (emode == 2 && efixedProp == EMPTY_DBL())
+    detectorEfixed = inputWS->constInstrumentParameters().getDetectorDoubles(
+        *inputWS->getInstrument(), "Efixed");
+
   std::vector<std::string> parameters =
       inputWS->getInstrument()->getStringParameter("show-signed-theta");
   bool signedTheta =
@@ -522,8 +534,9 @@ ConvertUnits::convertViaTOF(Kernel::Unit_const_sptr fromUnit,
   double checkl2;
   double checktwoTheta;
   size_t checkIndex = 0;
-  if (getDetectorValues(spectrumInfo, *outputUnit, emode, *inputWS, signedTheta,
-                        checkIndex, checkefixed, checkl2, checktwoTheta)) {
+  if (getDetectorValues(spectrumInfo, *outputUnit, emode, detectorEfixed,
+                        signedTheta, checkIndex, checkefixed, checkl2,
+                        checktwoTheta)) {
     const double checkdelta = 0.0;
     // copy the X values for the check
     auto checkXValues = inputWS->readX(checkIndex);
@@ -549,7 +562,7 @@ ConvertUnits::convertViaTOF(Kernel::Unit_const_sptr fromUnit,
     // Now get the detector object for this histogram
     double l2;
     double twoTheta;
-    if (getDetectorValues(outSpectrumInfo, *outputUnit, emode, *outputWS,
+    if (getDetectorValues(outSpectrumInfo, *outputUnit, emode, detectorEfixed,
                           signedTheta, i, efixed, l2, twoTheta)) {
 
       /// @todo Don't yet consider hold-off (delta)
@@ -639,12 +652,28 @@ const std::vector<double> ConvertUnits::calculateRebinParams(
       }
     }
   }
+  if (isDistributed(*workspace)) {
+    // The range has to cover the spectra of all ranks
+    double globalXMin, globalXMax;
+    Parallel::all_reduce(communicator(), XMin, globalXMin,
+                         [](double a, double b) { return std::min(a, b); });
+    Parallel::all_reduce(communicator(), XMax, globalXMax,
+                         [](double a, double b) { return std::max(a, b); });
+    XMin = globalXMin;
+    XMax = globalXMax;
+  }
   const double step =
       (XMax - XMin) / static_cast<double>(workspace->blocksize());
 
   return {XMin, step, XMax};
 }
 
+/// @return true if the spectra of the workspace are spread over several ranks
+bool ConvertUnits::isDistributed(const API::MatrixWorkspace &workspace) const {
+  return communicator().size() > 1 &&
+         workspace.storageMode() == Parallel::StorageMode::Distributed;
+}
+
 /** Reverses the workspace if X values are in descending order
 *  @param WS The workspace to operate on
 */
@@ -798,5 +827,11 @@ void ConvertUnits::putBackBinWidth(const API::MatrixWorkspace_sptr outputWS) {
   }
 }
 
+Parallel::ExecutionMode ConvertUnits::getParallelExecutionMode(
+    const std::map<std::string, Parallel::StorageMode> &storageModes) const {
+  return Parallel::getCorrespondingExecutionMode(
+      storageModes.at("InputWorkspace"));
+}
+
 } // namespace Algorithm
 } // namespace Mantid
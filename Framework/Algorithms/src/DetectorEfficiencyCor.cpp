@@ -75,7 +75,7 @@ const std::string THICKNESS_PARAM = "TubeThickness";
 // this default constructor calls default constructors and sets other member
 // data to impossible (flag) values
 DetectorEfficiencyCor::DetectorEfficiencyCor()
-    : Algorithm(), m_inputWS(), m_outputWS(), m_paraMap(nullptr), m_Ei(-1.0),
+    : Algorithm(), m_inputWS(), m_outputWS(), m_Ei(-1.0),
       m_ki(-1.0), m_shapeCache(), m_samplePos(), m_spectraSkipped() {
   m_shapeCache.clear();
 }
@@ -163,7 +163,11 @@ void DetectorEfficiencyCor::exec() {
 void DetectorEfficiencyCor::retrieveProperties() {
   // these first three properties are fully checked by validators
   m_inputWS = getProperty("InputWorkspace");
-  m_paraMap = &(m_inputWS->constInstrumentParameters());
+  // Look up the detector parameters once for all detectors
+  const auto &paraMap = m_inputWS->constInstrumentParameters();
+  const auto instrument = m_inputWS->getInstrument();
+  m_pressures = paraMap.getDetectorDoubles(*instrument, PRESSURE_PARAM);
+  m_wallThicknesses = paraMap.getDetectorDoubles(*instrument, THICKNESS_PARAM);
 
   m_Ei = getProperty("IncidentEnergy");
   // If we're not given an Ei, see if one has been set.
@@ -221,17 +225,14 @@ void DetectorEfficiencyCor::correctForEfficiency(
   for (const auto index : spectrumDefinition) {
     const auto detIndex = index.first;
     const auto &det_member = detectorInfo.detector(detIndex);
-    Parameter_sptr par =
-        m_paraMap->getRecursive(det_member.getComponentID(), PRESSURE_PARAM);
-    if (!par) {
+    const double atms = m_pressures[detIndex];
+    if (std::isnan(atms)) {
       throw Exception::NotFoundError(PRESSURE_PARAM, spectraIn);
     }
-    const double atms = par->value<double>();
-    par = m_paraMap->getRecursive(det_member.getComponentID(), THICKNESS_PARAM);
-    if (!par) {
+    const double wallThickness = m_wallThicknesses[detIndex];
+    if (std::isnan(wallThickness)) {
       throw Exception::NotFoundError(THICKNESS_PARAM, spectraIn);
     }
-    const double wallThickness = par->value<double>();
     double detRadius(0.0);
     V3D detAxis;
     getDetectorGeometry(det_member, detRadius, detAxis);
@@ -9,11 +9,18 @@
 #include "MantidAPI/WorkspaceFactory.h"
 #include "MantidDataObjects/EventWorkspace.h"
 #include "MantidDataObjects/GroupingWorkspace.h"
+#include "MantidDataObjects/Workspace2D.h"
 #include "MantidDataObjects/WorkspaceCreation.h"
 #include "MantidHistogramData/LogarithmicGenerator.h"
 #include "MantidIndexing/Group.h"
 #include "MantidIndexing/IndexInfo.h"
 #include "MantidKernel/VectorHelper.h"
+#include "MantidParallel/Collectives.h"
+#include "MantidTypes/SpectrumDefinition.h"
+
+#include <boost/serialization/map.hpp>
+#include <boost/serialization/utility.hpp>
+#include <boost/serialization/vector.hpp>
 
 #include <cfloat>
 #include <iterator>
@@ -141,7 +148,9 @@ void DiffractionFocussing2::exec() {
 
   m_eventW = boost::dynamic_pointer_cast<const EventWorkspace>(m_matrixInputW);
   if (m_eventW != nullptr) {
-    if (getProperty("PreserveEvents")) {
+    // Events are not sent between ranks, so distributed focussing always
+    // produces histograms
+    if (getProperty("PreserveEvents") && !isDistributed()) {
       // Input workspace is an event workspace. Use the other exec method
       this->execEvent();
       this->cleanup();
@@ -150,6 +159,15 @@ void DiffractionFocussing2::exec() {
       // get the full d-spacing range
       m_eventW->sortAll(DataObjects::TOF_SORT, nullptr);
       m_matrixInputW->getXMinMax(eventXMin, eventXMax);
+      if (isDistributed()) {
+        double xMin, xMax;
+        Parallel::all_reduce(communicator(), eventXMin, xMin,
+                             [](double a, double b) { return std::min(a, b); });
+        Parallel::all_reduce(communicator(), eventXMax, xMax,
+                             [](double a, double b) { return std::max(a, b); });
+        eventXMin = xMin;
+        eventXMax = xMax;
+      }
     }
   }
 
@@ -163,13 +181,14 @@ void DiffractionFocussing2::exec() {
   if (nPoints <= 0) {
     throw std::runtime_error("No points found in the data range.");
   }
+  if (isDistributed()) {
+    focusDistributed(eventXMin, eventXMax, totalHistProcess);
+    this->cleanup();
+    return;
+  }
+
   API::MatrixWorkspace_sptr out = API::WorkspaceFactory::Instance().create(
       m_matrixInputW, nGroups, nPoints + 1, nPoints);
-  // Caching containers that are either only read from or unused. Initialize
-  // them once.
-  // Helgrind will show a race-condition but the data is completely unused so it
-  // is irrelevant
-  MantidVec weights_default(1, 1.0), emptyVec(1, 0.0), EOutDummy(nPoints);
 
   std::unique_ptr<Progress> prog = make_unique<API::Progress>(
       this, 0.2, 1.0, static_cast<int>(totalHistProcess) + nGroups);
@@ -198,118 +217,14 @@ void DiffractionFocussing2::exec() {
     auto &Yout = outSpec.dataY();
     auto &Eout = outSpec.dataE();
 
-    // Initialize the group's weight vector here and the dummy vector used for
-    // accumulating errors.
+    // Initialize the group's weight vector here
     MantidVec groupWgt(nPoints, 0.0);
 
     // loop through the contributing histograms
     const std::vector<size_t> &indices = m_wsIndices[outWorkspaceIndex];
-    const size_t groupSize = indices.size();
-    for (size_t i = 0; i < groupSize; i++) {
-      size_t inWorkspaceIndex = indices[i];
-      // This is the input spectrum
-      const auto &inSpec = m_matrixInputW->getSpectrum(inWorkspaceIndex);
-      // Get reference to its old X,Y,and E.
-      auto &Xin = inSpec.x();
-      auto &Yin = inSpec.y();
-      auto &Ein = inSpec.e();
-
-      try {
-        // TODO This should be implemented in Histogram as rebin
-        Mantid::Kernel::VectorHelper::rebinHistogram(
-            Xin.rawData(), Yin.rawData(), Ein.rawData(), Xout.rawData(), Yout,
-            Eout, true);
-      } catch (...) {
-        // Should never happen because Xout is constructed to envelop all of the
-        // Xin vectors
-        std::ostringstream mess;
-        mess << "Error in rebinning process for spectrum:" << inWorkspaceIndex;
-        throw std::runtime_error(mess.str());
-      }
-
-      // Check for masked bins in this spectrum
-      if (m_matrixInputW->hasMaskedBins(i)) {
-        MantidVec weight_bins, weights;
-        weight_bins.push_back(Xin.front());
-        // If there are masked bins, get a reference to the list of them
-        const API::MatrixWorkspace::MaskList &mask =
-            m_matrixInputW->maskedBins(i);
-        // Now iterate over the list, adjusting the weights for the affected
-        // bins
-        for (const auto &bin : mask) {
-          const double currentX = Xin[bin.first];
-          // Add an intermediate bin with full weight if masked bins aren't
-          // consecutive
-          if (weight_bins.back() != currentX) {
-            weights.push_back(1.0);
-            weight_bins.push_back(currentX);
-          }
-          // The weight for this masked bin is 1 - the degree to which this bin
-          // is masked
-          weights.push_back(1.0 - bin.second);
-          weight_bins.push_back(Xin[bin.first + 1]);
-        }
-        // Add on a final bin with full weight if masking doesn't go up to the
-        // end
-        if (weight_bins.back() != Xin.back()) {
-          weights.push_back(1.0);
-          weight_bins.push_back(Xin.back());
-        }
-
-        // Create a zero vector for the errors because we don't care about them
-        // here
-        const MantidVec zeroes(weights.size(), 0.0);
-        // Rebin the weights - note that this is a distribution
-        VectorHelper::rebin(weight_bins, weights, zeroes, Xout.rawData(),
-                            groupWgt, EOutDummy, true, true);
-      } else // If no masked bins we want to add 1 to the weight of the output
-             // bins that this input covers
-      {
-        // Initialized within the loop to avoid having to wrap writing to it
-        // with a PARALLEL_CRITICAL sections
-        MantidVec limits(2);
-
-        if (eventXMin > 0. && eventXMax > 0.) {
-          limits[0] = eventXMin;
-          limits[1] = eventXMax;
-        } else {
-          limits[0] = Xin.front();
-          limits[1] = Xin.back();
-        }
-
-        // Rebin the weights - note that this is a distribution
-        VectorHelper::rebin(limits, weights_default, emptyVec, Xout.rawData(),
-                            groupWgt, EOutDummy, true, true);
-      }
-      prog->report();
-    } // end of loop for input spectra
-
-    // Calculate the bin widths
-    std::vector<double> widths(Xout.size());
-    std::adjacent_difference(Xout.begin(), Xout.end(), widths.begin());
-
-    // Take the square root of the errors
-    std::transform(Eout.begin(), Eout.end(), Eout.begin(),
-                   static_cast<double (*)(double)>(sqrt));
-
-    // Multiply the data and errors by the bin widths because the rebin
-    // function, when used
-    // in the fashion above for the weights, doesn't put it back in
-    std::transform(Yout.begin(), Yout.end(), widths.begin() + 1, Yout.begin(),
-                   std::multiplies<double>());
-    std::transform(Eout.begin(), Eout.end(), widths.begin() + 1, Eout.begin(),
-                   std::multiplies<double>());
-
-    // Now need to normalise the data (and errors) by the weights
-    std::transform(Yout.begin(), Yout.end(), groupWgt.begin(), Yout.begin(),
-                   std::divides<double>());
-    std::transform(Eout.begin(), Eout.end(), groupWgt.begin(), Eout.begin(),
-                   std::divides<double>());
-    // Now multiply by the number of spectra in the group
-    std::transform(Yout.begin(), Yout.end(), Yout.begin(),
-                   std::bind2nd(std::multiplies<double>(), groupSize));
-    std::transform(Eout.begin(), Eout.end(), Eout.begin(),
-                   std::bind2nd(std::multiplies<double>(), groupSize));
+    addGroupSpectra(indices, Xout, Yout, Eout, groupWgt, eventXMin, eventXMax,
+                    *prog);
+    normaliseGroup(Xout, Yout, Eout, groupWgt, indices.size());
 
     prog->report();
     PARALLEL_END_INTERUPT_REGION
@@ -325,6 +240,280 @@ void DiffractionFocussing2::exec() {
   this->cleanup();
 }
 
+//=============================================================================
+/** Rebin the spectra of a group onto the X values of the group and add them up.
+ * The squared errors are accumulated, and the weight of each output bin counts
+ * the unmasked input spectra covering it.
+ * @param indices :: workspace indices of the spectra in the group
+ * @param Xout :: the bin edges of the group
+ * @param Yout :: the sum of the counts
+ * @param Eout :: the sum of the squared errors
+ * @param groupWgt :: the weights of the output bins
+ * @param eventXMin :: lowest X of the events, 0 if not an event workspace
+ * @param eventXMax :: highest X of the events, 0 if not an event workspace
+ * @param prog :: progress reporter, reported once per spectrum
+ */
+void DiffractionFocussing2::addGroupSpectra(
+    const std::vector<size_t> &indices, const HistogramData::BinEdges &Xout,
+    MantidVec &Yout, MantidVec &Eout, MantidVec &groupWgt,
+    const double eventXMin, const double eventXMax, Progress &prog) const {
+  // Caching containers that are either only read from or unused
+  MantidVec weights_default(1, 1.0), emptyVec(1, 0.0), EOutDummy(nPoints);
+  const size_t groupSize = indices.size();
+  for (size_t i = 0; i < groupSize; i++) {
+    size_t inWorkspaceIndex = indices[i];
+    // This is the input spectrum
+    const auto &inSpec = m_matrixInputW->getSpectrum(inWorkspaceIndex);
+    // Get reference to its old X,Y,and E.
+    auto &Xin = inSpec.x();
+    auto &Yin = inSpec.y();
+    auto &Ein = inSpec.e();
+
+    try {
+      // TODO This should be implemented in Histogram as rebin
+      Mantid::Kernel::VectorHelper::rebinHistogram(
+          Xin.rawData(), Yin.rawData(), Ein.rawData(), Xout.rawData(), Yout,
+          Eout, true);
+    } catch (...) {
+      // Should never happen because Xout is constructed to envelop all of the
+      // Xin vectors
+      std::ostringstream mess;
+      mess << "Error in rebinning process for spectrum:" << inWorkspaceIndex;
+      throw std::runtime_error(mess.str());
+    }
+
+    // Check for masked bins in this spectrum
+    if (m_matrixInputW->hasMaskedBins(i)) {
+      MantidVec weight_bins, weights;
+      weight_bins.push_back(Xin.front());
+      // If there are masked bins, get a reference to the list of them
+      const API::MatrixWorkspace::MaskList &mask =
+          m_matrixInputW->maskedBins(i);
+      // Now iterate over the list, adjusting the weights for the affected
+      // bins
+      for (const auto &bin : mask) {
+        const double currentX = Xin[bin.first];
+        // Add an intermediate bin with full weight if masked bins aren't
+        // consecutive
+        if (weight_bins.back() != currentX) {
+          weights.push_back(1.0);
+          weight_bins.push_back(currentX);
+        }
+        // The weight for this masked bin is 1 - the degree to which this bin
+        // is masked
+        weights.push_back(1.0 - bin.second);
+        weight_bins.push_back(Xin[bin.first + 1]);
+      }
+      // Add on a final bin with full weight if masking doesn't go up to the
+      // end
+      if (weight_bins.back() != Xin.back()) {
+        weights.push_back(1.0);
+        weight_bins.push_back(Xin.back());
+      }
+
+      // Create a zero vector for the errors because we don't care about them
+      // here
+      const MantidVec zeroes(weights.size(), 0.0);
+      // Rebin the weights - note that this is a distribution
+      VectorHelper::rebin(weight_bins, weights, zeroes, Xout.rawData(),
+                          groupWgt, EOutDummy, true, true);
+    } else // If no masked bins we want to add 1 to the weight of the output
+           // bins that this input covers
+    {
+      // Initialized within the loop to avoid having to wrap writing to it
+      // with a PARALLEL_CRITICAL sections
+      MantidVec limits(2);
+
+      if (eventXMin > 0. && eventXMax > 0.) {
+        limits[0] = eventXMin;
+        limits[1] = eventXMax;
+      } else {
+        limits[0] = Xin.front();
+        limits[1] = Xin.back();
+      }
+
+      // Rebin the weights - note that this is a distribution
+      VectorHelper::rebin(limits, weights_default, emptyVec, Xout.rawData(),
+                          groupWgt, EOutDummy, true, true);
+    }
+    prog.report();
+  } // end of loop for input spectra
+}
+
+/** Turn the sums of a group into the focussed spectrum: take the square root
+ * of the squared errors and normalise by the weights of the bins.
+ * @param Xout :: the bin edges of the group
+ * @param Yout :: the sum of the counts, replaced by the focussed counts
+ * @param Eout :: the sum of the squared errors, replaced by the errors
+ * @param groupWgt :: the weights of the output bins
+ * @param groupSize :: the number of spectra in the group
+ */
+void DiffractionFocussing2::normaliseGroup(const HistogramData::BinEdges &Xout,
+                                           MantidVec &Yout, MantidVec &Eout,
+                                           const MantidVec &groupWgt,
+                                           const size_t groupSize) const {
+  // Calculate the bin widths
+  std::vector<double> widths(Xout.size());
+  std::adjacent_difference(Xout.begin(), Xout.end(), widths.begin());
+
+  // Take the square root of the errors
+  std::transform(Eout.begin(), Eout.end(), Eout.begin(),
+                 static_cast<double (*)(double)>(sqrt));
+
+  // Multiply the data and errors by the bin widths because the rebin
+  // function, when used
+  // in the fashion above for the weights, doesn't put it back in
+  std::transform(Yout.begin(), Yout.end(), widths.begin() + 1, Yout.begin(),
+                 std::multiplies<double>());
+  std::transform(Eout.begin(), Eout.end(), widths.begin() + 1, Eout.begin(),
+                 std::multiplies<double>());
+
+  // Now need to normalise the data (and errors) by the weights
+  std::transform(Yout.begin(), Yout.end(), groupWgt.begin(), Yout.begin(),
+                 std::divides<double>());
+  std::transform(Eout.begin(), Eout.end(), groupWgt.begin(), Eout.begin(),
+                 std::divides<double>());
+  // Now multiply by the number of spectra in the group
+  std::transform(Yout.begin(), Yout.end(), Yout.begin(),
+                 std::bind2nd(std::multiplies<double>(), groupSize));
+  std::transform(Eout.begin(), Eout.end(), Eout.begin(),
+                 std::bind2nd(std::multiplies<double>(), groupSize));
+}
+
+/** Focus a workspace with spectra spread over several ranks. Each rank adds
+ * up the spectra of each group it holds, the sums are reduced onto the master
+ * rank and normalised there. The output workspace only exists on the master
+ * rank.
+ * @param eventXMin :: lowest X of the events, 0 if not an event workspace
+ * @param eventXMax :: highest X of the events, 0 if not an event workspace
+ * @param totalHistProcess :: number of spectra to focus on this rank
+ */
+void DiffractionFocussing2::focusDistributed(const double eventXMin,
+                                             const double eventXMax,
+                                             const size_t totalHistProcess) {
+  // Sums of each group, in the order of the groups in group2xvector: Y, the
+  // squared errors and the weights of the bins followed by the number of
+  // spectra. The groups are the same on all ranks.
+  const size_t points = static_cast<size_t>(nPoints);
+  const size_t groupLength = 3 * points + 1;
+  std::vector<double> sums(group2xvector.size() * groupLength, 0.0);
+  std::vector<size_t> offsets(m_validGroups.size());
+  for (size_t i = 0; i < m_validGroups.size(); ++i) {
+    const auto it =
+        group2xvector.find(static_cast<int>(m_validGroups[i]));
+    offsets[i] = std::distance(group2xvector.begin(), it) * groupLength;
+  }
+
+  Progress prog(this, 0.2, 1.0, static_cast<int>(totalHistProcess) + nGroups);
+  PARALLEL_FOR_IF(Kernel::threadSafe(*m_matrixInputW))
+  for (int i = 0; i < static_cast<int>(m_validGroups.size()); ++i) {
+    PARALLEL_START_INTERUPT_REGION
+    const auto &Xout =
+        group2xvector.at(static_cast<int>(m_validGroups[i]));
+    MantidVec Yout(points, 0.0), Eout(points, 0.0), groupWgt(points, 0.0);
+    addGroupSpectra(m_wsIndices[i], Xout, Yout, Eout, groupWgt, eventXMin,
+                    eventXMax, prog);
+    auto groupSums = sums.begin() + offsets[i];
+    groupSums = std::copy(Yout.begin(), Yout.end(), groupSums);
+    groupSums = std::copy(Eout.begin(), Eout.end(), groupSums);
+    groupSums = std::copy(groupWgt.begin(), groupWgt.end(), groupSums);
+    *groupSums = static_cast<double>(m_wsIndices[i].size());
+    PARALLEL_END_INTERUPT_REGION
+  }
+  PARALLEL_CHECK_INTERUPT_REGION
+
+  // The detectors of the groups on this rank, flattened as group number and
+  // number of detectors followed by the detector and time index pairs
+  const auto localIndexInfo = Indexing::group(
+      m_matrixInputW->indexInfo(), std::vector<Indexing::SpectrumNumber>(
+                                       m_validGroups.begin(),
+                                       m_validGroups.end()),
+      m_wsIndices);
+  std::vector<size_t> detectors;
+  for (size_t i = 0; i < localIndexInfo.size(); ++i) {
+    const auto &spectrumDefinition = (*localIndexInfo.spectrumDefinitions())[i];
+    detectors.push_back(static_cast<size_t>(
+        static_cast<int>(localIndexInfo.spectrumNumber(i))));
+    detectors.push_back(spectrumDefinition.size());
+    for (const auto &index : spectrumDefinition) {
+      detectors.push_back(index.first);
+      detectors.push_back(index.second);
+    }
+  }
+
+  const auto &comm = communicator();
+  const auto add = [](const std::vector<double> &a,
+                      const std::vector<double> &b) {
+    std::vector<double> result(a);
+    std::transform(result.begin(), result.end(), b.begin(), result.begin(),
+                   std::plus<double>());
+    return result;
+  };
+  if (comm.rank() != 0) {
+    Parallel::reduce(comm, sums, add, 0);
+    Parallel::gather(comm, detectors, 0);
+    setProperty("OutputWorkspace", boost::make_shared<Workspace2D>(
+                                       Parallel::StorageMode::MasterOnly));
+    return;
+  }
+  std::vector<double> totals;
+  std::vector<std::vector<size_t>> allDetectors;
+  Parallel::reduce(comm, sums, totals, add, 0);
+  Parallel::gather(comm, detectors, allDetectors, 0);
+
+  std::map<int, SpectrumDefinition> groupDetectors;
+  for (const auto &rankDetectors : allDetectors) {
+    auto it = rankDetectors.begin();
+    while (it != rankDetectors.end()) {
+      auto &spectrumDefinition = groupDetectors[static_cast<int>(*it++)];
+      const size_t count = *it++;
+      for (size_t i = 0; i < count; ++i, it += 2)
+        spectrumDefinition.add(*it, *(it + 1));
+    }
+  }
+  std::vector<Indexing::SpectrumNumber> groups;
+  std::vector<SpectrumDefinition> spectrumDefinitions;
+  for (const auto &group : group2xvector) {
+    groups.emplace_back(group.first);
+    spectrumDefinitions.push_back(groupDetectors[group.first]);
+  }
+  Indexing::IndexInfo indexInfo(std::move(groups),
+                                Parallel::StorageMode::MasterOnly, comm);
+  indexInfo.setSpectrumDefinitions(std::move(spectrumDefinitions));
+
+  // Not created from the input workspace since the local spectra of the input
+  // would be copied if the numbers of spectra happen to match
+  auto out = create<Workspace2D>(m_matrixInputW->getInstrument(), indexInfo,
+                                 BinEdges(points + 1));
+  out->copyExperimentInfoFrom(m_matrixInputW.get());
+  out->setTitle(m_matrixInputW->getTitle());
+  out->getAxis(0)->unit() = m_matrixInputW->getAxis(0)->unit();
+  out->setYUnit(m_matrixInputW->YUnit());
+
+  size_t index = 0;
+  for (const auto &group : group2xvector) {
+    const auto &Xout = group.second;
+    auto groupSums = totals.begin() + index * groupLength;
+    MantidVec Yout(groupSums, groupSums + points);
+    MantidVec Eout(groupSums + points, groupSums + 2 * points);
+    const MantidVec groupWgt(groupSums + 2 * points, groupSums + 3 * points);
+    const auto groupSize = static_cast<size_t>(groupSums[3 * points]);
+    normaliseGroup(Xout, Yout, Eout, groupWgt, groupSize);
+    out->setBinEdges(index, Xout);
+    out->mutableY(index) = Yout;
+    out->mutableE(index) = Eout;
+    prog.report();
+    ++index;
+  }
+  setProperty("OutputWorkspace", std::move(out));
+}
+
+/// @return true if the spectra of the input are spread over several ranks
+bool DiffractionFocussing2::isDistributed() const {
+  return communicator().size() > 1 &&
+         m_matrixInputW->storageMode() == Parallel::StorageMode::Distributed;
+}
+
 //=============================================================================
 /** Executes the algorithm in the case of an Event input workspace
  *
@@ -584,6 +773,23 @@ void DiffractionFocussing2::determineRebinParameters() {
       (gpit->second).second = temp;
   }
 
+  if (isDistributed()) {
+    // All ranks need the same X values for a group, from all of its spectra
+    group2minmaxmap localGroup2minmax;
+    localGroup2minmax.swap(group2minmax);
+    Parallel::all_reduce(
+        communicator(), localGroup2minmax, group2minmax,
+        [](const group2minmaxmap &a, const group2minmaxmap &b) {
+          auto result = a;
+          for (const auto &range : b) {
+            auto it = result.emplace(range).first;
+            it->second.first = std::min(it->second.first, range.second.first);
+            it->second.second =
+                std::max(it->second.second, range.second.second);
+          }
+          return result;
+        });
+  }
   nGroups = group2minmax.size(); // Number of unique groups
 
   double Xmin, Xmax, step;
@@ -669,5 +875,16 @@ size_t DiffractionFocussing2::setupGroupToWSIndices() {
   return totalHistProcess;
 }
 
+Parallel::ExecutionMode DiffractionFocussing2::getParallelExecutionMode(
+    const std::map<std::string, Parallel::StorageMode> &storageModes) const {
+  // Every rank needs the grouping of all of its detectors
+  const auto grouping = storageModes.find("GroupingWorkspace");
+  if (grouping != storageModes.end() &&
+      grouping->second != Parallel::StorageMode::Cloned)
+    return Parallel::ExecutionMode::Invalid;
+  return Parallel::getCorrespondingExecutionMode(
+      storageModes.at("InputWorkspace"));
+}
+
 } // namespace Algorithm
 } // namespace Mantid
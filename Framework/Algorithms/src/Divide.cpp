@@ -85,6 +85,21 @@ void Divide::performBinaryOperation(const MantidVec &lhsX,
   }
 }
 
+/// Without an rhs error the output errors do not depend on the lhs values.
+/// Division by zero is left to performBinaryOperation, which warns about it.
+bool Divide::canTransformWithSingleValue(const double rhsY,
+                                         const double rhsE) const {
+  return rhsE == 0 && rhsY != 0;
+}
+
+void Divide::transformWithSingleValue(MatrixWorkspace &out, const size_t index,
+                                      const double rhsY, const double rhsE) {
+  (void)rhsE; // Avoid compiler warning
+  const double rhsAbs = fabs(rhsY);
+  out.transformE(index, [rhsAbs](const double e) { return fabs(e) / rhsAbs; });
+  out.transformY(index, [rhsY](const double y) { return y / rhsY; });
+}
+
 void Divide::setOutputUnits(const API::MatrixWorkspace_const_sptr lhs,
                             const API::MatrixWorkspace_const_sptr rhs,
                             API::MatrixWorkspace_sptr out) {
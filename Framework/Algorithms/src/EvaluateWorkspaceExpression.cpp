@@ -0,0 +1,360 @@
+#include "MantidAlgorithms/EvaluateWorkspaceExpression.h"
+#include "MantidAPI/AnalysisDataService.h"
+#include "MantidAPI/Axis.h"
+#include "MantidAPI/Expression.h"
+#include "MantidAPI/HistoWorkspace.h"
+#include "MantidAPI/MatrixWorkspace.h"
+#include "MantidAPI/Progress.h"
+#include "MantidAPI/SpectrumInfo.h"
+#include "MantidAPI/WorkspaceOpOverloads.h"
+#include "MantidDataObjects/WorkspaceCreation.h"
+#include "MantidKernel/MandatoryValidator.h"
+#include "MantidKernel/Unit.h"
+#include "MantidKernel/make_cow.h"
+
+#include <boost/lexical_cast.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace Mantid {
+namespace Algorithms {
+
+using namespace API;
+using namespace Kernel;
+using HistogramData::HistogramE;
+using HistogramData::HistogramY;
+
+// Register the algorithm into the AlgorithmFactory
+DECLARE_ALGORITHM(EvaluateWorkspaceExpression)
+
+namespace {
+/// @return true if the workspace holds a single value, which is combined
+/// with every bin of the other operands
+bool isSingleValue(const MatrixWorkspace &workspace) {
+  return workspace.getNumberHistograms() == 1 && workspace.blocksize() == 1;
+}
+
+/// The number of bins evaluated at a time, small enough for the stack of a
+/// thread to stay in the cache
+constexpr size_t BLOCK_SIZE = 1024;
+
+}
+
+/// The values and uncertainties of a block of bins on the evaluation stack of
+/// a thread
+struct EvaluateWorkspaceExpression::Stack {
+  Stack(const size_t depth, const size_t size)
+      : y(depth, std::vector<double>(size)),
+        e(depth, std::vector<double>(size)) {}
+  std::vector<std::vector<double>> y;
+  std::vector<std::vector<double>> e;
+};
+
+//----------------------------------------------------------------------------------------------
+
+/// Algorithms name for identification. @see Algorithm::name
+const std::string EvaluateWorkspaceExpression::name() const {
+  return "EvaluateWorkspaceExpression";
+}
+
+/// Algorithm's version for identification. @see Algorithm::version
+int EvaluateWorkspaceExpression::version() const { return 1; }
+
+/// Algorithm's category for identification. @see Algorithm::category
+const std::string EvaluateWorkspaceExpression::category() const {
+  return "Arithmetic";
+}
+
+/// Algorithm's summary for use in the GUI and help. @see Algorithm::summary
+const std::string EvaluateWorkspaceExpression::summary() const {
+  return "Evaluates an arithmetic expression of workspaces and numbers in a "
+         "single pass over the data.";
+}
+
+//----------------------------------------------------------------------------------------------
+/** Initialize the algorithm's properties.
+ */
+void EvaluateWorkspaceExpression::init() {
+  declareProperty("Expression", "",
+                  boost::make_shared<MandatoryValidator<std::string>>(),
+                  "An expression of the names of workspaces and numbers using "
+                  "+, -, * and /, for example (sample - background) / "
+                  "vanadium * 2.");
+  declareProperty(make_unique<WorkspaceProperty<>>("OutputWorkspace", "",
+                                                   Direction::Output),
+                  "The result of the expression.");
+}
+
+//----------------------------------------------------------------------------------------------
+/** Execute the algorithm.
+ */
+void EvaluateWorkspaceExpression::exec() {
+  Expression expression;
+  expression.parse(getPropertyValue("Expression"));
+  m_operands.clear();
+  m_operandNames.clear();
+  m_program.clear();
+  m_shapeOperand = 0;
+  m_depth = 0;
+  m_maxDepth = 0;
+  compile(expression);
+  if (m_operands.empty())
+    throw std::invalid_argument("The expression does not use any workspace.");
+  checkOperands();
+
+  const auto &shape = *m_operands[m_shapeOperand];
+  MatrixWorkspace_sptr outputWS = DataObjects::create<HistoWorkspace>(shape);
+  const size_t numberOfSpectra = shape.getNumberHistograms();
+  const size_t numberOfBins = shape.blocksize();
+
+  std::vector<const SpectrumInfo *> spectrumInfos;
+  bool threadSafe = outputWS->threadSafe();
+  for (const auto &operand : m_operands) {
+    spectrumInfos.push_back(isSingleValue(*operand) ? nullptr
+                                                    : &operand->spectrumInfo());
+    threadSafe = threadSafe && operand->threadSafe();
+  }
+  std::vector<Stack> stacks(
+      PARALLEL_GET_MAX_THREADS,
+      Stack(m_maxDepth, std::min(numberOfBins, BLOCK_SIZE)));
+  std::vector<char> masked(numberOfSpectra, 0);
+
+  Progress progress(this, 0.0, 1.0, numberOfSpectra);
+  PARALLEL_FOR_IF(threadSafe)
+  for (int64_t index = 0; index < static_cast<int64_t>(numberOfSpectra);
+       ++index) {
+    PARALLEL_START_INTERUPT_REGION
+    const auto i = static_cast<size_t>(index);
+    // As in the binary operations, a spectrum masked in any operand is masked
+    // in the output and its data are cleared
+    for (const auto spectrumInfo : spectrumInfos) {
+      if (spectrumInfo && spectrumInfo->hasDetectors(i) &&
+          spectrumInfo->isMasked(i))
+        masked[i] = 1;
+    }
+    if (masked[i]) {
+      outputWS->setSharedY(i, make_cow<HistogramY>(numberOfBins, 0.0));
+      outputWS->setSharedE(i, make_cow<HistogramE>(numberOfBins, 0.0));
+      progress.report();
+      continue;
+    }
+
+    auto &stack = stacks[PARALLEL_THREAD_NUMBER];
+    std::vector<HistogramData::Histogram> histograms;
+    histograms.reserve(m_operands.size());
+    for (const auto &operand : m_operands)
+      histograms.push_back(isSingleValue(*operand) ? operand->histogram(0)
+                                                   : operand->histogram(i));
+    auto outY = make_cow<HistogramY>(numberOfBins);
+    auto outE = make_cow<HistogramE>(numberOfBins);
+    for (size_t begin = 0; begin < numberOfBins; begin += BLOCK_SIZE) {
+      const size_t n = std::min(BLOCK_SIZE, numberOfBins - begin);
+      evaluate(stack, histograms, begin, n);
+      std::copy_n(stack.y[0].cbegin(), n, outY.access().begin() + begin);
+      std::copy_n(stack.e[0].cbegin(), n, outE.access().begin() + begin);
+    }
+    outputWS->setSharedY(i, outY);
+    outputWS->setSharedE(i, outE);
+    progress.report();
+    PARALLEL_END_INTERUPT_REGION
+  }
+  PARALLEL_CHECK_INTERUPT_REGION
+
+  auto &outputSpectrumInfo = outputWS->mutableSpectrumInfo();
+  for (size_t i = 0; i < numberOfSpectra; ++i) {
+    if (masked[i])
+      outputSpectrumInfo.setMasked(i, true);
+  }
+  for (const auto &operand : m_operands) {
+    if (isSingleValue(*operand))
+      continue;
+    for (size_t i = 0; i < numberOfSpectra; ++i) {
+      if (!operand->hasMaskedBins(i))
+        continue;
+      for (const auto &mask : operand->maskedBins(i))
+        outputWS->flagMasked(i, mask.first, mask.second);
+    }
+  }
+  setProperty("OutputWorkspace", outputWS);
+}
+
+/** Run the program on a block of bins of a spectrum. The result is left at
+ * the bottom of the stack.
+ * @param stack :: The evaluation stack of the thread
+ * @param histograms :: The spectrum of each operand that is not a single value
+ * @param begin :: The index of the first bin of the block
+ * @param n :: The number of bins in the block
+ */
+void EvaluateWorkspaceExpression::evaluate(
+    Stack &stack, const std::vector<HistogramData::Histogram> &histograms,
+    const size_t begin, const size_t n) const {
+  size_t top = 0;
+  for (const auto &instruction : m_program) {
+    switch (instruction.code) {
+    case Instruction::Code::Load: {
+      const auto &operand = *m_operands[instruction.operand];
+      if (isSingleValue(operand)) {
+        std::fill_n(stack.y[top].begin(), n, operand.y(0)[0]);
+        std::fill_n(stack.e[top].begin(), n, operand.e(0)[0]);
+      } else {
+        const auto &histogram = histograms[instruction.operand];
+        std::copy_n(histogram.y().cbegin() + begin, n, stack.y[top].begin());
+        std::copy_n(histogram.e().cbegin() + begin, n, stack.e[top].begin());
+      }
+      ++top;
+      break;
+    }
+    case Instruction::Code::Constant:
+      std::fill_n(stack.y[top].begin(), n, instruction.value);
+      std::fill_n(stack.e[top].begin(), n, 0.0);
+      ++top;
+      break;
+    case Instruction::Code::Negate:
+      for (size_t j = 0; j < n; ++j)
+        stack.y[top - 1][j] = -stack.y[top - 1][j];
+      break;
+    default: {
+      --top;
+      auto &lhsY = stack.y[top - 1];
+      auto &lhsE = stack.e[top - 1];
+      const auto &rhsY = stack.y[top];
+      const auto &rhsE = stack.e[top];
+      // The uncertainties are those of the Plus, Minus, Multiply and Divide
+      // algorithms
+      switch (instruction.code) {
+      case Instruction::Code::Add:
+        for (size_t j = 0; j < n; ++j) {
+          lhsY[j] += rhsY[j];
+          lhsE[j] = std::sqrt(lhsE[j] * lhsE[j] + rhsE[j] * rhsE[j]);
+        }
+        break;
+      case Instruction::Code::Subtract:
+        for (size_t j = 0; j < n; ++j) {
+          lhsY[j] -= rhsY[j];
+          lhsE[j] = std::sqrt(lhsE[j] * lhsE[j] + rhsE[j] * rhsE[j]);
+        }
+        break;
+      case Instruction::Code::Multiply:
+        for (size_t j = 0; j < n; ++j) {
+          lhsE[j] = std::sqrt(std::pow(lhsE[j] * rhsY[j], 2) +
+                              std::pow(rhsE[j] * lhsY[j], 2));
+          lhsY[j] *= rhsY[j];
+        }
+        break;
+      default:
+        for (size_t j = 0; j < n; ++j) {
+          lhsE[j] = std::sqrt(std::pow(lhsE[j], 2) +
+                              std::pow(lhsY[j] * rhsE[j] / rhsY[j], 2)) /
+                    std::fabs(rhsY[j]);
+          lhsY[j] /= rhsY[j];
+        }
+      }
+    }
+    }
+  }
+}
+
+/** Append the instructions computing an expression to the program. The
+ * operators of the same precedence are applied from left to right.
+ * @param expression :: The parsed expression
+ * @throw std::invalid_argument if the expression uses unsupported operators
+ */
+void EvaluateWorkspaceExpression::compile(const Expression &expression) {
+  const auto &expr = expression.bracketsRemoved();
+  const auto &name = expr.name();
+  if (!expr.isFunct()) {
+    Instruction instruction{Instruction::Code::Constant, 0, 0.0};
+    try {
+      instruction.value = boost::lexical_cast<double>(name);
+    } catch (boost::bad_lexical_cast &) {
+      instruction.code = Instruction::Code::Load;
+      instruction.operand = addOperand(name);
+    }
+    m_program.push_back(instruction);
+    m_maxDepth = std::max(m_maxDepth, ++m_depth);
+  } else if (expr.size() == 1 && (name == "-" || name == "+")) {
+    compile(expr[0]);
+    if (name == "-")
+      m_program.push_back({Instruction::Code::Negate, 0, 0.0});
+  } else if (name == "+" || name == "*") {
+    for (size_t i = 0; i < expr.size(); ++i) {
+      compile(expr[i]);
+      if (i > 0)
+        compileOperation(expr[i].operator_name());
+    }
+  } else {
+    throw std::invalid_argument("Unsupported operation '" + name +
+                                "' in expression " + expression.str());
+  }
+}
+
+/** Append a binary operation to the program.
+ * @param op :: The operator: one of +, -, * and /
+ */
+void EvaluateWorkspaceExpression::compileOperation(const std::string &op) {
+  Instruction instruction{Instruction::Code::Add, 0, 0.0};
+  if (op == "-")
+    instruction.code = Instruction::Code::Subtract;
+  else if (op == "*")
+    instruction.code = Instruction::Code::Multiply;
+  else if (op == "/")
+    instruction.code = Instruction::Code::Divide;
+  m_program.push_back(instruction);
+  --m_depth;
+}
+
+/** Find the workspace with the given name, adding it to the operands the
+ * first time it is used.
+ * @param name :: The name of a MatrixWorkspace in the AnalysisDataService
+ * @return The index of the operand
+ */
+size_t EvaluateWorkspaceExpression::addOperand(const std::string &name) {
+  const auto known =
+      std::find(m_operandNames.cbegin(), m_operandNames.cend(), name);
+  if (known != m_operandNames.cend())
+    return std::distance(m_operandNames.cbegin(), known);
+
+  auto &ads = AnalysisDataService::Instance();
+  if (!ads.doesExist(name))
+    throw std::invalid_argument("There is no workspace called '" + name +
+                                "' to use in the expression.");
+  auto workspace = ads.retrieveWS<MatrixWorkspace>(name);
+  if (!workspace)
+    throw std::invalid_argument("Workspace '" + name +
+                                "' is not a MatrixWorkspace.");
+  m_operands.push_back(workspace);
+  m_operandNames.push_back(name);
+  if (isSingleValue(*m_operands[m_shapeOperand]) && !isSingleValue(*workspace))
+    m_shapeOperand = m_operands.size() - 1;
+  return m_operands.size() - 1;
+}
+
+/** Check that the workspaces of the expression can be combined bin by bin.
+ * @throw std::invalid_argument if their binning or units are different
+ */
+void EvaluateWorkspaceExpression::checkOperands() const {
+  const auto &shape = *m_operands[m_shapeOperand];
+  const auto &shapeName = m_operandNames[m_shapeOperand];
+  const auto shapeUnit = shape.getAxis(0)->unit();
+  for (size_t i = 0; i < m_operands.size(); ++i) {
+    const auto &operand = *m_operands[i];
+    if (i == m_shapeOperand || isSingleValue(operand))
+      continue;
+    if (operand.getNumberHistograms() != shape.getNumberHistograms() ||
+        operand.blocksize() != shape.blocksize() ||
+        !WorkspaceHelpers::matchingBins(shape, operand, true))
+      throw std::invalid_argument("Workspace '" + m_operandNames[i] +
+                                  "' does not have the same spectra and bins "
+                                  "as '" +
+                                  shapeName + "'.");
+    const auto unit = operand.getAxis(0)->unit();
+    if ((unit ? unit->unitID() : "") != (shapeUnit ? shapeUnit->unitID() : ""))
+      throw std::invalid_argument("Workspace '" + m_operandNames[i] +
+                                  "' does not have the same X unit as '" +
+                                  shapeName + "'.");
+  }
+}
+
+} // namespace Algorithms
+} // namespace Mantid
@@ -20,6 +20,9 @@
 #include "MantidKernel/System.h"
 #include "MantidKernel/TimeSeriesProperty.h"
 #include "MantidKernel/VisibleWhenProperty.h"
+
+#include <Poco/Path.h>
+
 #include <memory>
 #include <sstream>
 
@@ -50,7 +53,9 @@ FilterEvents::FilterEvents()
       m_matrixSplitterWS(), m_detCorrectWorkspace(),
       m_useSplittersWorkspace(false), m_useArbTableSplitters(false),
       m_targetWorkspaceIndexSet(), m_splitters(), m_outputWorkspacesMap(),
-      m_wsNames(), m_detTofOffsets(), m_detTofFactors(),
+      m_wsNames(), m_outputDirectory(), m_currentPassTargets(),
+      m_outputFileNames(), m_pass(0), m_numberOfPasses(1),
+      m_scratchEventLists(), m_detTofOffsets(), m_detTofFactors(),
       m_filterByPulseTime(false), m_informationWS(), m_hasInfoWS(),
       m_progress(0.), m_outputWSNameBase(), m_toGroupWS(false),
       m_vecSplitterTime(), m_vecSplitterGroup(), m_splitSampleLogs(false),
@@ -152,6 +157,43 @@ void FilterEvents::init() {
   declareProperty(
       "FilterStartTime", "",
       "Start time for splitters that can be parsed to DateAndTime.");
+
+  declareProperty(
+      Kernel::make_unique<FileProperty>("OutputDirectory", "",
+                                        FileProperty::OptionalDirectory),
+      "If given, each output workspace is saved to a processed NeXus file "
+      "named after it in this directory instead of being added to the "
+      "analysis data service.");
+
+  auto mustBeNonNegative = boost::make_shared<BoundedValidator<int>>();
+  mustBeNonNegative->setLower(0);
+  declareProperty(
+      "OutputWorkspacesPerPass", 0, mustBeNonNegative,
+      "The maximum number of output workspaces held in memory when they are "
+      "saved to OutputDirectory. The input is split in several passes, each "
+      "creating, filling and saving this many output workspaces. With 0 all "
+      "output workspaces are created in a single pass.");
+}
+
+/** Cross-check the properties
+ * @return A map from the names of invalid properties to error messages
+ */
+std::map<std::string, std::string> FilterEvents::validateInputs() {
+  std::map<std::string, std::string> errors;
+  const std::string outputDirectory = getProperty("OutputDirectory");
+  if (outputDirectory.empty()) {
+    const int perPass = getProperty("OutputWorkspacesPerPass");
+    if (perPass > 0)
+      errors["OutputWorkspacesPerPass"] =
+          "Output workspaces can be created in several passes only if they "
+          "are saved to OutputDirectory.";
+  } else {
+    const bool toGroup = getProperty("GroupWorkspaces");
+    if (toGroup)
+      errors["GroupWorkspaces"] =
+          "Output workspaces saved to OutputDirectory cannot be grouped.";
+  }
+  return errors;
 }
 
 /** Execution body
@@ -173,41 +215,76 @@ void FilterEvents::exec() {
   else
     processMatrixSplitterWorkspace();
 
-  // Create output workspaces
-  m_progress = 0.1;
-  progress(m_progress, "Create Output Workspaces.");
-  if (m_useArbTableSplitters)
-    createOutputWorkspacesTableSplitterCase();
-  else if (m_useSplittersWorkspace)
-    createOutputWorkspaces();
-  else
-    createOutputWorkspacesMatrixCase();
-
   // Optionall import corrections
-  m_progress = 0.20;
+  m_progress = 0.1;
   progress(m_progress, "Importing TOF corrections. ");
   setupDetectorTOFCalibration();
 
-  // Filter Events
-  m_progress = 0.30;
-  progress(m_progress, "Filter Events.");
-  double progressamount;
-  if (m_toGroupWS)
-    progressamount = 0.6;
-  else
-    progressamount = 0.7;
+  // The output workspaces of all targets are created in one pass over the
+  // input, unless they are saved to files as they are completed. Then each
+  // pass creates, fills and saves the workspaces of a part of the targets to
+  // limit the memory used.
+  const int perPass = getProperty("OutputWorkspacesPerPass");
+  const std::vector<int> targets(m_targetWorkspaceIndexSet.begin(),
+                                 m_targetWorkspaceIndexSet.end());
+  const size_t passSize = perPass > 0 && !m_outputDirectory.empty()
+                              ? static_cast<size_t>(perPass)
+                              : targets.size();
+  m_numberOfPasses =
+      targets.empty() ? 1 : (targets.size() + passSize - 1) / passSize;
+  for (size_t first = 0; first < targets.size(); first += passSize) {
+    m_pass = first / passSize;
+    m_currentPassTargets.clear();
+    if (passSize < targets.size()) {
+      const size_t last = std::min(first + passSize, targets.size());
+      m_currentPassTargets.insert(targets.begin() + first,
+                                  targets.begin() + last);
+      g_log.information() << "Splitting events to " << last - first
+                          << " of " << targets.size()
+                          << " output workspaces.\n";
+    }
 
-  std::vector<Kernel::TimeSeriesProperty<int> *> split_tsp_vector;
-  if (m_useSplittersWorkspace) {
-    filterEventsBySplitters(progressamount);
-    generateSplitterTSPalpha(split_tsp_vector);
-  } else {
-    filterEventsByVectorSplitters(progressamount);
-    generateSplitterTSP(split_tsp_vector);
-  }
+    // Create output workspaces
+    m_progress = 0.2;
+    progress(passProgress(m_progress), "Create Output Workspaces.");
+    if (m_useArbTableSplitters)
+      createOutputWorkspacesTableSplitterCase();
+    else if (m_useSplittersWorkspace)
+      createOutputWorkspaces();
+    else
+      createOutputWorkspacesMatrixCase();
+
+    // Filter Events
+    m_progress = 0.30;
+    progress(passProgress(m_progress), "Filter Events.");
+    double progressamount;
+    if (m_toGroupWS)
+      progressamount = 0.6;
+    else
+      progressamount = 0.7;
+
+    // Events of the targets created in other passes go to a scratch event
+    // list per thread, which is emptied after each spectrum
+    m_scratchEventLists.resize(
+        m_currentPassTargets.empty() ? 0 : PARALLEL_GET_MAX_THREADS);
+    std::vector<Kernel::TimeSeriesProperty<int> *> split_tsp_vector;
+    if (m_useSplittersWorkspace) {
+      filterEventsBySplitters(progressamount);
+      generateSplitterTSPalpha(split_tsp_vector);
+    } else {
+      filterEventsByVectorSplitters(progressamount);
+      generateSplitterTSP(split_tsp_vector);
+    }
+    m_scratchEventLists.clear();
 
-  // assign split_tsp_vector to all the output workspaces!
-  mapSplitterTSPtoWorkspaces(split_tsp_vector);
+    // assign split_tsp_vector to all the output workspaces!
+    mapSplitterTSPtoWorkspaces(split_tsp_vector);
+
+    if (!m_outputDirectory.empty())
+      saveOutputWorkspaces();
+  }
+  if (!m_outputDirectory.empty())
+    setProperty("NumberOutputWS", static_cast<int>(m_wsNames.size()));
 
   // Optional to group detector
   // TODO:FIXME - move this part to a method
@@ -231,13 +308,15 @@ void FilterEvents::exec() {
   // TODO:FIXME - move this part to a method
   // Form the names of output workspaces
   std::vector<std::string> outputwsnames;
-  std::map<int, DataObjects::EventWorkspace_sptr>::iterator miter;
-  // for (miter = m_outputWorkspacesMap.begin();
-  //     miter != m_outputWorkspacesMap.end(); ++miter) {
-  //  outputwsnames.push_back(miter->second->name());
-  for (miter = m_outputWorkspacesMap.begin();
-       miter != m_outputWorkspacesMap.end(); ++miter) {
-    outputwsnames.push_back(miter->second->getName());
+  if (m_outputDirectory.empty()) {
+    std::map<int, DataObjects::EventWorkspace_sptr>::iterator miter;
+    for (miter = m_outputWorkspacesMap.begin();
+         miter != m_outputWorkspacesMap.end(); ++miter) {
+      outputwsnames.push_back(miter->second->getName());
+    }
+  } else {
+    // The saved workspaces are not in the ADS
+    outputwsnames = m_wsNames;
   }
   setProperty("OutputWorkspaceNames", outputwsnames);
 
@@ -289,6 +368,7 @@ void FilterEvents::processAlgorithmProperties() {
   m_filterByPulseTime = this->getProperty("FilterByPulseTime");
 
   m_toGroupWS = this->getProperty("GroupWorkspaces");
+  m_outputDirectory = getPropertyValue("OutputDirectory");
 
   //-------------------------------------------------------------------------
   // TOF detector/sample correction
@@ -795,6 +875,9 @@ void FilterEvents::createOutputWorkspaces() {
   double wsgindex = 0.;
 
   for (auto const wsgroup : m_targetWorkspaceIndexSet) {
+    if (!isInCurrentPass(wsgroup))
+      continue;
+
     // Generate new workspace name
     bool add2output = true;
     std::stringstream wsname;
@@ -839,17 +922,7 @@ void FilterEvents::createOutputWorkspaces() {
         propertynamess << "OutputWorkspace_" << wsgroup;
       }
 
-      // Inserted this pair to map
-      m_wsNames.push_back(wsname.str());
-
-      // Set (property) to output workspace and set to ADS
-      declareProperty(
-          Kernel::make_unique<
-              API::WorkspaceProperty<DataObjects::EventWorkspace>>(
-              propertynamess.str(), wsname.str(), Direction::Output),
-          "Output");
-      setProperty(propertynamess.str(), optws);
-      AnalysisDataService::Instance().addOrReplace(wsname.str(), optws);
+      addOutputWorkspace(wsgroup, propertynamess.str(), wsname.str(), optws);
 
       ++numoutputws;
 
@@ -861,7 +934,7 @@ void FilterEvents::createOutputWorkspaces() {
 
       // Update progress report
       m_progress = 0.1 + 0.1 * wsgindex / numnewws;
-      progress(m_progress, "Creating output workspace");
+      progress(passProgress(m_progress), "Creating output workspace");
       wsgindex += 1.;
     } // If add workspace to output
 
@@ -900,6 +973,8 @@ void FilterEvents::createOutputWorkspacesMatrixCase() {
     if (wsgroup < 0)
       throw std::runtime_error("It is not possible to have split-target group "
                                "index < 0 in MatrixWorkspace case.");
+    if (!isInCurrentPass(wsgroup))
+      continue;
 
     // workspace name
     std::stringstream wsname;
@@ -925,16 +1000,7 @@ void FilterEvents::createOutputWorkspacesMatrixCase() {
       propertynamess << "OutputWorkspace_" << wsgroup;
     }
 
-    // Inserted this pair to map
-    m_wsNames.push_back(wsname.str());
-
-    // Set (property) to output workspace and set to ADS
-    declareProperty(Kernel::make_unique<
-                        API::WorkspaceProperty<DataObjects::EventWorkspace>>(
-                        propertynamess.str(), wsname.str(), Direction::Output),
-                    "Output");
-    setProperty(propertynamess.str(), optws);
-    AnalysisDataService::Instance().addOrReplace(wsname.str(), optws);
+    addOutputWorkspace(wsgroup, propertynamess.str(), wsname.str(), optws);
 
     g_log.debug() << "Created output Workspace of group = " << wsgroup
                   << "  Property Name = " << propertynamess.str()
@@ -946,7 +1012,7 @@ void FilterEvents::createOutputWorkspacesMatrixCase() {
     m_progress =
         0.1 +
         0.1 * static_cast<double>(wsgindex) / static_cast<double>(numoutputws);
-    progress(m_progress, "Creating output workspace");
+    progress(passProgress(m_progress), "Creating output workspace");
     wsgindex += 1;
   } // END-FOR (wsgroup)
 
@@ -982,6 +1048,8 @@ void FilterEvents::createOutputWorkspacesTableSplitterCase() {
     if (wsgroup < 0)
       throw std::runtime_error("It is not possible to have split-target group "
                                "index < 0 in TableWorkspace case.");
+    if (!isInCurrentPass(wsgroup))
+      continue;
 
     // workspace name
     std::stringstream wsname;
@@ -1006,16 +1074,7 @@ void FilterEvents::createOutputWorkspacesTableSplitterCase() {
       propertynamess << "OutputWorkspace_" << wsgroup;
     }
 
-    // Inserted this pair to map
-    m_wsNames.push_back(wsname.str());
-
-    // Set (property) to output workspace and set to ADS
-    declareProperty(Kernel::make_unique<
-                        API::WorkspaceProperty<DataObjects::EventWorkspace>>(
-                        propertynamess.str(), wsname.str(), Direction::Output),
-                    "Output");
-    setProperty(propertynamess.str(), optws);
-    AnalysisDataService::Instance().addOrReplace(wsname.str(), optws);
+    addOutputWorkspace(wsgroup, propertynamess.str(), wsname.str(), optws);
 
     g_log.debug() << "Created output Workspace of group = " << wsgroup
                   << "  Property Name = " << propertynamess.str()
@@ -1027,7 +1086,7 @@ void FilterEvents::createOutputWorkspacesTableSplitterCase() {
     m_progress =
         0.1 +
         0.1 * static_cast<double>(wsgindex) / static_cast<double>(numoutputws);
-    progress(m_progress, "Creating output workspace");
+    progress(passProgress(m_progress), "Creating output workspace");
     wsgindex += 1;
   } // END-FOR (wsgroup)
 
@@ -1038,6 +1097,75 @@ void FilterEvents::createOutputWorkspacesTableSplitterCase() {
   return;
 }
 
+/** Check whether the output workspace of a target is created in the current
+ * pass over the input workspace
+ * @param wsgroup :: the (integer) group index of the target
+ * @return True if the workspace of the target is created in this pass
+ */
+bool FilterEvents::isInCurrentPass(const int wsgroup) const {
+  return m_currentPassTargets.empty() ||
+         m_currentPassTargets.count(wsgroup) > 0;
+}
+
+/** Convert the progress within the current pass to the overall progress.
+ * The passes share the range after the TOF corrections are imported, so a
+ * single pass reports the progress unchanged.
+ * @param fraction :: the progress within the current pass, from 0.1 to 1
+ * @return The overall progress
+ */
+double FilterEvents::passProgress(const double fraction) const {
+  return 0.1 + (0.9 * static_cast<double>(m_pass) + fraction - 0.1) /
+                   static_cast<double>(m_numberOfPasses);
+}
+
+/** Register a new output workspace. It is set to an output property and added
+ * to the ADS, or saved to OutputDirectory once it is filled.
+ * @param wsgroup :: the (integer) group index of the target
+ * @param propertyName :: name of the output property
+ * @param wsName :: name of the output workspace
+ * @param workspace :: the output workspace
+ */
+void FilterEvents::addOutputWorkspace(
+    const int wsgroup, const std::string &propertyName,
+    const std::string &wsName,
+    const DataObjects::EventWorkspace_sptr &workspace) {
+  // Inserted this pair to map
+  m_wsNames.push_back(wsName);
+
+  if (!m_outputDirectory.empty()) {
+    m_outputFileNames.emplace(wsgroup, wsName);
+    return;
+  }
+
+  // Set (property) to output workspace and set to ADS
+  declareProperty(
+      Kernel::make_unique<API::WorkspaceProperty<DataObjects::EventWorkspace>>(
+          propertyName, wsName, Direction::Output),
+      "Output");
+  setProperty(propertyName, workspace);
+  AnalysisDataService::Instance().addOrReplace(wsName, workspace);
+}
+
+/** Save the output workspaces of the current pass to OutputDirectory and
+ * release them
+ */
+void FilterEvents::saveOutputWorkspaces() {
+  const Poco::Path directory(m_outputDirectory);
+  for (const auto &output : m_outputFileNames) {
+    const auto filename = Poco::Path(directory, output.second + ".nxs");
+    g_log.information() << "Saving " << output.second << " to "
+                        << filename.toString() << "\n";
+    auto save = createChildAlgorithm("SaveNexusProcessed");
+    save->setProperty<Workspace_sptr>(
+        "InputWorkspace", m_outputWorkspacesMap.at(output.first));
+    save->setPropertyValue("Filename", filename.toString());
+    save->setPropertyValue("Title", output.second);
+    save->executeAsChildAlg();
+  }
+  m_outputFileNames.clear();
+  m_outputWorkspacesMap.clear();
+}
+
 /** Set up neutron event's TOF correction.
   * It can be (1) parsed from TOF-correction table workspace to vectors,
   * (2) created according to detector's position in instrument;
@@ -1261,6 +1389,40 @@ void FilterEvents::setupCustomizedTOFCorrection() {
   }
 }
 
+/** Get the event lists of a spectrum in the output workspaces (which should
+ * be empty) for splitting the spectrum's events. When the output workspaces
+ * are created in several passes, the targets of the other passes and the
+ * unfiltered events (-1) share the scratch event list of the calling thread.
+ * @param wsIndex :: the workspace index of the spectrum
+ * @return The output event list of each target
+ */
+std::map<int, DataObjects::EventList *>
+FilterEvents::getOutputEventLists(const size_t wsIndex) {
+  std::map<int, DataObjects::EventList *> outputs;
+  PARALLEL_CRITICAL(build_elist) {
+    for (auto &ws : m_outputWorkspacesMap) {
+      int index = ws.first;
+      auto &output_el = ws.second->getSpectrum(wsIndex);
+      outputs.emplace(index, &output_el);
+    }
+  }
+  if (!m_scratchEventLists.empty()) {
+    auto scratch = &m_scratchEventLists[PARALLEL_THREAD_NUMBER];
+    for (const auto target : m_targetWorkspaceIndexSet)
+      outputs.emplace(target, scratch);
+    outputs.emplace(-1, scratch);
+  }
+  return outputs;
+}
+
+/** Empty the scratch event list of the calling thread once a spectrum is
+ * split, so that the events of the other passes are not kept
+ */
+void FilterEvents::clearScratchEventList() {
+  if (!m_scratchEventLists.empty())
+    m_scratchEventLists[PARALLEL_THREAD_NUMBER].clear();
+}
+
 /** Main filtering method
   * Structure: per spectrum --> per workspace
  */
@@ -1279,15 +1441,7 @@ void FilterEvents::filterEventsBySplitters(double progressamount) {
 
     // Filter the non-skipped
     if (!m_vecSkip[iws]) {
-      // Get the output event lists (should be empty) to be a map
-      std::map<int, DataObjects::EventList *> outputs;
-      PARALLEL_CRITICAL(build_elist) {
-        for (auto &ws : m_outputWorkspacesMap) {
-          int index = ws.first;
-          auto &output_el = ws.second->getSpectrum(iws);
-          outputs.emplace(index, &output_el);
-        }
-      }
+      auto outputs = getOutputEventLists(static_cast<size_t>(iws));
       // Get a holder on input workspace's event list of this spectrum
       const DataObjects::EventList &input_el = m_eventWS->getSpectrum(iws);
 
@@ -1301,6 +1455,7 @@ void FilterEvents::filterEventsBySplitters(double progressamount) {
       } else {
         input_el.splitByFullTime(m_splitters, outputs, false, 1.0, 0.0);
       }
+      clearScratchEventList();
     }
 
     PARALLEL_END_INTERUPT_REGION
@@ -1308,7 +1463,7 @@ void FilterEvents::filterEventsBySplitters(double progressamount) {
   PARALLEL_CHECK_INTERUPT_REGION
 
   // Split the sample logs in each target workspace.
-  progress(0.1 + progressamount, "Splitting logs");
+  progress(passProgress(0.1 + progressamount), "Splitting logs");
 
   if (!m_splitSampleLogs) {
     // Skip if choice is no
@@ -1325,12 +1480,13 @@ void FilterEvents::filterEventsBySplitters(double progressamount) {
   double outwsindex = 0.;
 
   // split sample logs from original workspace to new one
+  auto splittersByTarget = generateSplittersByTarget();
   for (auto &ws : m_outputWorkspacesMap) {
     int wsindex = ws.first;
     DataObjects::EventWorkspace_sptr opws = ws.second;
 
-    // Generate a list of splitters for current output workspace
-    Kernel::TimeSplitterType splitters = generateSplitters(wsindex);
+    // The list of splitters for current output workspace
+    Kernel::TimeSplitterType &splitters = splittersByTarget[wsindex];
 
     g_log.debug() << "[FilterEvents D1215]: Output workspace Index " << wsindex
                   << ": Name = " << opws->getName()
@@ -1353,7 +1509,8 @@ void FilterEvents::filterEventsBySplitters(double progressamount) {
     }
     opws->mutableRun().integrateProtonCharge();
 
-    progress(0.1 + progressamount + outwsindex / numws * 0.2, "Splitting logs");
+    progress(passProgress(0.1 + progressamount + outwsindex / numws * 0.2),
+             "Splitting logs");
     outwsindex += 1.;
   }
 }
@@ -1394,15 +1551,7 @@ void FilterEvents::filterEventsByVectorSplitters(double progressamount) {
 
     // Filter the non-skipped spectrum
     if (!m_vecSkip[iws]) {
-      // Get the output event lists (should be empty) to be a map
-      map<int, DataObjects::EventList *> outputs;
-      PARALLEL_CRITICAL(build_elist) {
-        for (auto &ws : m_outputWorkspacesMap) {
-          int index = ws.first;
-          auto &output_el = ws.second->getSpectrum(iws);
-          outputs.emplace(index, &output_el);
-        }
-      }
+      auto outputs = getOutputEventLists(static_cast<size_t>(iws));
 
       // Get a holder on input workspace's event list of this spectrum
       const DataObjects::EventList &input_el = m_eventWS->getSpectrum(iws);
@@ -1423,6 +1572,8 @@ void FilterEvents::filterEventsByVectorSplitters(double progressamount) {
             m_vecSplitterTime, m_vecSplitterGroup, outputs, false, 1.0, 0.0);
       }
 
+      clearScratchEventList();
+
       if (printdetail)
         g_log.notice(logmessage);
     }
@@ -1433,7 +1584,7 @@ void FilterEvents::filterEventsByVectorSplitters(double progressamount) {
 
   // Finish (1) adding events and splitting the sample logs in each target
   // workspace.
-  progress(0.1 + progressamount, "Splitting logs");
+  progress(passProgress(0.1 + progressamount), "Splitting logs");
 
   g_log.notice("Splitters in format of Matrixworkspace are not recommended to "
                "split sample logs. ");
@@ -1482,10 +1633,8 @@ void FilterEvents::filterEventsByVectorSplitters(double progressamount) {
         std::map<int, DataObjects::EventWorkspace_sptr>::iterator wsiter;
         wsiter = m_outputWorkspacesMap.find(tindex);
         if (wsiter == m_outputWorkspacesMap.end()) {
-          ;
-          //  g_log.error() << "Workspace target (" << tindex
-          //          << ") does not have workspace associated."
-          //        << "\n";
+          // not in the outputs of this pass
+          delete output_vector[tindex];
         } else {
           DataObjects::EventWorkspace_sptr ws_i = wsiter->second;
           ws_i->mutableRun().addProperty(output_vector[tindex], true);
@@ -1512,9 +1661,8 @@ void FilterEvents::filterEventsByVectorSplitters(double progressamount) {
         std::map<int, DataObjects::EventWorkspace_sptr>::iterator wsiter;
         wsiter = m_outputWorkspacesMap.find(tindex);
         if (wsiter == m_outputWorkspacesMap.end()) {
-          g_log.error() << "Workspace target (" << tindex
-                        << ") does not have workspace associated."
-                        << "\n";
+          // not in the outputs of this pass
+          delete output_vector[tindex];
         } else {
           DataObjects::EventWorkspace_sptr ws_i = wsiter->second;
           ws_i->mutableRun().addProperty(output_vector[tindex], true);
@@ -1527,37 +1675,22 @@ void FilterEvents::filterEventsByVectorSplitters(double progressamount) {
     }
   }
 
-  for (int tindex = 0; tindex <= max_target_index; ++tindex) {
-    // set to output workspace
-    for (int tindex = 0; tindex <= max_target_index; ++tindex) {
-      // find output workspace
-      std::map<int, DataObjects::EventWorkspace_sptr>::iterator wsiter;
-      wsiter = m_outputWorkspacesMap.find(tindex);
-      if (wsiter == m_outputWorkspacesMap.end()) {
-        g_log.error() << "Workspace target (" << tindex
-                      << ") does not have workspace associated."
-                      << "\n";
-      } else {
-        DataObjects::EventWorkspace_sptr ws_i = wsiter->second;
-        ws_i->mutableRun().integrateProtonCharge();
-      }
-    }
-  }
+  // set to output workspace
+  for (auto &ws : m_outputWorkspacesMap)
+    ws.second->mutableRun().integrateProtonCharge();
 
   return;
 }
 
-/** Generate splitters for specified workspace index as a subset of
- * m_splitters
+/** Group the splitters of m_splitters by their target workspace index, in a
+ * single pass over them
+ * @return Map from the workspace index to its splitters
  */
-Kernel::TimeSplitterType FilterEvents::generateSplitters(int wsindex) {
-  Kernel::TimeSplitterType splitters;
-  for (const auto &splitter : m_splitters) {
-    int index = splitter.index();
-    if (index == wsindex) {
-      splitters.push_back(splitter);
-    }
-  }
+std::map<int, Kernel::TimeSplitterType>
+FilterEvents::generateSplittersByTarget() const {
+  std::map<int, Kernel::TimeSplitterType> splitters;
+  for (const auto &splitter : m_splitters)
+    splitters[splitter.index()].push_back(splitter);
   return splitters;
 }
 
@@ -1735,6 +1868,12 @@ void FilterEvents::mapSplitterTSPtoWorkspaces(
         outws->mutableRun().addProperty(split_tsp_vec[miter->first], true);
       }
     }
+    // delete the logs that are not owned by a workspace
+    for (int itarget = 0; itarget < static_cast<int>(split_tsp_vec.size());
+         ++itarget) {
+      if (m_outputWorkspacesMap.count(itarget) == 0)
+        delete split_tsp_vec[itarget];
+    }
   } else {
     // Either Table-type or Matrix-type splitters
     for (int itarget = 0; itarget < static_cast<int>(split_tsp_vec.size());
@@ -1745,8 +1884,10 @@ void FilterEvents::mapSplitterTSPtoWorkspaces(
 
       // skip if an itarget does not have matched workspace
       if (ws_iter == m_outputWorkspacesMap.end()) {
-        g_log.warning() << "iTarget " << itarget
-                        << " does not have any workspace associated.\n";
+        if (isInCurrentPass(itarget))
+          g_log.warning() << "iTarget " << itarget
+                          << " does not have any workspace associated.\n";
+        delete split_tsp_vec[itarget];
         continue;
       }
 
@@ -40,6 +40,22 @@ void Minus::performBinaryOperation(const MantidVec &lhsX, const MantidVec &lhsY,
     EOut = lhsE;
 }
 
+bool Minus::canTransformWithSingleValue(const double rhsY,
+                                        const double rhsE) const {
+  (void)rhsY; // Avoid compiler warning
+  (void)rhsE;
+  return true;
+}
+
+void Minus::transformWithSingleValue(MatrixWorkspace &out, const size_t index,
+                                     const double rhsY, const double rhsE) {
+  out.transformY(index, [rhsY](const double y) { return y - rhsY; });
+  // Only do E if non-zero, otherwise leave it unchanged
+  if (rhsE != 0)
+    out.transformE(index, std::bind2nd(VectorHelper::SumGaussError<double>(),
+                                       rhsE));
+}
+
 // ===================================== EVENT LIST BINARY OPERATIONS
 // ==========================================
 /** Carries out the binary operation IN-PLACE on a single EventList,
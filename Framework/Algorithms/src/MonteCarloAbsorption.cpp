@@ -22,6 +22,7 @@
 #include "MantidKernel/DeltaEMode.h"
 #include "MantidKernel/EnabledWhenProperty.h"
 #include "MantidKernel/MersenneTwister.h"
+#include "MantidKernel/Philox.h"
 #include "MantidKernel/PhysicalConstants.h"
 #include "MantidKernel/VectorHelper.h"
 
@@ -109,6 +110,11 @@ void MonteCarloAbsorption::init() {
       "The number of \"neutron\" events to generate per simulated point");
   declareProperty("SeedValue", DEFAULT_SEED, positiveInt,
                   "Seed the random number generator with this value");
+  declareProperty("IndependentRandomStreams", false,
+                  "If true, simulate every point with its own random number "
+                  "stream so that the points are statistically independent "
+                  "and can be computed in parallel. The results do not "
+                  "depend on the number of threads.");
 
   InterpolationOption interpolateOpt;
   declareProperty(interpolateOpt.property(), interpolateOpt.propertyDoc());
@@ -147,8 +153,10 @@ void MonteCarloAbsorption::exec() {
   InterpolationOption interpolateOpt;
   interpolateOpt.set(getPropertyValue("Interpolation"));
   const bool useSparseInstrument = getProperty("SparseInstrument");
-  auto outputWS = doSimulation(*inputWS, static_cast<size_t>(nevents), nlambda,
-                               seed, interpolateOpt, useSparseInstrument);
+  const bool independentStreams = getProperty("IndependentRandomStreams");
+  auto outputWS =
+      doSimulation(*inputWS, static_cast<size_t>(nevents), nlambda, seed,
+                   interpolateOpt, useSparseInstrument, independentStreams);
 
   setProperty("OutputWorkspace", std::move(outputWS));
 }
@@ -162,12 +170,14 @@ void MonteCarloAbsorption::exec() {
  * @param seed Seed value for the random number generator
  * @param interpolateOpt Method of interpolation to compute unsimulated points
  * @param useSparseInstrument If true, use sparse instrument in simulation
+ * @param independentStreams If true, use a separate random number stream for
+ * each simulated point and run the points in parallel
  * @return A new workspace containing the correction factors & errors
  */
 MatrixWorkspace_uptr MonteCarloAbsorption::doSimulation(
     const MatrixWorkspace &inputWS, const size_t nevents, int nlambda,
     const int seed, const InterpolationOption &interpolateOpt,
-    const bool useSparseInstrument) {
+    const bool useSparseInstrument, const bool independentStreams) {
   auto outputWS = createOutputWorkspace(inputWS);
   const auto inputNbins = static_cast<int>(inputWS.blocksize());
   if (isEmpty(nlambda) || nlambda > inputNbins) {
@@ -199,9 +209,20 @@ MatrixWorkspace_uptr MonteCarloAbsorption::doSimulation(
   EFixedProvider efixed(instrumentWS);
   auto beamProfile = createBeamProfile(*instrument, inputWS.sample());
 
-  // Configure progress
+  // Indices of the simulated wavelength points. The last point is always
+  // included for the interpolation
   const int lambdaStepSize = nbins / nlambda;
-  Progress prog(this, 0.0, 1.0, nhists * nbins / lambdaStepSize);
+  std::vector<int> simulatedPoints;
+  for (int j = 0; j < nbins; j += lambdaStepSize) {
+    simulatedPoints.emplace_back(j);
+    if (lambdaStepSize > 1 && j + lambdaStepSize >= nbins && j + 1 != nbins) {
+      j = nbins - lambdaStepSize - 1;
+    }
+  }
+  const auto npoints = static_cast<int64_t>(simulatedPoints.size());
+
+  // Configure progress
+  Progress prog(this, 0.0, 1.0, nhists * npoints);
   prog.setNotifyStep(0.01);
   const std::string reportMsg = "Computing corrections";
 
@@ -210,6 +231,46 @@ MatrixWorkspace_uptr MonteCarloAbsorption::doSimulation(
 
   const auto &spectrumInfo = simulationWS.spectrumInfo();
 
+  // Simulate a single wavelength point of a spectrum
+  auto simulatePoint = [&efixed, &strategy](
+      PseudoRandomNumberGenerator &rng, const V3D &detPos,
+      const double lambdaFixed, const double lambdaStep) {
+    double lambdaIn(lambdaStep), lambdaOut(lambdaStep);
+    if (efixed.emode() == DeltaEMode::Direct) {
+      lambdaIn = lambdaFixed;
+    } else if (efixed.emode() == DeltaEMode::Indirect) {
+      lambdaOut = lambdaFixed;
+    } else {
+      // elastic case already initialized
+    }
+    return std::get<0>(strategy.calculate(rng, detPos, lambdaIn, lambdaOut));
+  };
+
+  // With independent streams every (spectrum, point) pair is a separate task
+  // seeded by its indices, so the points of a spectrum are spread over the
+  // threads and the results do not depend on the scheduling.
+  std::vector<double> streamResults;
+  if (independentStreams) {
+    streamResults.resize(static_cast<size_t>(nhists * npoints));
+    PARALLEL_FOR_IF(Kernel::threadSafe(simulationWS))
+    for (int64_t k = 0; k < nhists * npoints; ++k) {
+      PARALLEL_START_INTERUPT_REGION
+      const int64_t i = k / npoints;
+      if (!spectrumInfo.hasDetectors(i)) {
+        continue;
+      }
+      prog.report(reportMsg);
+      const int j = simulatedPoints[k % npoints];
+      const double lambdaFixed =
+          toWavelength(efixed.value(spectrumInfo.detector(i).getID()));
+      Philox rng(seed, static_cast<uint64_t>(i) * nbins + j);
+      streamResults[k] = simulatePoint(rng, spectrumInfo.position(i),
+                                       lambdaFixed, simulationWS.points(i)[j]);
+      PARALLEL_END_INTERUPT_REGION
+    }
+    PARALLEL_CHECK_INTERUPT_REGION
+  }
+
   PARALLEL_FOR_IF(Kernel::threadSafe(simulationWS))
   for (int64_t i = 0; i < nhists; ++i) {
     PARALLEL_START_INTERUPT_REGION
@@ -221,32 +282,23 @@ MatrixWorkspace_uptr MonteCarloAbsorption::doSimulation(
     if (!spectrumInfo.hasDetectors(i)) {
       continue;
     }
-    // Per spectrum values
-    const auto &detPos = spectrumInfo.position(i);
-    const double lambdaFixed =
-        toWavelength(efixed.value(spectrumInfo.detector(i).getID()));
-    MersenneTwister rng(seed);
 
     auto &outY = simulationWS.mutableY(i);
-    const auto lambdas = simulationWS.points(i);
-    // Simulation for each requested wavelength point
-    for (int j = 0; j < nbins; j += lambdaStepSize) {
-      prog.report(reportMsg);
-      const double lambdaStep = lambdas[j];
-      double lambdaIn(lambdaStep), lambdaOut(lambdaStep);
-      if (efixed.emode() == DeltaEMode::Direct) {
-        lambdaIn = lambdaFixed;
-      } else if (efixed.emode() == DeltaEMode::Indirect) {
-        lambdaOut = lambdaFixed;
-      } else {
-        // elastic case already initialized
+    if (independentStreams) {
+      for (int64_t point = 0; point < npoints; ++point) {
+        outY[simulatedPoints[point]] = streamResults[i * npoints + point];
       }
-      std::tie(outY[j], std::ignore) =
-          strategy.calculate(rng, detPos, lambdaIn, lambdaOut);
-
-      // Ensure we have the last point for the interpolation
-      if (lambdaStepSize > 1 && j + lambdaStepSize >= nbins && j + 1 != nbins) {
-        j = nbins - lambdaStepSize - 1;
+    } else {
+      // Per spectrum values
+      const auto &detPos = spectrumInfo.position(i);
+      const double lambdaFixed =
+          toWavelength(efixed.value(spectrumInfo.detector(i).getID()));
+      MersenneTwister rng(seed);
+      const auto lambdas = simulationWS.points(i);
+      // Simulation for each requested wavelength point
+      for (const auto j : simulatedPoints) {
+        prog.report(reportMsg);
+        outY[j] = simulatePoint(rng, detPos, lambdaFixed, lambdas[j]);
       }
     }
 
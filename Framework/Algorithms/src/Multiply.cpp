@@ -60,6 +60,21 @@ void Multiply::performBinaryOperation(const MantidVec &lhsX,
   }
 }
 
+/// Without an rhs error the output errors do not depend on the lhs values
+bool Multiply::canTransformWithSingleValue(const double rhsY,
+                                           const double rhsE) const {
+  (void)rhsY; // Avoid compiler warning
+  return rhsE == 0;
+}
+
+void Multiply::transformWithSingleValue(MatrixWorkspace &out,
+                                        const size_t index, const double rhsY,
+                                        const double rhsE) {
+  (void)rhsE; // Avoid compiler warning
+  out.transformE(index, [rhsY](const double e) { return fabs(e * rhsY); });
+  out.transformY(index, [rhsY](const double y) { return y * rhsY; });
+}
+
 void Multiply::setOutputUnits(const API::MatrixWorkspace_const_sptr lhs,
                               const API::MatrixWorkspace_const_sptr rhs,
                               API::MatrixWorkspace_sptr out) {
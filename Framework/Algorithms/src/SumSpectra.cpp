@@ -1,13 +1,25 @@
 #include "MantidAlgorithms/SumSpectra.h"
+#include "MantidAPI/Axis.h"
 #include "MantidAPI/CommonBinsValidator.h"
 #include "MantidAPI/Run.h"
 #include "MantidAPI/SpectrumInfo.h"
 #include "MantidAPI/WorkspaceFactory.h"
 #include "MantidDataObjects/RebinnedOutput.h"
+#include "MantidDataObjects/Workspace2D.h"
 #include "MantidDataObjects/WorkspaceCreation.h"
 #include "MantidGeometry/IDetector.h"
+#include "MantidIndexing/GlobalSpectrumIndex.h"
+#include "MantidIndexing/IndexInfo.h"
+#include "MantidIndexing/SpectrumIndexSet.h"
 #include "MantidKernel/ArrayProperty.h"
 #include "MantidKernel/BoundedValidator.h"
+#include "MantidParallel/Collectives.h"
+#include "MantidTypes/SpectrumDefinition.h"
+
+#include <boost/serialization/vector.hpp>
+
+#include <functional>
+#include <limits>
 
 namespace Mantid {
 namespace Algorithms {
@@ -86,7 +98,8 @@ std::map<std::string, std::string> SumSpectra::validateInputs() {
   std::map<std::string, std::string> validationOutput;
 
   MatrixWorkspace_const_sptr localworkspace = getProperty("InputWorkspace");
-  m_numberOfSpectra = static_cast<int>(localworkspace->getNumberHistograms());
+  m_numberOfSpectra =
+      static_cast<int>(localworkspace->indexInfo().globalSize());
   const int minIndex = getProperty("StartWorkspaceIndex");
   const int maxIndex = getProperty("EndWorkspaceIndex");
 
@@ -112,6 +125,13 @@ std::map<std::string, std::string> SumSpectra::validateInputs() {
         "Selected maximum workspace index is greater than available spectra.";
   }
 
+  // The fractional areas of a RebinnedOutput cannot be combined across ranks
+  if (localworkspace->id() == "RebinnedOutput" &&
+      localworkspace->storageMode() == Parallel::StorageMode::Distributed) {
+    validationOutput["InputWorkspace"] =
+        "RebinnedOutput workspaces with distributed storage are not supported.";
+  }
+
   // check ListOfWorkspaceIndices in range
   const std::vector<int> indices_list = getProperty("ListOfWorkspaceIndices");
   m_indices.clear();
@@ -128,10 +148,11 @@ std::map<std::string, std::string> SumSpectra::validateInputs() {
   return validationOutput;
 }
 
-/** Executes the algorithm
- *
+/** Read the index properties and fill the set of workspace indices to sum.
+ * For a distributed workspace these are global indices.
+ * @param localworkspace :: the input workspace
  */
-void SumSpectra::exec() {
+void SumSpectra::setupIndices(const API::MatrixWorkspace &localworkspace) {
   // Try and retrieve the optional properties
   m_minWsInd = getProperty("StartWorkspaceIndex");
   m_maxWsInd = getProperty("EndWorkspaceIndex");
@@ -140,11 +161,13 @@ void SumSpectra::exec() {
   m_keepMonitors = getProperty("IncludeMonitors");
   m_replaceSpecialValues = getProperty("RemoveSpecialValues");
 
-  // Get the input workspace
-  MatrixWorkspace_const_sptr localworkspace = getProperty("InputWorkspace");
-
-  m_numberOfSpectra = static_cast<int>(localworkspace->getNumberHistograms());
-  m_yLength = static_cast<int>(localworkspace->blocksize());
+  m_numberOfSpectra =
+      static_cast<int>(localworkspace.indexInfo().globalSize());
+  // A rank may hold none of the spectra of a distributed workspace, the
+  // length is then agreed with the other ranks in execDistributed()
+  m_yLength = localworkspace.getNumberHistograms() > 0
+                  ? static_cast<int>(localworkspace.blocksize())
+                  : 0;
 
   // Check 'StartSpectrum' is in range 0-m_numberOfSpectra
   if (m_minWsInd >= m_numberOfSpectra) {
@@ -173,6 +196,15 @@ void SumSpectra::exec() {
     for (int i = m_minWsInd; i <= m_maxWsInd; i++)
       m_indices.insert(i);
   }
+}
+
+/** Executes the algorithm
+ *
+ */
+void SumSpectra::exec() {
+  // Get the input workspace
+  MatrixWorkspace_const_sptr localworkspace = getProperty("InputWorkspace");
+  setupIndices(*localworkspace);
 
   // determine the output spectrum number
   m_outSpecNum = getOutputSpecNo(localworkspace);
@@ -311,7 +343,7 @@ void SumSpectra::doWorkspace2D(ISpectrum &outSpec, Progress &progress,
   auto &OutputYError = outSpec.mutableE();
 
   std::vector<double> Weight;
-  std::vector<size_t> nZeros;
+  std::vector<double> nZeros;
   if (m_calculateWeightedSum) {
     Weight.assign(OutputYSum.size(), 0);
     nZeros.assign(OutputYSum.size(), 0);
@@ -333,40 +365,13 @@ void SumSpectra::doWorkspace2D(ISpectrum &outSpec, Progress &progress,
       break;
     }
 
-    if (spectrumInfo.hasDetectors(wsIndex)) {
-      // Skip monitors, if the property is set to do so
-      if (!m_keepMonitors && spectrumInfo.isMonitor(wsIndex))
-        continue;
-      // Skip masked detectors
-      if (spectrumInfo.isMasked(wsIndex)) {
-        numMasked++;
-        continue;
-      }
-    }
+    if (skipSpectrum(spectrumInfo, wsIndex, numMasked))
+      continue;
     numSpectra++;
 
-    const auto &YValues = localworkspace->y(wsIndex);
-    const auto &YErrors = localworkspace->e(wsIndex);
-    if (m_calculateWeightedSum) {
-      // Retrieve the spectrum into a vector
-      for (int i = 0; i < m_yLength; ++i) {
-        if (std::isnormal(YErrors[i])) {
-          const double yErrorsVal = YErrors[i];
-          const double errsq = yErrorsVal * yErrorsVal;
-          OutputYError[i] += errsq;
-          Weight[i] += 1. / errsq;
-          OutputYSum[i] += YValues[i] / errsq;
-        } else {
-          nZeros[i]++;
-        }
-      }
-    } else {
-      OutputYSum += YValues;
-      for (int i = 0; i < m_yLength; ++i) {
-        const auto yErrorsVal = YErrors[i];
-        OutputYError[i] += yErrorsVal * yErrorsVal;
-      }
-    }
+    addSpectrum(localworkspace->y(wsIndex), localworkspace->e(wsIndex),
+                &OutputYSum[0], &OutputYError[0], Weight.data(),
+                nZeros.data());
 
     // Map all the detectors onto the spectrum of the output
     outSpec.addDetectorIDs(
@@ -375,17 +380,90 @@ void SumSpectra::doWorkspace2D(ISpectrum &outSpec, Progress &progress,
     progress.report();
   }
 
+  if (m_calculateWeightedSum)
+    numZeros = normalizeWeightedSum(&OutputYSum[0], Weight.data(),
+                                    nZeros.data(), numSpectra);
+}
+
+/**
+ * Check whether a spectrum is left out of the sum because it is a monitor or
+ * is masked.
+ * @param spectrumInfo The spectrum info of the input workspace.
+ * @param wsIndex The workspace index of the spectrum.
+ * @param numMasked The number of masked spectra, incremented if the spectrum
+ * is masked.
+ * @return True if the spectrum must not be summed.
+ */
+bool SumSpectra::skipSpectrum(const SpectrumInfo &spectrumInfo,
+                              const size_t wsIndex, size_t &numMasked) const {
+  if (!spectrumInfo.hasDetectors(wsIndex))
+    return false;
+  // Skip monitors, if the property is set to do so
+  if (!m_keepMonitors && spectrumInfo.isMonitor(wsIndex))
+    return true;
+  // Skip masked detectors
+  if (spectrumInfo.isMasked(wsIndex)) {
+    numMasked++;
+    return true;
+  }
+  return false;
+}
+
+/**
+ * Add one spectrum to the running sums. For a weighted sum the counts are
+ * weighted by the inverse of their variance, and bins without a valid error
+ * are counted in nZeros instead.
+ * @param yValues The counts of the spectrum.
+ * @param yErrors The errors of the spectrum.
+ * @param ySum The sum of the counts.
+ * @param eSum The sum of the squared errors.
+ * @param weight The sum of the weights, only used for a weighted sum.
+ * @param nZeros The number of skipped bins, only used for a weighted sum.
+ */
+void SumSpectra::addSpectrum(const HistogramData::HistogramY &yValues,
+                             const HistogramData::HistogramE &yErrors,
+                             double *ySum, double *eSum, double *weight,
+                             double *nZeros) const {
   if (m_calculateWeightedSum) {
-    numZeros = 0;
-    for (size_t i = 0; i < Weight.size(); i++) {
-      if (numSpectra > nZeros[i])
-        OutputYSum[i] *= double(numSpectra - nZeros[i]) / Weight[i];
-      if (nZeros[i] != 0)
-        numZeros += nZeros[i];
+    for (int i = 0; i < m_yLength; ++i) {
+      if (std::isnormal(yErrors[i])) {
+        const double errsq = yErrors[i] * yErrors[i];
+        eSum[i] += errsq;
+        weight[i] += 1. / errsq;
+        ySum[i] += yValues[i] / errsq;
+      } else {
+        nZeros[i]++;
+      }
+    }
+  } else {
+    for (int i = 0; i < m_yLength; ++i) {
+      ySum[i] += yValues[i];
+      eSum[i] += yErrors[i] * yErrors[i];
     }
   }
 }
 
+/**
+ * Turn the sums of a weighted sum into the weighted average scaled by the
+ * number of contributing spectra.
+ * @param ySum The sum of the weighted counts.
+ * @param weight The sum of the weights.
+ * @param nZeros The number of skipped bins.
+ * @param numSpectra The number of summed spectra.
+ * @return The total number of skipped bins.
+ */
+size_t SumSpectra::normalizeWeightedSum(double *ySum, const double *weight,
+                                        const double *nZeros,
+                                        const size_t numSpectra) const {
+  size_t numZeros = 0;
+  for (int i = 0; i < m_yLength; i++) {
+    if (static_cast<double>(numSpectra) > nZeros[i])
+      ySum[i] *= (static_cast<double>(numSpectra) - nZeros[i]) / weight[i];
+    numZeros += static_cast<size_t>(nZeros[i]);
+  }
+  return numZeros;
+}
+
 /**
  * This function handles the logic for summing RebinnedOutput workspaces.
  * @param outputWorkspace the workspace to hold the summed input
@@ -556,5 +634,168 @@ void SumSpectra::execEvent(EventWorkspace_const_sptr localworkspace,
   setProperty("OutputWorkspace", std::move(outputWorkspace));
 }
 
+/** Executes the algorithm for a workspace with spectra spread over several
+ * ranks. Each rank sums its own spectra and the partial sums are reduced onto
+ * the master rank, which holds the output. Event workspaces are histogrammed,
+ * so the output is always a Workspace2D.
+ */
+void SumSpectra::execDistributed() {
+  MatrixWorkspace_sptr in_ws = getProperty("InputWorkspace");
+  setupIndices(*in_ws);
+  m_calculateWeightedSum = getProperty("WeightedSum");
+  const bool isEventWorkspace = in_ws->id() == "EventWorkspace";
+  if (isEventWorkspace)
+    m_calculateWeightedSum = false;
+  auto localworkspace = replaceSpecialValues(in_ws);
+
+  // The selected indices are global, sum those on this rank
+  const auto &indexInfo = localworkspace->indexInfo();
+  std::vector<Indexing::GlobalSpectrumIndex> globalIndices(m_indices.begin(),
+                                                           m_indices.end());
+  const auto localIndices = indexInfo.makeIndexSet(globalIndices);
+
+  // Every rank has to agree on the number of bins before the partial sums
+  // are combined. The check is collective so that all ranks throw together
+  // rather than leaving the others blocked in the reduction.
+  const auto &comm = communicator();
+  const auto maximum = [](const std::vector<int> &a,
+                          const std::vector<int> &b) {
+    return std::vector<int>{std::max(a[0], b[0]), std::max(a[1], b[1])};
+  };
+  const bool hasSpectra = localworkspace->getNumberHistograms() > 0;
+  const std::vector<int> localLength{
+      hasSpectra ? m_yLength : -1,
+      hasSpectra ? -m_yLength : std::numeric_limits<int>::min()};
+  std::vector<int> lengthRange;
+  Parallel::all_reduce(comm, localLength, lengthRange, maximum);
+  if (lengthRange[0] < 0)
+    throw std::runtime_error("SumSpectra: no rank holds any spectra.");
+  if (lengthRange[0] != -lengthRange[1])
+    throw std::runtime_error(
+        "SumSpectra: the number of bins differs between ranks.");
+  m_yLength = lengthRange[0];
+
+  // The partial sums are packed in a single vector: the Y sum, the squared
+  // errors, the weights and the zero counts of the bins followed by the
+  // number of summed, masked and zero spectra.
+  const size_t yLength = static_cast<size_t>(m_yLength);
+  std::vector<double> sums(4 * yLength + 3, 0.0);
+  double *ySum = sums.data();
+  double *eSum = ySum + yLength;
+  double *weight = eSum + yLength;
+  double *nZeros = weight + yLength;
+  size_t numSpectra(0);
+  size_t numMasked(0);
+  size_t numZeros(0);
+  auto specNum = std::numeric_limits<specnum_t>::max();
+  // Detector and time index of each detector of the summed spectra
+  std::vector<size_t> detectors;
+
+  Progress progress(this, 0.0, 1.0, localIndices.size());
+  const auto &spectrumInfo = localworkspace->spectrumInfo();
+  for (const auto wsIndex : localIndices) {
+    // Like getOutputSpecNo(), skipped spectra count for the spectrum number
+    specNum = std::min(specNum, static_cast<specnum_t>(
+                                    indexInfo.spectrumNumber(wsIndex)));
+    if (skipSpectrum(spectrumInfo, wsIndex, numMasked))
+      continue;
+    numSpectra++;
+
+    addSpectrum(localworkspace->y(wsIndex), localworkspace->e(wsIndex), ySum,
+                eSum, weight, nZeros);
+    if (isEventWorkspace &&
+        static_cast<const EventWorkspace &>(*localworkspace)
+            .getSpectrum(wsIndex)
+            .empty())
+      numZeros++;
+
+    for (const auto &index : spectrumInfo.spectrumDefinition(wsIndex)) {
+      detectors.push_back(index.first);
+      detectors.push_back(index.second);
+    }
+    progress.report();
+  }
+
+  const auto sum = [](const std::vector<double> &a,
+                      const std::vector<double> &b) {
+    std::vector<double> result(a);
+    std::transform(result.begin(), result.end(), b.begin(), result.begin(),
+                   std::plus<double>());
+    return result;
+  };
+  const auto minimum = [](specnum_t a, specnum_t b) { return std::min(a, b); };
+  sums[4 * yLength] = static_cast<double>(numSpectra);
+  sums[4 * yLength + 1] = static_cast<double>(numMasked);
+  sums[4 * yLength + 2] = static_cast<double>(numZeros);
+  if (comm.rank() != 0) {
+    Parallel::reduce(comm, sums, sum, 0);
+    Parallel::reduce(comm, specNum, minimum, 0);
+    Parallel::gather(comm, detectors, 0);
+    setProperty("OutputWorkspace", boost::make_shared<Workspace2D>(
+                                       Parallel::StorageMode::MasterOnly));
+    return;
+  }
+  std::vector<double> totals;
+  std::vector<std::vector<size_t>> allDetectors;
+  Parallel::reduce(comm, sums, totals, sum, 0);
+  Parallel::reduce(comm, specNum, m_outSpecNum, minimum, 0);
+  Parallel::gather(comm, detectors, allDetectors, 0);
+  sums = std::move(totals);
+  ySum = sums.data();
+  eSum = ySum + yLength;
+  weight = eSum + yLength;
+  nZeros = weight + yLength;
+  numSpectra = static_cast<size_t>(sums[4 * yLength]);
+  numMasked = static_cast<size_t>(sums[4 * yLength + 1]);
+  numZeros = static_cast<size_t>(sums[4 * yLength + 2]);
+
+  if (m_calculateWeightedSum)
+    numZeros = normalizeWeightedSum(ySum, weight, nZeros, numSpectra);
+
+  SpectrumDefinition spectrumDefinition;
+  for (const auto &rankDetectors : allDetectors)
+    for (size_t i = 0; i < rankDetectors.size(); i += 2)
+      spectrumDefinition.add(rankDetectors[i], rankDetectors[i + 1]);
+  Indexing::IndexInfo outputIndexInfo(
+      std::vector<Indexing::SpectrumNumber>{
+          Indexing::SpectrumNumber(m_outSpecNum)},
+      Parallel::StorageMode::MasterOnly, comm);
+  outputIndexInfo.setSpectrumDefinitions(
+      std::vector<SpectrumDefinition>{spectrumDefinition});
+  // Not created from the input workspace since its local spectrum would be
+  // copied if it only has one. The master rank always holds the first
+  // spectrum, and the bins are common.
+  auto outputWorkspace =
+      create<Workspace2D>(localworkspace->getInstrument(), outputIndexInfo,
+                          localworkspace->histogram(0));
+  outputWorkspace->copyExperimentInfoFrom(localworkspace.get());
+  outputWorkspace->setTitle(localworkspace->getTitle());
+  outputWorkspace->getAxis(0)->unit() = localworkspace->getAxis(0)->unit();
+  outputWorkspace->setYUnit(localworkspace->YUnit());
+  outputWorkspace->setDistribution(localworkspace->isDistribution());
+  auto &YSum = outputWorkspace->mutableY(0);
+  auto &YError = outputWorkspace->mutableE(0);
+  for (size_t i = 0; i < yLength; ++i) {
+    YSum[i] = ySum[i];
+    YError[i] = std::sqrt(eSum[i]);
+  }
+
+  // set up the summing statistics
+  outputWorkspace->mutableRun().addProperty("NumAllSpectra", int(numSpectra),
+                                            "", true);
+  outputWorkspace->mutableRun().addProperty("NumMaskSpectra", int(numMasked),
+                                            "", true);
+  outputWorkspace->mutableRun().addProperty("NumZeroSpectra", int(numZeros), "",
+                                            true);
+
+  setProperty("OutputWorkspace", std::move(outputWorkspace));
+}
+
+Parallel::ExecutionMode SumSpectra::getParallelExecutionMode(
+    const std::map<std::string, Parallel::StorageMode> &storageModes) const {
+  return Parallel::getCorrespondingExecutionMode(
+      storageModes.at("InputWorkspace"));
+}
+
 } // namespace Algorithms
 } // namespace Mantid
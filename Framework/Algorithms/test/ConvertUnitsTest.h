@@ -14,10 +14,16 @@
 #include "MantidDataHandling/LoadInstrument.h"
 #include "MantidDataObjects/EventWorkspace.h"
 #include "MantidDataObjects/Workspace2D.h"
+#include "MantidDataObjects/WorkspaceCreation.h"
 #include "MantidGeometry/Instrument.h"
 #include "MantidGeometry/Objects/Object.h"
+#include "MantidHistogramData/LinearGenerator.h"
+#include "MantidIndexing/IndexInfo.h"
 #include "MantidKernel/OptionalBool.h"
 #include "MantidKernel/UnitFactory.h"
+#include "MantidTestHelpers/ComponentCreationHelper.h"
+#include "MantidTestHelpers/ParallelAlgorithmCreation.h"
+#include "MantidTestHelpers/ParallelRunner.h"
 
 using namespace Mantid::Kernel;
 using namespace Mantid::API;
@@ -99,6 +105,51 @@ void setup_Points_WS(std::string &inputSpace) {
   loader.setProperty("RewriteSpectraMap", Mantid::Kernel::OptionalBool(false));
   loader.execute();
 }
+
+/// Convert a workspace with different TOF ranges in each spectrum to
+/// d-spacing with AlignBins
+MatrixWorkspace_sptr
+run_align_bins(const Mantid::Parallel::Communicator &comm,
+               const Mantid::Parallel::StorageMode storageMode) {
+  // 2 banks of 9 detectors
+  auto instrument = ComponentCreationHelper::createTestInstrumentCylindrical(2);
+  Mantid::Indexing::IndexInfo indexInfo(18, storageMode, comm);
+  MatrixWorkspace_sptr ws =
+      create<Workspace2D>(instrument, indexInfo, BinEdges(11));
+  for (size_t i = 0; i < ws->getNumberHistograms(); ++i) {
+    const auto global =
+        static_cast<double>(static_cast<int>(indexInfo.spectrumNumber(i)) - 1);
+    const Mantid::HistogramData::LinearGenerator edges(1000.0 + 100.0 * global,
+                                                       100.0);
+    ws->setHistogram(i, BinEdges(11, edges), Counts(10, global + 1.0));
+  }
+  ws->getAxis(0)->unit() = UnitFactory::Instance().create("TOF");
+
+  auto alg = ParallelTestHelpers::create<ConvertUnits>(comm);
+  alg->setProperty("InputWorkspace", ws);
+  alg->setProperty("Target", "dSpacing");
+  alg->setProperty("AlignBins", true);
+  TS_ASSERT_THROWS_NOTHING(alg->execute());
+  return alg->getProperty("OutputWorkspace");
+}
+
+void run_align_bins_distributed(const Mantid::Parallel::Communicator &comm) {
+  const auto expected =
+      run_align_bins(comm, Mantid::Parallel::StorageMode::Cloned);
+  const auto out =
+      run_align_bins(comm, Mantid::Parallel::StorageMode::Distributed);
+  TS_ASSERT_EQUALS(out->storageMode(),
+                   Mantid::Parallel::StorageMode::Distributed);
+  // The bins of all ranks cover the range of all spectra
+  const auto &indexInfo = out->indexInfo();
+  for (size_t i = 0; i < out->getNumberHistograms(); ++i) {
+    const auto global =
+        static_cast<size_t>(static_cast<int>(indexInfo.spectrumNumber(i)) - 1);
+    TS_ASSERT_EQUALS(out->x(i).rawData(), expected->x(global).rawData());
+    TS_ASSERT_EQUALS(out->y(i).rawData(), expected->y(global).rawData());
+    TS_ASSERT_EQUALS(out->e(i).rawData(), expected->e(global).rawData());
+  }
+}
 }
 
 class ConvertUnitsTest : public CxxTest::TestSuite {
@@ -816,6 +867,10 @@ public:
     AnalysisDataService::Instance().remove(wsName);
   }
 
+  void test_parallel_distributed_align_bins() {
+    ParallelTestHelpers::runParallel(run_align_bins_distributed);
+  }
+
 private:
   ConvertUnits alg;
   std::string inputSpace;
@@ -10,9 +10,15 @@
 #include "MantidDataHandling/LoadNexus.h"
 #include "MantidDataHandling/LoadRaw3.h"
 #include "MantidDataObjects/EventWorkspace.h"
+#include "MantidDataObjects/GroupingWorkspace.h"
+#include "MantidDataObjects/WorkspaceCreation.h"
+#include "MantidIndexing/IndexInfo.h"
 #include "MantidKernel/UnitFactory.h"
 #include <cxxtest/TestSuite.h>
 #include "MantidKernel/cow_ptr.h"
+#include "MantidTestHelpers/ComponentCreationHelper.h"
+#include "MantidTestHelpers/ParallelAlgorithmCreation.h"
+#include "MantidTestHelpers/ParallelRunner.h"
 #include "MantidTestHelpers/WorkspaceCreationHelper.h"
 #include "MantidAPI/FrameworkManager.h"
 
@@ -24,6 +30,65 @@ using namespace Mantid::Algorithms;
 using namespace Mantid::DataObjects;
 using Mantid::HistogramData::BinEdges;
 
+namespace {
+/// Focus a workspace with one spectrum per detector of a cylindrical test
+/// instrument into two groups, one per bank. The spectra have different
+/// d-spacing ranges and their counts are given by the global index.
+MatrixWorkspace_sptr run_focus(const Parallel::Communicator &comm,
+                               const Parallel::StorageMode storageMode) {
+  // 2 banks of 9 detectors
+  auto instrument = ComponentCreationHelper::createTestInstrumentCylindrical(2);
+  const size_t numSpectra = 18;
+  Indexing::IndexInfo indexInfo(numSpectra, storageMode, comm);
+  MatrixWorkspace_sptr ws =
+      create<Workspace2D>(instrument, indexInfo, BinEdges(11));
+  for (size_t i = 0; i < ws->getNumberHistograms(); ++i) {
+    const auto global =
+        static_cast<double>(static_cast<int>(indexInfo.spectrumNumber(i)) - 1);
+    const HistogramData::LinearGenerator edges(1.0 + 0.1 * global, 0.5);
+    ws->setHistogram(i, BinEdges(11, edges),
+                     HistogramData::Counts(10, global + 1.0));
+  }
+  ws->getAxis(0)->unit() = UnitFactory::Instance().create("dSpacing");
+
+  auto grouping = boost::make_shared<GroupingWorkspace>(instrument);
+  for (size_t i = 0; i < grouping->getNumberHistograms(); ++i)
+    grouping->mutableY(i)[0] = i < 9 ? 1.0 : 2.0;
+
+  auto alg = ParallelTestHelpers::create<DiffractionFocussing2>(comm);
+  alg->setProperty("InputWorkspace", ws);
+  alg->setProperty("GroupingWorkspace", grouping);
+  TS_ASSERT_THROWS_NOTHING(alg->execute());
+  return alg->getProperty("OutputWorkspace");
+}
+
+void run_focus_distributed(const Parallel::Communicator &comm) {
+  const auto expected = run_focus(comm, Parallel::StorageMode::Cloned);
+  const auto out = run_focus(comm, Parallel::StorageMode::Distributed);
+  if (comm.size() > 1)
+    TS_ASSERT_EQUALS(out->storageMode(), Parallel::StorageMode::MasterOnly);
+  if (comm.rank() != 0) {
+    TS_ASSERT_EQUALS(out->getNumberHistograms(), 0);
+    return;
+  }
+  TS_ASSERT_EQUALS(out->getNumberHistograms(), 2);
+  if (out->getNumberHistograms() != 2)
+    return;
+  for (size_t i = 0; i < 2; ++i) {
+    TS_ASSERT_EQUALS(out->getSpectrum(i).getSpectrumNo(),
+                     expected->getSpectrum(i).getSpectrumNo());
+    TS_ASSERT_EQUALS(out->getSpectrum(i).getDetectorIDs(),
+                     expected->getSpectrum(i).getDetectorIDs());
+    TS_ASSERT_EQUALS(out->x(i).rawData(), expected->x(i).rawData());
+    // The partial sums of the ranks are added in a different order
+    for (size_t j = 0; j < out->y(i).size(); ++j) {
+      TS_ASSERT_DELTA(out->y(i)[j], expected->y(i)[j], 1e-10);
+      TS_ASSERT_DELTA(out->e(i)[j], expected->e(i)[j], 1e-10);
+    }
+  }
+}
+}
+
 class DiffractionFocussing2Test : public CxxTest::TestSuite {
 public:
   void testName() { TS_ASSERT_EQUALS(focus.name(), "DiffractionFocussing"); }
@@ -237,6 +302,10 @@ public:
     }
   }
 
+  void test_parallel_distributed() {
+    ParallelTestHelpers::runParallel(run_focus_distributed);
+  }
+
 private:
   DiffractionFocussing2 focus;
 };
@@ -0,0 +1,249 @@
+#ifndef MANTID_ALGORITHMS_EVALUATEWORKSPACEEXPRESSIONTEST_H_
+#define MANTID_ALGORITHMS_EVALUATEWORKSPACEEXPRESSIONTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidAPI/AnalysisDataService.h"
+#include "MantidAPI/SpectrumInfo.h"
+#include "MantidAlgorithms/Divide.h"
+#include "MantidAlgorithms/EvaluateWorkspaceExpression.h"
+#include "MantidAlgorithms/Minus.h"
+#include "MantidAlgorithms/Multiply.h"
+#include "MantidTestHelpers/WorkspaceCreationHelper.h"
+
+using Mantid::Algorithms::EvaluateWorkspaceExpression;
+using Mantid::API::AnalysisDataService;
+using Mantid::API::MatrixWorkspace;
+using Mantid::API::MatrixWorkspace_sptr;
+
+class EvaluateWorkspaceExpressionTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static EvaluateWorkspaceExpressionTest *createSuite() {
+    return new EvaluateWorkspaceExpressionTest();
+  }
+  static void destroySuite(EvaluateWorkspaceExpressionTest *suite) {
+    delete suite;
+  }
+
+  EvaluateWorkspaceExpressionTest() {
+    auto &ads = AnalysisDataService::Instance();
+    ads.addOrReplace("a", WorkspaceCreationHelper::create2DWorkspace154(
+                              4, 5, true));
+    ads.addOrReplace("b", WorkspaceCreationHelper::create2DWorkspace123(
+                              4, 5, true));
+    ads.addOrReplace("c", WorkspaceCreationHelper::create2DWorkspaceBinned(
+                              4, 5, 1.0));
+    ads.addOrReplace("s", WorkspaceCreationHelper::
+                              createWorkspaceSingleValueWithError(4.0, 0.5));
+  }
+
+  ~EvaluateWorkspaceExpressionTest() override {
+    auto &ads = AnalysisDataService::Instance();
+    for (const auto name : {"a", "b", "c", "s"})
+      ads.remove(name);
+  }
+
+  void test_Init() {
+    EvaluateWorkspaceExpression alg;
+    TS_ASSERT_THROWS_NOTHING(alg.initialize());
+    TS_ASSERT(alg.isInitialized());
+  }
+
+  void test_expression_matches_the_binary_operations() {
+    auto &ads = AnalysisDataService::Instance();
+    Mantid::Algorithms::Minus minus;
+    auto difference = runBinaryOperation(
+        minus, ads.retrieveWS<MatrixWorkspace>("a"),
+        ads.retrieveWS<MatrixWorkspace>("b"));
+    Mantid::Algorithms::Divide divide;
+    auto ratio = runBinaryOperation(divide, difference,
+                                    ads.retrieveWS<MatrixWorkspace>("c"));
+    Mantid::Algorithms::Multiply multiply;
+    auto expected = runBinaryOperation(
+        multiply, ratio,
+        WorkspaceCreationHelper::createWorkspaceSingleValue(2.0));
+
+    auto result = evaluate("(a - b) / c * 2");
+    checkSameData(*result, *expected);
+  }
+
+  void test_single_values_and_constants_apply_to_every_bin() {
+    auto result = evaluate("-a + s * 3");
+    auto a = AnalysisDataService::Instance().retrieveWS<MatrixWorkspace>("a");
+    for (size_t i = 0; i < result->getNumberHistograms(); ++i) {
+      for (size_t j = 0; j < result->blocksize(); ++j) {
+        TS_ASSERT_DELTA(result->y(i)[j], 12.0 - a->y(i)[j], 1e-12);
+        TS_ASSERT_DELTA(result->e(i)[j],
+                        std::sqrt(a->e(i)[j] * a->e(i)[j] + 1.5 * 1.5), 1e-12);
+      }
+    }
+    TS_ASSERT_EQUALS(result->x(0).rawData(), a->x(0).rawData());
+  }
+
+  void test_operators_of_same_precedence_apply_from_left_to_right() {
+    auto result = evaluate("c - 1 - 1");
+    TS_ASSERT_DELTA(result->y(0)[0], 0.0, 1e-12);
+    result = evaluate("c / 2 * 4");
+    TS_ASSERT_DELTA(result->y(0)[0], 4.0, 1e-12);
+  }
+
+  void test_masked_spectra_are_masked_in_output() {
+    auto &ads = AnalysisDataService::Instance();
+    ads.addOrReplace("masked", WorkspaceCreationHelper::create2DWorkspace123(
+                                   4, 5, true, {1}));
+    auto result = evaluate("a + masked");
+    const auto &spectrumInfo = result->spectrumInfo();
+    TS_ASSERT(!spectrumInfo.isMasked(0));
+    TS_ASSERT(spectrumInfo.isMasked(1));
+    TS_ASSERT_EQUALS(result->y(1)[0], 0.0);
+    TS_ASSERT_EQUALS(result->e(1)[0], 0.0);
+    TS_ASSERT_DIFFERS(result->y(0)[0], 0.0);
+    ads.remove("masked");
+  }
+
+  void test_same_instance_runs_twice() {
+    EvaluateWorkspaceExpression alg;
+    setUpAlgorithm(alg, "s * 2 + a");
+    TS_ASSERT_THROWS_NOTHING(alg.execute());
+    MatrixWorkspace_sptr first = alg.getProperty("OutputWorkspace");
+    TS_ASSERT_DELTA(first->y(0)[0], 13.0, 1e-12);
+
+    alg.setPropertyValue("Expression", "c * 2");
+    TS_ASSERT_THROWS_NOTHING(alg.execute());
+    MatrixWorkspace_sptr second = alg.getProperty("OutputWorkspace");
+    TS_ASSERT_DELTA(second->y(0)[0], 4.0, 1e-12);
+  }
+
+  void test_spectra_longer_than_a_block() {
+    auto &ads = AnalysisDataService::Instance();
+    ads.addOrReplace("long_a", WorkspaceCreationHelper::create2DWorkspaceBinned(
+                                   2, 2500, 0.0, 1.0));
+    auto longB = WorkspaceCreationHelper::create2DWorkspaceBinned(2, 2500);
+    for (size_t i = 0; i < longB->getNumberHistograms(); ++i) {
+      auto &y = longB->mutableY(i);
+      for (size_t j = 0; j < y.size(); ++j)
+        y[j] = static_cast<double>(j + 1);
+    }
+    ads.addOrReplace("long_b", longB);
+
+    Mantid::Algorithms::Multiply multiply;
+    auto expected =
+        runBinaryOperation(multiply, ads.retrieveWS<MatrixWorkspace>("long_a"),
+                           ads.retrieveWS<MatrixWorkspace>("long_b"));
+    auto result = evaluate("long_a * long_b");
+    checkSameData(*result, *expected);
+    ads.remove("long_a");
+    ads.remove("long_b");
+  }
+
+  void test_workspaces_with_different_sizes_throw() {
+    AnalysisDataService::Instance().addOrReplace(
+        "small", WorkspaceCreationHelper::create2DWorkspace123(3, 5, true));
+    EvaluateWorkspaceExpression alg;
+    setUpAlgorithm(alg, "a + small");
+    TS_ASSERT_THROWS(alg.execute(), std::invalid_argument);
+    AnalysisDataService::Instance().remove("small");
+  }
+
+  void test_unknown_workspace_throws() {
+    EvaluateWorkspaceExpression alg;
+    setUpAlgorithm(alg, "a + unknown");
+    TS_ASSERT_THROWS(alg.execute(), std::invalid_argument);
+  }
+
+  void test_unsupported_operator_throws() {
+    EvaluateWorkspaceExpression alg;
+    setUpAlgorithm(alg, "a ^ 2");
+    TS_ASSERT_THROWS(alg.execute(), std::invalid_argument);
+  }
+
+  void test_expression_without_workspace_throws() {
+    EvaluateWorkspaceExpression alg;
+    setUpAlgorithm(alg, "1 + 2");
+    TS_ASSERT_THROWS(alg.execute(), std::invalid_argument);
+  }
+
+private:
+  void setUpAlgorithm(EvaluateWorkspaceExpression &alg,
+                      const std::string &expression) {
+    alg.setChild(true);
+    alg.setRethrows(true);
+    alg.initialize();
+    alg.setPropertyValue("Expression", expression);
+    alg.setPropertyValue("OutputWorkspace", "_unused_for_child");
+  }
+
+  MatrixWorkspace_sptr evaluate(const std::string &expression) {
+    EvaluateWorkspaceExpression alg;
+    setUpAlgorithm(alg, expression);
+    TS_ASSERT_THROWS_NOTHING(alg.execute());
+    return alg.getProperty("OutputWorkspace");
+  }
+
+  MatrixWorkspace_sptr runBinaryOperation(Mantid::API::Algorithm &alg,
+                                          MatrixWorkspace_sptr lhs,
+                                          MatrixWorkspace_sptr rhs) {
+    alg.setChild(true);
+    alg.setRethrows(true);
+    alg.initialize();
+    alg.setProperty("LHSWorkspace", lhs);
+    alg.setProperty("RHSWorkspace", rhs);
+    alg.setPropertyValue("OutputWorkspace", "_unused_for_child");
+    alg.execute();
+    return alg.getProperty("OutputWorkspace");
+  }
+
+  void checkSameData(const MatrixWorkspace &result,
+                     const MatrixWorkspace &expected) {
+    TS_ASSERT_EQUALS(result.getNumberHistograms(),
+                     expected.getNumberHistograms());
+    TS_ASSERT_EQUALS(result.blocksize(), expected.blocksize());
+    for (size_t i = 0; i < result.getNumberHistograms(); ++i) {
+      TS_ASSERT_EQUALS(result.x(i).rawData(), expected.x(i).rawData());
+      for (size_t j = 0; j < result.blocksize(); ++j) {
+        TS_ASSERT_DELTA(result.y(i)[j], expected.y(i)[j], 1e-12);
+        TS_ASSERT_DELTA(result.e(i)[j], expected.e(i)[j], 1e-12);
+      }
+    }
+  }
+};
+
+class EvaluateWorkspaceExpressionTestPerformance : public CxxTest::TestSuite {
+public:
+  static EvaluateWorkspaceExpressionTestPerformance *createSuite() {
+    return new EvaluateWorkspaceExpressionTestPerformance();
+  }
+  static void destroySuite(EvaluateWorkspaceExpressionTestPerformance *suite) {
+    delete suite;
+  }
+
+  EvaluateWorkspaceExpressionTestPerformance() {
+    auto &ads = AnalysisDataService::Instance();
+    ads.addOrReplace("perf_a", WorkspaceCreationHelper::create2DWorkspace154(
+                                   10000, 1000, true));
+    ads.addOrReplace("perf_b", WorkspaceCreationHelper::create2DWorkspace123(
+                                   10000, 1000, true));
+    ads.addOrReplace("perf_c",
+                     WorkspaceCreationHelper::create2DWorkspaceBinned(
+                         10000, 1000, 1.0));
+  }
+
+  ~EvaluateWorkspaceExpressionTestPerformance() override {
+    auto &ads = AnalysisDataService::Instance();
+    for (const auto name : {"perf_a", "perf_b", "perf_c"})
+      ads.remove(name);
+  }
+
+  void test_normalisation_expression() {
+    EvaluateWorkspaceExpression alg;
+    alg.setChild(true);
+    alg.initialize();
+    alg.setPropertyValue("Expression", "(perf_a - perf_b) / perf_c * 2");
+    alg.setPropertyValue("OutputWorkspace", "_unused_for_child");
+    TS_ASSERT_THROWS_NOTHING(alg.execute());
+  }
+};
+
+#endif /* MANTID_ALGORITHMS_EVALUATEWORKSPACEEXPRESSIONTEST_H_ */
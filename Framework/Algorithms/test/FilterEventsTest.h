@@ -7,6 +7,7 @@
 #include "MantidAPI/SpectrumInfo.h"
 #include "MantidAPI/TableRow.h"
 #include "MantidAlgorithms/FilterEvents.h"
+#include "MantidDataHandling/LoadNexusProcessed.h"
 #include "MantidDataObjects/TableWorkspace.h"
 #include "MantidDataObjects/EventList.h"
 #include "MantidDataObjects/EventWorkspace.h"
@@ -17,6 +18,9 @@
 #include "MantidKernel/TimeSeriesProperty.h"
 #include "MantidTestHelpers/WorkspaceCreationHelper.h"
 
+#include <Poco/File.h>
+#include <Poco/Path.h>
+
 #include <random>
 
 using namespace Mantid;
@@ -954,6 +958,90 @@ public:
     return;
   }
 
+  //----------------------------------------------------------------------------------------------
+  /** Filter events in several passes, saving the output workspaces to files
+    * instead of keeping them all in memory
+    */
+  void test_FilterToDirectoryInPasses() {
+    int64_t runstart_i64 = 20000000000;
+    int64_t pulsedt = 100 * 1000 * 1000;
+    int64_t tofdt = 10 * 1000 * 1000;
+    size_t numpulses = 5;
+
+    EventWorkspace_sptr inpWS =
+        createEventWorkspace(runstart_i64, pulsedt, tofdt, numpulses);
+    AnalysisDataService::Instance().addOrReplace("Test12", inpWS);
+
+    SplittersWorkspace_sptr splws =
+        createSplittersWorkspace(runstart_i64, pulsedt, tofdt);
+    AnalysisDataService::Instance().addOrReplace("Splitter12", splws);
+
+    const std::string directory = Poco::Path::temp();
+
+    FilterEvents filter;
+    filter.initialize();
+    filter.setProperty("InputWorkspace", "Test12");
+    filter.setProperty("OutputWorkspaceBaseName", "FilteredWS12");
+    filter.setProperty("SplitterWorkspace", "Splitter12");
+    filter.setProperty("OutputWorkspaceIndexedFrom1", true);
+    filter.setProperty("OutputDirectory", directory);
+    filter.setProperty("OutputWorkspacesPerPass", 1);
+
+    TS_ASSERT_THROWS_NOTHING(filter.execute());
+    TS_ASSERT(filter.isExecuted());
+
+    // Same outputs as test_FilterWOCorrection2, but in files
+    int numsplittedws = filter.getProperty("NumberOutputWS");
+    TS_ASSERT_EQUALS(numsplittedws, 3);
+    std::vector<std::string> outputwsnames =
+        filter.getProperty("OutputWorkspaceNames");
+    TS_ASSERT_EQUALS(outputwsnames.size(), 3);
+    const std::vector<size_t> numevents{4, 16, 21};
+    for (size_t i = 0; i < outputwsnames.size(); ++i) {
+      TS_ASSERT(!AnalysisDataService::Instance().doesExist(outputwsnames[i]));
+      const std::string filename =
+          Poco::Path(Poco::Path(directory), outputwsnames[i] + ".nxs")
+              .toString();
+      TS_ASSERT(Poco::File(filename).exists());
+
+      Mantid::DataHandling::LoadNexusProcessed load;
+      load.initialize();
+      load.setChild(true);
+      load.setPropertyValue("Filename", filename);
+      load.setPropertyValue("OutputWorkspace", "_unused_for_child");
+      TS_ASSERT_THROWS_NOTHING(load.execute());
+      Workspace_sptr loaded = load.getProperty("OutputWorkspace");
+      auto loadedws = boost::dynamic_pointer_cast<EventWorkspace>(loaded);
+      TS_ASSERT(loadedws);
+      if (loadedws)
+        TS_ASSERT_EQUALS(loadedws->getSpectrum(i == 0 ? 0 : 1)
+                             .getNumberEvents(),
+                         numevents[i]);
+      Poco::File(filename).remove();
+    }
+
+    AnalysisDataService::Instance().remove("Test12");
+    AnalysisDataService::Instance().remove("Splitter12");
+  }
+
+  void test_PassesRequireOutputDirectory() {
+    EventWorkspace_sptr inpWS =
+        createEventWorkspace(20000000000, 100000000, 10000000, 5);
+    SplittersWorkspace_sptr splws =
+        createSplittersWorkspace(20000000000, 100000000, 10000000);
+
+    FilterEvents filter;
+    filter.initialize();
+    filter.setRethrows(true);
+    filter.setProperty("InputWorkspace", inpWS);
+    filter.setProperty("OutputWorkspaceBaseName", "FilteredWS13");
+    filter.setProperty("SplitterWorkspace", splws);
+    filter.setProperty("OutputWorkspacesPerPass", 2);
+
+    TS_ASSERT_THROWS(filter.execute(), std::runtime_error);
+    TS_ASSERT(!filter.isExecuted());
+  }
+
   //----------------------------------------------------------------------------------------------
   /** Create an EventWorkspace.  This workspace has
     * @param runstart_i64 : absolute run start time in int64_t format with unit
@@ -8,6 +8,7 @@
 #include "MantidGeometry/Instrument/SampleEnvironment.h"
 #include "MantidGeometry/Objects/ShapeFactory.h"
 #include "MantidKernel/Material.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/PhysicalConstants.h"
 #include "MantidKernel/UnitFactory.h"
 
@@ -214,6 +215,49 @@ public:
     TS_ASSERT_DELTA(2.8600668e-05, outputWS->y(0).back(), delta);
   }
 
+  void test_Independent_Streams_Do_Not_Depend_On_Number_Of_Threads() {
+    using Mantid::Kernel::DeltaEMode;
+    TestWorkspaceDescriptor wsProps = {5, 10, Environment::SampleOnly,
+                                       DeltaEMode::Elastic, -1, -1};
+    auto inputWS = setUpWS(wsProps);
+
+    const int maxThreads = PARALLEL_GET_MAX_THREADS;
+    PARALLEL_SET_NUM_THREADS(1);
+    auto serialWS = runIndependentStreams(inputWS);
+    PARALLEL_SET_NUM_THREADS(maxThreads);
+    auto parallelWS = runIndependentStreams(inputWS);
+
+    verifyDimensions(wsProps, parallelWS);
+    for (size_t i = 0; i < parallelWS->getNumberHistograms(); ++i) {
+      TS_ASSERT_EQUALS(serialWS->y(i).rawData(), parallelWS->y(i).rawData());
+      for (const auto y : parallelWS->y(i)) {
+        TS_ASSERT(y > 0.0 && y < 1.0);
+      }
+    }
+    // Each spectrum has its own streams
+    TS_ASSERT_DIFFERS(parallelWS->y(0).front(), parallelWS->y(1).front());
+  }
+
+  void test_Independent_Streams_With_Interpolation() {
+    using Mantid::Kernel::DeltaEMode;
+    TestWorkspaceDescriptor wsProps = {2, 10, Environment::SampleOnly,
+                                       DeltaEMode::Indirect, -1, -1};
+    auto mcabs = createAlgorithm();
+    TS_ASSERT_THROWS_NOTHING(
+        mcabs->setProperty("InputWorkspace", setUpWS(wsProps)));
+    mcabs->setProperty("NumberOfWavelengthPoints", 3);
+    mcabs->setProperty("IndependentRandomStreams", true);
+    mcabs->execute();
+    auto outputWS = getOutputWorkspace(mcabs);
+
+    verifyDimensions(wsProps, outputWS);
+    for (size_t i = 0; i < outputWS->getNumberHistograms(); ++i) {
+      for (const auto y : outputWS->y(i)) {
+        TS_ASSERT(y > 0.0 && y < 1.0);
+      }
+    }
+  }
+
   //---------------------------------------------------------------------------
   // Failure cases
   //---------------------------------------------------------------------------
@@ -331,6 +375,15 @@ private:
     return getOutputWorkspace(mcabs);
   }
 
+  Mantid::API::MatrixWorkspace_const_sptr
+  runIndependentStreams(const Mantid::API::MatrixWorkspace_sptr &inputWS) {
+    auto mcabs = createAlgorithm();
+    TS_ASSERT_THROWS_NOTHING(mcabs->setProperty("InputWorkspace", inputWS));
+    mcabs->setProperty("IndependentRandomStreams", true);
+    mcabs->execute();
+    return getOutputWorkspace(mcabs);
+  }
+
   Mantid::API::IAlgorithm_sptr createAlgorithm() {
     using Mantid::API::IAlgorithm;
     using Mantid::Algorithms::MonteCarloAbsorption;
@@ -407,6 +460,15 @@ public:
     alg.execute();
   }
 
+  void test_exec_sample_elastic_independent_streams() {
+    Mantid::Algorithms::MonteCarloAbsorption alg;
+    alg.initialize();
+    alg.setProperty("InputWorkspace", inputElastic);
+    alg.setProperty("IndependentRandomStreams", true);
+    alg.setPropertyValue("OutputWorkspace", "__unused_on_child");
+    alg.execute();
+  }
+
 private:
   Mantid::API::Workspace_sptr inputElastic;
   Mantid::API::Workspace_sptr inputDirect;
@@ -103,6 +103,48 @@ public:
     doTestScaleWithDx("Add", outputWorkspaceIsInputWorkspace);
   }
 
+  void test_add_leaves_errors_shared_with_input() {
+    using namespace Mantid::API;
+
+    MatrixWorkspace_sptr in =
+        WorkspaceCreationHelper::create2DWorkspace123(3, 10);
+    Mantid::Algorithms::Scale scale2;
+    scale2.initialize();
+    scale2.setChild(true);
+    scale2.setProperty("InputWorkspace", in);
+    scale2.setPropertyValue("OutputWorkspace", "unused");
+    scale2.setProperty("Factor", 2.0);
+    scale2.setProperty("Operation", "Add");
+    TS_ASSERT_THROWS_NOTHING(scale2.execute());
+    MatrixWorkspace_sptr result = scale2.getProperty("OutputWorkspace");
+
+    testScaleFactorApplied(in, result, 2.0, false); // multiply=false
+    for (size_t i = 0; i < result->getNumberHistograms(); ++i) {
+      TS_ASSERT_EQUALS(result->sharedE(i), in->sharedE(i));
+    }
+  }
+
+  void test_multiply_in_place_leaves_clone_unchanged() {
+    using namespace Mantid::API;
+
+    auto in = WorkspaceCreationHelper::create2DWorkspace123(3, 10);
+    MatrixWorkspace_const_sptr original = in->clone();
+    AnalysisDataService::Instance().add("toscale", in);
+    Mantid::Algorithms::Scale scale2;
+    scale2.initialize();
+    scale2.setPropertyValue("InputWorkspace", "toscale");
+    scale2.setPropertyValue("OutputWorkspace", "toscale");
+    scale2.setProperty("Factor", 2.5);
+    TS_ASSERT_THROWS_NOTHING(scale2.execute());
+    auto result =
+        AnalysisDataService::Instance().retrieveWS<MatrixWorkspace>("toscale");
+
+    testScaleFactorApplied(original, result, 2.5, true); // multiply=true
+    TS_ASSERT_EQUALS(original->y(0)[0], 2.0);
+    TS_ASSERT_EQUALS(original->e(0)[0], 3.0);
+    AnalysisDataService::Instance().remove("toscale");
+  }
+
 private:
   void testScaleFactorApplied(
       const Mantid::API::MatrixWorkspace_const_sptr &inputWS,
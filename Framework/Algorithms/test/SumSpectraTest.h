@@ -1,12 +1,18 @@
 #ifndef SUMSPECTRATEST_H_
 #define SUMSPECTRATEST_H_
 
+#include "MantidAlgorithms/CreateWorkspace.h"
 #include "MantidAlgorithms/SumSpectra.h"
 #include "MantidAPI/AnalysisDataService.h"
 #include "MantidAPI/SpectrumInfo.h"
 #include "MantidAPI/WorkspaceFactory.h"
+#include "MantidDataObjects/RebinnedOutput.h"
 #include "MantidDataObjects/Workspace2D.h"
+#include "MantidDataObjects/WorkspaceCreation.h"
 #include "MantidGeometry/Instrument/ParameterMap.h"
+#include "MantidIndexing/IndexInfo.h"
+#include "MantidTestHelpers/ParallelAlgorithmCreation.h"
+#include "MantidTestHelpers/ParallelRunner.h"
 #include "MantidTestHelpers/WorkspaceCreationHelper.h"
 #include <boost/lexical_cast.hpp>
 #include <cxxtest/TestSuite.h>
@@ -17,6 +23,80 @@ using namespace Mantid;
 using namespace Mantid::API;
 using namespace Mantid::DataObjects;
 
+namespace {
+void run_sum_spectra(const Parallel::Communicator &comm,
+                     const std::string &storageMode) {
+  // One bin per spectrum, with the counts given by the spectrum number
+  const int nspec = 100;
+  std::vector<double> dataX, dataY, dataE;
+  for (int i = 0; i < nspec; ++i) {
+    dataX.insert(dataX.end(), {1.0, 2.0});
+    dataY.push_back(static_cast<double>(i + 1));
+    dataE.push_back(1.0);
+  }
+  auto create = ParallelTestHelpers::create<Algorithms::CreateWorkspace>(comm);
+  create->setProperty<int>("NSpec", nspec);
+  create->setProperty<std::vector<double>>("DataX", dataX);
+  create->setProperty<std::vector<double>>("DataY", dataY);
+  create->setProperty<std::vector<double>>("DataE", dataE);
+  create->setProperty("ParallelStorageMode", storageMode);
+  create->execute();
+  MatrixWorkspace_sptr ws = create->getProperty("OutputWorkspace");
+
+  auto sum = ParallelTestHelpers::create<Algorithms::SumSpectra>(comm);
+  sum->setProperty("InputWorkspace", ws);
+  sum->setProperty("StartWorkspaceIndex", 2);
+  sum->setProperty("EndWorkspaceIndex", 10);
+  sum->setProperty("ListOfWorkspaceIndices", "50");
+  TS_ASSERT_THROWS_NOTHING(sum->execute());
+  MatrixWorkspace_const_sptr out = sum->getProperty("OutputWorkspace");
+  const bool distributed =
+      comm.size() > 1 &&
+      Parallel::fromString(storageMode) == Parallel::StorageMode::Distributed;
+  if (distributed)
+    TS_ASSERT_EQUALS(out->storageMode(), Parallel::StorageMode::MasterOnly);
+  if (comm.rank() == 0 || !distributed) {
+    TS_ASSERT_EQUALS(out->getNumberHistograms(), 1);
+    // Spectra 3 to 11 and 51
+    TS_ASSERT_EQUALS(out->y(0)[0], 114.0);
+    TS_ASSERT_DELTA(out->e(0)[0], std::sqrt(10.0), 1e-12);
+    TS_ASSERT_EQUALS(out->getSpectrum(0).getSpectrumNo(), 3);
+    TS_ASSERT_EQUALS(out->run().getPropertyValueAsType<int>("NumAllSpectra"),
+                     10);
+  } else {
+    TS_ASSERT_EQUALS(out->getNumberHistograms(), 0);
+  }
+}
+
+void run_sum_spectra_ranks_without_spectra(const Parallel::Communicator &comm) {
+  // A single spectrum, so all but the master rank hold no spectra
+  MatrixWorkspace_sptr ws = create<Workspace2D>(
+      Indexing::IndexInfo(1, Parallel::StorageMode::Distributed, comm),
+      HistogramData::Histogram(HistogramData::BinEdges{1.0, 2.0, 3.0},
+                               HistogramData::Counts{2.0, 3.0}));
+  auto sum = ParallelTestHelpers::create<Algorithms::SumSpectra>(comm);
+  sum->setProperty("InputWorkspace", ws);
+  TS_ASSERT_THROWS_NOTHING(sum->execute());
+  MatrixWorkspace_const_sptr out = sum->getProperty("OutputWorkspace");
+  if (comm.rank() == 0) {
+    TS_ASSERT_EQUALS(out->getNumberHistograms(), 1);
+    TS_ASSERT_EQUALS(out->y(0)[0], 2.0);
+    TS_ASSERT_EQUALS(out->y(0)[1], 3.0);
+    TS_ASSERT_EQUALS(out->getSpectrum(0).getSpectrumNo(), 1);
+  }
+}
+
+void run_rebinned_output_distributed(const Parallel::Communicator &comm) {
+  MatrixWorkspace_sptr ws = create<RebinnedOutput>(
+      Indexing::IndexInfo(10, Parallel::StorageMode::Distributed, comm),
+      HistogramData::BinEdges{1.0, 2.0, 3.0});
+  auto sum = ParallelTestHelpers::create<Algorithms::SumSpectra>(comm);
+  sum->setProperty("InputWorkspace", ws);
+  // The fractional areas are not combined across ranks
+  TS_ASSERT_THROWS(sum->execute(), std::runtime_error);
+}
+}
+
 class SumSpectraTest : public CxxTest::TestSuite {
 public:
   static SumSpectraTest *createSuite() { return new SumSpectraTest(); }
@@ -508,6 +588,24 @@ public:
     AnalysisDataService::Instance().remove(outWsName);
   }
 
+  void test_parallel_cloned() {
+    ParallelTestHelpers::runParallel(run_sum_spectra,
+                                     "Parallel::StorageMode::Cloned");
+  }
+
+  void test_parallel_distributed() {
+    ParallelTestHelpers::runParallel(run_sum_spectra,
+                                     "Parallel::StorageMode::Distributed");
+  }
+
+  void test_parallel_distributed_rebinned_output_is_rejected() {
+    ParallelTestHelpers::runParallel(run_rebinned_output_distributed);
+  }
+
+  void test_parallel_ranks_without_spectra() {
+    ParallelTestHelpers::runParallel(run_sum_spectra_ranks_without_spectra);
+  }
+
 private:
   int nTestHist;
   Mantid::Algorithms::SumSpectra alg; // Test with range limits
@@ -6,6 +6,7 @@
 //----------------------------------------------------------------------
 #include "MantidAPI/Algorithm.h"
 #include "MantidAPI/IFunction.h"
+#include "MantidAPI/ITableWorkspace_fwd.h"
 
 namespace Mantid {
 namespace CurveFitting {
@@ -78,6 +79,15 @@ class DLLExport PlotPeakByLogValue : public API::Algorithm {
     std::vector<int> indx; ///< a list of ws indices to fit if i and spec < 0
   };
 
+  /** A spectrum to fit
+    */
+  struct SpectrumToFit {
+    size_t input;    ///< Index of the InputData of the spectrum
+    int wsIndex;     ///< Workspace index of the spectrum
+    double logValue; ///< The value to plot the parameters against
+    API::MatrixWorkspace_sptr ws; ///< The workspace of the spectrum
+  };
+
 public:
   /// Algorithm's name for identification overriding a virtual method
   const std::string name() const override { return "PlotPeakByLogValue"; }
@@ -105,6 +115,23 @@ private:
   /// Create a list of input workspace names
   std::vector<InputData> makeNames() const;
 
+  /// Create the list of spectra to fit
+  std::vector<SpectrumToFit> makeSpectra(const std::vector<InputData> &inputs,
+                                         const std::string &logName);
+
+  /// Check if the spectra can be fitted without the Fit algorithm
+  bool canFitInBatch(const API::IFunction &function);
+
+  /// Fit the spectra with a BatchFitter
+  void fitInBatch(API::IFunction_sptr function,
+                  const std::vector<SpectrumToFit> &spectra,
+                  const std::vector<double> &initialParams,
+                  API::ITableWorkspace &result);
+
+  /// Write the results of a fit to the output table
+  void setResultRow(API::ITableWorkspace &result, size_t row,
+                    const API::IFunction &function, double chi2) const;
+
   /// Create a minimizer string based on template string provided
   std::string getMinimizerString(const std::string &wsName,
                                  const std::string &wsIndex);
@@ -0,0 +1,83 @@
+#ifndef MANTID_CURVEFITTING_BATCHFITTER_H_
+#define MANTID_CURVEFITTING_BATCHFITTER_H_
+
+#include "MantidAPI/IFunction.h"
+#include "MantidAPI/MatrixWorkspace_fwd.h"
+#include "MantidKernel/System.h"
+
+#include <string>
+
+namespace Mantid {
+namespace CurveFitting {
+
+/** BatchFitter : Fits a function to spectra of matrix workspaces without
+  running Fit as a child algorithm.
+
+  Creating, initializing and executing a Fit algorithm for every spectrum
+  dominates the time of sequential fits of many small spectra. A BatchFitter
+  is set up once with the options common to all the fits and then fits the
+  function it is given to one spectrum at a time, in the same way as Fit with
+  default options does. The fitted parameters and their errors are left in
+  the function. fit() does not change the fitter, so several threads may use
+  one fitter as long as each of them fits its own copy of the function.
+
+  Copyright &copy; 2017 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class DLLExport BatchFitter {
+public:
+  /// The outcome of a fit
+  struct Result {
+    /// The cost function divided by the degrees of freedom
+    double chi2OverDoF = 0.0;
+    /// Number of iterations of the minimizer
+    size_t iterations = 0;
+    /// "success" or the reason the fit failed
+    std::string status;
+  };
+
+  BatchFitter(const std::string &minimizer, const std::string &costFunction,
+              size_t maxIterations);
+  /// Fit only the data between startX and endX (EMPTY_DBL for no limit)
+  void setRange(double startX, double endX);
+  /// Set the peak radius passed to the peak functions (0 for no limit)
+  void setPeakRadius(int peakRadius) { m_peakRadius = peakRadius; }
+
+  Result fit(API::IFunction_sptr function, API::MatrixWorkspace_sptr workspace,
+             size_t workspaceIndex) const;
+
+  static bool canFit(const API::IFunction &function);
+
+private:
+  /// Minimizer name followed by its options
+  const std::string m_minimizer;
+  /// Name of the cost function
+  const std::string m_costFunction;
+  const size_t m_maxIterations;
+  double m_startX;
+  double m_endX;
+  int m_peakRadius = 0;
+};
+
+} // namespace CurveFitting
+} // namespace Mantid
+
+#endif /* MANTID_CURVEFITTING_BATCHFITTER_H_ */
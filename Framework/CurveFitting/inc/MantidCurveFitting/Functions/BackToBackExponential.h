@@ -70,6 +70,7 @@ public:
   /// overwrite IFunction base class methods
   std::string name() const override { return "BackToBackExponential"; }
   const std::string category() const override { return "Peak"; }
+  bool isThreadSafe() const override { return true; }
   void function1D(double *out, const double *xValues,
                   const size_t nData) const override;
   void functionDeriv1D(API::Jacobian *jacobian, const double *xValues,
@@ -7,6 +7,7 @@
 #include "MantidAPI/CompositeFunction.h"
 #include <boost/shared_array.hpp>
 #include <cmath>
+#include <memory>
 #include <vector>
 
 namespace Mantid {
@@ -140,8 +141,8 @@ public:
   /// Set up the function for a fit.
   void setUpForFit() override;
 
-  /// Deletes and zeroes pointer m_resolution forsing function(...) to
-  /// recalculate the resolution function
+  /// Clears m_resolution, forcing function(...) to recalculate the resolution
+  /// function, if the parameters of the resolution have changed
   void refreshResolution() const;
 
 protected:
@@ -149,10 +150,28 @@ protected:
   void init() override;
 
 private:
+  struct FFTPlan;
+  /// The FFT tables and workspace for a domain size
+  FFTPlan &fftPlan(size_t nData) const;
+  /// Calculate the Fourier transform of the resolution unless it is cached
+  void transformResolution(const double *xValues, size_t nData) const;
+  /// Convolve the values of a model with the resolution in place
+  void convolve(double *values, const double *xValues, size_t nData) const;
+
   /// Keep the Fourier transform of the resolution function (divided by the
   /// step in xValues) when in FFT mode, and the inverted resolution if in
   /// Direct mode
   mutable std::vector<double> m_resolution;
+  /// The size and range of the domain the transform in m_resolution is for,
+  /// empty if m_resolution does not hold a transform
+  mutable std::vector<double> m_resolutionDomain;
+  /// The parameters of the resolution function m_resolution was calculated
+  /// with
+  mutable std::vector<double> m_resolutionParameters;
+  /// The resolution function m_resolution was calculated with
+  mutable const API::IFunction *m_resolutionFunction = nullptr;
+  /// FFT tables and workspace, reused while the size of the domain is the same
+  mutable std::shared_ptr<FFTPlan> m_fftPlan;
 };
 
 } // namespace Functions
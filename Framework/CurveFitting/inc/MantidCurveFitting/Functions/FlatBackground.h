@@ -36,6 +36,7 @@ namespace Functions {
 class DLLExport FlatBackground : public BackgroundFunction {
 public:
   std::string name() const override;
+  bool isThreadSafe() const override { return true; }
   void function1D(double *out, const double *xValues,
                   const size_t nData) const override;
   void functionDeriv1D(API::Jacobian *out, const double *xValues,
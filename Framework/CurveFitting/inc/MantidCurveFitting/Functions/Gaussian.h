@@ -69,6 +69,7 @@ public:
   /// overwrite IFunction base class methods
   std::string name() const override { return "Gaussian"; }
   const std::string category() const override { return "Peak"; }
+  bool isThreadSafe() const override { return true; }
   void setActiveParameter(size_t i, double value) override;
   double activeParameter(size_t i) const override;
 
@@ -64,6 +64,7 @@ public:
   /// overwrite IFunction base class methods
   std::string name() const override { return "Lorentzian"; }
   const std::string category() const override { return "Peak"; }
+  bool isThreadSafe() const override { return true; }
 
 protected:
   void functionLocal(double *out, const double *xValues,
@@ -4,9 +4,11 @@
 //----------------------------------------------------------------------
 // Includes
 //----------------------------------------------------------------------
+#include "MantidAPI/CompiledExpression.h"
 #include "MantidAPI/ParamFunction.h"
 #include "MantidAPI/IFunction1D.h"
 #include <boost/shared_array.hpp>
+#include <memory>
 
 namespace mu {
 class Parser;
@@ -54,6 +56,8 @@ public:
   std::string name() const override { return "UserFunction"; }
   // Returns Category
   const std::string category() const override { return "General"; }
+  /// A compiled formula keeps no state during the evaluation
+  bool isThreadSafe() const override { return m_compiled != nullptr; }
 
   /// Function you want to fit to.
   void function1D(double *out, const double *xValues,
@@ -61,6 +65,9 @@ public:
   /// Derivatives of function with respect to active parameters
   void functionDeriv(const API::FunctionDomain &domain,
                      API::Jacobian &jacobian) override;
+  /// Derivatives of the compiled formula
+  void functionDeriv1D(API::Jacobian *out, const double *xValues,
+                       const size_t nData) override;
 
   /// Returns the number of attributes associated with the function
   size_t nAttributes() const override { return 1; }
@@ -89,11 +96,18 @@ private:
   mutable double m_x;
   /// True indicates that input formula contains 'x' variable
   bool m_x_set;
+  /// The formula compiled for fast evaluation, if it is supported
+  std::unique_ptr<API::CompiledExpression> m_compiled;
+  /// Derivatives of the compiled formula with respect to the parameters
+  std::vector<API::CompiledExpression> m_derivatives;
   /// Temporary data storage used in functionDeriv
   mutable boost::shared_array<double> m_tmp;
   /// Temporary data storage used in functionDeriv
   mutable boost::shared_array<double> m_tmp1;
 
+  /// Values of x and the parameters for the compiled formula
+  std::vector<API::CompiledExpression::Argument>
+  arguments(const double *xValues) const;
   /// mu::Parser callback function for setting variables.
   static double *AddVariable(const char *varName, void *pufun);
 };
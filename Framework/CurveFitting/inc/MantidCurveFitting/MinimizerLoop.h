@@ -0,0 +1,69 @@
+#ifndef MANTID_CURVEFITTING_MINIMIZERLOOP_H_
+#define MANTID_CURVEFITTING_MINIMIZERLOOP_H_
+
+#include "MantidAPI/IFuncMinimizer.h"
+#include "MantidKernel/System.h"
+
+#include <functional>
+#include <string>
+
+namespace Mantid {
+namespace API {
+class IFunction;
+}
+namespace Kernel {
+class ProgressBase;
+}
+namespace CurveFitting {
+namespace CostFunctions {
+class CostFuncFitting;
+}
+
+/** MinimizerLoop : The steps of a fit shared by the Fit algorithm and
+  BatchFitter: iterating the minimizer, describing how the fit ended and
+  normalising the cost function by the degrees of freedom.
+
+  Copyright &copy; 2017 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+namespace MinimizerLoop {
+
+/// Re-create the cost function and the minimizer for the remaining iterations
+/// after the function changed its parameters during an iteration
+using Recovery = std::function<void(size_t)>;
+
+/// Iterate a minimizer until it finishes or the iteration limit is reached
+DLLExport size_t run(API::IFunction &function,
+                     API::IFuncMinimizer_sptr &minimizer, size_t maxIterations,
+                     const Recovery &recover,
+                     Kernel::ProgressBase *progress = nullptr);
+/// Finalize a minimizer and return "success" or the reason the fit failed
+DLLExport std::string finalize(API::IFuncMinimizer &minimizer,
+                               size_t nIterations, size_t maxIterations);
+/// The cost function value divided by the degrees of freedom
+DLLExport double chi2OverDoF(const CostFunctions::CostFuncFitting &costFunction,
+                             double costFunctionValue);
+
+} // namespace MinimizerLoop
+} // namespace CurveFitting
+} // namespace Mantid
+
+#endif /* MANTID_CURVEFITTING_MINIMIZERLOOP_H_ */
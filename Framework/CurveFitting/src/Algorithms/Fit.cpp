@@ -3,8 +3,8 @@
 //----------------------------------------------------------------------
 #include "MantidCurveFitting/Algorithms/Fit.h"
 #include "MantidCurveFitting/CostFunctions/CostFuncFitting.h"
+#include "MantidCurveFitting/MinimizerLoop.h"
 
-#include "MantidAPI/CompositeFunction.h"
 #include "MantidAPI/FuncMinimizerFactory.h"
 #include "MantidAPI/IFuncMinimizer.h"
 #include "MantidAPI/ITableWorkspace.h"
@@ -13,7 +13,6 @@
 #include "MantidAPI/WorkspaceFactory.h"
 
 #include "MantidKernel/BoundedValidator.h"
-#include "MantidKernel/Exception.h"
 #include "MantidKernel/StartsWithValidator.h"
 
 #include <boost/make_shared.hpp>
@@ -154,61 +153,17 @@ size_t Fit::runMinimizer() {
   auto prog = boost::make_shared<API::Progress>(this, 0.0, 1.0, nsteps);
   m_function->setProgressReporter(prog);
 
-  // do the fitting until success or iteration limit is reached
-  size_t iter = 0;
-  bool isFinished = false;
-  g_log.debug("Starting minimizer iteration\n");
-  while (iter < m_maxIterations) {
-    g_log.debug() << "Starting iteration " << iter << "\n";
-    try {
-      // Perform a single iteration. isFinished is set when minimizer wants to
-      // quit.
-      m_function->iterationStarting();
-      isFinished = !m_minimizer->iterate(iter);
-      m_function->iterationFinished();
-    } catch (Kernel::Exception::FitSizeWarning &) {
-      // This is an attempt to recover after the function changes its number of
-      // parameters or ties during the iteration.
-      if (auto cf = dynamic_cast<API::CompositeFunction *>(m_function.get())) {
-        // Make sure the composite function is valid.
-        cf->checkFunction();
-      }
-      // Re-create the cost function and minimizer.
-      initializeMinimizer(m_maxIterations - iter);
-    }
-
-    prog->report();
-    ++iter;
-    if (isFinished) {
-      // It was the last iteration. Break out of the loop and return the number
-      // of finished iterations.
-      break;
-    }
-  }
-  g_log.debug() << "Number of minimizer iterations=" << iter << "\n";
-  return iter;
+  return MinimizerLoop::run(
+      *m_function, m_minimizer, m_maxIterations,
+      [this](size_t iterationsLeft) { initializeMinimizer(iterationsLeft); },
+      prog.get());
 }
 
 /// Finalize the minimizer.
 /// @param nIterations :: The actual number of iterations done by the minimizer.
 void Fit::finalizeMinimizer(size_t nIterations) {
-  m_minimizer->finalize();
-
-  auto errorString = m_minimizer->getError();
-  g_log.debug() << "Iteration stopped. Minimizer status string=" << errorString
-                << "\n";
-
-  if (nIterations >= m_maxIterations) {
-    if (!errorString.empty()) {
-      errorString += '\n';
-    }
-    errorString += "Failed to converge after " +
-                   std::to_string(m_maxIterations) + " iterations.";
-  }
-
-  if (errorString.empty()) {
-    errorString = "success";
-  }
+  const auto errorString =
+      MinimizerLoop::finalize(*m_minimizer, nIterations, m_maxIterations);
 
   // return the status flag
   setPropertyValue("OutputStatus", errorString);
@@ -223,12 +178,9 @@ void Fit::finalizeMinimizer(size_t nIterations) {
 /// Create algorithm output worksapces.
 void Fit::createOutput() {
 
-  // degrees of freedom
-  size_t dof = m_costFunction->getDomain()->size() - m_costFunction->nParams();
-  if (dof == 0)
-    dof = 1;
   double rawcostfuncval = m_minimizer->costFunctionVal();
-  double finalCostFuncVal = rawcostfuncval / double(dof);
+  double finalCostFuncVal =
+      MinimizerLoop::chi2OverDoF(*m_costFunction, rawcostfuncval);
 
   setProperty("OutputChi2overDoF", finalCostFuncVal);
 
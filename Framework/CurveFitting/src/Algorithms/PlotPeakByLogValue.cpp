@@ -8,6 +8,7 @@
 #include <boost/algorithm/string/replace.hpp>
 
 #include "MantidCurveFitting/Algorithms/PlotPeakByLogValue.h"
+#include "MantidCurveFitting/BatchFitter.h"
 #include "MantidAPI/IFuncMinimizer.h"
 #include "MantidAPI/AlgorithmManager.h"
 #include "MantidAPI/FuncMinimizerFactory.h"
@@ -27,6 +28,7 @@
 #include "MantidAPI/WorkspaceFactory.h"
 #include "MantidKernel/ListValidator.h"
 #include "MantidKernel/MandatoryValidator.h"
+#include "MantidKernel/MultiThreaded.h"
 
 namespace {
 Mantid::Kernel::Logger g_log("PlotPeakByLogValue");
@@ -201,23 +203,172 @@ void PlotPeakByLogValue::exec() {
 
   setProperty("OutputWorkspace", result);
 
+  const std::vector<SpectrumToFit> spectra = makeSpectra(wsNames, logName);
+  result->setRowCount(spectra.size());
+  for (size_t row = 0; row < spectra.size(); ++row) {
+    if (isDataName) {
+      result->cell<std::string>(row, 0) = wsNames[spectra[row].input].name;
+    } else {
+      result->cell<double>(row, 0) = spectra[row].logValue;
+    }
+  }
+
+  if (canFitInBatch(*ifun)) {
+    // There are no output workspaces to group
+    fitInBatch(ifun, spectra, initialParams, *result);
+    return;
+  }
+
   std::vector<std::string> covariance_workspaces;
   std::vector<std::string> fit_workspaces;
   std::vector<std::string> parameter_workspaces;
+  if (createFitOutput) {
+    covariance_workspaces.reserve(spectra.size());
+    fit_workspaces.reserve(spectra.size());
+    parameter_workspaces.reserve(spectra.size());
+  }
+
+  Progress prog(this, 0.0, 1.0, spectra.size());
+  for (size_t row = 0; row < spectra.size(); ++row) {
+    const SpectrumToFit &spectrum = spectra[row];
+    const int j = spectrum.wsIndex;
+    const std::string &wsName = wsNames[spectrum.input].name;
+    double chi2;
+
+    try {
+      if (passWSIndexToFunction) {
+        setWorkspaceIndexAttribute(ifun, j);
+      }
+
+      g_log.debug() << "Fitting " << spectrum.ws->getName() << " index " << j
+                    << " with \n";
+      g_log.debug() << ifun->asString() << '\n';
+
+      const std::string spectrum_index = std::to_string(j);
+      std::string wsBaseName;
+
+      if (createFitOutput)
+        wsBaseName = wsName + "_" + spectrum_index;
+
+      bool histogramFit = getPropertyValue("EvaluationType") == "Histogram";
+
+      // Fit the function
+      API::IAlgorithm_sptr fit =
+          AlgorithmManager::Instance().createUnmanaged("Fit");
+      fit->initialize();
+      fit->setPropertyValue("EvaluationType",
+                            getPropertyValue("EvaluationType"));
+      fit->setProperty("Function", ifun);
+      fit->setProperty("InputWorkspace", spectrum.ws);
+      fit->setProperty("WorkspaceIndex", j);
+      fit->setPropertyValue("StartX", getPropertyValue("StartX"));
+      fit->setPropertyValue("EndX", getPropertyValue("EndX"));
+      fit->setPropertyValue("Minimizer",
+                            getMinimizerString(wsName, spectrum_index));
+      fit->setPropertyValue("CostFunction", getPropertyValue("CostFunction"));
+      fit->setPropertyValue("MaxIterations", getPropertyValue("MaxIterations"));
+      fit->setPropertyValue("PeakRadius", getPropertyValue("PeakRadius"));
+      fit->setProperty("CalcErrors", true);
+      fit->setProperty("CreateOutput", createFitOutput);
+      if (!histogramFit) {
+        fit->setProperty("OutputCompositeMembers", outputCompositeMembers);
+        fit->setProperty("ConvolveMembers", outputConvolvedMembers);
+      }
+      fit->setProperty("Output", wsBaseName);
+      fit->execute();
+
+      if (!fit->isExecuted()) {
+        throw std::runtime_error("Fit child algorithm failed: " +
+                                 spectrum.ws->getName());
+      }
+
+      ifun = fit->getProperty("Function");
+      chi2 = fit->getProperty("OutputChi2overDoF");
+
+      if (createFitOutput) {
+        covariance_workspaces.push_back(wsBaseName +
+                                        "_NormalisedCovarianceMatrix");
+        parameter_workspaces.push_back(wsBaseName + "_Parameters");
+        fit_workspaces.push_back(wsBaseName + "_Workspace");
+      }
+
+      g_log.debug() << "Fit result " << fit->getPropertyValue("OutputStatus")
+                    << ' ' << chi2 << '\n';
+
+    } catch (...) {
+      g_log.error("Error in Fit ChildAlgorithm");
+      throw;
+    }
+
+    // Put the fitted parameters into the result table
+    setResultRow(*result, row, *ifun, chi2);
+
+    prog.report("Fitting Workspace: (" + std::to_string(spectrum.input) +
+                ") - ");
+    interruption_point();
+
+    if (individual) {
+      for (size_t i = 0; i < initialParams.size(); ++i) {
+        ifun->setParameter(i, initialParams[i]);
+      }
+    }
+  }
+
+  if (createFitOutput) {
+    // collect output of fit for each spectrum into workspace groups
+    API::IAlgorithm_sptr groupAlg =
+        AlgorithmManager::Instance().createUnmanaged("GroupWorkspaces");
+    groupAlg->initialize();
+    groupAlg->setProperty("InputWorkspaces", covariance_workspaces);
+    groupAlg->setProperty("OutputWorkspace",
+                          m_baseName + "_NormalisedCovarianceMatrices");
+    groupAlg->execute();
 
-  double dProg = 1. / static_cast<double>(wsNames.size());
-  double Prog = 0.;
-  for (int i = 0; i < static_cast<int>(wsNames.size()); ++i) {
-    InputData data = getWorkspace(wsNames[i]);
+    groupAlg = AlgorithmManager::Instance().createUnmanaged("GroupWorkspaces");
+    groupAlg->initialize();
+    groupAlg->setProperty("InputWorkspaces", parameter_workspaces);
+    groupAlg->setProperty("OutputWorkspace", m_baseName + "_Parameters");
+    groupAlg->execute();
+
+    groupAlg = AlgorithmManager::Instance().createUnmanaged("GroupWorkspaces");
+    groupAlg->initialize();
+    groupAlg->setProperty("InputWorkspaces", fit_workspaces);
+    groupAlg->setProperty("OutputWorkspace", m_baseName + "_Workspaces");
+    groupAlg->execute();
+  }
+
+  for (auto &minimizerWorkspace : m_minimizerWorkspaces) {
+    const std::string paramName = minimizerWorkspace.first;
+    API::IAlgorithm_sptr groupAlg =
+        AlgorithmManager::Instance().createUnmanaged("GroupWorkspaces");
+    groupAlg->initialize();
+    groupAlg->setProperty("InputWorkspaces", minimizerWorkspace.second);
+    groupAlg->setProperty("OutputWorkspace", m_baseName + "_" + paramName);
+    groupAlg->execute();
+  }
+}
+
+/**
+ * Find the spectra to fit and the values to plot their parameters against.
+ * @param inputs :: The list of input data created by makeNames().
+ * @param logName :: The value of the LogValue property.
+ * @return The spectra in the order they are fitted.
+ */
+std::vector<PlotPeakByLogValue::SpectrumToFit>
+PlotPeakByLogValue::makeSpectra(const std::vector<InputData> &inputs,
+                                const std::string &logName) {
+  std::vector<SpectrumToFit> spectra;
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    InputData data = getWorkspace(inputs[i]);
 
     if (!data.ws) {
-      g_log.warning() << "Cannot access workspace " << wsNames[i].name << '\n';
+      g_log.warning() << "Cannot access workspace " << inputs[i].name << '\n';
       continue;
     }
 
     if (data.i < 0 && data.indx.empty()) {
       g_log.warning() << "Zero spectra selected for fitting in workspace "
-                      << wsNames[i].name << '\n';
+                      << inputs[i].name << '\n';
       continue;
     }
 
@@ -230,15 +381,7 @@ void PlotPeakByLogValue::exec() {
       jend = data.indx.back() + 1;
     }
 
-    if (createFitOutput) {
-      covariance_workspaces.reserve(covariance_workspaces.size() + jend);
-      fit_workspaces.reserve(fit_workspaces.size() + jend);
-      parameter_workspaces.reserve(parameter_workspaces.size() + jend);
-    }
-
-    dProg /= abs(jend - j);
     for (; j < jend; ++j) {
-
       // Find the log value: it is either a log-file value or simply the
       // workspace number
       double logValue = 0;
@@ -264,134 +407,116 @@ void PlotPeakByLogValue::exec() {
         }
         logValue = logp->lastValue();
       }
+      spectra.push_back({i, j, logValue, data.ws});
+    }
+  }
+  return spectra;
+}
 
-      double chi2;
-
-      try {
-        if (passWSIndexToFunction) {
-          setWorkspaceIndexAttribute(ifun, j);
-        }
-
-        g_log.debug() << "Fitting " << data.ws->getName() << " index " << j
-                      << " with \n";
-        g_log.debug() << ifun->asString() << '\n';
-
-        const std::string spectrum_index = std::to_string(j);
-        std::string wsBaseName;
-
-        if (createFitOutput)
-          wsBaseName = wsNames[i].name + "_" + spectrum_index;
-
-        bool histogramFit = getPropertyValue("EvaluationType") == "Histogram";
-
-        // Fit the function
-        API::IAlgorithm_sptr fit =
-            AlgorithmManager::Instance().createUnmanaged("Fit");
-        fit->initialize();
-        fit->setPropertyValue("EvaluationType",
-                              getPropertyValue("EvaluationType"));
-        fit->setProperty("Function", ifun);
-        fit->setProperty("InputWorkspace", data.ws);
-        fit->setProperty("WorkspaceIndex", j);
-        fit->setPropertyValue("StartX", getPropertyValue("StartX"));
-        fit->setPropertyValue("EndX", getPropertyValue("EndX"));
-        fit->setPropertyValue(
-            "Minimizer", getMinimizerString(wsNames[i].name, spectrum_index));
-        fit->setPropertyValue("CostFunction", getPropertyValue("CostFunction"));
-        fit->setPropertyValue("MaxIterations",
-                              getPropertyValue("MaxIterations"));
-        fit->setPropertyValue("PeakRadius", getPropertyValue("PeakRadius"));
-        fit->setProperty("CalcErrors", true);
-        fit->setProperty("CreateOutput", createFitOutput);
-        if (!histogramFit) {
-          fit->setProperty("OutputCompositeMembers", outputCompositeMembers);
-          fit->setProperty("ConvolveMembers", outputConvolvedMembers);
-        }
-        fit->setProperty("Output", wsBaseName);
-        fit->execute();
-
-        if (!fit->isExecuted()) {
-          throw std::runtime_error("Fit child algorithm failed: " +
-                                   data.ws->getName());
-        }
-
-        ifun = fit->getProperty("Function");
-        chi2 = fit->getProperty("OutputChi2overDoF");
-
-        if (createFitOutput) {
-          covariance_workspaces.push_back(wsBaseName +
-                                          "_NormalisedCovarianceMatrix");
-          parameter_workspaces.push_back(wsBaseName + "_Parameters");
-          fit_workspaces.push_back(wsBaseName + "_Workspace");
-        }
-
-        g_log.debug() << "Fit result " << fit->getPropertyValue("OutputStatus")
-                      << ' ' << chi2 << '\n';
-
-      } catch (...) {
-        g_log.error("Error in Fit ChildAlgorithm");
-        throw;
-      }
-
-      // Extract the fitted parameters and put them into the result table
-      TableRow row = result->appendRow();
-      if (isDataName) {
-        row << wsNames[i].name;
-      } else {
-        row << logValue;
-      }
-
-      for (size_t iPar = 0; iPar < ifun->nParams(); ++iPar) {
-        row << ifun->getParameter(iPar) << ifun->getError(iPar);
-      }
-      row << chi2;
-
-      Prog += dProg;
-      std::string current = std::to_string(i);
-      progress(Prog, ("Fitting Workspace: (" + current + ") - "));
-      interruption_point();
-
-      if (individual) {
-        for (size_t i = 0; i < initialParams.size(); ++i) {
-          ifun->setParameter(i, initialParams[i]);
-        }
-      }
+/**
+ * Check if the spectra can be fitted by a BatchFitter instead of the Fit
+ * algorithm. This is possible if Fit wouldn't create any output workspaces.
+ * @param function :: The fitting function.
+ */
+bool PlotPeakByLogValue::canFitInBatch(const API::IFunction &function) {
+  const bool createFitOutput = getProperty("CreateOutput");
+  if (createFitOutput || getPropertyValue("EvaluationType") == "Histogram" ||
+      !BatchFitter::canFit(function)) {
+    return false;
+  }
+  // Minimizers with output workspaces need a Fit algorithm to declare them
+  const std::string minimizer = getPropertyValue("Minimizer");
+  if (minimizer.find('$') != std::string::npos) {
+    return false;
+  }
+  auto probe = FuncMinimizerFactory::Instance().createMinimizer(minimizer);
+  const auto minimizerProps = probe->getProperties();
+  return std::none_of(minimizerProps.cbegin(), minimizerProps.cend(),
+                      [](const Kernel::Property *prop) {
+                        return dynamic_cast<const IWorkspaceProperty *>(prop) &&
+                               !prop->value().empty();
+                      });
+}
 
-    } // for(;j < jend;++j)
+/**
+ * Fit the spectra with a BatchFitter and write the results straight to the
+ * output table. Individual fits of a thread safe function run in parallel,
+ * each thread fitting its own copy of the function.
+ * @param function :: The fitting function with the initial parameters.
+ * @param spectra :: The spectra to fit.
+ * @param initialParams :: The parameters to start each individual fit with.
+ * @param result :: The output table, with a row for each spectrum.
+ */
+void PlotPeakByLogValue::fitInBatch(IFunction_sptr function,
+                                    const std::vector<SpectrumToFit> &spectra,
+                                    const std::vector<double> &initialParams,
+                                    ITableWorkspace &result) {
+  const bool individual = getPropertyValue("FitType") == "Individual";
+  const bool passWSIndexToFunction = getProperty("PassWSIndexToFunction");
+  const int maxIterations = getProperty("MaxIterations");
+  BatchFitter fitter(getPropertyValue("Minimizer"),
+                     getPropertyValue("CostFunction"),
+                     static_cast<size_t>(std::max(maxIterations, 0)));
+  fitter.setRange(getProperty("StartX"), getProperty("EndX"));
+  fitter.setPeakRadius(getProperty("PeakRadius"));
+
+  // Sequential fits start from the result of the previous one
+  const bool parallel = individual && function->isThreadSafe();
+  std::vector<IFunction_sptr> functions(1, function);
+  if (parallel) {
+    functions.resize(PARALLEL_GET_MAX_THREADS);
+    for (auto &fun : functions) {
+      fun = function->copyForEvaluation();
+    }
   }
 
-  if (createFitOutput) {
-    // collect output of fit for each spectrum into workspace groups
-    API::IAlgorithm_sptr groupAlg =
-        AlgorithmManager::Instance().createUnmanaged("GroupWorkspaces");
-    groupAlg->initialize();
-    groupAlg->setProperty("InputWorkspaces", covariance_workspaces);
-    groupAlg->setProperty("OutputWorkspace",
-                          m_baseName + "_NormalisedCovarianceMatrices");
-    groupAlg->execute();
+  Progress prog(this, 0.0, 1.0, spectra.size());
+  const int nSpectra = static_cast<int>(spectra.size());
+  PARALLEL_FOR_IF(parallel)
+  for (int row = 0; row < nSpectra; ++row) {
+    PARALLEL_START_INTERUPT_REGION
+    auto &fun = functions[PARALLEL_THREAD_NUMBER];
+    if (individual) {
+      for (size_t i = 0; i < initialParams.size(); ++i) {
+        fun->setParameter(i, initialParams[i]);
+      }
+    }
+    const SpectrumToFit &spectrum = spectra[row];
+    if (passWSIndexToFunction) {
+      setWorkspaceIndexAttribute(fun, spectrum.wsIndex);
+    }
 
-    groupAlg = AlgorithmManager::Instance().createUnmanaged("GroupWorkspaces");
-    groupAlg->initialize();
-    groupAlg->setProperty("InputWorkspaces", parameter_workspaces);
-    groupAlg->setProperty("OutputWorkspace", m_baseName + "_Parameters");
-    groupAlg->execute();
+    const auto fit = fitter.fit(fun, spectrum.ws,
+                                static_cast<size_t>(spectrum.wsIndex));
+    g_log.debug() << "Fit result of " << spectrum.ws->getName() << " index "
+                  << spectrum.wsIndex << ": " << fit.status << ' '
+                  << fit.chi2OverDoF << '\n';
 
-    groupAlg = AlgorithmManager::Instance().createUnmanaged("GroupWorkspaces");
-    groupAlg->initialize();
-    groupAlg->setProperty("InputWorkspaces", fit_workspaces);
-    groupAlg->setProperty("OutputWorkspace", m_baseName + "_Workspaces");
-    groupAlg->execute();
+    setResultRow(result, static_cast<size_t>(row), *fun, fit.chi2OverDoF);
+    prog.report("Fitting Workspace: (" + std::to_string(spectrum.input) +
+                ") - ");
+    PARALLEL_END_INTERUPT_REGION
   }
+  PARALLEL_CHECK_INTERUPT_REGION
+}
 
-  for (auto &minimizerWorkspace : m_minimizerWorkspaces) {
-    const std::string paramName = minimizerWorkspace.first;
-    API::IAlgorithm_sptr groupAlg =
-        AlgorithmManager::Instance().createUnmanaged("GroupWorkspaces");
-    groupAlg->initialize();
-    groupAlg->setProperty("InputWorkspaces", minimizerWorkspace.second);
-    groupAlg->setProperty("OutputWorkspace", m_baseName + "_" + paramName);
-    groupAlg->execute();
+/**
+ * Write the fitted parameters, their errors and the chi squared to a row of
+ * the output table.
+ * @param result :: The output table.
+ * @param row :: The row to write to.
+ * @param function :: The fitted function.
+ * @param chi2 :: The chi squared divided by the degrees of freedom.
+ */
+void PlotPeakByLogValue::setResultRow(ITableWorkspace &result, size_t row,
+                                      const IFunction &function,
+                                      double chi2) const {
+  size_t column = 1;
+  for (size_t iPar = 0; iPar < function.nParams(); ++iPar) {
+    result.cell<double>(row, column++) = function.getParameter(iPar);
+    result.cell<double>(row, column++) = function.getError(iPar);
   }
+  result.cell<double>(row, column) = chi2;
 }
 
 /** Get a workspace identified by an InputData structure.
@@ -0,0 +1,128 @@
+#include "MantidCurveFitting/BatchFitter.h"
+#include "MantidCurveFitting/CostFunctions/CostFuncFitting.h"
+#include "MantidCurveFitting/FitMW.h"
+#include "MantidCurveFitting/GSLMatrix.h"
+#include "MantidCurveFitting/MinimizerLoop.h"
+
+#include "MantidAPI/CostFunctionFactory.h"
+#include "MantidAPI/FuncMinimizerFactory.h"
+#include "MantidAPI/FunctionDomain1D.h"
+#include "MantidAPI/FunctionValues.h"
+#include "MantidAPI/IFuncMinimizer.h"
+#include "MantidAPI/IFunction1DSpectrum.h"
+#include "MantidAPI/IFunctionGeneral.h"
+#include "MantidAPI/IFunctionMD.h"
+#include "MantidAPI/ILatticeFunction.h"
+#include "MantidAPI/MatrixWorkspace.h"
+#include "MantidKernel/EmptyValues.h"
+
+#include <gsl/gsl_errno.h>
+
+namespace Mantid {
+namespace CurveFitting {
+
+using namespace API;
+
+/**
+ * Constructor.
+ * @param minimizer :: The minimizer, optionally followed by its options as in
+ * the Minimizer property of Fit.
+ * @param costFunction :: The name of the cost function.
+ * @param maxIterations :: The maximum number of iterations of each fit.
+ */
+BatchFitter::BatchFitter(const std::string &minimizer,
+                         const std::string &costFunction,
+                         size_t maxIterations)
+    : m_minimizer(minimizer), m_costFunction(costFunction),
+      m_maxIterations(maxIterations), m_startX(EMPTY_DBL()),
+      m_endX(EMPTY_DBL()) {
+  // As in Fit, report GSL errors through the minimizers' status
+  gsl_set_error_handler_off();
+}
+
+/**
+ * Set the range of the x values to fit.
+ * @param startX :: The lowest x value, or EMPTY_DBL() for the whole spectrum.
+ * @param endX :: The highest x value, or EMPTY_DBL() for the whole spectrum.
+ */
+void BatchFitter::setRange(double startX, double endX) {
+  m_startX = startX;
+  m_endX = endX;
+}
+
+/**
+ * Fit a function to a spectrum. This does the same as running Fit with the
+ * options of this fitter and CalcErrors set.
+ * @param function :: The function to fit. On return it holds the fitted
+ * parameters and their errors.
+ * @param workspace :: The workspace with the data.
+ * @param workspaceIndex :: The index of the spectrum to fit.
+ * @return The chi squared and the status of the fit.
+ */
+BatchFitter::Result BatchFitter::fit(IFunction_sptr function,
+                                     MatrixWorkspace_sptr workspace,
+                                     size_t workspaceIndex) const {
+  function->setUpForFit();
+
+  FitMW creator;
+  creator.setWorkspace(workspace);
+  creator.setWorkspaceIndex(workspaceIndex);
+  creator.setRange(m_startX, m_endX);
+  FunctionDomain_sptr domain;
+  FunctionValues_sptr values;
+  creator.createDomain(domain, values);
+  if (m_peakRadius != 0) {
+    if (auto d1d = dynamic_cast<FunctionDomain1D *>(domain.get())) {
+      d1d->setPeakRadius(m_peakRadius);
+    }
+  }
+  creator.initFunction(function);
+
+  auto costFunction =
+      boost::dynamic_pointer_cast<CostFunctions::CostFuncFitting>(
+          CostFunctionFactory::Instance().create(m_costFunction));
+  if (!costFunction) {
+    throw std::invalid_argument(m_costFunction +
+                                " cannot be used to fit a function.");
+  }
+  costFunction->setFittingFunction(function, domain, values);
+  auto minimizer =
+      FuncMinimizerFactory::Instance().createMinimizer(m_minimizer);
+  minimizer->initialize(costFunction, m_maxIterations);
+
+  Result result;
+  result.iterations = MinimizerLoop::run(
+      *function, minimizer, m_maxIterations,
+      [&](size_t iterationsLeft) {
+        costFunction->setFittingFunction(function, domain, values);
+        minimizer->initialize(costFunction, iterationsLeft);
+      });
+  result.status =
+      MinimizerLoop::finalize(*minimizer, result.iterations, m_maxIterations);
+  const double costFunctionValue = minimizer->costFunctionVal();
+  result.chi2OverDoF =
+      MinimizerLoop::chi2OverDoF(*costFunction, costFunctionValue);
+
+  if (costFunction->nParams() > 0) {
+    GSLMatrix covar;
+    costFunction->calCovarianceMatrix(covar);
+    costFunction->calFittingErrors(covar, costFunctionValue);
+  }
+  return result;
+}
+
+/**
+ * Check if a function can be fitted by a BatchFitter. Functions that Fit
+ * evaluates on anything other than a simple 1D domain cannot.
+ * @param function :: A fitting function.
+ */
+bool BatchFitter::canFit(const IFunction &function) {
+  return function.getNumberDomains() == 1 &&
+         !dynamic_cast<const ILatticeFunction *>(&function) &&
+         !dynamic_cast<const IFunctionMD *>(&function) &&
+         !dynamic_cast<const IFunction1DSpectrum *>(&function) &&
+         !dynamic_cast<const IFunctionGeneral *>(&function);
+}
+
+} // namespace CurveFitting
+} // namespace Mantid
@@ -236,10 +236,12 @@ void CostFuncLeastSquares::addValDerivHessian(API::IFunction_sptr function,
   size_t iActiveP = 0;
   double fVal = 0.0;
   std::vector<double> weights = getFitWeights(values);
+  std::vector<size_t> activeParameters;
 
   for (size_t ip = 0; ip < np; ++ip) {
     if (!function->isActive(ip))
       continue;
+    activeParameters.push_back(ip);
     double d = 0.0;
     for (size_t i = 0; i < ny; ++i) {
       double calc = values->getCalculated(i);
@@ -264,32 +266,42 @@ void CostFuncLeastSquares::addValDerivHessian(API::IFunction_sptr function,
   if (!evalHessian)
     return;
 
-  size_t i1 = 0;                  // active parameter index
-  for (size_t i = 0; i < np; ++i) // over parameters
-  {
-    if (!function->isActive(i))
-      continue;
-    size_t i2 = 0;                  // active parameter index
-    for (size_t j = 0; j <= i; ++j) // over ~ half of parameters
-    {
-      if (!function->isActive(j))
-        continue;
+  for (auto &w : weights) {
+    w *= w;
+  }
+  // Calculate the lower triangle of the Hessian one row per iteration. The
+  // rows are independent and are shared between threads unless this is
+  // already running on a thread of ParDomain's loop over the domains or the
+  // problem is too small to be worth it.
+  const int nActive = static_cast<int>(activeParameters.size());
+  const bool parallel =
+      nActive > 1 &&
+      ny * activeParameters.size() >=
+          API::IFunction::MIN_WORK_FOR_PARALLEL_DERIVATIVES &&
+      PARALLEL_NUMBER_OF_THREADS == 1;
+  PARALLEL_FOR_IF(parallel)
+  for (int row = 0; row < nActive; ++row) {
+    const auto i1 = static_cast<size_t>(row); // active parameter index
+    const size_t i = activeParameters[i1];
+    std::vector<double> sums(i1 + 1, 0.0);
+    for (size_t i2 = 0; i2 <= i1; ++i2) { // over ~ half of parameters
+      const size_t j = activeParameters[i2];
       double d = 0.0;
       for (size_t k = 0; k < ny; ++k) // over fitting data
       {
-        double w = weights[k];
-        d += jacobian.get(k, i) * jacobian.get(k, j) * w * w;
+        d += jacobian.get(k, i) * jacobian.get(k, j) * weights[k];
       }
-      PARALLEL_CRITICAL(hessian_set) {
-        double h = m_hessian.get(i1, i2);
-        m_hessian.set(i1, i2, h + d);
+      sums[i2] = d;
+    }
+    PARALLEL_CRITICAL(hessian_set) {
+      for (size_t i2 = 0; i2 <= i1; ++i2) {
+        const double h = m_hessian.get(i1, i2) + sums[i2];
+        m_hessian.set(i1, i2, h);
         if (i1 != i2) {
-          m_hessian.set(i2, i1, h + d);
+          m_hessian.set(i2, i1, h);
         }
       }
-      ++i2;
     }
-    ++i1;
   }
 }
 
@@ -3,6 +3,7 @@
 //----------------------------------------------------------------------
 #include "MantidCurveFitting/Functions/Convolution.h"
 #include "MantidCurveFitting/Functions/DeltaFunction.h"
+#include "MantidCurveFitting/Jacobian.h"
 #include "MantidAPI/IFunction1D.h"
 #include "MantidAPI/FunctionFactory.h"
 #include "MantidAPI/FunctionValues.h"
@@ -11,6 +12,8 @@
 #include <cmath>
 #include <algorithm>
 #include <functional>
+#include <limits>
+#include <utility>
 
 #include <gsl/gsl_errno.h>
 #include <gsl/gsl_fft_real.h>
@@ -21,6 +24,49 @@
 
 namespace {
 const double tolerance{0.02};
+
+/**
+ * Check if the FFT mode can be used on a domain. The direct mode is needed
+ * only for domains crossing x = 0 that are not nearly symmetric with respect
+ * to the inversion E --> -E.
+ * @param xValues :: The x values of the domain.
+ * @param nData :: The size of the domain.
+ */
+bool isFFTModeDomain(const double *xValues, size_t nData) {
+  double dx =
+      (xValues[nData - 1] - xValues[0]) / static_cast<double>((nData - 1));
+  // positive x-values:
+  auto ixP = static_cast<size_t>(xValues[nData - 1] / dx);
+  auto ixN = nData - ixP - 1; // negative x-values (ixP+ixN=nData-1)
+
+  // determine wether to use FFT or Direct calculations
+  int assymmetry = abs(static_cast<int>(ixP - ixN));
+  return !(xValues[0] * xValues[nData - 1] < 0 &&
+           assymmetry > tolerance * static_cast<double>(ixP + ixN));
+}
+
+/**
+ * Differentiate the height prefactor of a delta function with respect to one
+ * of its parameters by a forward difference, with the step used by
+ * IFunction::calNumericalDeriv.
+ * @param delta :: The delta function. The parameter is restored on return.
+ * @param iParam :: The index of the parameter.
+ * @param prefactor :: The prefactor at the current parameter values.
+ */
+double
+prefactorDerivative(Mantid::CurveFitting::Functions::DeltaFunction &delta,
+                    size_t iParam, double prefactor) {
+  const double epsilon = std::numeric_limits<double>::epsilon() * 100;
+  const double stepPercentage = 0.001;
+  const double cutoff =
+      100.0 * std::numeric_limits<double>::min() / stepPercentage;
+  const double value = delta.getParameter(iParam);
+  const double step = fabs(value) < cutoff ? epsilon : value * stepPercentage;
+  delta.setParameter(iParam, value + step, false);
+  const double stepped = delta.HeightPrefactor();
+  delta.setParameter(iParam, value, false);
+  return (stepped - prefactor) / step;
+}
 }
 
 namespace Mantid {
@@ -38,14 +84,116 @@ DECLARE_FUNCTION(Convolution)
 /// Constructor
 Convolution::Convolution() {
   declareAttribute("FixResolution", Attribute(true));
-  setAttributeValue("NumDeriv", true);
 }
 
 void Convolution::init() {}
 
+/**
+ * Calculate the derivatives. When the resolution has no active or tied
+ * parameters and the FFT mode is used, the convolution is linear in the model,
+ * and its derivatives with respect to the model parameters are the
+ * convolutions of the derivatives of the model. These are transformed one
+ * after another with the same FFT tables and resolution transform. Otherwise,
+ * or if the NumDeriv attribute is set, the derivatives are calculated
+ * numerically.
+ * @param domain :: The domain of the function.
+ * @param jacobian :: The Jacobian receiving the derivatives.
+ */
 void Convolution::functionDeriv(const FunctionDomain &domain,
-                                Jacobian &jacobian) {
-  calNumericalDeriv(domain, jacobian);
+                                API::Jacobian &jacobian) {
+  const auto d1d = dynamic_cast<const FunctionDomain1D *>(&domain);
+  bool isLinear = !getAttribute("NumDeriv").asBool() && nFunctions() == 2 &&
+                  d1d && domain.size() > 1 &&
+                  isFFTModeDomain(d1d->getPointerAt(0), domain.size());
+  if (isLinear) {
+    const auto &res = *getFunction(0);
+    for (size_t i = 0; i < res.nParams(); ++i) {
+      if (res.isActive(i) || res.getTie(i)) {
+        isLinear = false;
+        break;
+      }
+    }
+  }
+  if (!isLinear) {
+    calNumericalDeriv(domain, jacobian);
+    return;
+  }
+
+  const size_t nData = domain.size();
+  const double *xValues = d1d->getPointerAt(0);
+  transformResolution(xValues, nData);
+  auto model = getFunction(1);
+  const size_t offset = paramOffset(1);
+  CurveFitting::Jacobian modelJacobian(nData, model->nParams());
+  model->functionDeriv(domain, modelJacobian);
+  std::vector<double> column(nData);
+  for (size_t ip = 0; ip < model->nParams(); ++ip) {
+    for (size_t i = 0; i < nData; ++i) {
+      column[i] = modelJacobian.get(i, ip);
+    }
+    convolve(column.data(), xValues, nData);
+    for (size_t i = 0; i < nData; ++i) {
+      jacobian.set(i, offset + ip, column[i]);
+    }
+  }
+
+  // Delta functions add copies of the resolution shifted by their centres and
+  // scaled by their heights times HeightPrefactor(). DeltaFunction has no
+  // derivatives of its own, so all their columns are set here. The
+  // derivatives with respect to the centres are central differences with a
+  // step much smaller than the spacing of the x values. Other parameters of
+  // subclasses only enter through HeightPrefactor(), which is differentiated
+  // numerically.
+  std::vector<std::pair<size_t, boost::shared_ptr<DeltaFunction>>> deltas;
+  if (auto cf = boost::dynamic_pointer_cast<CompositeFunction>(model)) {
+    size_t memberOffset = offset;
+    for (size_t i = 0; i < cf->nFunctions(); ++i) {
+      auto member = cf->getFunction(i);
+      if (auto df = boost::dynamic_pointer_cast<DeltaFunction>(member)) {
+        deltas.emplace_back(memberOffset, df);
+      }
+      memberOffset += member->nParams();
+    }
+  } else if (auto df = boost::dynamic_pointer_cast<DeltaFunction>(model)) {
+    deltas.emplace_back(offset, df);
+  }
+  if (deltas.empty()) {
+    return;
+  }
+  auto resolution = boost::dynamic_pointer_cast<IFunction1D>(getFunction(0));
+  const double step = 1e-3 * (xValues[1] - xValues[0]);
+  std::vector<double> x(nData), shifted(nData), plus(nData), minus(nData);
+  for (const auto &delta : deltas) {
+    auto &df = *delta.second;
+    const double prefactor = df.HeightPrefactor();
+    const double height = df.getParameter("Height");
+    const double centre = df.getParameter("Centre");
+    const auto resolutionAt = [&](double shift, std::vector<double> &out) {
+      std::transform(xValues, xValues + nData, x.begin(),
+                     [shift](double xi) { return xi - shift; });
+      resolution->function1D(out.data(), x.data(), nData);
+    };
+    resolutionAt(centre, shifted);
+    resolutionAt(centre + step, plus);
+    resolutionAt(centre - step, minus);
+    const size_t iHeight = delta.first + df.parameterIndex("Height");
+    const size_t iCentre = delta.first + df.parameterIndex("Centre");
+    for (size_t i = 0; i < nData; ++i) {
+      jacobian.set(i, iHeight, prefactor * shifted[i]);
+      jacobian.set(i, iCentre, prefactor * height * (plus[i] - minus[i]) /
+                                   (2.0 * step));
+    }
+    for (size_t ip = 0; ip < df.nParams(); ++ip) {
+      if (delta.first + ip == iHeight || delta.first + ip == iCentre) {
+        continue;
+      }
+      const double derivative =
+          prefactorDerivative(df, ip, prefactor) * height;
+      for (size_t i = 0; i < nData; ++i) {
+        jacobian.set(i, delta.first + ip, derivative * shifted[i]);
+      }
+    }
+  }
 }
 
 void Convolution::setAttribute(const std::string &attName,
@@ -66,22 +214,24 @@ void Convolution::setAttribute(const std::string &attName,
   CompositeFunction::setAttribute(attName, att);
 }
 
-namespace {
-// anonymous namespace for local definitions
-
-// A struct incapsulating workspaces for real fft
-struct RealFFTWorkspace {
-  explicit RealFFTWorkspace(size_t nData)
-      : workspace(gsl_fft_real_workspace_alloc(nData)),
-        wavetable(gsl_fft_real_wavetable_alloc(nData)) {}
-  ~RealFFTWorkspace() {
+/// The GSL wavetables and workspace of the real FFTs of one size
+struct Convolution::FFTPlan {
+  explicit FFTPlan(size_t nData)
+      : size(nData), workspace(gsl_fft_real_workspace_alloc(nData)),
+        wavetable(gsl_fft_real_wavetable_alloc(nData)),
+        inverseWavetable(gsl_fft_halfcomplex_wavetable_alloc(nData)) {}
+  ~FFTPlan() {
+    gsl_fft_halfcomplex_wavetable_free(inverseWavetable);
     gsl_fft_real_wavetable_free(wavetable);
     gsl_fft_real_workspace_free(workspace);
   }
+  FFTPlan(const FFTPlan &) = delete;
+  FFTPlan &operator=(const FFTPlan &) = delete;
+  const size_t size;
   gsl_fft_real_workspace *workspace;
   gsl_fft_real_wavetable *wavetable;
+  gsl_fft_halfcomplex_wavetable *inverseWavetable;
 };
-}
 
 /**
  * Calculates convolution of the two member functions. Switches from FFT mode
@@ -98,21 +248,10 @@ void Convolution::function(const FunctionDomain &domain,
     return;
   }
   const auto &d1d = dynamic_cast<const FunctionDomain1D &>(domain);
-  const size_t nData = domain.size();
-  const double *xValues = d1d.getPointerAt(0);
-  double dx =
-      (xValues[nData - 1] - xValues[0]) / static_cast<double>((nData - 1));
-  // positive x-values:
-  auto ixP = static_cast<size_t>(xValues[nData - 1] / dx);
-  auto ixN = nData - ixP - 1; // negative x-values (ixP+ixN=nData-1)
-
-  // determine wether to use FFT or Direct calculations
-  int assymmetry = abs(static_cast<int>(ixP - ixN));
-  if (xValues[0] * xValues[nData - 1] < 0 &&
-      assymmetry > tolerance * static_cast<double>(ixP + ixN)) {
-    functionDirectMode(domain, values);
-  } else {
+  if (isFFTModeDomain(d1d.getPointerAt(0), domain.size())) {
     functionFFTMode(domain, values);
+  } else {
+    functionDirectMode(domain, values);
   }
 }
 
@@ -128,57 +267,7 @@ void Convolution::functionFFTMode(const FunctionDomain &domain,
   const auto &d1d = dynamic_cast<const FunctionDomain1D &>(domain);
   size_t nData = domain.size();
   const double *xValues = d1d.getPointerAt(0);
-  refreshResolution();
-  RealFFTWorkspace workspace(nData);
-  int n2 = static_cast<int>(nData) / 2;
-  bool odd = n2 * 2 != static_cast<int>(nData);
-  if (m_resolution.empty()) {
-    m_resolution.resize(nData);
-    // the resolution must be defined on interval -L < xr < L, L ==
-    // (xValues[nData-1] - xValues[0]) / 2
-    std::vector<double> xr(nData);
-    double dx =
-        (xValues[nData - 1] - xValues[0]) / static_cast<double>((nData - 1));
-    // make sure that xr[nData/2] == 0.0
-    xr[n2] = 0.0;
-    for (int i = 1; i < n2; i++) {
-      double x = i * dx;
-      xr[n2 + i] = x;
-      xr[n2 - i] = -x;
-    }
-
-    xr[0] = -n2 * dx;
-    if (odd)
-      xr[nData - 1] = -xr[0];
-
-    IFunction1D_sptr fun =
-        boost::dynamic_pointer_cast<IFunction1D>(getFunction(0));
-    if (!fun) {
-      throw std::runtime_error("Convolution can work only with IFunction1D");
-    }
-    fun->function1D(m_resolution.data(), xr.data(), nData);
-
-    // rotate the data to produce the right transform
-    if (odd) {
-      double tmp = m_resolution[nData - 1];
-      for (int i = n2 - 1; i >= 0; i--) {
-        m_resolution[n2 + i + 1] = m_resolution[i];
-        m_resolution[i] = m_resolution[n2 + i];
-      }
-      m_resolution[n2] = tmp;
-    } else {
-      for (int i = 0; i < n2; i++) {
-        double tmp = m_resolution[i];
-        m_resolution[i] = m_resolution[n2 + i];
-        m_resolution[n2 + i] = tmp;
-      }
-    }
-    gsl_fft_real_transform(m_resolution.data(), 1, nData, workspace.wavetable,
-                           workspace.workspace);
-    std::transform(m_resolution.begin(), m_resolution.end(),
-                   m_resolution.begin(),
-                   std::bind2nd(std::multiplies<double>(), dx));
-  }
+  transformResolution(xValues, nData);
 
   // Now m_resolution contains fourier transform of the resolution
 
@@ -232,45 +321,8 @@ void Convolution::functionFFTMode(const FunctionDomain &domain,
   double *out = values.getPointerToCalculated(0);
 
   if (!deltaFunctionsOnly) {
-    // Transform the model function
     getFunction(1)->function(domain, values);
-    gsl_fft_real_transform(out, 1, nData, workspace.wavetable,
-                           workspace.workspace);
-
-    // Fourier transform is integration - multiply by the step in the
-    // integration variable
-    double dx = nData > 1 ? xValues[1] - xValues[0] : 1.;
-    std::transform(out, out + nData, out,
-                   std::bind2nd(std::multiplies<double>(), dx));
-
-    // now out contains fourier transform of the model function
-
-    HalfComplex res(m_resolution.data(), nData);
-    HalfComplex fun(out, nData);
-
-    // Multiply transforms of the resolution and model functions
-    // Result is stored in fun
-    for (size_t i = 0; i <= res.size(); i++) {
-      // complex multiplication
-      double res_r = res.real(i);
-      double res_i = res.imag(i);
-      double fun_r = fun.real(i);
-      double fun_i = fun.imag(i);
-      fun.set(i, res_r * fun_r - res_i * fun_i, res_r * fun_i + res_i * fun_r);
-    }
-
-    // Inverse fourier transform of fun
-    gsl_fft_halfcomplex_wavetable *wavetable_r =
-        gsl_fft_halfcomplex_wavetable_alloc(nData);
-    gsl_fft_halfcomplex_inverse(out, 1, nData, wavetable_r,
-                                workspace.workspace);
-    gsl_fft_halfcomplex_wavetable_free(wavetable_r);
-
-    // Inverse fourier transform is integration - multiply by the step in the
-    // integration variable
-    dx = nData > 1 ? 1. / (xValues[1] - xValues[0]) : 1.;
-    std::transform(out, out + nData, out,
-                   std::bind2nd(std::multiplies<double>(), dx));
+    convolve(out, xValues, nData);
   } else {
     values.zeroCalculated();
   }
@@ -300,6 +352,133 @@ void Convolution::functionFFTMode(const FunctionDomain &domain,
 
 } // end of Convolution::functionFFTMode
 
+/**
+ * Get the FFT tables and workspace for a domain size, creating them if the
+ * size has changed since the last call.
+ * @param nData :: The size of the domain.
+ */
+Convolution::FFTPlan &Convolution::fftPlan(size_t nData) const {
+  if (!m_fftPlan || m_fftPlan->size != nData) {
+    m_fftPlan = std::make_shared<FFTPlan>(nData);
+  }
+  return *m_fftPlan;
+}
+
+/**
+ * Calculate the Fourier transform of the resolution function on a domain
+ * symmetric with respect to x = 0 unless m_resolution already holds it: the
+ * transform is kept while the domain and the parameters of the resolution
+ * stay the same.
+ * @param xValues :: The x values of the domain.
+ * @param nData :: The size of the domain.
+ */
+void Convolution::transformResolution(const double *xValues,
+                                      size_t nData) const {
+  refreshResolution();
+  const std::vector<double> domainKey{static_cast<double>(nData), xValues[0],
+                                      xValues[nData - 1]};
+  if (domainKey != m_resolutionDomain) {
+    m_resolution.clear();
+  }
+  if (!m_resolution.empty()) {
+    return;
+  }
+  auto &plan = fftPlan(nData);
+  int n2 = static_cast<int>(nData) / 2;
+  bool odd = n2 * 2 != static_cast<int>(nData);
+  m_resolution.resize(nData);
+  // the resolution must be defined on interval -L < xr < L, L ==
+  // (xValues[nData-1] - xValues[0]) / 2
+  std::vector<double> xr(nData);
+  double dx =
+      (xValues[nData - 1] - xValues[0]) / static_cast<double>((nData - 1));
+  // make sure that xr[nData/2] == 0.0
+  xr[n2] = 0.0;
+  for (int i = 1; i < n2; i++) {
+    double x = i * dx;
+    xr[n2 + i] = x;
+    xr[n2 - i] = -x;
+  }
+
+  xr[0] = -n2 * dx;
+  if (odd)
+    xr[nData - 1] = -xr[0];
+
+  IFunction1D_sptr fun =
+      boost::dynamic_pointer_cast<IFunction1D>(getFunction(0));
+  if (!fun) {
+    throw std::runtime_error("Convolution can work only with IFunction1D");
+  }
+  fun->function1D(m_resolution.data(), xr.data(), nData);
+
+  // rotate the data to produce the right transform
+  if (odd) {
+    double tmp = m_resolution[nData - 1];
+    for (int i = n2 - 1; i >= 0; i--) {
+      m_resolution[n2 + i + 1] = m_resolution[i];
+      m_resolution[i] = m_resolution[n2 + i];
+    }
+    m_resolution[n2] = tmp;
+  } else {
+    for (int i = 0; i < n2; i++) {
+      double tmp = m_resolution[i];
+      m_resolution[i] = m_resolution[n2 + i];
+      m_resolution[n2 + i] = tmp;
+    }
+  }
+  gsl_fft_real_transform(m_resolution.data(), 1, nData, plan.wavetable,
+                         plan.workspace);
+  std::transform(m_resolution.begin(), m_resolution.end(),
+                 m_resolution.begin(),
+                 std::bind2nd(std::multiplies<double>(), dx));
+  m_resolutionDomain = domainKey;
+}
+
+/**
+ * Convolve values of the model with the resolution using the transform in
+ * m_resolution.
+ * @param values :: The values of the model, replaced with the convolution.
+ * @param xValues :: The x values of the domain.
+ * @param nData :: The size of the domain.
+ */
+void Convolution::convolve(double *values, const double *xValues,
+                           size_t nData) const {
+  auto &plan = fftPlan(nData);
+  gsl_fft_real_transform(values, 1, nData, plan.wavetable, plan.workspace);
+
+  // Fourier transform is integration - multiply by the step in the
+  // integration variable
+  double dx = nData > 1 ? xValues[1] - xValues[0] : 1.;
+  std::transform(values, values + nData, values,
+                 std::bind2nd(std::multiplies<double>(), dx));
+
+  // now values contains fourier transform of the model function
+
+  HalfComplex res(m_resolution.data(), nData);
+  HalfComplex fun(values, nData);
+
+  // Multiply transforms of the resolution and model functions
+  // Result is stored in fun
+  for (size_t i = 0; i <= res.size(); i++) {
+    // complex multiplication
+    double res_r = res.real(i);
+    double res_i = res.imag(i);
+    double fun_r = fun.real(i);
+    double fun_i = fun.imag(i);
+    fun.set(i, res_r * fun_r - res_i * fun_i, res_r * fun_i + res_i * fun_r);
+  }
+
+  // Inverse fourier transform of fun
+  gsl_fft_halfcomplex_inverse(values, 1, nData, plan.inverseWavetable,
+                              plan.workspace);
+
+  // Inverse fourier transform is integration - multiply by the step in the
+  // integration variable
+  dx = nData > 1 ? 1. / (xValues[1] - xValues[0]) : 1.;
+  std::transform(values, values + nData, values,
+                 std::bind2nd(std::multiplies<double>(), dx));
+}
+
 /**
  * Calculates convolution of the two member functions when the
  * domain is not symmetric with respect to inversion E --> -E.
@@ -345,6 +524,8 @@ void Convolution::functionDirectMode(const FunctionDomain &domain,
     m_resolution.resize(nData);
   }
   resolution->function1D(m_resolution.data(), xValues, nData);
+  // m_resolution no longer holds a transform
+  m_resolutionDomain.clear();
 
   // Reverse the axis of the resolution data
   std::reverse(m_resolution.begin(), m_resolution.end());
@@ -476,25 +657,22 @@ size_t Convolution::addFunction(IFunction_sptr f) {
   */
 void Convolution::setUpForFit() { m_resolution.clear(); }
 
-/// Deletes and zeroes pointer m_resolution forsing function(...) to recalculate
-/// the resolution function
+/// Clears m_resolution, forcing function(...) to recalculate the resolution
+/// function, if the parameters of the resolution have changed since it was
+/// calculated. The parameters are compared rather than checked for being
+/// active so that the transform is reused while only the model changes.
 void Convolution::refreshResolution() const {
-  // refresh when calculation for the first time
-  bool needRefreshing = m_resolution.empty();
-  if (!needRefreshing) {
-    // if resolution has active parameters always refresh
-    IFunction &res = *getFunction(0);
-    for (size_t i = 0; i < res.nParams(); ++i) {
-      if (res.isActive(i)) {
-        needRefreshing = true;
-        break;
-      }
-    }
+  const IFunction &res = *getFunction(0);
+  std::vector<double> parameters(res.nParams());
+  for (size_t i = 0; i < res.nParams(); ++i) {
+    parameters[i] = res.getParameter(i);
   }
-  if (!needRefreshing)
+  if (&res == m_resolutionFunction && parameters == m_resolutionParameters)
     return;
   // delete fourier transform of the resolution to force its recalculation
   m_resolution.clear();
+  m_resolutionFunction = &res;
+  m_resolutionParameters.swap(parameters);
 }
 
 } // namespace Functions
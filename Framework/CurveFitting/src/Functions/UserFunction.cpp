@@ -4,6 +4,7 @@
 #include "MantidCurveFitting/Functions/UserFunction.h"
 #include "MantidAPI/FunctionFactory.h"
 #include "MantidAPI/MuParserUtils.h"
+#include "MantidKernel/make_unique.h"
 #include <boost/tokenizer.hpp>
 #include "MantidGeometry/muParser_Silent.h"
 
@@ -63,6 +64,8 @@ void UserFunction::setAttribute(const std::string &attName,
   }
 
   m_x_set = false;
+  m_compiled.reset();
+  m_derivatives.clear();
   clearAllParameters();
 
   try {
@@ -93,6 +96,21 @@ void UserFunction::setAttribute(const std::string &attName,
   }
 
   m_parser->SetExpr(m_formula);
+
+  // Formulas using only the operations CompiledExpression supports are
+  // evaluated over whole arrays and get analytical derivatives
+  std::vector<std::string> variables(1, "x");
+  for (size_t i = 0; i < nParams(); i++) {
+    variables.push_back(parameterName(i));
+  }
+  try {
+    m_compiled = Kernel::make_unique<CompiledExpression>(m_formula, variables);
+  } catch (std::invalid_argument &) {
+    return;
+  }
+  for (size_t i = 0; i < nParams(); i++) {
+    m_derivatives.push_back(m_compiled->derivative(i + 1));
+  }
 }
 
 /** Calculate the fitting function.
@@ -104,6 +122,10 @@ void UserFunction::setAttribute(const std::string &attName,
 */
 void UserFunction::function1D(double *out, const double *xValues,
                               const size_t nData) const {
+  if (m_compiled) {
+    m_compiled->evaluate(arguments(xValues), out, nData);
+    return;
+  }
   for (size_t i = 0; i < nData; i++) {
     m_x = xValues[i];
     out[i] = m_parser->Eval();
@@ -118,7 +140,47 @@ void UserFunction::function1D(double *out, const double *xValues,
 */
 void UserFunction::functionDeriv(const API::FunctionDomain &domain,
                                  API::Jacobian &jacobian) {
-  calNumericalDeriv(domain, jacobian);
+  if (m_compiled) {
+    IFunction1D::functionDeriv(domain, jacobian);
+  } else {
+    calNumericalDeriv(domain, jacobian);
+  }
+}
+
+/**
+ * Calculate the derivatives of the compiled formula.
+ * @param out :: The Jacobian receiving the derivatives.
+ * @param xValues :: The array of nData x-values.
+ * @param nData :: The number of points.
+ */
+void UserFunction::functionDeriv1D(API::Jacobian *out, const double *xValues,
+                                   const size_t nData) {
+  if (!m_compiled) {
+    IFunction1D::functionDeriv1D(out, xValues, nData);
+    return;
+  }
+  const auto values = arguments(xValues);
+  std::vector<double> derivative(nData);
+  for (size_t ip = 0; ip < m_derivatives.size(); ++ip) {
+    m_derivatives[ip].evaluate(values, derivative.data(), nData);
+    for (size_t i = 0; i < nData; ++i) {
+      out->set(i, ip, derivative[i]);
+    }
+  }
+}
+
+/**
+ * @param xValues :: The x values to pass to the compiled formula.
+ * @return The arguments of the compiled formula: x and the parameters.
+ */
+std::vector<CompiledExpression::Argument>
+UserFunction::arguments(const double *xValues) const {
+  std::vector<CompiledExpression::Argument> result(1 + nParams());
+  result[0] = {xValues, 0.0};
+  for (size_t i = 0; i < nParams(); i++) {
+    result[i + 1] = {nullptr, getParameter(i)};
+  }
+  return result;
 }
 
 } // namespace Functions
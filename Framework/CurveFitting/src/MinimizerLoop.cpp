@@ -0,0 +1,113 @@
+#include "MantidCurveFitting/MinimizerLoop.h"
+#include "MantidCurveFitting/CostFunctions/CostFuncFitting.h"
+
+#include "MantidAPI/CompositeFunction.h"
+#include "MantidAPI/FunctionDomain.h"
+#include "MantidKernel/Exception.h"
+#include "MantidKernel/Logger.h"
+#include "MantidKernel/ProgressBase.h"
+
+namespace Mantid {
+namespace CurveFitting {
+namespace MinimizerLoop {
+
+namespace {
+/// Logger
+Kernel::Logger g_log("Fit");
+} // namespace
+
+/**
+ * Run the minimizer's iteration loop.
+ * @param function :: The function being fitted.
+ * @param minimizer :: The initialized minimizer. recover may replace it.
+ * @param maxIterations :: The maximum number of iterations.
+ * @param recover :: Called with the number of remaining iterations when the
+ * function changes its number of parameters or ties during an iteration.
+ * @param progress :: Reported once per iteration if not null.
+ * @return Number of actual iterations.
+ */
+size_t run(API::IFunction &function, API::IFuncMinimizer_sptr &minimizer,
+           size_t maxIterations, const Recovery &recover,
+           Kernel::ProgressBase *progress) {
+  // do the fitting until success or iteration limit is reached
+  size_t iter = 0;
+  bool isFinished = false;
+  g_log.debug("Starting minimizer iteration\n");
+  while (iter < maxIterations) {
+    g_log.debug() << "Starting iteration " << iter << "\n";
+    try {
+      // Perform a single iteration. isFinished is set when minimizer wants to
+      // quit.
+      function.iterationStarting();
+      isFinished = !minimizer->iterate(iter);
+      function.iterationFinished();
+    } catch (Kernel::Exception::FitSizeWarning &) {
+      // This is an attempt to recover after the function changes its number of
+      // parameters or ties during the iteration.
+      if (auto cf = dynamic_cast<API::CompositeFunction *>(&function)) {
+        // Make sure the composite function is valid.
+        cf->checkFunction();
+      }
+      // Re-create the cost function and minimizer.
+      recover(maxIterations - iter);
+    }
+
+    if (progress) {
+      progress->report();
+    }
+    ++iter;
+    if (isFinished) {
+      // It was the last iteration. Break out of the loop and return the number
+      // of finished iterations.
+      break;
+    }
+  }
+  g_log.debug() << "Number of minimizer iterations=" << iter << "\n";
+  return iter;
+}
+
+/**
+ * Finalize the minimizer.
+ * @param minimizer :: The minimizer.
+ * @param nIterations :: The actual number of iterations done by the minimizer.
+ * @param maxIterations :: The maximum number of iterations.
+ * @return "success" or the reason the fit failed.
+ */
+std::string finalize(API::IFuncMinimizer &minimizer, size_t nIterations,
+                     size_t maxIterations) {
+  minimizer.finalize();
+
+  auto errorString = minimizer.getError();
+  g_log.debug() << "Iteration stopped. Minimizer status string=" << errorString
+                << "\n";
+
+  if (nIterations >= maxIterations) {
+    if (!errorString.empty()) {
+      errorString += '\n';
+    }
+    errorString += "Failed to converge after " + std::to_string(maxIterations) +
+                   " iterations.";
+  }
+
+  if (errorString.empty()) {
+    errorString = "success";
+  }
+  return errorString;
+}
+
+/**
+ * Divide a cost function value by the degrees of freedom of the fit.
+ * @param costFunction :: The cost function of the fit.
+ * @param costFunctionValue :: The value to divide.
+ */
+double chi2OverDoF(const CostFunctions::CostFuncFitting &costFunction,
+                   double costFunctionValue) {
+  size_t dof = costFunction.getDomain()->size() - costFunction.nParams();
+  if (dof == 0)
+    dof = 1;
+  return costFunctionValue / double(dof);
+}
+
+} // namespace MinimizerLoop
+} // namespace CurveFitting
+} // namespace Mantid
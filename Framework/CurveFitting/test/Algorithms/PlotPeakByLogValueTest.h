@@ -558,6 +558,42 @@ public:
     AnalysisDataService::Instance().clear();
   }
 
+  void test_individual_fits_give_same_results_with_and_without_output() {
+    createData();
+    const std::string function = "name=LinearBackground,A0=1,A1=0.3;name="
+                                 "Gaussian,PeakCentre=5,Height=2,Sigma=0.1";
+    auto fitWithOutput = [&function](bool createOutput) {
+      PlotPeakByLogValue alg;
+      alg.initialize();
+      alg.setPropertyValue(
+          "Input", "PlotPeakGroup_0,i1;PlotPeakGroup_1,i1;PlotPeakGroup_2,i1");
+      alg.setPropertyValue("OutputWorkspace", "PlotPeakResult");
+      alg.setPropertyValue("FitType", "Individual");
+      alg.setProperty("CreateOutput", createOutput);
+      alg.setPropertyValue("Function", function);
+      alg.execute();
+      TS_ASSERT(alg.isExecuted());
+      return WorkspaceCreationHelper::getWS<TableWorkspace>("PlotPeakResult");
+    };
+
+    // Without output the spectra are fitted by a BatchFitter
+    auto batch = fitWithOutput(false);
+    auto fits = fitWithOutput(true);
+    TS_ASSERT_EQUALS(batch->rowCount(), 3);
+    TS_ASSERT_EQUALS(batch->rowCount(), fits->rowCount());
+    TS_ASSERT_EQUALS(batch->columnCount(), fits->columnCount());
+    for (size_t row = 0; row < batch->rowCount(); ++row) {
+      for (size_t col = 0; col < batch->columnCount(); ++col) {
+        TS_ASSERT_DELTA(batch->Double(row, col), fits->Double(row, col),
+                        1e-10);
+      }
+    }
+    TS_ASSERT_DELTA(batch->Double(1, 5), 1.8, 1e-10);
+
+    deleteData();
+    AnalysisDataService::Instance().clear();
+  }
+
   void test_histogram_fit() {
     size_t nbins = 10;
     auto ws =
@@ -684,4 +720,50 @@ private:
   }
 };
 
+class PlotPeakPerformance_Expression {
+public:
+  double operator()(double x, int spec) {
+    const double c = 5. + 0.0005 * spec;
+    return 1. + 0.3 * x + 2. * exp(-0.5 * (x - c) * (x - c) / 0.01);
+  }
+};
+
+class PlotPeakByLogValueTestPerformance : public CxxTest::TestSuite {
+public:
+  static PlotPeakByLogValueTestPerformance *createSuite() {
+    return new PlotPeakByLogValueTestPerformance();
+  }
+  static void destroySuite(PlotPeakByLogValueTestPerformance *suite) {
+    delete suite;
+  }
+
+  PlotPeakByLogValueTestPerformance() {
+    FrameworkManager::Instance();
+    auto ws = WorkspaceCreationHelper::create2DWorkspaceFromFunction(
+        PlotPeakPerformance_Expression(), 2000, 0, 10, 0.05, false);
+    AnalysisDataService::Instance().addOrReplace("PlotPeakPerformance", ws);
+  }
+
+  ~PlotPeakByLogValueTestPerformance() override {
+    AnalysisDataService::Instance().clear();
+  }
+
+  void test_individual_fits() { fit("Individual"); }
+
+  void test_sequential_fits() { fit("Sequential"); }
+
+private:
+  void fit(const std::string &fitType) {
+    PlotPeakByLogValue alg;
+    alg.initialize();
+    alg.setPropertyValue("Input", "PlotPeakPerformance,v1:2000");
+    alg.setPropertyValue("OutputWorkspace", "PlotPeakPerformanceResult");
+    alg.setPropertyValue("FitType", fitType);
+    alg.setPropertyValue("Function", "name=LinearBackground,A0=1,A1=0.3;name="
+                                     "Gaussian,PeakCentre=5,Height=2,Sigma=0."
+                                     "1");
+    TS_ASSERT_THROWS_NOTHING(alg.execute());
+  }
+};
+
 #endif /*PLOTPEAKBYLOGVALUETEST_H_*/
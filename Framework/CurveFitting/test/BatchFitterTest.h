@@ -0,0 +1,98 @@
+#ifndef MANTID_CURVEFITTING_BATCHFITTERTEST_H_
+#define MANTID_CURVEFITTING_BATCHFITTERTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidAPI/FrameworkManager.h"
+#include "MantidAPI/FunctionFactory.h"
+#include "MantidAPI/MatrixWorkspace.h"
+#include "MantidAPI/MultiDomainFunction.h"
+#include "MantidCurveFitting/Algorithms/Fit.h"
+#include "MantidCurveFitting/BatchFitter.h"
+#include "MantidTestHelpers/WorkspaceCreationHelper.h"
+
+using Mantid::CurveFitting::BatchFitter;
+using namespace Mantid::API;
+
+namespace {
+struct PeakOnBackground {
+  double operator()(double x, int spec) {
+    const double c = 5.0 + 0.1 * spec;
+    return 1.0 + 0.3 * x + 2.0 * std::exp(-0.5 * (x - c) * (x - c) / 0.09);
+  }
+};
+
+struct Step {
+  double operator()(double x, int) { return x < 5.0 ? 1.0 : 3.0; }
+};
+
+const std::string PEAK_FUNCTION = "name=LinearBackground,A0=1.2,A1=0.2;"
+                                  "name=Gaussian,PeakCentre=5.1,Height=1.5,"
+                                  "Sigma=0.4";
+}
+
+class BatchFitterTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static BatchFitterTest *createSuite() { return new BatchFitterTest(); }
+  static void destroySuite(BatchFitterTest *suite) { delete suite; }
+
+  BatchFitterTest() { FrameworkManager::Instance(); }
+
+  void test_fit_gives_same_result_as_Fit() {
+    MatrixWorkspace_sptr ws =
+        WorkspaceCreationHelper::create2DWorkspaceFromFunction(
+            PeakOnBackground(), 3, 0.0, 10.0, 0.05);
+
+    auto expected =
+        FunctionFactory::Instance().createInitialized(PEAK_FUNCTION);
+    Mantid::CurveFitting::Algorithms::Fit fit;
+    fit.initialize();
+    fit.setChild(true);
+    fit.setProperty("Function", expected);
+    fit.setProperty("InputWorkspace", ws);
+    fit.setProperty("WorkspaceIndex", 2);
+    fit.setProperty("CalcErrors", true);
+    fit.execute();
+    const double chi2 = fit.getProperty("OutputChi2overDoF");
+
+    auto function =
+        FunctionFactory::Instance().createInitialized(PEAK_FUNCTION);
+    BatchFitter fitter("Levenberg-Marquardt", "Least squares", 500);
+    const auto result = fitter.fit(function, ws, 2);
+
+    TS_ASSERT_EQUALS(result.status, fit.getPropertyValue("OutputStatus"));
+    TS_ASSERT_EQUALS(result.status, "success");
+    TS_ASSERT_DELTA(result.chi2OverDoF, chi2, 1e-12);
+    for (size_t i = 0; i < function->nParams(); ++i) {
+      TS_ASSERT_DELTA(function->getParameter(i), expected->getParameter(i),
+                      1e-12);
+      TS_ASSERT_DELTA(function->getError(i), expected->getError(i), 1e-12);
+    }
+    TS_ASSERT_DELTA(function->getParameter("f1.PeakCentre"), 5.2, 1e-6);
+  }
+
+  void test_fit_only_uses_data_in_range() {
+    MatrixWorkspace_sptr ws =
+        WorkspaceCreationHelper::create2DWorkspaceFromFunction(Step(), 1, 0.0,
+                                                               10.0, 0.1);
+    auto function =
+        FunctionFactory::Instance().createInitialized("name=FlatBackground");
+    BatchFitter fitter("Levenberg-Marquardt", "Least squares", 500);
+    fitter.setRange(6.0, 9.0);
+    fitter.fit(function, ws, 0);
+    TS_ASSERT_DELTA(function->getParameter(0), 3.0, 1e-10);
+  }
+
+  void test_canFit() {
+    auto peak = FunctionFactory::Instance().createInitialized(PEAK_FUNCTION);
+    TS_ASSERT(BatchFitter::canFit(*peak));
+    auto multi = FunctionFactory::Instance().createInitialized(
+        "composite=MultiDomainFunction;name=FlatBackground,$domains=i;"
+        "name=FlatBackground,$domains=i");
+    TS_ASSERT(!BatchFitter::canFit(*multi));
+  }
+};
+
+#endif /* MANTID_CURVEFITTING_BATCHFITTERTEST_H_ */
@@ -430,6 +430,54 @@ public:
     TS_ASSERT_EQUALS(s.getError(), "success");
   }
 
+  void test_thread_safe_only_if_all_members_are() {
+    auto fun = boost::dynamic_pointer_cast<CompositeFunction>(
+        FunctionFactory::Instance().createInitialized(
+            "name=Gaussian;name=LinearBackground"));
+    TS_ASSERT(fun->isThreadSafe());
+    fun->addFunction(boost::make_shared<CurveFittingLinear>());
+    TS_ASSERT(!fun->isThreadSafe());
+  }
+
+  void test_numerical_derivatives_match_analytic_ones() {
+    auto numeric = createPeaks();
+    numeric->setAttributeValue("NumDeriv", true);
+    auto analytic = createPeaks();
+    checkNumericalDerivatives(*numeric, *analytic);
+  }
+
+  void test_numerical_derivatives_follow_parameter_changes() {
+    auto numeric = createPeaks();
+    numeric->setAttributeValue("NumDeriv", true);
+    auto analytic = createPeaks();
+    checkNumericalDerivatives(*numeric, *analytic);
+    // The copies of the function evaluated by the threads are kept between
+    // calls and must be given the new parameter values
+    for (int i = 0; i < 10; ++i) {
+      const std::string sigma = "f" + std::to_string(i + 1) + ".Sigma";
+      numeric->setParameter(sigma, 0.3);
+      analytic->setParameter(sigma, 0.3);
+    }
+    checkNumericalDerivatives(*numeric, *analytic);
+  }
+
+  void test_numerical_derivatives_follow_replaced_members() {
+    auto numeric =
+        boost::dynamic_pointer_cast<CompositeFunction>(createPeaks());
+    numeric->setAttributeValue("NumDeriv", true);
+    auto analytic =
+        boost::dynamic_pointer_cast<CompositeFunction>(createPeaks());
+    checkNumericalDerivatives(*numeric, *analytic);
+    // A member with the same number of parameters must not leave the kept
+    // copies of the old member in use
+    const std::string lorentzian =
+        "name=Lorentzian,Amplitude=10,PeakCentre=3,FWHM=0.5";
+    auto &factory = FunctionFactory::Instance();
+    numeric->replaceFunction(3, factory.createInitialized(lorentzian));
+    analytic->replaceFunction(3, factory.createInitialized(lorentzian));
+    checkNumericalDerivatives(*numeric, *analytic);
+  }
+
   void test_constraints_str() {
     auto fun = FunctionFactory::Instance().createInitialized(
         "name=Gaussian,constraints=(Height>0)");
@@ -510,6 +558,100 @@ public:
                                       "LinearBackground,A0=0,A1=0,ties=(A0=A1);"
                                       "ties=(f0.Sigma=f1.A1)");
   }
+private:
+  /// A background and 10 Gaussians with enough data points for the
+  /// numerical derivatives to be calculated in parallel
+  IFunction_sptr createPeaks() {
+    std::string definition = "name=LinearBackground,A0=1,A1=0.1";
+    for (int i = 0; i < 10; ++i) {
+      definition += ";name=Gaussian,Height=" + std::to_string(10 + i) +
+                    ",PeakCentre=" + std::to_string(1 + i) + ",Sigma=0.5";
+    }
+    return FunctionFactory::Instance().createInitialized(definition);
+  }
+
+  void checkNumericalDerivatives(IFunction &numeric, IFunction &analytic) {
+    const size_t np = analytic.nParams();
+    std::vector<double> parameters(np);
+    for (size_t i = 0; i < np; ++i) {
+      parameters[i] = numeric.getParameter(i);
+    }
+
+    FunctionDomain1DVector domain(0.0, 12.0, 401);
+    TS_ASSERT_LESS_THAN_EQUALS(IFunction::MIN_WORK_FOR_PARALLEL_DERIVATIVES,
+                               domain.size() * np);
+    GSLJacobian numericJacobian(numeric, domain.size());
+    GSLJacobian analyticJacobian(analytic, domain.size());
+    numeric.functionDeriv(domain, numericJacobian);
+    analytic.functionDeriv(domain, analyticJacobian);
+
+    for (size_t ip = 0; ip < np; ++ip) {
+      TS_ASSERT_EQUALS(numeric.getParameter(ip), parameters[ip]);
+      double scale = 0.0;
+      for (size_t i = 0; i < domain.size(); ++i) {
+        scale = std::max(scale, std::fabs(analyticJacobian.get(i, ip)));
+      }
+      for (size_t i = 0; i < domain.size(); ++i) {
+        TS_ASSERT_DELTA(numericJacobian.get(i, ip), analyticJacobian.get(i, ip),
+                        0.02 * scale);
+      }
+    }
+  }
+};
+
+class CompositeFunctionTestPerformance : public CxxTest::TestSuite {
+public:
+  static CompositeFunctionTestPerformance *createSuite() {
+    return new CompositeFunctionTestPerformance();
+  }
+  static void destroySuite(CompositeFunctionTestPerformance *suite) {
+    delete suite;
+  }
+
+  CompositeFunctionTestPerformance()
+      : m_domain(boost::make_shared<FunctionDomain1DVector>(0.0, 100.0,
+                                                            20000)) {
+    FrameworkManager::Instance();
+    // 25 peaks with numerical derivatives and a background: 127 parameters
+    std::string definition = "name=LinearBackground,A0=1,A1=0.01";
+    for (int i = 0; i < 25; ++i) {
+      definition += ";name=BackToBackExponential,I=" + std::to_string(10 + i) +
+                    ",A=2,B=1.5,X0=" + std::to_string(2 + 4 * i) + ",S=0.3";
+    }
+    m_function = FunctionFactory::Instance().createInitialized(definition);
+    m_values = boost::make_shared<FunctionValues>(*m_domain);
+    m_function->function(*m_domain, *m_values);
+    m_values->setFitDataFromCalculated(*m_values);
+    m_values->setFitWeights(1.0);
+  }
+
+  void test_member_jacobians() {
+    GSLJacobian jacobian(*m_function, m_domain->size());
+    m_function->setAttributeValue("NumDeriv", false);
+    for (int i = 0; i < 5; ++i) {
+      m_function->functionDeriv(*m_domain, jacobian);
+    }
+  }
+
+  void test_numerical_jacobian() {
+    GSLJacobian jacobian(*m_function, m_domain->size());
+    m_function->setAttributeValue("NumDeriv", true);
+    for (int i = 0; i < 5; ++i) {
+      m_function->functionDeriv(*m_domain, jacobian);
+    }
+  }
+
+  void test_least_squares_hessian() {
+    m_function->setAttributeValue("NumDeriv", false);
+    CostFuncLeastSquares costFunction;
+    costFunction.setFittingFunction(m_function, m_domain, m_values);
+    TS_ASSERT_THROWS_NOTHING(costFunction.valDerivHessian());
+  }
+
+private:
+  FunctionDomain1D_sptr m_domain;
+  FunctionValues_sptr m_values;
+  IFunction_sptr m_function;
 };
 
 #endif /*CURVEFITTING_COMPOSITEFUNCTIONTEST_H_*/
@@ -5,9 +5,12 @@
 
 #include "MantidCurveFitting/Functions/Convolution.h"
 #include "MantidCurveFitting/Functions/DeltaFunction.h"
+#include "MantidCurveFitting/Jacobian.h"
 
 #include "MantidDataObjects/TableWorkspace.h"
 #include "MantidAPI/FunctionFactory.h"
+#include "MantidAPI/FunctionDomain1D.h"
+#include "MantidAPI/FunctionValues.h"
 
 using namespace Mantid;
 using namespace Mantid::API;
@@ -152,6 +155,25 @@ DECLARE_FUNCTION(ConvolutionTest_Gauss)
 DECLARE_FUNCTION(ConvolutionTest_Lorentz)
 DECLARE_FUNCTION(ConvolutionTest_Linear)
 
+namespace {
+/// A quasielastic model convolved with a fixed resolution
+const std::string QENS_FUNCTION =
+    "composite=Convolution,FixResolution=true;"
+    "name=Gaussian,Height=1.2,PeakCentre=0.01,Sigma=0.05;"
+    "(name=DeltaFunction,Height=0.7,Centre=0.02;"
+    "name=Lorentzian,Amplitude=2.0,PeakCentre=-0.01,FWHM=0.2)";
+
+/// A domain symmetric with respect to x = 0, where the FFT mode is used
+std::vector<double> symmetricX(size_t n, double xMax) {
+  std::vector<double> x(n);
+  const double dx = 2.0 * xMax / static_cast<double>(n - 1);
+  for (size_t i = 0; i < n; ++i) {
+    x[i] = -xMax + dx * static_cast<double>(i);
+  }
+  return x;
+}
+}
+
 class ConvolutionTest : public CxxTest::TestSuite {
 public:
   void testFunction() {
@@ -394,12 +416,131 @@ public:
     }
   }
 
+  void test_derivatives_with_fixed_resolution() {
+    checkDerivatives(QENS_FUNCTION);
+  }
+
+  void test_derivatives_of_delta_function_subclass_with_fixed_resolution() {
+    // The height of ElasticDiffSphere depends on its Radius
+    checkDerivatives("composite=Convolution,FixResolution=true;"
+                     "name=Gaussian,Height=1.2,PeakCentre=0.01,Sigma=0.05;"
+                     "(name=ElasticDiffSphere,Q=0.5,Height=0.7,Centre=0.02,"
+                     "Radius=3.5;name=Lorentzian,Amplitude=2.0,"
+                     "PeakCentre=-0.01,FWHM=0.2)");
+  }
+
+  void test_NumDeriv_gives_numerical_derivatives() {
+    auto conv = FunctionFactory::Instance().createInitialized(
+        "composite=Convolution,FixResolution=true,NumDeriv=true;" +
+        QENS_FUNCTION.substr(QENS_FUNCTION.find(';') + 1));
+    const auto x = symmetricX(201, 1.0);
+    FunctionDomain1DView domain(x.data(), x.size());
+    Mantid::CurveFitting::Jacobian jacobian(x.size(), conv->nParams());
+    Mantid::CurveFitting::Jacobian numerical(x.size(), conv->nParams());
+    conv->functionDeriv(domain, jacobian);
+    conv->calNumericalDeriv(domain, numerical);
+    for (size_t ip = 0; ip < conv->nParams(); ++ip) {
+      for (size_t i = 0; i < x.size(); ++i) {
+        TS_ASSERT_EQUALS(jacobian.get(i, ip), numerical.get(i, ip));
+      }
+    }
+  }
+
+  void test_resolution_is_recalculated_when_domain_or_parameters_change() {
+    auto conv = FunctionFactory::Instance().createInitialized(QENS_FUNCTION);
+    const auto x1 = symmetricX(201, 1.0);
+    const auto x2 = symmetricX(201, 0.5);
+    FunctionDomain1DView domain1(x1.data(), x1.size());
+    FunctionDomain1DView domain2(x2.data(), x2.size());
+    FunctionValues values(domain1);
+    conv->function(domain1, values);
+
+    auto check = [&conv](const FunctionDomain1D &domain) {
+      FunctionValues cached(domain), expected(domain);
+      conv->function(domain, cached);
+      auto fresh = FunctionFactory::Instance().createInitialized(
+          conv->asString());
+      fresh->function(domain, expected);
+      for (size_t i = 0; i < domain.size(); ++i) {
+        TS_ASSERT_DELTA(cached.getCalculated(i), expected.getCalculated(i),
+                        1e-12);
+      }
+    };
+    check(domain2);
+    conv->setParameter("f0.Sigma", 0.08);
+    check(domain2);
+    check(domain1);
+  }
+
   void testForCategories() {
     Convolution forCat;
     const std::vector<std::string> categories = forCat.categories();
     TS_ASSERT(categories.size() == 1);
     TS_ASSERT(categories[0] == "General");
   }
+
+private:
+  /// Compare the derivatives of a convolution with numerical ones
+  void checkDerivatives(const std::string &functionString) {
+    auto conv = FunctionFactory::Instance().createInitialized(functionString);
+    const auto x = symmetricX(201, 1.0);
+    FunctionDomain1DView domain(x.data(), x.size());
+    Mantid::CurveFitting::Jacobian jacobian(x.size(), conv->nParams());
+    Mantid::CurveFitting::Jacobian numerical(x.size(), conv->nParams());
+    conv->functionDeriv(domain, jacobian);
+    conv->calNumericalDeriv(domain, numerical);
+    for (size_t ip = 0; ip < conv->nParams(); ++ip) {
+      if (!conv->isActive(ip)) {
+        continue;
+      }
+      double scale = 0.0;
+      for (size_t i = 0; i < x.size(); ++i) {
+        scale = std::max(scale, std::fabs(numerical.get(i, ip)));
+      }
+      TSM_ASSERT_LESS_THAN(conv->parameterName(ip), 0.0, scale);
+      for (size_t i = 0; i < x.size(); ++i) {
+        TS_ASSERT_DELTA(jacobian.get(i, ip), numerical.get(i, ip),
+                        1e-4 * scale);
+      }
+    }
+  }
+
+};
+
+class ConvolutionTestPerformance : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static ConvolutionTestPerformance *createSuite() {
+    return new ConvolutionTestPerformance();
+  }
+  static void destroySuite(ConvolutionTestPerformance *suite) {
+    delete suite;
+  }
+
+  ConvolutionTestPerformance()
+      : m_x(symmetricX(2001, 1.0)), m_domain(m_x.data(), m_x.size()),
+        m_values(m_domain) {
+    m_function = FunctionFactory::Instance().createInitialized(QENS_FUNCTION);
+  }
+
+  /// The evaluations of a fit of a quasielastic spectrum
+  void test_fit_iterations() {
+    Mantid::CurveFitting::Jacobian jacobian(m_x.size(),
+                                            m_function->nParams());
+    for (size_t iteration = 0; iteration < 500; ++iteration) {
+      m_function->setParameter("f1.f1.FWHM",
+                               0.2 + 1e-4 * static_cast<double>(iteration));
+      m_function->function(m_domain, m_values);
+      m_function->functionDeriv(m_domain, jacobian);
+    }
+  }
+
+private:
+  std::vector<double> m_x;
+  FunctionDomain1DView m_domain;
+  FunctionValues m_values;
+  IFunction_sptr m_function;
 };
 
 #endif /*CONVOLUTIONTEST_H_*/
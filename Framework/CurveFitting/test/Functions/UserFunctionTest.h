@@ -7,6 +7,9 @@
 #include "MantidAPI/Jacobian.h"
 #include "MantidAPI/FunctionDomain1D.h"
 
+#include <algorithm>
+#include <cmath>
+
 using namespace Mantid::CurveFitting;
 using namespace Mantid::CurveFitting::Functions;
 using namespace Mantid::API;
@@ -78,6 +81,54 @@ public:
     TS_ASSERT(categories.size() == 1);
     TS_ASSERT(categories[0] == "General");
   }
+
+  void test_derivatives_of_compiled_formula_are_exact() {
+    UserFunction fun;
+    fun.setAttribute("Formula",
+                     UserFunction::Attribute("h*exp(-(x-c)^2/(2*s^2))"));
+    fun.setParameter("h", 2.2);
+    fun.setParameter("c", 0.4);
+    fun.setParameter("s", 0.3);
+    TS_ASSERT(fun.isThreadSafe());
+
+    const size_t nData = 10;
+    std::vector<double> x(nData);
+    for (size_t i = 0; i < nData; i++) {
+      x[i] = 0.1 * static_cast<double>(i);
+    }
+    FunctionDomain1DVector domain(x);
+    UserTestJacobian J(nData, 3);
+    fun.functionDeriv(domain, J);
+    for (size_t i = 0; i < nData; i++) {
+      const double dx = x[i] - 0.4;
+      const double e = exp(-dx * dx / 0.18);
+      TS_ASSERT_DELTA(J.get(i, 0), e, 1e-12);
+      TS_ASSERT_DELTA(J.get(i, 1), 2.2 * e * dx / 0.09, 1e-12);
+      TS_ASSERT_DELTA(J.get(i, 2), 2.2 * e * dx * dx / 0.027, 1e-12);
+    }
+  }
+
+  void test_formula_not_compiled_uses_muParser() {
+    UserFunction fun;
+    fun.setAttribute("Formula", UserFunction::Attribute("a*min(x,c)"));
+    fun.setParameter("a", 2.0);
+    fun.setParameter("c", 0.5);
+    TS_ASSERT(!fun.isThreadSafe());
+
+    const size_t nData = 10;
+    std::vector<double> x(nData), y(nData);
+    for (size_t i = 0; i < nData; i++) {
+      x[i] = 0.1 * static_cast<double>(i);
+    }
+    fun.function1D(&y[0], &x[0], nData);
+    FunctionDomain1DVector domain(x);
+    UserTestJacobian J(nData, 2);
+    fun.functionDeriv(domain, J);
+    for (size_t i = 0; i < nData; i++) {
+      TS_ASSERT_DELTA(y[i], 2.0 * std::min(x[i], 0.5), 1e-12);
+      TS_ASSERT_DELTA(J.get(i, 0), std::min(x[i], 0.5), 1e-6);
+    }
+  }
 };
 
 #endif /*USERFUNCTIONTEST_H_*/
@@ -0,0 +1,96 @@
+#ifndef MANTID_CURVEFITTING_MINIMIZERLOOPTEST_H_
+#define MANTID_CURVEFITTING_MINIMIZERLOOPTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidAPI/FunctionDomain1D.h"
+#include "MantidAPI/FunctionValues.h"
+#include "MantidCurveFitting/CostFunctions/CostFuncLeastSquares.h"
+#include "MantidCurveFitting/FuncMinimizers/LevenbergMarquardtMDMinimizer.h"
+#include "MantidCurveFitting/Functions/UserFunction.h"
+#include "MantidCurveFitting/MinimizerLoop.h"
+
+using namespace Mantid::API;
+using namespace Mantid::CurveFitting;
+using Mantid::CurveFitting::CostFunctions::CostFuncLeastSquares;
+using Mantid::CurveFitting::FuncMinimisers::LevenbergMarquardtMDMinimizer;
+using Mantid::CurveFitting::Functions::UserFunction;
+
+class MinimizerLoopTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static MinimizerLoopTest *createSuite() { return new MinimizerLoopTest(); }
+  static void destroySuite(MinimizerLoopTest *suite) { delete suite; }
+
+  void test_run_stops_when_the_minimizer_converges() {
+    auto costFunction = createCostFunction();
+    IFuncMinimizer_sptr minimizer =
+        boost::make_shared<LevenbergMarquardtMDMinimizer>();
+    minimizer->initialize(costFunction, 500);
+    bool recovered = false;
+
+    const size_t iterations = MinimizerLoop::run(
+        *m_function, minimizer, 500,
+        [&recovered](size_t) { recovered = true; });
+
+    TS_ASSERT_LESS_THAN(iterations, 500);
+    TS_ASSERT(!recovered);
+    TS_ASSERT_EQUALS(MinimizerLoop::finalize(*minimizer, iterations, 500),
+                     "success");
+    TS_ASSERT_DELTA(m_function->getParameter("a"), 1.1, 0.001);
+    TS_ASSERT_DELTA(m_function->getParameter("b"), 2.2, 0.001);
+  }
+
+  void test_finalize_reports_the_iteration_limit() {
+    auto costFunction = createCostFunction();
+    IFuncMinimizer_sptr minimizer =
+        boost::make_shared<LevenbergMarquardtMDMinimizer>();
+    minimizer->initialize(costFunction, 1);
+
+    const size_t iterations =
+        MinimizerLoop::run(*m_function, minimizer, 1, [](size_t) {});
+
+    TS_ASSERT_EQUALS(iterations, 1);
+    const auto status = MinimizerLoop::finalize(*minimizer, iterations, 1);
+    TS_ASSERT_DIFFERS(status.find("Failed to converge after 1 iterations."),
+                      std::string::npos);
+  }
+
+  void test_chi2OverDoF_divides_by_the_degrees_of_freedom() {
+    auto costFunction = createCostFunction();
+    // 20 points and 2 parameters
+    TS_ASSERT_DELTA(MinimizerLoop::chi2OverDoF(*costFunction, 36.0), 2.0,
+                    1e-15);
+  }
+
+private:
+  /// Least squares of a straight line to 20 points
+  boost::shared_ptr<CostFuncLeastSquares> createCostFunction() {
+    FunctionDomain1D_sptr domain =
+        boost::make_shared<FunctionDomain1DVector>(0.0, 10.0, 20);
+    FunctionValues mockData(*domain);
+    UserFunction dataMaker;
+    dataMaker.setAttributeValue("Formula", "a*x+b");
+    dataMaker.setParameter("a", 1.1);
+    dataMaker.setParameter("b", 2.2);
+    dataMaker.function(*domain, mockData);
+
+    auto values = boost::make_shared<FunctionValues>(*domain);
+    values->setFitDataFromCalculated(mockData);
+    values->setFitWeights(1.0);
+
+    m_function = boost::make_shared<UserFunction>();
+    m_function->setAttributeValue("Formula", "a*x+b");
+    m_function->setParameter("a", 1.);
+    m_function->setParameter("b", 2.);
+
+    auto costFunction = boost::make_shared<CostFuncLeastSquares>();
+    costFunction->setFittingFunction(m_function, domain, values);
+    return costFunction;
+  }
+
+  boost::shared_ptr<UserFunction> m_function;
+};
+
+#endif /* MANTID_CURVEFITTING_MINIMIZERLOOPTEST_H_ */
@@ -0,0 +1,99 @@
+#ifndef MANTID_DATAHANDLING_EVENTCACHEFILE_H_
+#define MANTID_DATAHANDLING_EVENTCACHEFILE_H_
+
+#include "MantidDataObjects/EventWorkspace.h"
+#include "MantidKernel/System.h"
+
+#include <Poco/SharedMemory.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Mantid {
+namespace DataHandling {
+
+/** EventCacheFile : A compact binary file of the events in an EventWorkspace
+  that is read through a read-only memory mapping.
+
+  The file holds a header, the spectrum numbers and detector IDs of every
+  spectrum, and the (time-of-flight, pulse time) pairs of all the events
+  stored contiguously spectrum by spectrum. Opening the file maps it into the
+  address space without reading it, so the events of a spectrum are only
+  paged in from disk by the operating system when they are accessed and pages
+  that are no longer used can be dropped again. This allows spectra to be
+  loaded or histogrammed from files much larger than the available memory.
+
+  The file uses the native byte order and is intended as a local cache, not
+  an archival or exchange format.
+
+  Copyright &copy; 2017 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class DLLExport EventCacheFile {
+public:
+  /// An event as it is stored in the file
+  struct Event {
+    double tof;
+    int64_t pulseTime;
+  };
+
+  static void write(const std::string &filename,
+                    const DataObjects::EventWorkspace &workspace);
+
+  explicit EventCacheFile(const std::string &filename);
+
+  /// @return the number of spectra in the file
+  size_t getNumberHistograms() const { return m_numSpectra; }
+  /// @return the total number of events in the file
+  size_t getNumberEvents() const { return m_eventOffsets[m_numSpectra]; }
+  /// @return the name of the instrument of the saved workspace
+  const std::string &instrumentName() const { return m_instrumentName; }
+
+  specnum_t spectrumNumber(const size_t index) const;
+  std::vector<detid_t> detectorIDs(const size_t index) const;
+  size_t numberOfEvents(const size_t index) const;
+  const Event *eventsBegin(const size_t index) const;
+  const Event *eventsEnd(const size_t index) const;
+
+private:
+  /// The mapping of the whole file
+  Poco::SharedMemory m_memory;
+  /// Number of spectra
+  size_t m_numSpectra;
+  /// Instrument name
+  std::string m_instrumentName;
+  /// Index of the first event of each spectrum, and the total at the end
+  const uint64_t *m_eventOffsets;
+  /// Index of the first detector ID of each spectrum, and the total at the end
+  const uint64_t *m_detectorOffsets;
+  /// Spectrum numbers
+  const int32_t *m_spectrumNumbers;
+  /// Detector IDs of all spectra
+  const int32_t *m_detectorIDs;
+  /// All the events
+  const Event *m_events;
+};
+
+} // namespace DataHandling
+} // namespace Mantid
+
+#endif /* MANTID_DATAHANDLING_EVENTCACHEFILE_H_ */
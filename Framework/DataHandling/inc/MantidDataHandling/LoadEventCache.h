@@ -0,0 +1,71 @@
+#ifndef MANTID_DATAHANDLING_LOADEVENTCACHE_H_
+#define MANTID_DATAHANDLING_LOADEVENTCACHE_H_
+
+#include "MantidAPI/Algorithm.h"
+#include "MantidAPI/MatrixWorkspace_fwd.h"
+#include "MantidKernel/System.h"
+
+namespace Mantid {
+namespace DataHandling {
+class EventCacheFile;
+
+/** LoadEventCache : Loads or histograms spectra from an event cache file
+  written by SaveEventCache. The file is memory mapped, so only the events of
+  the requested spectra are read from disk, and when binning parameters are
+  given the events are histogrammed straight from the mapping without being
+  held in memory.
+
+  Copyright &copy; 2017 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class DLLExport LoadEventCache : public API::Algorithm {
+public:
+  const std::string name() const override;
+  int version() const override;
+  const std::string category() const override;
+  const std::string summary() const override;
+
+private:
+  void init() override;
+  void exec() override;
+  std::map<std::string, std::string> validateInputs() override;
+
+  API::MatrixWorkspace_sptr loadEvents(const EventCacheFile &file);
+  API::MatrixWorkspace_sptr histogramEvents(const EventCacheFile &file,
+                                            const std::vector<double> &params);
+  void setSpectra(const EventCacheFile &file, API::MatrixWorkspace &ws);
+  void runLoadInstrument(const std::string &instrumentName,
+                         API::MatrixWorkspace_sptr ws);
+
+  /// First workspace index in the file to load
+  size_t m_startIndex{0};
+  /// Number of spectra to load
+  size_t m_numSpectra{0};
+  /// Smallest time-of-flight to keep
+  double m_tofMin{0.};
+  /// Largest time-of-flight to keep
+  double m_tofMax{0.};
+};
+
+} // namespace DataHandling
+} // namespace Mantid
+
+#endif /* MANTID_DATAHANDLING_LOADEVENTCACHE_H_ */
@@ -25,6 +25,7 @@
 
 #include <boost/lexical_cast.hpp>
 #include <boost/scoped_array.hpp>
+#include <condition_variable>
 #include <functional>
 #include <memory>
 #include <mutex>
@@ -215,6 +216,9 @@ public:
   /// whether or not to launch multiple ProcessBankData jobs per bank
   bool splitProcessing;
 
+  void reserveEventBuffer(const size_t bytes);
+  void releaseEventBuffer(const size_t bytes);
+
   /// Flag for dealing with a simulated file
   bool m_haveWeights;
 
@@ -227,12 +231,26 @@ public:
   std::vector<std::vector<WeightedEventVector_pt>> weightedEventVectors;
 
 private:
+  /// Limit in bytes on event data read from file but not yet processed. 0
+  /// means no limit.
+  size_t m_eventBufferLimit;
+  /// Bytes of event data read from file but not yet processed
+  size_t m_eventBufferInUse;
+  /// Mutex protecting m_eventBufferInUse
+  std::mutex m_eventBufferMutex;
+  /// Signalled when event data has been processed and its memory released
+  std::condition_variable m_eventBufferReleased;
+
   /// Intialisation code
   void init() override;
 
   /// Execution code
   void exec() override;
 
+  Parallel::ExecutionMode getParallelExecutionMode(
+      const std::map<std::string, Parallel::StorageMode> &storageModes)
+      const override;
+
   DataObjects::EventWorkspace_sptr createEmptyEventWorkspace();
 
   /// Map detector IDs to event lists.
@@ -241,6 +259,7 @@ private:
 
   void createWorkspaceIndexMaps(const bool monitors,
                                 const std::vector<std::string> &bankNames);
+  void partitionSpectra();
   void loadEvents(API::Progress *const prog, const bool monitors);
   void createSpectraMapping(
       const std::string &nxsfile, const bool monitorsOnly,
@@ -0,0 +1,194 @@
+#include "MantidDataHandling/EventCacheFile.h"
+#include "MantidGeometry/Instrument.h"
+
+#include <Poco/File.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace Mantid {
+namespace DataHandling {
+
+using namespace DataObjects;
+
+namespace {
+/// Identifies an event cache file
+const char MAGIC[8] = {'M', 'T', 'D', 'E', 'V', 'C', 'A', 'C'};
+/// Version of the layout
+const uint64_t VERSION = 1;
+
+/// The start of the file. Every section that follows starts on 8 bytes.
+struct Header {
+  char magic[8];
+  uint64_t version;
+  uint64_t numSpectra;
+  uint64_t numEvents;
+  uint64_t numDetectorIDs;
+  uint64_t instrumentNameLength;
+};
+
+/// @return bytes rounded up to a multiple of 8
+size_t padded(const size_t bytes) { return (bytes + 7) / 8 * 8; }
+
+/// Write a block of data followed by zeros up to the next multiple of 8 bytes
+void writePadded(std::ofstream &file, const void *data, const size_t bytes) {
+  file.write(static_cast<const char *>(data), bytes);
+  const char zeros[8] = {0};
+  file.write(zeros, padded(bytes) - bytes);
+}
+
+/// Reads consecutive sections from the mapped file, checking its size
+class SectionReader {
+public:
+  SectionReader(const char *begin, const char *end, const std::string &name)
+      : m_position(begin), m_end(end), m_name(name) {}
+
+  template <typename T> const T *read(const size_t count) {
+    const size_t bytes = padded(count * sizeof(T));
+    if (static_cast<size_t>(m_end - m_position) < bytes)
+      throw std::runtime_error("Event cache file " + m_name +
+                               " is truncated.");
+    const T *section = reinterpret_cast<const T *>(m_position);
+    m_position += bytes;
+    return section;
+  }
+
+private:
+  const char *m_position;
+  const char *m_end;
+  const std::string &m_name;
+};
+}
+
+//----------------------------------------------------------------------------------------------
+/** Write the events of a workspace to an event cache file.
+ * @param filename :: The path of the file to write
+ * @param workspace :: A workspace containing TOF events
+ * @throw std::invalid_argument if the events are weighted
+ * @throw std::runtime_error if the file cannot be written
+ */
+void EventCacheFile::write(const std::string &filename,
+                           const EventWorkspace &workspace) {
+  if (workspace.getEventType() != TOF)
+    throw std::invalid_argument(
+        "Only workspaces with unweighted (TOF) events can be cached.");
+
+  const size_t numSpectra = workspace.getNumberHistograms();
+  std::vector<uint64_t> eventOffsets(numSpectra + 1, 0);
+  std::vector<uint64_t> detectorOffsets(numSpectra + 1, 0);
+  std::vector<int32_t> spectrumNumbers(numSpectra);
+  std::vector<int32_t> detectorIDs;
+  for (size_t i = 0; i < numSpectra; ++i) {
+    const auto &spectrum = workspace.getSpectrum(i);
+    spectrumNumbers[i] = spectrum.getSpectrumNo();
+    const auto &ids = spectrum.getDetectorIDs();
+    detectorIDs.insert(detectorIDs.end(), ids.begin(), ids.end());
+    eventOffsets[i + 1] = eventOffsets[i] + spectrum.getNumberEvents();
+    detectorOffsets[i + 1] = detectorIDs.size();
+  }
+
+  const auto instrument = workspace.getInstrument();
+  const std::string instrumentName = instrument ? instrument->getName() : "";
+
+  std::ofstream file(filename.c_str(), std::ios::out | std::ios::binary);
+  if (!file)
+    throw std::runtime_error("Unable to open " + filename + " for writing.");
+
+  Header header;
+  std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+  header.version = VERSION;
+  header.numSpectra = numSpectra;
+  header.numEvents = eventOffsets.back();
+  header.numDetectorIDs = detectorIDs.size();
+  header.instrumentNameLength = instrumentName.size();
+  writePadded(file, &header, sizeof(header));
+  writePadded(file, instrumentName.data(), instrumentName.size());
+  writePadded(file, eventOffsets.data(),
+              eventOffsets.size() * sizeof(uint64_t));
+  writePadded(file, detectorOffsets.data(),
+              detectorOffsets.size() * sizeof(uint64_t));
+  writePadded(file, spectrumNumbers.data(),
+              spectrumNumbers.size() * sizeof(int32_t));
+  writePadded(file, detectorIDs.data(), detectorIDs.size() * sizeof(int32_t));
+
+  std::vector<Event> buffer;
+  for (size_t i = 0; i < numSpectra; ++i) {
+    const auto &events = workspace.getSpectrum(i).getEvents();
+    buffer.resize(events.size());
+    std::transform(events.cbegin(), events.cend(), buffer.begin(),
+                   [](const TofEvent &event) {
+                     return Event{event.tof(),
+                                  event.pulseTime().totalNanoseconds()};
+                   });
+    file.write(reinterpret_cast<const char *>(buffer.data()),
+               buffer.size() * sizeof(Event));
+  }
+
+  if (!file)
+    throw std::runtime_error("Failed to write the event cache file " +
+                             filename);
+}
+
+//----------------------------------------------------------------------------------------------
+/** Map an event cache file into memory. No event data is read.
+ * @param filename :: The path of the file
+ * @throw std::runtime_error if the file is not a valid event cache file
+ */
+EventCacheFile::EventCacheFile(const std::string &filename)
+    : m_memory(Poco::File(filename), Poco::SharedMemory::AM_READ) {
+  SectionReader reader(m_memory.begin(), m_memory.end(), filename);
+  const Header &header = *reader.read<Header>(1);
+  if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0)
+    throw std::runtime_error(filename + " is not an event cache file.");
+  if (header.version != VERSION)
+    throw std::runtime_error("Unsupported version of event cache file " +
+                             filename);
+
+  m_numSpectra = static_cast<size_t>(header.numSpectra);
+  const char *name = reader.read<char>(header.instrumentNameLength);
+  m_instrumentName.assign(name, header.instrumentNameLength);
+  m_eventOffsets = reader.read<uint64_t>(m_numSpectra + 1);
+  m_detectorOffsets = reader.read<uint64_t>(m_numSpectra + 1);
+  m_spectrumNumbers = reader.read<int32_t>(m_numSpectra);
+  m_detectorIDs = reader.read<int32_t>(header.numDetectorIDs);
+  m_events = reader.read<Event>(header.numEvents);
+
+  if (m_eventOffsets[m_numSpectra] != header.numEvents ||
+      m_detectorOffsets[m_numSpectra] != header.numDetectorIDs)
+    throw std::runtime_error("Event cache file " + filename +
+                             " is inconsistent.");
+}
+
+/// @return the spectrum number of the spectrum at the given index
+specnum_t EventCacheFile::spectrumNumber(const size_t index) const {
+  return m_spectrumNumbers[index];
+}
+
+/// @return the detector IDs of the spectrum at the given index
+std::vector<detid_t> EventCacheFile::detectorIDs(const size_t index) const {
+  return std::vector<detid_t>(m_detectorIDs + m_detectorOffsets[index],
+                              m_detectorIDs + m_detectorOffsets[index + 1]);
+}
+
+/// @return the number of events in the spectrum at the given index
+size_t EventCacheFile::numberOfEvents(const size_t index) const {
+  return static_cast<size_t>(m_eventOffsets[index + 1] -
+                             m_eventOffsets[index]);
+}
+
+/// @return a pointer to the first event of the spectrum at the given index
+const EventCacheFile::Event *
+EventCacheFile::eventsBegin(const size_t index) const {
+  return m_events + m_eventOffsets[index];
+}
+
+/// @return a pointer past the last event of the spectrum at the given index
+const EventCacheFile::Event *
+EventCacheFile::eventsEnd(const size_t index) const {
+  return m_events + m_eventOffsets[index + 1];
+}
+
+} // namespace DataHandling
+} // namespace Mantid
@@ -1,5 +1,7 @@
 #include "MantidDataHandling/EventWorkspaceCollection.h"
 #include "MantidDataObjects/EventWorkspace.h"
+#include "MantidDataObjects/WorkspaceCreation.h"
+#include "MantidIndexing/IndexInfo.h"
 #include "MantidKernel/UnitFactory.h"
 #include "MantidGeometry/Instrument.h"
 #include "MantidAPI/Axis.h"
@@ -254,6 +256,16 @@ void EventWorkspaceCollection::padSpectra(const std::vector<int32_t> &padding) {
   }
 }
 
+/** Replace the workspaces by empty ones with the given spectra, e.g. only the
+ * spectra on this rank for a distributed workspace.
+ * @param indexInfo :: spectrum numbers and definitions of the new spectra
+ */
+void EventWorkspaceCollection::setIndexInfo(
+    const Indexing::IndexInfo &indexInfo) {
+  for (auto &ws : m_WsVec)
+    ws = create<EventWorkspace>(*ws, indexInfo, HistogramData::BinEdges(2));
+}
+
 void EventWorkspaceCollection::setInstrument(
     const Geometry::Instrument_const_sptr &inst) {
   for (auto &ws : m_WsVec) {
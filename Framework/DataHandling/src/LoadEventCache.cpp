@@ -0,0 +1,283 @@
+#include "MantidDataHandling/LoadEventCache.h"
+#include "MantidAPI/Axis.h"
+#include "MantidAPI/FileProperty.h"
+#include "MantidAPI/Progress.h"
+#include "MantidAPI/WorkspaceFactory.h"
+#include "MantidDataHandling/EventCacheFile.h"
+#include "MantidDataObjects/EventWorkspace.h"
+#include "MantidKernel/ArrayProperty.h"
+#include "MantidKernel/BoundedValidator.h"
+#include "MantidKernel/MultiThreaded.h"
+#include "MantidKernel/OptionalBool.h"
+#include "MantidKernel/RebinParamsValidator.h"
+#include "MantidKernel/UnitFactory.h"
+#include "MantidKernel/VectorHelper.h"
+
+#include <algorithm>
+#include <limits>
+#include <set>
+
+namespace Mantid {
+namespace DataHandling {
+
+using namespace Mantid::Kernel;
+using namespace Mantid::API;
+using namespace Mantid::DataObjects;
+using Mantid::HistogramData::BinEdges;
+using Mantid::HistogramData::Counts;
+using Mantid::HistogramData::Histogram;
+
+// Register the algorithm into the AlgorithmFactory
+DECLARE_ALGORITHM(LoadEventCache)
+
+//----------------------------------------------------------------------------------------------
+
+/// Algorithms name for identification. @see Algorithm::name
+const std::string LoadEventCache::name() const { return "LoadEventCache"; }
+
+/// Algorithm's version for identification. @see Algorithm::version
+int LoadEventCache::version() const { return 1; }
+
+/// Algorithm's category for identification. @see Algorithm::category
+const std::string LoadEventCache::category() const {
+  return "DataHandling\\Events";
+}
+
+/// Algorithm's summary for use in the GUI and help. @see Algorithm::summary
+const std::string LoadEventCache::summary() const {
+  return "Loads or histograms spectra from an event cache file written by "
+         "SaveEventCache, reading only the events that are needed.";
+}
+
+//----------------------------------------------------------------------------------------------
+/** Initialize the algorithm's properties.
+ */
+void LoadEventCache::init() {
+  declareProperty(make_unique<FileProperty>("Filename", "", FileProperty::Load,
+                                            ".evcache"),
+                  "The name of the event cache file to read.");
+  declareProperty(make_unique<WorkspaceProperty<MatrixWorkspace>>(
+                      "OutputWorkspace", "", Direction::Output),
+                  "An EventWorkspace, or a Workspace2D if Params is given.");
+
+  auto mustBeNonNegative = boost::make_shared<BoundedValidator<int>>();
+  mustBeNonNegative->setLower(0);
+  declareProperty("StartWorkspaceIndex", 0, mustBeNonNegative,
+                  "The index of the first spectrum in the file to load.");
+  declareProperty("EndWorkspaceIndex", EMPTY_INT(), mustBeNonNegative,
+                  "The index of the last spectrum in the file to load "
+                  "(default the last spectrum).");
+
+  declareProperty(make_unique<PropertyWithValue<double>>(
+                      "FilterByTofMin", EMPTY_DBL(), Direction::Input),
+                  "Optional: The minimum accepted time-of-flight in "
+                  "microseconds. Keep blank to load all events.");
+  declareProperty(make_unique<PropertyWithValue<double>>(
+                      "FilterByTofMax", EMPTY_DBL(), Direction::Input),
+                  "Optional: The maximum accepted time-of-flight in "
+                  "microseconds. Keep blank to load all events.");
+
+  declareProperty(
+      make_unique<ArrayProperty<double>>(
+          "Params", boost::make_shared<RebinParamsValidator>(true)),
+      "Optional: Binning parameters (first bin boundary, width, last bin "
+      "boundary, ...). When given, the events are histogrammed directly "
+      "from the file into a Workspace2D without loading them.");
+}
+
+//----------------------------------------------------------------------------------------------
+/** Check the ranges and binning parameters.
+ */
+std::map<std::string, std::string> LoadEventCache::validateInputs() {
+  std::map<std::string, std::string> result;
+  const int startIndex = getProperty("StartWorkspaceIndex");
+  const int endIndex = getProperty("EndWorkspaceIndex");
+  if (endIndex != EMPTY_INT() && endIndex < startIndex)
+    result["EndWorkspaceIndex"] =
+        "EndWorkspaceIndex must not be smaller than StartWorkspaceIndex.";
+
+  const double tofMin = getProperty("FilterByTofMin");
+  const double tofMax = getProperty("FilterByTofMax");
+  if (tofMin != EMPTY_DBL() && tofMax != EMPTY_DBL() && tofMax < tofMin)
+    result["FilterByTofMax"] =
+        "FilterByTofMax must not be smaller than FilterByTofMin.";
+
+  const std::vector<double> params = getProperty("Params");
+  if (params.size() == 1)
+    result["Params"] = "The first and last bin boundaries must be given as "
+                       "well as the bin width.";
+  return result;
+}
+
+//----------------------------------------------------------------------------------------------
+/** Execute the algorithm.
+ */
+void LoadEventCache::exec() {
+  const std::string filename = getPropertyValue("Filename");
+  EventCacheFile file(filename);
+
+  const size_t numSpectraInFile = file.getNumberHistograms();
+  const int startIndex = getProperty("StartWorkspaceIndex");
+  const int endIndex = getProperty("EndWorkspaceIndex");
+  m_startIndex = static_cast<size_t>(startIndex);
+  const size_t lastIndex = endIndex == EMPTY_INT()
+                               ? numSpectraInFile - 1
+                               : static_cast<size_t>(endIndex);
+  if (numSpectraInFile == 0 || lastIndex >= numSpectraInFile ||
+      m_startIndex > lastIndex)
+    throw std::out_of_range("The requested workspace indices are not in the "
+                            "file, which has " +
+                            std::to_string(numSpectraInFile) + " spectra.");
+  m_numSpectra = lastIndex - m_startIndex + 1;
+
+  m_tofMin = getProperty("FilterByTofMin");
+  m_tofMax = getProperty("FilterByTofMax");
+  if (m_tofMin == EMPTY_DBL())
+    m_tofMin = std::numeric_limits<double>::lowest();
+  if (m_tofMax == EMPTY_DBL())
+    m_tofMax = std::numeric_limits<double>::max();
+
+  const std::vector<double> params = getProperty("Params");
+  MatrixWorkspace_sptr ws =
+      params.empty() ? loadEvents(file) : histogramEvents(file, params);
+
+  ws->getAxis(0)->unit() = UnitFactory::Instance().create("TOF");
+  ws->setYUnit("Counts");
+  if (!file.instrumentName().empty())
+    runLoadInstrument(file.instrumentName(), ws);
+  setSpectra(file, *ws);
+
+  setProperty("OutputWorkspace", ws);
+}
+
+//----------------------------------------------------------------------------------------------
+/** Copy the events of the requested spectra into an EventWorkspace.
+ * @param file :: The mapped event cache file
+ * @return the new workspace
+ */
+MatrixWorkspace_sptr LoadEventCache::loadEvents(const EventCacheFile &file) {
+  auto ws = boost::dynamic_pointer_cast<EventWorkspace>(
+      WorkspaceFactory::Instance().create("EventWorkspace", m_numSpectra, 2,
+                                          1));
+
+  double shortestTof = std::numeric_limits<double>::max();
+  double longestTof = std::numeric_limits<double>::lowest();
+  Progress progress(this, 0.0, 0.9, m_numSpectra);
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int64_t i = 0; i < static_cast<int64_t>(m_numSpectra); ++i) {
+    PARALLEL_START_INTERUPT_REGION
+    const size_t index = m_startIndex + static_cast<size_t>(i);
+    auto &eventList = ws->getSpectrum(static_cast<size_t>(i));
+    eventList.reserve(file.numberOfEvents(index));
+    double shortest = std::numeric_limits<double>::max();
+    double longest = std::numeric_limits<double>::lowest();
+    for (auto event = file.eventsBegin(index); event != file.eventsEnd(index);
+         ++event) {
+      if (event->tof < m_tofMin || event->tof > m_tofMax)
+        continue;
+      eventList.addEventQuickly(
+          TofEvent(event->tof, DateAndTime(event->pulseTime)));
+      shortest = std::min(shortest, event->tof);
+      longest = std::max(longest, event->tof);
+    }
+    PARALLEL_CRITICAL(LoadEventCache_tofRange) {
+      shortestTof = std::min(shortestTof, shortest);
+      longestTof = std::max(longestTof, longest);
+    }
+    progress.report();
+    PARALLEL_END_INTERUPT_REGION
+  }
+  PARALLEL_CHECK_INTERUPT_REGION
+
+  // One bin covering all the events, as LoadEventNexus does
+  if (shortestTof > longestTof) {
+    shortestTof = 0.;
+    longestTof = 1.;
+  } else if (shortestTof == longestTof) {
+    longestTof += 1.;
+  }
+  ws->setAllX(BinEdges{shortestTof, longestTof});
+  return ws;
+}
+
+//----------------------------------------------------------------------------------------------
+/** Histogram the events of the requested spectra without loading them.
+ * @param file :: The mapped event cache file
+ * @param params :: The binning parameters
+ * @return the new workspace
+ */
+MatrixWorkspace_sptr
+LoadEventCache::histogramEvents(const EventCacheFile &file,
+                                const std::vector<double> &params) {
+  std::vector<double> xValues;
+  const int numEdges =
+      VectorHelper::createAxisFromRebinParams(params, xValues, true);
+  const BinEdges edges(std::move(xValues));
+  MatrixWorkspace_sptr ws = WorkspaceFactory::Instance().create(
+      "Workspace2D", m_numSpectra, numEdges, numEdges - 1);
+
+  const auto &x = edges.rawData();
+  const double low = std::max(x.front(), m_tofMin);
+  Progress progress(this, 0.0, 0.9, m_numSpectra);
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int64_t i = 0; i < static_cast<int64_t>(m_numSpectra); ++i) {
+    PARALLEL_START_INTERUPT_REGION
+    const size_t index = m_startIndex + static_cast<size_t>(i);
+    std::vector<double> counts(x.size() - 1, 0.);
+    for (auto event = file.eventsBegin(index); event != file.eventsEnd(index);
+         ++event) {
+      const double tof = event->tof;
+      if (tof < low || tof > m_tofMax || tof >= x.back())
+        continue;
+      const auto bin = std::upper_bound(x.cbegin(), x.cend(), tof) - 1;
+      counts[static_cast<size_t>(bin - x.cbegin())] += 1.;
+    }
+    ws->setHistogram(static_cast<size_t>(i),
+                     Histogram(edges, Counts(std::move(counts))));
+    progress.report();
+    PARALLEL_END_INTERUPT_REGION
+  }
+  PARALLEL_CHECK_INTERUPT_REGION
+  return ws;
+}
+
+//----------------------------------------------------------------------------------------------
+/** Set the spectrum numbers and detector IDs saved in the file.
+ * @param file :: The mapped event cache file
+ * @param ws :: The output workspace
+ */
+void LoadEventCache::setSpectra(const EventCacheFile &file,
+                                MatrixWorkspace &ws) {
+  for (size_t i = 0; i < m_numSpectra; ++i) {
+    auto &spectrum = ws.getSpectrum(i);
+    const auto ids = file.detectorIDs(m_startIndex + i);
+    spectrum.setSpectrumNo(file.spectrumNumber(m_startIndex + i));
+    spectrum.setDetectorIDs(std::set<detid_t>(ids.begin(), ids.end()));
+  }
+}
+
+//----------------------------------------------------------------------------------------------
+/** Load the instrument definition of the saved workspace. A missing
+ * definition is not an error since the events are still usable.
+ * @param instrumentName :: The name of the instrument
+ * @param ws :: The workspace to load the instrument into
+ */
+void LoadEventCache::runLoadInstrument(const std::string &instrumentName,
+                                       MatrixWorkspace_sptr ws) {
+  IAlgorithm_sptr loadInst = createChildAlgorithm("LoadInstrument", 0.9, 1.0);
+  try {
+    loadInst->setPropertyValue("InstrumentName", instrumentName);
+    loadInst->setProperty<MatrixWorkspace_sptr>("Workspace", ws);
+    loadInst->setProperty("RewriteSpectraMap", OptionalBool(false));
+    loadInst->execute();
+  } catch (std::invalid_argument &) {
+    g_log.information("Invalid argument to LoadInstrument Child Algorithm");
+  } catch (std::runtime_error &) {
+    g_log.information()
+        << "Unable to load the instrument definition of " << instrumentName
+        << ", the workspace will have no instrument geometry.\n";
+  }
+}
+
+} // namespace DataHandling
+} // namespace Mantid
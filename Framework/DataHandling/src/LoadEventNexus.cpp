@@ -8,9 +8,11 @@
 #include "MantidAPI/Run.h"
 #include "MantidAPI/Sample.h"
 #include "MantidAPI/SpectrumDetectorMapping.h"
+#include "MantidAPI/SpectrumInfo.h"
 #include "MantidGeometry/Instrument.h"
 #include "MantidGeometry/Instrument/Goniometer.h"
 #include "MantidGeometry/Instrument/RectangularDetector.h"
+#include "MantidIndexing/IndexInfo.h"
 #include "MantidKernel/ArrayProperty.h"
 #include "MantidKernel/BoundedValidator.h"
 #include "MantidKernel/MultiThreaded.h"
@@ -20,6 +22,8 @@
 #include "MantidKernel/Timer.h"
 #include "MantidKernel/UnitFactory.h"
 #include "MantidKernel/VisibleWhenProperty.h"
+#include "MantidParallel/Communicator.h"
+#include "MantidTypes/SpectrumDefinition.h"
 
 #include <boost/function.hpp>
 #include <boost/random/mersenne_twister.hpp>
@@ -28,6 +32,7 @@
 #include <boost/shared_ptr.hpp>
 
 #include <functional>
+#include <unordered_map>
 
 using std::map;
 using std::string;
@@ -102,7 +107,7 @@ public:
         prog(prog), scheduler(scheduler), m_loadError(false),
         m_oldNexusFileNames(oldNeXusFileNames), m_loadStart(), m_loadSize(),
         m_event_id(nullptr), m_event_time_of_flight(nullptr),
-        m_have_weight(false), m_event_weight(nullptr),
+        m_have_weight(false), m_event_weight(nullptr), m_bufferBytes(0),
         m_framePeriodNumbers(framePeriodNumbers) {
     setMutex(ioMutex);
     m_cost = static_cast<double>(numEvents);
@@ -423,6 +428,7 @@ public:
 
     m_loadError = false;
     m_have_weight = alg->m_haveWeights;
+    m_bufferBytes = 0;
 
     prog->report(entry_name + ": load from disk");
 
@@ -459,6 +465,13 @@ public:
         m_loadSize[0] = static_cast<int>(stop_event - start_event);
 
         if ((m_loadSize[0] > 0) && (m_loadStart[0] >= 0)) {
+          // Wait until there is room for this bank's data. The memory is
+          // released when the arrays are freed after processing.
+          m_bufferBytes = static_cast<size_t>(m_loadSize[0]) *
+                          (sizeof(uint32_t) + sizeof(float) +
+                           (m_have_weight ? sizeof(float) : 0));
+          alg->reserveEventBuffer(m_bufferBytes);
+
           // Load pixel IDs
           this->loadEventId(file);
           if (alg->getCancel())
@@ -503,10 +516,25 @@ public:
         delete[] m_event_weight;
       }
       delete event_index_ptr;
+      alg->releaseEventBuffer(m_bufferBytes);
 
       return;
     }
 
+    // convert things to shared_arrays. The reserved buffer memory is released
+    // once all the processing tasks sharing the arrays are done with them.
+    LoadEventNexus *loader = alg;
+    const size_t bufferBytes = m_bufferBytes;
+    boost::shared_array<uint32_t> event_id_shrd(
+        m_event_id, [loader, bufferBytes](uint32_t *ids) {
+          delete[] ids;
+          loader->releaseEventBuffer(bufferBytes);
+        });
+    boost::shared_array<float> event_time_of_flight_shrd(
+        m_event_time_of_flight);
+    boost::shared_array<float> event_weight_shrd(m_event_weight);
+    boost::shared_ptr<std::vector<uint64_t>> event_index_shrd(event_index_ptr);
+
     const auto bank_size = m_max_id - m_min_id;
     const uint32_t minSpectraToLoad = static_cast<uint32_t>(alg->m_specMin);
     const uint32_t maxSpectraToLoad = static_cast<uint32_t>(alg->m_specMax);
@@ -546,13 +574,6 @@ public:
     size_t numEvents = m_loadSize[0];
     size_t startAt = m_loadStart[0];
 
-    // convert things to shared_arrays
-    boost::shared_array<uint32_t> event_id_shrd(m_event_id);
-    boost::shared_array<float> event_time_of_flight_shrd(
-        m_event_time_of_flight);
-    boost::shared_array<float> event_weight_shrd(m_event_weight);
-    boost::shared_ptr<std::vector<uint64_t>> event_index_shrd(event_index_ptr);
-
     ProcessBankData *newTask1 = new ProcessBankData(
         alg, entry_name, prog, event_id_shrd, event_time_of_flight_shrd,
         numEvents, startAt, event_index_shrd, thisBankPulseTimes, m_have_weight,
@@ -615,6 +636,8 @@ private:
   bool m_have_weight;
   /// Event weights
   float *m_event_weight;
+  /// Bytes reserved in the loader's event buffer for this bank
+  size_t m_bufferBytes;
   /// Frame period numbers
   const std::vector<int> m_framePeriodNumbers;
 }; // END-DEF-CLASS LoadBankFromDiskTask
@@ -636,7 +659,8 @@ LoadEventNexus::LoadEventNexus()
       eventid_max(0), pixelID_to_wi_vector(), pixelID_to_wi_offset(),
       m_bankPulseTimes(), m_allBanksPulseTimes(), m_top_entry_name(),
       m_file(nullptr), splitProcessing(false), m_haveWeights(false),
-      weightedEventVectors(), m_instrument_loaded_correctly(false),
+      weightedEventVectors(), m_eventBufferLimit(0), m_eventBufferInUse(0),
+      m_instrument_loaded_correctly(false),
       loadlogs(false), m_logs_loaded_correctly(false), event_id_is_spec(false) {
 }
 
@@ -647,6 +671,34 @@ LoadEventNexus::~LoadEventNexus() {
     delete m_file;
 }
 
+//----------------------------------------------------------------------------------------------
+/** Reserve memory for event data that is about to be read from the file,
+ * waiting until enough data from other banks has been processed to stay under
+ * the EventBufferLimit. A bank larger than the limit is read once nothing else
+ * is buffered.
+ * @param bytes :: The number of bytes to reserve
+ */
+void LoadEventNexus::reserveEventBuffer(const size_t bytes) {
+  std::unique_lock<std::mutex> lock(m_eventBufferMutex);
+  m_eventBufferReleased.wait(lock, [this, bytes] {
+    return m_eventBufferLimit == 0 || m_eventBufferInUse == 0 ||
+           m_eventBufferInUse + bytes <= m_eventBufferLimit;
+  });
+  m_eventBufferInUse += bytes;
+}
+
+/** Release memory reserved with reserveEventBuffer once the events have been
+ * added to the workspace.
+ * @param bytes :: The number of bytes to release
+ */
+void LoadEventNexus::releaseEventBuffer(const size_t bytes) {
+  {
+    std::lock_guard<std::mutex> lock(m_eventBufferMutex);
+    m_eventBufferInUse -= std::min(bytes, m_eventBufferInUse);
+  }
+  m_eventBufferReleased.notify_all();
+}
+
 //----------------------------------------------------------------------------------------------
 /**
 * Return the confidence with with this algorithm can load the file
@@ -752,6 +804,17 @@ void LoadEventNexus::init() {
                   "This specified the tolerance to use (in microseconds) when "
                   "compressing.");
 
+  auto mustBeNonNegative = boost::make_shared<BoundedValidator<double>>();
+  mustBeNonNegative->setLower(0.0);
+  declareProperty("EventBufferLimit", 0.0, mustBeNonNegative,
+                  "Maximum memory (in MB) used for event data that has been "
+                  "read from the file but not yet added to the workspace "
+                  "(optional, default 0 meaning no limit). Reading of banks "
+                  "waits for earlier banks to be processed when this is "
+                  "reached, which bounds the peak memory while loading. Banks "
+                  "are always read whole: a bank larger than the limit is "
+                  "read once no other bank is buffered.");
+
   auto mustBePositive = boost::make_shared<BoundedValidator<int>>();
   mustBePositive->setLower(1);
   declareProperty("ChunkNumber", EMPTY_INT(), mustBePositive,
@@ -769,6 +832,7 @@ void LoadEventNexus::init() {
   std::string grp3 = "Reduce Memory Use";
   setPropertyGroup("Precount", grp3);
   setPropertyGroup("CompressTolerance", grp3);
+  setPropertyGroup("EventBufferLimit", grp3);
   setPropertyGroup("ChunkNumber", grp3);
   setPropertyGroup("TotalChunks", grp3);
 
@@ -1121,6 +1185,8 @@ void LoadEventNexus::createWorkspaceIndexMaps(
   // Create the required spectra mapping so that the workspace knows what to pad
   // to
   createSpectraMapping(m_filename, monitors, bankNames);
+  if (!monitors && communicator().size() > 1)
+    partitionSpectra();
 
   // This map will be used to find the workspace index
   if (this->event_id_is_spec)
@@ -1131,6 +1197,36 @@ void LoadEventNexus::createWorkspaceIndexMaps(
         m_ws->getDetectorIDToWorkspaceIndexVector(pixelID_to_wi_offset, true);
 }
 
+/** Keep only the spectra of this rank when loading with several ranks. Events
+ * of the pixels of other ranks are discarded when the banks are read, so each
+ * rank holds the events of its own spectra only.
+ */
+void LoadEventNexus::partitionSpectra() {
+  const size_t globalSize = m_ws->getNumberHistograms();
+  std::vector<Indexing::SpectrumNumber> spectrumNumbers;
+  std::unordered_map<specnum_t, size_t> specNumToIndex;
+  spectrumNumbers.reserve(globalSize);
+  for (size_t i = 0; i < globalSize; ++i) {
+    const auto specNo = m_ws->getSpectrum(i).getSpectrumNo();
+    spectrumNumbers.emplace_back(specNo);
+    specNumToIndex[specNo] = i;
+  }
+  Indexing::IndexInfo indexInfo(std::move(spectrumNumbers),
+                                Parallel::StorageMode::Distributed,
+                                communicator());
+
+  const auto &spectrumInfo = m_ws->getSingleHeldWorkspace()->spectrumInfo();
+  std::vector<SpectrumDefinition> spectrumDefinitions;
+  spectrumDefinitions.reserve(indexInfo.size());
+  for (size_t i = 0; i < indexInfo.size(); ++i) {
+    const auto specNo = static_cast<specnum_t>(indexInfo.spectrumNumber(i));
+    spectrumDefinitions.push_back(
+        spectrumInfo.spectrumDefinition(specNumToIndex.at(specNo)));
+  }
+  indexInfo.setSpectrumDefinitions(std::move(spectrumDefinitions));
+  m_ws->setIndexInfo(indexInfo);
+}
+
 /** Load the instrument from the nexus file
 *
 * @param nexusfilename :: The name of the nexus file being loaded
@@ -1510,6 +1606,13 @@ void LoadEventNexus::loadEvents(API::Progress *const prog,
   // Make the thread pool
   ThreadScheduler *scheduler = new ThreadSchedulerMutexes();
   ThreadPool pool(scheduler);
+  // Reading waits for processing to release memory, which needs another thread
+  const double eventBufferLimit = getProperty("EventBufferLimit");
+  m_eventBufferInUse = 0;
+  m_eventBufferLimit =
+      ThreadPool::getNumPhysicalCores() > 1
+          ? static_cast<size_t>(eventBufferLimit * 1024. * 1024.)
+          : 0;
   auto diskIOMutex = boost::make_shared<std::mutex>();
   size_t bank0 = 0;
   size_t bankn = bankNames.size();
@@ -2530,5 +2633,12 @@ void LoadEventNexus::safeOpenFile(const std::string fname) {
   }
 }
 
+Parallel::ExecutionMode LoadEventNexus::getParallelExecutionMode(
+    const std::map<std::string, Parallel::StorageMode> &storageModes) const {
+  UNUSED_ARG(storageModes)
+  // Each rank loads the events of its own spectra
+  return Parallel::ExecutionMode::Distributed;
+}
+
 } // namespace DataHandling
 } // namespace Mantid
@@ -199,10 +199,15 @@ void ProcessBankData::run() { // override {
   //------------ Compress Events (or set sort order) ------------------
   // Do it on all the detector IDs we touched
   if (compress) {
+    const size_t numEventLists = outputWS.getNumberHistograms();
     for (detid_t pixID = m_min_id; pixID <= m_max_id; pixID++) {
       if (usedDetIds[pixID - m_min_id]) {
         // Find the the workspace index corresponding to that pixel ID
         size_t wi = getWorkspaceIndexFromPixelID(pixID);
+        // The events of pixels without a spectrum (e.g. on another rank) were
+        // discarded
+        if (wi >= numEventLists)
+          continue;
         auto &el = outputWS.getSpectrum(wi);
         if (compress)
           el.compressEvents(alg->compressTolerance, &el);
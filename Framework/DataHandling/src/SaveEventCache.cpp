@@ -0,0 +1,73 @@
+#include "MantidDataHandling/SaveEventCache.h"
+#include "MantidAPI/FileProperty.h"
+#include "MantidDataHandling/EventCacheFile.h"
+#include "MantidDataObjects/EventWorkspace.h"
+
+namespace Mantid {
+namespace DataHandling {
+
+using Mantid::API::FileProperty;
+using Mantid::API::WorkspaceProperty;
+using Mantid::DataObjects::EventWorkspace;
+using Mantid::DataObjects::EventWorkspace_const_sptr;
+using Mantid::Kernel::Direction;
+
+// Register the algorithm into the AlgorithmFactory
+DECLARE_ALGORITHM(SaveEventCache)
+
+//----------------------------------------------------------------------------------------------
+
+/// Algorithms name for identification. @see Algorithm::name
+const std::string SaveEventCache::name() const { return "SaveEventCache"; }
+
+/// Algorithm's version for identification. @see Algorithm::version
+int SaveEventCache::version() const { return 1; }
+
+/// Algorithm's category for identification. @see Algorithm::category
+const std::string SaveEventCache::category() const {
+  return "DataHandling\\Events";
+}
+
+/// Algorithm's summary for use in the GUI and help. @see Algorithm::summary
+const std::string SaveEventCache::summary() const {
+  return "Saves the events of an EventWorkspace to a file that "
+         "LoadEventCache can read without holding all the events in memory.";
+}
+
+//----------------------------------------------------------------------------------------------
+/** Initialize the algorithm's properties.
+ */
+void SaveEventCache::init() {
+  declareProperty(Kernel::make_unique<WorkspaceProperty<EventWorkspace>>(
+                      "InputWorkspace", "", Direction::Input),
+                  "An EventWorkspace with unweighted events.");
+  declareProperty(Kernel::make_unique<FileProperty>(
+                      "Filename", "", FileProperty::Save, ".evcache"),
+                  "The name of the event cache file to write.");
+}
+
+//----------------------------------------------------------------------------------------------
+/** Check that the events can be saved.
+ */
+std::map<std::string, std::string> SaveEventCache::validateInputs() {
+  std::map<std::string, std::string> result;
+  EventWorkspace_const_sptr inputWS = getProperty("InputWorkspace");
+  if (inputWS && inputWS->getEventType() != DataObjects::TOF)
+    result["InputWorkspace"] = "Weighted events cannot be saved to an event "
+                               "cache file.";
+  return result;
+}
+
+//----------------------------------------------------------------------------------------------
+/** Execute the algorithm.
+ */
+void SaveEventCache::exec() {
+  EventWorkspace_const_sptr inputWS = getProperty("InputWorkspace");
+  const std::string filename = getPropertyValue("Filename");
+  EventCacheFile::write(filename, *inputWS);
+  g_log.information() << "Saved " << inputWS->getNumberEvents()
+                      << " events to " << filename << "\n";
+}
+
+} // namespace DataHandling
+} // namespace Mantid
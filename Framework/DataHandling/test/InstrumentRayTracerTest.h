@@ -92,6 +92,33 @@ public:
       }
   }
 
+  void test_TOPAZ_reused_tracer() {
+    Instrument_const_sptr inst = topazWS->getInstrument();
+    // One tracker for all the rays uses the bounding volume hierarchy
+    InstrumentRayTracer tracker(inst);
+    for (int azimuth = 0; azimuth < 360; azimuth += 3)
+      for (int elev = -89; elev < 89; elev += 3) {
+        V3D testDir;
+        testDir.spherical(1, double(elev), double(azimuth));
+        tracker.traceFromSample(testDir);
+        Links results = tracker.getResults();
+      }
+  }
+
+  void test_TOPAZ_batched() {
+    Instrument_const_sptr inst = topazWS->getInstrument();
+    std::vector<V3D> directions;
+    for (int azimuth = 0; azimuth < 360; azimuth += 1)
+      for (int elev = -89; elev < 89; elev += 1) {
+        V3D testDir;
+        testDir.spherical(1, double(elev), double(azimuth));
+        directions.push_back(testDir);
+      }
+    InstrumentRayTracer tracker(inst);
+    const auto results = tracker.traceFromSample(directions);
+    TS_ASSERT_EQUALS(results.size(), directions.size());
+  }
+
 private:
   void showResults(Links &results, Instrument_const_sptr inst) {
     Links::const_iterator resultItr = results.begin();
@@ -0,0 +1,131 @@
+#ifndef MANTID_DATAHANDLING_LOADEVENTCACHETEST_H_
+#define MANTID_DATAHANDLING_LOADEVENTCACHETEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidAPI/Axis.h"
+#include "MantidDataHandling/LoadEventCache.h"
+#include "MantidDataHandling/SaveEventCache.h"
+#include "MantidDataObjects/Workspace2D.h"
+#include "MantidTestHelpers/WorkspaceCreationHelper.h"
+
+#include <Poco/File.h>
+
+using Mantid::DataHandling::LoadEventCache;
+using Mantid::DataHandling::SaveEventCache;
+using namespace Mantid::API;
+using namespace Mantid::DataObjects;
+
+class LoadEventCacheTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static LoadEventCacheTest *createSuite() { return new LoadEventCacheTest(); }
+  static void destroySuite(LoadEventCacheTest *suite) { delete suite; }
+
+  LoadEventCacheTest() {
+    m_input = WorkspaceCreationHelper::createGroupedEventWorkspace(
+        {{1, 2}, {3}, {4, 5, 6}}, 20);
+    for (size_t i = 0; i < 3; ++i)
+      m_input->getSpectrum(i).setSpectrumNo(static_cast<int>(10 + i));
+    SaveEventCache save;
+    save.initialize();
+    save.setProperty("InputWorkspace", m_input);
+    save.setPropertyValue("Filename", "LoadEventCacheTest.evcache");
+    save.execute();
+    m_filename = save.getPropertyValue("Filename");
+  }
+
+  ~LoadEventCacheTest() override { Poco::File(m_filename).remove(); }
+
+  void test_Init() {
+    LoadEventCache alg;
+    TS_ASSERT_THROWS_NOTHING(alg.initialize())
+    TS_ASSERT(alg.isInitialized())
+  }
+
+  void test_load_all_events() {
+    auto ws = boost::dynamic_pointer_cast<EventWorkspace>(runLoad());
+    TS_ASSERT(ws);
+    if (!ws)
+      return;
+    TS_ASSERT_EQUALS(ws->getNumberHistograms(), 3);
+    TS_ASSERT_EQUALS(ws->getNumberEvents(), m_input->getNumberEvents());
+    TS_ASSERT_EQUALS(ws->getAxis(0)->unit()->unitID(), "TOF");
+    for (size_t i = 0; i < 3; ++i) {
+      const auto &spectrum = ws->getSpectrum(i);
+      const auto &expected = m_input->getSpectrum(i);
+      TS_ASSERT_EQUALS(spectrum.getSpectrumNo(), expected.getSpectrumNo());
+      TS_ASSERT_EQUALS(spectrum.getDetectorIDs(), expected.getDetectorIDs());
+      TS_ASSERT_EQUALS(spectrum.getEvents(), expected.getEvents());
+    }
+  }
+
+  void test_load_range_of_spectra_and_tof() {
+    auto ws = boost::dynamic_pointer_cast<EventWorkspace>(
+        runLoad({{"StartWorkspaceIndex", "1"},
+                 {"EndWorkspaceIndex", "2"},
+                 {"FilterByTofMin", "5"},
+                 {"FilterByTofMax", "9.9"}}));
+    TS_ASSERT(ws);
+    if (!ws)
+      return;
+    TS_ASSERT_EQUALS(ws->getNumberHistograms(), 2);
+    TS_ASSERT_EQUALS(ws->getSpectrum(0).getSpectrumNo(), 11);
+    TS_ASSERT_EQUALS(ws->getSpectrum(1).getSpectrumNo(), 12);
+    for (size_t i = 0; i < 2; ++i) {
+      size_t expectedCount = 0;
+      for (const auto &event : m_input->getSpectrum(i + 1).getEvents())
+        if (event.tof() >= 5. && event.tof() <= 9.9)
+          ++expectedCount;
+      TS_ASSERT_EQUALS(ws->getSpectrum(i).getNumberEvents(), expectedCount);
+      for (const auto &event : ws->getSpectrum(i).getEvents()) {
+        TS_ASSERT_LESS_THAN_EQUALS(5., event.tof());
+        TS_ASSERT_LESS_THAN_EQUALS(event.tof(), 9.9);
+      }
+    }
+  }
+
+  void test_histogram_matches_event_workspace() {
+    auto ws = runLoad({{"Params", "0,1,19"}});
+    TS_ASSERT(boost::dynamic_pointer_cast<Workspace2D>(ws));
+    TS_ASSERT_EQUALS(ws->getNumberHistograms(), 3);
+    for (size_t i = 0; i < 3; ++i) {
+      TS_ASSERT_EQUALS(ws->getSpectrum(i).getSpectrumNo(),
+                       m_input->getSpectrum(i).getSpectrumNo());
+      TS_ASSERT_EQUALS(ws->x(i).rawData(), m_input->x(i).rawData());
+      TS_ASSERT_EQUALS(ws->y(i).rawData(), m_input->y(i).rawData());
+      TS_ASSERT_EQUALS(ws->e(i).rawData(), m_input->e(i).rawData());
+    }
+  }
+
+  void test_invalid_index_range_throws() {
+    LoadEventCache alg;
+    alg.initialize();
+    alg.setRethrows(true);
+    alg.setPropertyValue("Filename", m_filename);
+    alg.setPropertyValue("OutputWorkspace", "LoadEventCacheTest_out");
+    alg.setProperty("StartWorkspaceIndex", 3);
+    TS_ASSERT_THROWS(alg.execute(), std::out_of_range);
+  }
+
+private:
+  MatrixWorkspace_sptr
+  runLoad(const std::map<std::string, std::string> &properties = {}) {
+    LoadEventCache alg;
+    alg.setChild(true);
+    alg.initialize();
+    alg.setRethrows(true);
+    alg.setPropertyValue("Filename", m_filename);
+    alg.setPropertyValue("OutputWorkspace", "unused_for_child");
+    for (const auto &property : properties)
+      alg.setPropertyValue(property.first, property.second);
+    TS_ASSERT_THROWS_NOTHING(alg.execute());
+    return alg.getProperty("OutputWorkspace");
+  }
+
+  EventWorkspace_sptr m_input;
+  std::string m_filename;
+};
+
+#endif /* MANTID_DATAHANDLING_LOADEVENTCACHETEST_H_ */
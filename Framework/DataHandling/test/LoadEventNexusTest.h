@@ -12,14 +12,62 @@
 #include "MantidKernel/Property.h"
 #include "MantidKernel/TimeSeriesProperty.h"
 #include "MantidDataHandling/LoadEventNexus.h"
+#include "MantidIndexing/IndexInfo.h"
+#include "MantidParallel/Collectives.h"
+#include "MantidTestHelpers/ParallelAlgorithmCreation.h"
+#include "MantidTestHelpers/ParallelRunner.h"
+#include "MantidTypes/SpectrumDefinition.h"
 #include <cxxtest/TestSuite.h>
 
+#include <mutex>
+
 using namespace Mantid::Geometry;
 using namespace Mantid::API;
 using namespace Mantid::DataObjects;
 using namespace Mantid::Kernel;
 using namespace Mantid::DataHandling;
 
+namespace {
+void run_load_distributed(const Mantid::Parallel::Communicator &comm) {
+  auto load = ParallelTestHelpers::create<LoadEventNexus>(comm);
+  load->setProperty("Filename", "CNCS_7860_event.nxs");
+  load->setProperty("BankName", "bank36");
+  load->setProperty("SingleBankPixelsOnly", true);
+  load->setProperty("LoadLogs", false);
+  {
+    // The NeXus library is not thread safe, and the ranks are threads in
+    // builds without MPI. The load does not communicate between ranks.
+    static std::mutex mutex;
+    std::lock_guard<std::mutex> lock(mutex);
+    TS_ASSERT_THROWS_NOTHING(load->execute());
+  }
+  Workspace_sptr out = load->getProperty("OutputWorkspace");
+  auto ws = boost::dynamic_pointer_cast<EventWorkspace>(out);
+  TS_ASSERT(ws);
+  if (!ws)
+    return;
+
+  const auto &indexInfo = ws->indexInfo();
+  TS_ASSERT_EQUALS(indexInfo.globalSize(), 1024);
+  if (comm.size() > 1) {
+    TS_ASSERT_EQUALS(ws->storageMode(),
+                     Mantid::Parallel::StorageMode::Distributed);
+    TS_ASSERT_LESS_THAN(ws->getNumberHistograms(), 1024);
+  }
+  const auto &spectrumInfo = ws->spectrumInfo();
+  for (size_t i = 0; i < ws->getNumberHistograms(); ++i) {
+    TS_ASSERT_EQUALS(ws->getSpectrum(i).getSpectrumNo(),
+                     static_cast<int>(indexInfo.spectrumNumber(i)));
+    TS_ASSERT_EQUALS(spectrumInfo.spectrumDefinition(i).size(), 1);
+  }
+  // Every event is loaded on exactly one rank
+  size_t numEvents = 0;
+  Mantid::Parallel::all_reduce(comm, ws->getNumberEvents(), numEvents,
+                               std::plus<size_t>());
+  TS_ASSERT_EQUALS(numEvents, 7274);
+}
+}
+
 class LoadEventNexusTest : public CxxTest::TestSuite {
 private:
   void
@@ -187,6 +235,39 @@ public:
     }
   }
 
+  void test_EventBufferLimit_loads_the_same_events() {
+    LoadEventNexus ld;
+    ld.initialize();
+    ld.setPropertyValue("Filename", "CNCS_7860_event.nxs");
+    ld.setPropertyValue("OutputWorkspace", "cncs_unlimited");
+    ld.setProperty<bool>("LoadLogs", false); // Time-saver
+    TS_ASSERT(ld.execute());
+
+    // Much smaller than most banks, so reading has to wait for processing
+    LoadEventNexus ldLimited;
+    ldLimited.initialize();
+    ldLimited.setPropertyValue("Filename", "CNCS_7860_event.nxs");
+    ldLimited.setPropertyValue("OutputWorkspace", "cncs_limited");
+    ldLimited.setProperty<bool>("LoadLogs", false);
+    ldLimited.setProperty("EventBufferLimit", 0.01);
+    TS_ASSERT(ldLimited.execute());
+
+    auto &ads = AnalysisDataService::Instance();
+    auto WS = ads.retrieveWS<EventWorkspace>("cncs_unlimited");
+    auto WSLimited = ads.retrieveWS<EventWorkspace>("cncs_limited");
+    TS_ASSERT_EQUALS(WSLimited->getNumberEvents(), 112266);
+    TS_ASSERT_EQUALS(WSLimited->getNumberHistograms(),
+                     WS->getNumberHistograms());
+    for (size_t i = 0; i < WS->getNumberHistograms(); ++i) {
+      const auto &el = WS->getSpectrum(i);
+      const auto &elLimited = WSLimited->getSpectrum(i);
+      TS_ASSERT_EQUALS(elLimited.getTofs(), el.getTofs());
+      TS_ASSERT_EQUALS(elLimited.getPulseTimes(), el.getPulseTimes());
+    }
+    ads.remove("cncs_unlimited");
+    ads.remove("cncs_limited");
+  }
+
   void test_TOF_filtered_loading() {
     const std::string wsName = "test_filtering";
     const double filterStart = 45000;
@@ -743,6 +824,10 @@ public:
     }
   }
 
+  void test_parallel_distributed() {
+    ParallelTestHelpers::runParallel(run_load_distributed);
+  }
+
 private:
   std::string wsSpecFilterAndEventMonitors;
 };
@@ -0,0 +1,75 @@
+#ifndef MANTID_DATAHANDLING_SAVEEVENTCACHETEST_H_
+#define MANTID_DATAHANDLING_SAVEEVENTCACHETEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidDataHandling/EventCacheFile.h"
+#include "MantidDataHandling/SaveEventCache.h"
+#include "MantidTestHelpers/WorkspaceCreationHelper.h"
+
+#include <Poco/File.h>
+
+using Mantid::DataHandling::EventCacheFile;
+using Mantid::DataHandling::SaveEventCache;
+using namespace Mantid::DataObjects;
+
+class SaveEventCacheTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static SaveEventCacheTest *createSuite() { return new SaveEventCacheTest(); }
+  static void destroySuite(SaveEventCacheTest *suite) { delete suite; }
+
+  void test_Init() {
+    SaveEventCache alg;
+    TS_ASSERT_THROWS_NOTHING(alg.initialize())
+    TS_ASSERT(alg.isInitialized())
+  }
+
+  void test_exec() {
+    auto ws = WorkspaceCreationHelper::createEventWorkspace(4, 10, 10);
+    SaveEventCache alg;
+    alg.initialize();
+    alg.setRethrows(true);
+    TS_ASSERT_THROWS_NOTHING(alg.setProperty("InputWorkspace", ws));
+    TS_ASSERT_THROWS_NOTHING(
+        alg.setPropertyValue("Filename", "SaveEventCacheTest.evcache"));
+    TS_ASSERT_THROWS_NOTHING(alg.execute());
+    TS_ASSERT(alg.isExecuted());
+
+    const std::string filename = alg.getPropertyValue("Filename");
+    TS_ASSERT(Poco::File(filename).exists());
+
+    EventCacheFile file(filename);
+    TS_ASSERT_EQUALS(file.getNumberHistograms(), 4);
+    TS_ASSERT_EQUALS(file.getNumberEvents(), 40);
+    for (size_t i = 0; i < 4; ++i) {
+      const auto &events = ws->getSpectrum(i).getEvents();
+      TS_ASSERT_EQUALS(file.spectrumNumber(i),
+                       ws->getSpectrum(i).getSpectrumNo());
+      TS_ASSERT_EQUALS(file.numberOfEvents(i), events.size());
+      auto event = file.eventsBegin(i);
+      for (const auto &expected : events) {
+        TS_ASSERT_EQUALS(event->tof, expected.tof());
+        TS_ASSERT_EQUALS(event->pulseTime,
+                         expected.pulseTime().totalNanoseconds());
+        ++event;
+      }
+      TS_ASSERT_EQUALS(event, file.eventsEnd(i));
+    }
+    Poco::File(filename).remove();
+  }
+
+  void test_weighted_events_are_rejected() {
+    auto ws = WorkspaceCreationHelper::createEventWorkspace(4, 10, 10);
+    ws->getSpectrum(0).switchTo(WEIGHTED);
+    SaveEventCache alg;
+    alg.initialize();
+    alg.setRethrows(true);
+    alg.setProperty("InputWorkspace", ws);
+    alg.setPropertyValue("Filename", "SaveEventCacheTest.evcache");
+    TS_ASSERT_THROWS(alg.execute(), std::runtime_error);
+  }
+};
+
+#endif /* MANTID_DATAHANDLING_SAVEEVENTCACHETEST_H_ */
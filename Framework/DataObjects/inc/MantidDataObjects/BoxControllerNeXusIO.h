@@ -103,8 +103,11 @@ private:
   /// the vector, which describes the event specific data size, namely how many
   /// column an event is composed into and this class reads/writres
   std::vector<int64_t> m_BlockSize;
-  /// lock Nexus file operations as Nexus is not thread safe
-  mutable std::mutex m_fileMutex;
+  /// lock Nexus file operations as Nexus is not thread safe. The lock is
+  /// global rather than per file: the HDF5 library underneath keeps global
+  /// state, so calls on two different files must not run at the same time,
+  /// e.g. when one file is loaded while another is written asynchronously
+  static std::mutex s_fileMutex;
 
   // Mainly static information which may be split into different IO classes
   // selected through chein of responsibility.
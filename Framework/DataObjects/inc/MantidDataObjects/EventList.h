@@ -10,6 +10,7 @@
 #include "MantidKernel/System.h"
 #include "MantidKernel/cow_ptr.h"
 #include <iosfwd>
+#include <memory>
 #include <vector>
 
 namespace Mantid {
@@ -43,6 +44,13 @@ enum EventSortType {
     or WeightedEvent (where each neutron can have a non-1 weight).
     This is done transparently.
 
+    The events can optionally be held as separate columns of TOF, pulse time,
+    weight and error (see switchToColumnStorage()), so that passes which only
+    read or change the TOF do not have to move the other fields through the
+    cache. Sorting, TOF conversion, masking, histogramming, filterByPulseTime
+    and splitByFullTime work on the columns directly. Any other operation
+    converts the list back to the event structures first.
+
     @author Janik Zikovsky, SNS ORNL
     @date 4/02/2010
 
@@ -115,6 +123,8 @@ public:
    * @param event :: TofEvent to add at the end of the list.
    * */
   inline void addEventQuickly(const TofEvent &event) {
+    if (m_columns)
+      switchToStructStorage();
     this->events.push_back(event);
     this->order = UNSORTED;
   }
@@ -125,6 +135,8 @@ public:
    * @param event :: WeightedEvent to add at the end of the list.
    * */
   inline void addEventQuickly(const WeightedEvent &event) {
+    if (m_columns)
+      switchToStructStorage();
     this->weightedEvents.push_back(event);
     this->order = UNSORTED;
   }
@@ -135,6 +147,8 @@ public:
    * @param event :: WeightedEventNoTime to add at the end of the list.
    * */
   inline void addEventQuickly(const WeightedEventNoTime &event) {
+    if (m_columns)
+      switchToStructStorage();
     this->weightedEventsNoTime.push_back(event);
     this->order = UNSORTED;
   }
@@ -143,6 +157,10 @@ public:
 
   void switchTo(Mantid::API::EventType newType) override;
 
+  void switchToColumnStorage();
+  void switchToStructStorage();
+  bool hasColumnStorage() const;
+
   WeightedEvent getEvent(size_t event_number);
 
   std::vector<TofEvent> &getEvents();
@@ -389,6 +407,21 @@ private:
   /// Mutex that is locked while sorting an event list
   mutable std::mutex m_sortMutex;
 
+  /// Structure-of-arrays storage of the events
+  struct Columns;
+
+  /// The events when held as columns; the event vectors are then empty
+  mutable std::unique_ptr<Columns> m_columns;
+
+  void ensureStructStorage() const;
+  void moveColumnsToStructs() const;
+  void generateHistogramFromColumns(const MantidVec &X, MantidVec &Y,
+                                    MantidVec &E, bool skipError) const;
+  void splitColumnsByFullTime(Kernel::TimeSplitterType &splitter,
+                              std::map<int, EventList *> &outputs,
+                              bool docorrection, double toffactor,
+                              double tofshift) const;
+
   template <class T>
   static typename std::vector<T>::const_iterator
   findFirstEvent(const std::vector<T> &events, const double seek_tof);
@@ -124,6 +124,9 @@ public:
   // Change the event type
   void switchEventType(const Mantid::API::EventType type);
 
+  // Hold the events of every list as columns, or as event structures
+  void setColumnStorage(const bool columns);
+
   // Returns true always - an EventWorkspace always represents histogramm-able
   // data
   bool isHistogramData() const override;
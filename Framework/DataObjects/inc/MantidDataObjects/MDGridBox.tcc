@@ -11,7 +11,10 @@
 #include "MantidDataObjects/MDGridBox.h"
 #include <boost/math/special_functions/round.hpp>
 #include <boost/optional.hpp>
+#include <algorithm>
+#include <iterator>
 #include <ostream>
+#include <utility>
 #include "MantidKernel/Strings.h"
 
 // These pragmas ignores the warning in the ctor where "d<nd-1" for nd=1.
@@ -1682,6 +1685,89 @@ TMDE(inline size_t MDGridBox)::addEventUnsafe(const MDE &event) {
     return 0;
 }
 
+//-----------------------------------------------------------------------------------------------
+/** Add several events to the grid box, rejecting those outside its bounds.
+ * Events on the upper boundary are kept and go to the last child box, as with
+ * addEvent(). The events are grouped by the child box they fall in and each
+ * group is passed down in one go, so the lock of each MDBox is taken once per
+ * call rather than once per event. This is thread-safe: several threads may add
+ * events concurrently, e.g. from their own buffers, as long as the boxes are
+ * not split at the same time.
+ *
+ * Note! nPoints, signal and error must be re-calculated using refreshCache()
+ * after all events have been added.
+ *
+ * @param events :: vector of events to add.
+ * @return the number of events that were rejected (because of being out of
+ *bounds)
+ */
+TMDE(size_t MDGridBox)::addEvents(const std::vector<MDE> &events) {
+  auto isInside = [this](const MDE &event) {
+    for (size_t d = 0; d < nd; d++) {
+      const coord_t x = event.getCenter(d);
+      if (x < this->extents[d].getMin() || x > this->extents[d].getMax())
+        return false;
+    }
+    return true;
+  };
+  const auto numGood = static_cast<size_t>(
+      std::count_if(events.cbegin(), events.cend(), isInside));
+  if (numGood == events.size()) {
+    addEventsToChildren(events);
+  } else {
+    std::vector<MDE> goodEvents;
+    goodEvents.reserve(numGood);
+    std::copy_if(events.cbegin(), events.cend(),
+                 std::back_inserter(goodEvents), isInside);
+    addEventsToChildren(goodEvents);
+  }
+  return events.size() - numGood;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** Add events to the child boxes, recursing into gridded children. Each child
+ * receives all of its events with a single call.
+ *
+ * Warning! No bounds checking is done. It must be known that the events are
+ * within the bounds of the grid box before adding.
+ *
+ * @param events :: vector of events to add.
+ */
+TMDE(void MDGridBox)::addEventsToChildren(const std::vector<MDE> &events) {
+  // Pairs of (child index, event index), sorted to group the events by child
+  // while keeping their order within each child
+  std::vector<std::pair<size_t, size_t>> order;
+  order.reserve(events.size());
+  for (size_t i = 0; i < events.size(); ++i) {
+    // Events on the upper boundary of a dimension belong to the last child
+    // box along it
+    size_t cindex(0);
+    for (size_t d = 0; d < nd; d++) {
+      const auto offset = events[i].getCenter(d) - this->extents[d].getMin();
+      auto index = static_cast<int>(offset / m_SubBoxSize[d]);
+      index = std::max(0, std::min(index, static_cast<int>(split[d]) - 1));
+      cindex += static_cast<size_t>(index) * splitCumul[d];
+    }
+    order.emplace_back(cindex, i);
+  }
+  std::sort(order.begin(), order.end());
+
+  std::vector<MDE> childEvents;
+  for (auto first = order.cbegin(); first != order.cend();) {
+    const size_t cindex = first->first;
+    childEvents.clear();
+    for (; first != order.cend() && first->first == cindex; ++first)
+      childEvents.push_back(events[first->second]);
+
+    auto child = m_Children[cindex];
+    if (child->isBox())
+      child->addEvents(childEvents);
+    else
+      static_cast<MDGridBox<MDE, nd> *>(child)->addEventsToChildren(
+          childEvents);
+  }
+}
+
 /**Sets particular child MDgridBox at the index, specified by the input
 *parameters
 *@param index     -- the position of the new child in the list of GridBox
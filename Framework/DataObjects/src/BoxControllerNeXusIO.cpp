@@ -5,6 +5,7 @@
 #include "MantidDataObjects/MDBoxFlatTree.h"
 #include "MantidKernel/ConfigService.h"
 #include "MantidKernel/Exception.h"
+#include "MantidKernel/Logger.h"
 #include "MantidAPI/FileFinder.h"
 #include "MantidDataObjects/MDEvent.h"
 
@@ -12,6 +13,11 @@
 
 namespace Mantid {
 namespace DataObjects {
+namespace {
+/// static logger
+Kernel::Logger g_log("BoxControllerNeXusIO");
+}
+
 // Default headers(attributes) describing the contents of the data, written by
 // this class
 const char *EventHeaders[] = {
@@ -20,6 +26,7 @@ const char *EventHeaders[] = {
 
 std::string BoxControllerNeXusIO::g_EventGroupName("event_data");
 std::string BoxControllerNeXusIO::g_DBDataName("free_space_blocks");
+std::mutex BoxControllerNeXusIO::s_fileMutex;
 
 /**Constructor
  @param bc shared pointer to the box controller which uses this IO operations
@@ -117,7 +124,7 @@ bool BoxControllerNeXusIO::openFile(const std::string &fileName,
   if (m_File)
     return false;
 
-  std::lock_guard<std::mutex> _lock(m_fileMutex);
+  std::lock_guard<std::mutex> _lock(s_fileMutex);
   m_ReadOnly = true;
   if (mode.find('w') != std::string::npos ||
       mode.find('W') != std::string::npos) {
@@ -333,7 +340,7 @@ void BoxControllerNeXusIO::saveGenericBlock(
   // Specify the dimensions
   std::vector<int64_t> dims(m_BlockSize);
 
-  std::lock_guard<std::mutex> _lock(m_fileMutex);
+  std::lock_guard<std::mutex> _lock(s_fileMutex);
   start[0] = int64_t(blockPosition);
   dims[0] = int64_t(DataBlock.size() / this->getNDataColums());
 
@@ -385,7 +392,7 @@ void BoxControllerNeXusIO::loadGenericBlock(std::vector<Type> &Block,
   std::vector<int64_t> start(2, 0);
   std::vector<int64_t> size(m_BlockSize);
 
-  std::lock_guard<std::mutex> _lock(m_fileMutex);
+  std::lock_guard<std::mutex> _lock(s_fileMutex);
 
   start[0] = static_cast<int64_t>(blockPosition);
   size[0] = static_cast<int64_t>(nPoints);
@@ -458,7 +465,7 @@ void BoxControllerNeXusIO::loadBlock(std::vector<double> &Block,
 
 /// Clear NeXus internal cache
 void BoxControllerNeXusIO::flushData() const {
-  std::lock_guard<std::mutex> _lock(m_fileMutex);
+  std::lock_guard<std::mutex> _lock(s_fileMutex);
   m_File->flush();
 }
 /** flush disk buffer data from memory and close underlying NeXus file*/
@@ -467,7 +474,7 @@ void BoxControllerNeXusIO::closeFile() {
     // write all file-backed data still stack in the data buffer into the file.
     this->flushCache();
     // lock file
-    std::lock_guard<std::mutex> _lock(m_fileMutex);
+    std::lock_guard<std::mutex> _lock(s_fileMutex);
 
     m_File->closeData(); // close events data
     if (!m_ReadOnly)     // write free space groups from the disk buffer
@@ -491,6 +498,17 @@ void BoxControllerNeXusIO::closeFile() {
   }
 }
 
-BoxControllerNeXusIO::~BoxControllerNeXusIO() { this->closeFile(); }
+BoxControllerNeXusIO::~BoxControllerNeXusIO() {
+  // The blocks queued for the I/O thread of the DiskBuffer must be written
+  // before the file is closed, and the thread is only joined by the base
+  // class destructor
+  try {
+    this->waitForAsyncWrites();
+  } catch (std::exception &e) {
+    g_log.error() << "Failed to write MD boxes to the file: " << e.what()
+                  << '\n';
+  }
+  this->closeFile();
+}
 }
 }
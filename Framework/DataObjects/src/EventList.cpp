@@ -4,7 +4,9 @@
 #include "MantidKernel/DateAndTime.h"
 #include "MantidKernel/Exception.h"
 #include "MantidKernel/Logger.h"
+#include "MantidKernel/RadixSort.h"
 #include "MantidKernel/Unit.h"
+#include "MantidKernel/make_unique.h"
 
 #ifdef _MSC_VER
 // qualifier applied to function type has no meaning; ignored
@@ -15,10 +17,13 @@
 #pragma warning(default : 4180)
 #endif
 
+#include <algorithm>
+#include <array>
 #include <cfloat>
 #include <cmath>
 #include <functional>
 #include <limits>
+#include <numeric>
 #include <stdexcept>
 
 using std::ostream;
@@ -81,6 +86,225 @@ public:
     return (tAtSample1 < tAtSample2);
   }
 };
+
+/// Lists at least this long are sorted with a radix sort rather than a
+/// comparison sort
+constexpr size_t MIN_EVENTS_FOR_RADIX_SORT = 50000;
+
+/// Radix sort key ordering events by TOF
+template <typename EventType> uint64_t tofKey(const EventType &event) {
+  return Kernel::RadixSort::orderedKey(event.tof());
+}
+
+/// Radix sort key ordering events by pulse time
+template <typename EventType> uint64_t pulseTimeKey(const EventType &event) {
+  return Kernel::RadixSort::orderedKey(event.pulseTime().totalNanoseconds());
+}
+
+/**
+ * Sort events by TOF, using a radix sort for long lists.
+ * @param events :: The events to sort
+ */
+template <typename EventType>
+void sortEventsByTof(std::vector<EventType> &events) {
+  if (events.size() >= MIN_EVENTS_FOR_RADIX_SORT)
+    Kernel::RadixSort::sortByKey(events, tofKey<EventType>);
+  else
+    tbb::parallel_sort(events.begin(), events.end(),
+                       [](const EventType &e1, const EventType &e2) {
+                         return e1.tof() < e2.tof();
+                       });
+}
+
+/**
+ * Sort events by pulse time, using a radix sort for long lists.
+ * @param events :: The events to sort
+ * @param comparator :: Comparison used for short lists
+ * @param withTof :: If true, events with equal pulse times are ordered by TOF
+ */
+template <typename EventType, typename Comparator>
+void sortEventsByPulseTime(std::vector<EventType> &events,
+                           Comparator comparator, const bool withTof) {
+  if (events.size() >= MIN_EVENTS_FOR_RADIX_SORT) {
+    // The radix sort is stable, so sort by the secondary key first
+    if (withTof)
+      Kernel::RadixSort::sortByKey(events, tofKey<EventType>);
+    Kernel::RadixSort::sortByKey(events, pulseTimeKey<EventType>);
+  } else {
+    tbb::parallel_sort(events.begin(), events.end(), comparator);
+  }
+}
+
+/**
+ * Locates the bin containing a value directly, without searching, when the
+ * bin edges have a constant linear or logarithmic step. This allows events
+ * to be histogrammed in a single pass without first sorting them.
+ */
+class RegularBinFinder {
+public:
+  /// Sentinel returned for values outside the binning range
+  static constexpr size_t OutOfRange = std::numeric_limits<size_t>::max();
+
+  /**
+   * Inspect the bin edges to determine whether they are regular.
+   * @param X :: The bin edges, assumed to be increasing
+   */
+  explicit RegularBinFinder(const MantidVec &X)
+      : m_X(X), m_numBins(X.size() > 1 ? X.size() - 1 : 0), m_start(0.0),
+        m_inverseStep(0.0), m_logarithmic(false), m_regular(false) {
+    if (m_numBins == 0)
+      return;
+    const double width = X.back() - X.front();
+    if (!(width > 0.0))
+      return;
+    // A predicted edge within a quarter of a bin of the actual edge means at
+    // most one correction step is needed when looking up a value
+    const double bins = static_cast<double>(m_numBins);
+    m_start = X.front();
+    m_inverseStep = bins / width;
+    m_regular = predictionsAreClose();
+    if (!m_regular && X.front() > 0.0) {
+      m_start = std::log(X.front());
+      m_inverseStep = bins / (std::log(X.back()) - m_start);
+      m_logarithmic = true;
+      m_regular = predictionsAreClose();
+    }
+  }
+
+  /// @return True if the bins have a constant linear or logarithmic step
+  bool isRegular() const { return m_regular; }
+
+  /**
+   * Find the bin index for a value with the same semantics as the sorted walk
+   * i.e. X[bin] <= x < X[bin + 1].
+   * @param x :: The value to locate
+   * @return The bin index or OutOfRange
+   */
+  size_t find(const double x) const {
+    if (!(x >= m_X.front() && x < m_X.back()))
+      return OutOfRange;
+    const double position =
+        (m_logarithmic ? std::log(x) - m_start : x - m_start) * m_inverseStep;
+    size_t bin = std::min(static_cast<size_t>(position), m_numBins - 1);
+    // Correct for rounding in the predicted position
+    while (bin > 0 && x < m_X[bin])
+      --bin;
+    while (bin < m_numBins - 1 && x >= m_X[bin + 1])
+      ++bin;
+    return bin;
+  }
+
+private:
+  /// @return True if every edge is within a quarter bin of its predicted value
+  bool predictionsAreClose() const {
+    for (size_t i = 1; i < m_numBins; ++i) {
+      const double edge = m_logarithmic ? std::log(m_X[i]) : m_X[i];
+      const double predicted = (edge - m_start) * m_inverseStep;
+      if (!(std::abs(predicted - static_cast<double>(i)) < 0.25))
+        return false;
+    }
+    return true;
+  }
+
+  const MantidVec &m_X;
+  const size_t m_numBins;
+  double m_start;
+  double m_inverseStep;
+  bool m_logarithmic;
+  bool m_regular;
+};
+
+/**
+ * The order that sorts a column of TOFs, using a radix sort for long lists.
+ * @param tofs :: The TOF of each event
+ * @return The index of the event that belongs at each position
+ */
+std::vector<size_t> tofSortOrder(const std::vector<double> &tofs) {
+  std::vector<size_t> order(tofs.size());
+  std::iota(order.begin(), order.end(), size_t(0));
+  if (order.size() >= MIN_EVENTS_FOR_RADIX_SORT)
+    Kernel::RadixSort::sortByKey(order, [&tofs](const size_t i) {
+      return Kernel::RadixSort::orderedKey(tofs[i]);
+    });
+  else
+    std::stable_sort(order.begin(), order.end(),
+                     [&tofs](const size_t i, const size_t j) {
+                       return tofs[i] < tofs[j];
+                     });
+  return order;
+}
+
+/**
+ * The order that sorts columns of events by pulse time.
+ * @param pulseTimes :: The pulse time of each event
+ * @param tofs :: The TOF of each event
+ * @param withTof :: If true, events with equal pulse times are ordered by TOF
+ * @return The index of the event that belongs at each position
+ */
+std::vector<size_t>
+pulseTimeSortOrder(const std::vector<DateAndTime> &pulseTimes,
+                   const std::vector<double> &tofs, const bool withTof) {
+  std::vector<size_t> order;
+  // Both sorts are stable, so sort by the secondary key first
+  if (withTof) {
+    order = tofSortOrder(tofs);
+  } else {
+    order.resize(pulseTimes.size());
+    std::iota(order.begin(), order.end(), size_t(0));
+  }
+  if (order.size() >= MIN_EVENTS_FOR_RADIX_SORT)
+    Kernel::RadixSort::sortByKey(order, [&pulseTimes](const size_t i) {
+      return Kernel::RadixSort::orderedKey(pulseTimes[i].totalNanoseconds());
+    });
+  else
+    std::stable_sort(order.begin(), order.end(),
+                     [&pulseTimes](const size_t i, const size_t j) {
+                       return pulseTimes[i] < pulseTimes[j];
+                     });
+  return order;
+}
+
+/**
+ * Reorder a column of event data.
+ * @param column :: The column to reorder. An empty column is left alone.
+ * @param order :: The index of the entry that belongs at each position
+ */
+template <typename T>
+void permuteColumn(std::vector<T> &column, const std::vector<size_t> &order) {
+  if (column.empty())
+    return;
+  std::vector<T> permuted(order.size());
+  std::transform(order.cbegin(), order.cend(), permuted.begin(),
+                 [&column](const size_t i) { return column[i]; });
+  column.swap(permuted);
+}
+
+/**
+ * Append a range of another column to a column.
+ * @param column :: The column to extend
+ * @param source :: The column to copy from. Nothing is copied if it is empty.
+ * @param first :: Index of the first entry to copy
+ * @param last :: One past the index of the last entry to copy
+ */
+template <typename T>
+void appendColumn(std::vector<T> &column, const std::vector<T> &source,
+                  const size_t first, const size_t last) {
+  if (!source.empty())
+    column.insert(column.end(), source.begin() + first, source.begin() + last);
+}
+
+/**
+ * Remove a range of entries from a column.
+ * @param column :: The column to shorten. An empty column is left alone.
+ * @param first :: Index of the first entry to remove
+ * @param last :: One past the index of the last entry to remove
+ */
+template <typename T>
+void eraseColumn(std::vector<T> &column, const size_t first,
+                 const size_t last) {
+  if (!column.empty())
+    column.erase(column.begin() + first, column.begin() + last);
+}
 }
 //==========================================================================
 /// --------------------- TofEvent Comparators
@@ -94,6 +318,16 @@ template <typename T> bool compareEventTof(const T &e1, const T &e2) {
   return (e1.tof() < e2.tof());
 }
 
+/** Compare an event's TOF with a value, return true if the event should be
+ * before it. Used to binary search a list of events sorted by TOF.
+ * @param event :: an event
+ * @param tof :: the TOF value to compare with
+ *  */
+template <typename T>
+bool compareEventTofWithValue(const T &event, const double tof) {
+  return (event.tof() < tof);
+}
+
 /** Compare two events' FRAME id, return true if e1 should be before e2.
  * @param e1 :: first event
  * @param e2 :: second event
@@ -119,6 +353,60 @@ bool compareEventPulseTimeTOF(const TofEvent &e1, const TofEvent &e2) {
   return false;
 }
 
+//==========================================================================
+/// --------------------- Column storage
+//==========================================================================
+/** The events of an EventList held as a structure of arrays. The weight and
+ * error columns are empty for TofEvent's and the pulse time column is empty
+ * for WeightedEventNoTime's.
+ */
+struct EventList::Columns {
+  std::vector<double> tofs;
+  std::vector<DateAndTime> pulseTimes;
+  std::vector<float> weights;
+  std::vector<float> errorSquareds;
+
+  /// Reorder the events so that event order[i] ends up at position i
+  void permute(const std::vector<size_t> &order) {
+    permuteColumn(tofs, order);
+    permuteColumn(pulseTimes, order);
+    permuteColumn(weights, order);
+    permuteColumn(errorSquareds, order);
+  }
+
+  /// Reverse the order of the events
+  void reverse() {
+    std::reverse(tofs.begin(), tofs.end());
+    std::reverse(pulseTimes.begin(), pulseTimes.end());
+    std::reverse(weights.begin(), weights.end());
+    std::reverse(errorSquareds.begin(), errorSquareds.end());
+  }
+
+  /// Append the events [first, last) of columns with the same layout
+  void append(const Columns &other, const size_t first, const size_t last) {
+    appendColumn(tofs, other.tofs, first, last);
+    appendColumn(pulseTimes, other.pulseTimes, first, last);
+    appendColumn(weights, other.weights, first, last);
+    appendColumn(errorSquareds, other.errorSquareds, first, last);
+  }
+
+  /// Remove the events [first, last)
+  void erase(const size_t first, const size_t last) {
+    eraseColumn(tofs, first, last);
+    eraseColumn(pulseTimes, first, last);
+    eraseColumn(weights, first, last);
+    eraseColumn(errorSquareds, first, last);
+  }
+
+  /// @return the capacity of the columns in bytes
+  size_t memorySize() const {
+    return tofs.capacity() * sizeof(double) +
+           pulseTimes.capacity() * sizeof(DateAndTime) +
+           (weights.capacity() + errorSquareds.capacity()) * sizeof(float) +
+           sizeof(Columns);
+  }
+};
+
 /// Constructor (empty)
 // EventWorkspace is always histogram data and so is thus EventList
 EventList::EventList()
@@ -204,6 +492,7 @@ EventList::~EventList() {
 void EventList::createFromHistogram(const ISpectrum *inSpec, bool GenerateZeros,
                                     bool GenerateMultipleEvents,
                                     int MaxEventsPerBin) {
+  ensureStructStorage();
   // Fresh start
   this->clear(true);
 
@@ -292,6 +581,10 @@ EventList &EventList::operator=(const EventList &rhs) {
   weightedEventsNoTime = rhs.weightedEventsNoTime;
   eventType = rhs.eventType;
   order = rhs.order;
+  if (rhs.m_columns)
+    m_columns = Kernel::make_unique<Columns>(*rhs.m_columns);
+  else
+    m_columns.reset();
   return *this;
 }
 
@@ -301,7 +594,7 @@ EventList &EventList::operator=(const EventList &rhs) {
  * @return reference to this
  * */
 EventList &EventList::operator+=(const TofEvent &event) {
-
+  ensureStructStorage();
   switch (this->eventType) {
   case TOF:
     // Simply push the events
@@ -329,6 +622,7 @@ EventList &EventList::operator+=(const TofEvent &event) {
  * @return reference to this
  * */
 EventList &EventList::operator+=(const std::vector<TofEvent> &more_events) {
+  ensureStructStorage();
   switch (this->eventType) {
   case TOF:
     // Simply push the events
@@ -369,6 +663,7 @@ EventList &EventList::operator+=(const std::vector<TofEvent> &more_events) {
  * @return reference to this
  * */
 EventList &EventList::operator+=(const WeightedEvent &event) {
+  ensureStructStorage();
   this->switchTo(WEIGHTED);
   this->weightedEvents.push_back(event);
   this->order = UNSORTED;
@@ -385,6 +680,7 @@ EventList &EventList::operator+=(const WeightedEvent &event) {
  * */
 EventList &EventList::
 operator+=(const std::vector<WeightedEvent> &more_events) {
+  ensureStructStorage();
   switch (this->eventType) {
   case TOF:
     // Need to switch to weighted
@@ -422,6 +718,7 @@ operator+=(const std::vector<WeightedEvent> &more_events) {
  * */
 EventList &EventList::
 operator+=(const std::vector<WeightedEventNoTime> &more_events) {
+  ensureStructStorage();
   switch (this->eventType) {
   case TOF:
   case WEIGHTED:
@@ -450,6 +747,8 @@ operator+=(const std::vector<WeightedEventNoTime> &more_events) {
  * @return reference to this
  * */
 EventList &EventList::operator+=(const EventList &more_events) {
+  ensureStructStorage();
+  more_events.ensureStructStorage();
   // We'll let the += operator for the given vector of event lists handle it
   switch (more_events.getEventType()) {
   case TOF:
@@ -515,6 +814,8 @@ void EventList::minusHelper(std::vector<T1> &events,
  * @return reference to this
  * */
 EventList &EventList::operator-=(const EventList &more_events) {
+  ensureStructStorage();
+  more_events.ensureStructStorage();
   if (this == &more_events) {
     // Special case, ticket #3844 part 2.
     // When doing this = this - this,
@@ -572,6 +873,8 @@ EventList &EventList::operator-=(const EventList &more_events) {
  * @return :: true if equal.
  */
 bool EventList::operator==(const EventList &rhs) const {
+  ensureStructStorage();
+  rhs.ensureStructStorage();
   if (this->getNumberEvents() != rhs.getNumberEvents())
     return false;
   if (this->eventType != rhs.eventType)
@@ -596,6 +899,8 @@ bool EventList::operator!=(const EventList &rhs) const {
 
 bool EventList::equals(const EventList &rhs, const double tolTof,
                        const double tolWeight, const int64_t tolPulse) const {
+  ensureStructStorage();
+  rhs.ensureStructStorage();
   // generic checks
   if (this->getNumberEvents() != rhs.getNumberEvents())
     return false;
@@ -683,6 +988,13 @@ void EventList::switchToWeightedEvents() {
     break;
 
   case TOF:
+    if (m_columns) {
+      // Every event gets a weight of 1
+      m_columns->weights.assign(m_columns->tofs.size(), 1.0f);
+      m_columns->errorSquareds.assign(m_columns->tofs.size(), 1.0f);
+      eventType = WEIGHTED;
+      break;
+    }
     weightedEventsNoTime.clear();
     // Convert and copy all TofEvents to the weightedEvents list.
     this->weightedEvents.assign(events.cbegin(), events.cend());
@@ -704,6 +1016,14 @@ void EventList::switchToWeightedEventsNoTime() {
     return;
 
   case TOF: {
+    if (m_columns) {
+      // Every event gets a weight of 1 and loses its pulse time
+      m_columns->weights.assign(m_columns->tofs.size(), 1.0f);
+      m_columns->errorSquareds.assign(m_columns->tofs.size(), 1.0f);
+      std::vector<DateAndTime>().swap(m_columns->pulseTimes);
+      eventType = WEIGHTED_NOTIME;
+      break;
+    }
     // Convert and copy all TofEvents to the weightedEvents list.
     this->weightedEventsNoTime.assign(events.cbegin(), events.cend());
     // Get rid of the old events
@@ -713,6 +1033,11 @@ void EventList::switchToWeightedEventsNoTime() {
   } break;
 
   case WEIGHTED: {
+    if (m_columns) {
+      std::vector<DateAndTime>().swap(m_columns->pulseTimes);
+      eventType = WEIGHTED_NOTIME;
+      break;
+    }
     // Convert and copy all TofEvents to the weightedEvents list.
     this->weightedEventsNoTime.assign(weightedEvents.cbegin(),
                                       weightedEvents.cend());
@@ -724,6 +1049,109 @@ void EventList::switchToWeightedEventsNoTime() {
   }
 }
 
+// -----------------------------------------------------------------------------------------------
+/** Hold the events as separate columns of TOF, pulse time, weight and error
+ * (only the columns that the event type uses). The event type and the sort
+ * order are kept. Operations that do not work on the columns switch the list
+ * back to the event structures (see switchToStructStorage()).
+ */
+void EventList::switchToColumnStorage() {
+  if (m_columns)
+    return;
+
+  auto columns = Kernel::make_unique<Columns>();
+  const size_t numEvents = this->getNumberEvents();
+  columns->tofs.reserve(numEvents);
+  switch (eventType) {
+  case TOF:
+    columns->pulseTimes.reserve(numEvents);
+    for (const auto &event : events) {
+      columns->tofs.push_back(event.m_tof);
+      columns->pulseTimes.push_back(event.m_pulsetime);
+    }
+    break;
+  case WEIGHTED:
+    columns->pulseTimes.reserve(numEvents);
+    columns->weights.reserve(numEvents);
+    columns->errorSquareds.reserve(numEvents);
+    for (const auto &event : weightedEvents) {
+      columns->tofs.push_back(event.m_tof);
+      columns->pulseTimes.push_back(event.m_pulsetime);
+      columns->weights.push_back(event.m_weight);
+      columns->errorSquareds.push_back(event.m_errorSquared);
+    }
+    break;
+  case WEIGHTED_NOTIME:
+    columns->weights.reserve(numEvents);
+    columns->errorSquareds.reserve(numEvents);
+    for (const auto &event : weightedEventsNoTime) {
+      columns->tofs.push_back(event.m_tof);
+      columns->weights.push_back(event.m_weight);
+      columns->errorSquareds.push_back(event.m_errorSquared);
+    }
+    break;
+  }
+
+  // STL Trick to release memory
+  std::vector<TofEvent>().swap(this->events);
+  std::vector<WeightedEvent>().swap(this->weightedEvents);
+  std::vector<WeightedEventNoTime>().swap(this->weightedEventsNoTime);
+  m_columns = std::move(columns);
+}
+
+// -----------------------------------------------------------------------------------------------
+/** Hold the events as TofEvent, WeightedEvent or WeightedEventNoTime
+ * structures again. Does nothing if they already are.
+ */
+void EventList::switchToStructStorage() { this->ensureStructStorage(); }
+
+/// @return true if the events are held as separate columns
+bool EventList::hasColumnStorage() const {
+  return static_cast<bool>(m_columns);
+}
+
+// -----------------------------------------------------------------------------------------------
+/** Move the events back into the event structures before an operation that
+ * has no column implementation. This is const, like sort(), so that const
+ * methods can call it, and it is guarded by the same mutex.
+ */
+void EventList::ensureStructStorage() const {
+  if (!m_columns)
+    return;
+
+  std::lock_guard<std::mutex> _lock(m_sortMutex);
+  // The list may have been converted while waiting for the lock
+  if (m_columns)
+    moveColumnsToStructs();
+}
+
+/// Fill the event vectors from the columns and release the columns
+void EventList::moveColumnsToStructs() const {
+  const Columns &columns = *m_columns;
+  const size_t numEvents = columns.tofs.size();
+  switch (eventType) {
+  case TOF:
+    events.reserve(numEvents);
+    for (size_t i = 0; i < numEvents; ++i)
+      events.emplace_back(columns.tofs[i], columns.pulseTimes[i]);
+    break;
+  case WEIGHTED:
+    weightedEvents.reserve(numEvents);
+    for (size_t i = 0; i < numEvents; ++i)
+      weightedEvents.emplace_back(columns.tofs[i], columns.pulseTimes[i],
+                                  columns.weights[i],
+                                  columns.errorSquareds[i]);
+    break;
+  case WEIGHTED_NOTIME:
+    weightedEventsNoTime.reserve(numEvents);
+    for (size_t i = 0; i < numEvents; ++i)
+      weightedEventsNoTime.emplace_back(columns.tofs[i], columns.weights[i],
+                                        columns.errorSquareds[i]);
+    break;
+  }
+  m_columns.reset();
+}
+
 // ==============================================================================================
 // --- Testing functions (mostly)
 // ---------------------------------------------------------------
@@ -736,6 +1164,7 @@ void EventList::switchToWeightedEventsNoTime() {
  * @return a WeightedEvent
  */
 WeightedEvent EventList::getEvent(size_t event_number) {
+  ensureStructStorage();
   switch (eventType) {
   case TOF:
     return WeightedEvent(events[event_number]);
@@ -762,6 +1191,7 @@ WeightedEvent EventList::getEvent(size_t event_number) {
  * @return a const reference to the list of non-weighted events
  * */
 const std::vector<TofEvent> &EventList::getEvents() const {
+  ensureStructStorage();
   if (eventType != TOF)
     throw std::runtime_error("EventList::getEvents() called for an EventList "
                              "that has weights. Use getWeightedEvents() or "
@@ -777,6 +1207,7 @@ const std::vector<TofEvent> &EventList::getEvents() const {
  * @return a reference to the list of non-weighted events
  * */
 std::vector<TofEvent> &EventList::getEvents() {
+  ensureStructStorage();
   if (eventType != TOF)
     throw std::runtime_error("EventList::getEvents() called for an EventList "
                              "that has weights. Use getWeightedEvents() or "
@@ -792,6 +1223,7 @@ std::vector<TofEvent> &EventList::getEvents() {
  * @return a reference to the list of weighted events
  * */
 std::vector<WeightedEvent> &EventList::getWeightedEvents() {
+  ensureStructStorage();
   if (eventType != WEIGHTED)
     throw std::runtime_error("EventList::getWeightedEvents() called for an "
                              "EventList not of type WeightedEvent. Use "
@@ -807,6 +1239,7 @@ std::vector<WeightedEvent> &EventList::getWeightedEvents() {
  * @return a const reference to the list of weighted events
  * */
 const std::vector<WeightedEvent> &EventList::getWeightedEvents() const {
+  ensureStructStorage();
   if (eventType != WEIGHTED)
     throw std::runtime_error("EventList::getWeightedEvents() called for an "
                              "EventList not of type WeightedEvent. Use "
@@ -820,6 +1253,7 @@ const std::vector<WeightedEvent> &EventList::getWeightedEvents() const {
  * @return a reference to the list of weighted events
  * */
 std::vector<WeightedEventNoTime> &EventList::getWeightedEventsNoTime() {
+  ensureStructStorage();
   if (eventType != WEIGHTED_NOTIME)
     throw std::runtime_error("EventList::getWeightedEvents() called for an "
                              "EventList not of type WeightedEventNoTime. Use "
@@ -834,6 +1268,7 @@ std::vector<WeightedEventNoTime> &EventList::getWeightedEventsNoTime() {
  * */
 const std::vector<WeightedEventNoTime> &
 EventList::getWeightedEventsNoTime() const {
+  ensureStructStorage();
   if (eventType != WEIGHTED_NOTIME)
     throw std::runtime_error("EventList::getWeightedEventsNoTime() called for "
                              "an EventList not of type WeightedEventNoTime. "
@@ -855,6 +1290,8 @@ void EventList::clear(const bool removeDetIDs) {
   this->weightedEventsNoTime.clear();
   std::vector<WeightedEventNoTime>().swap(
       this->weightedEventsNoTime); // STL Trick to release memory
+  if (m_columns)
+    *m_columns = Columns(); // Keep the column storage but release its memory
   if (removeDetIDs)
     this->clearDetectorIDs();
 }
@@ -898,7 +1335,10 @@ void EventList::setMRU(EventWorkspaceMRU *newMRU) { mru = newMRU; }
  *
  * @param num :: number of events that will be in this EventList
  */
-void EventList::reserve(size_t num) { this->events.reserve(num); }
+void EventList::reserve(size_t num) {
+  ensureStructStorage();
+  this->events.reserve(num);
+}
 
 // ==============================================================================================
 // --- Sorting functions -----------------------------------------------------
@@ -982,18 +1422,21 @@ void EventList::sortTof() const {
   if (this->order == TOF_SORT)
     return;
 
-  switch (eventType) {
-  case TOF:
-    tbb::parallel_sort(events.begin(), events.end(), compareEventTof<TofEvent>);
-    break;
-  case WEIGHTED:
-    tbb::parallel_sort(weightedEvents.begin(), weightedEvents.end(),
-                       compareEventTof<WeightedEvent>);
-    break;
-  case WEIGHTED_NOTIME:
-    tbb::parallel_sort(weightedEventsNoTime.begin(), weightedEventsNoTime.end(),
-                       compareEventTof<WeightedEventNoTime>);
-    break;
+  if (m_columns) {
+    // Only the TOF column is read to find the order
+    m_columns->permute(tofSortOrder(m_columns->tofs));
+  } else {
+    switch (eventType) {
+    case TOF:
+      sortEventsByTof(events);
+      break;
+    case WEIGHTED:
+      sortEventsByTof(weightedEvents);
+      break;
+    case WEIGHTED_NOTIME:
+      sortEventsByTof(weightedEventsNoTime);
+      break;
+    }
   }
   // Save the order to avoid unnecessary re-sorting.
   this->order = TOF_SORT;
@@ -1011,6 +1454,7 @@ void EventList::sortTof() const {
 void EventList::sortTimeAtSample(const double &tofFactor,
                                  const double &tofShift,
                                  bool forceResort) const {
+  ensureStructStorage();
   // Check pre-cached sort flag.
   if (this->order == TIMEATSAMPLE_SORT && !forceResort)
     return;
@@ -1055,17 +1499,23 @@ void EventList::sortPulseTime() const {
     return;
 
   // Perform sort.
-  switch (eventType) {
-  case TOF:
-    tbb::parallel_sort(events.begin(), events.end(), compareEventPulseTime);
-    break;
-  case WEIGHTED:
-    tbb::parallel_sort(weightedEvents.begin(), weightedEvents.end(),
-                       compareEventPulseTime);
-    break;
-  case WEIGHTED_NOTIME:
-    // Do nothing; there is no time to sort
-    break;
+  if (m_columns) {
+    // There is no time to sort for WeightedEventNoTime's
+    if (eventType != WEIGHTED_NOTIME)
+      m_columns->permute(pulseTimeSortOrder(m_columns->pulseTimes,
+                                            m_columns->tofs, false));
+  } else {
+    switch (eventType) {
+    case TOF:
+      sortEventsByPulseTime(events, compareEventPulseTime, false);
+      break;
+    case WEIGHTED:
+      sortEventsByPulseTime(weightedEvents, compareEventPulseTime, false);
+      break;
+    case WEIGHTED_NOTIME:
+      // Do nothing; there is no time to sort
+      break;
+    }
   }
   // Save the order to avoid unnecessary re-sorting.
   this->order = PULSETIME_SORT;
@@ -1085,17 +1535,23 @@ void EventList::sortPulseTimeTOF() const {
   if (this->order == PULSETIMETOF_SORT)
     return;
 
-  switch (eventType) {
-  case TOF:
-    tbb::parallel_sort(events.begin(), events.end(), compareEventPulseTimeTOF);
-    break;
-  case WEIGHTED:
-    tbb::parallel_sort(weightedEvents.begin(), weightedEvents.end(),
-                       compareEventPulseTimeTOF);
-    break;
-  case WEIGHTED_NOTIME:
-    // Do nothing; there is no time to sort
-    break;
+  if (m_columns) {
+    // There is no time to sort for WeightedEventNoTime's
+    if (eventType != WEIGHTED_NOTIME)
+      m_columns->permute(pulseTimeSortOrder(m_columns->pulseTimes,
+                                            m_columns->tofs, true));
+  } else {
+    switch (eventType) {
+    case TOF:
+      sortEventsByPulseTime(events, compareEventPulseTimeTOF, true);
+      break;
+    case WEIGHTED:
+      sortEventsByPulseTime(weightedEvents, compareEventPulseTimeTOF, true);
+      break;
+    case WEIGHTED_NOTIME:
+      // Do nothing; there is no time to sort
+      break;
+    }
   }
 
   // Save
@@ -1122,7 +1578,9 @@ void EventList::reverse() {
   std::reverse(x.begin(), x.end());
 
   // flip the events if they are tof sorted
-  if (this->isSortedByTof()) {
+  if (this->isSortedByTof() && m_columns) {
+    m_columns->reverse();
+  } else if (this->isSortedByTof()) {
     switch (eventType) {
     case TOF:
       std::reverse(this->events.begin(), this->events.end());
@@ -1149,6 +1607,8 @@ void EventList::reverse() {
  * @return the number of events in the list.
  *  */
 size_t EventList::getNumberEvents() const {
+  if (m_columns)
+    return m_columns->tofs.size();
   switch (eventType) {
   case TOF:
     return this->events.size();
@@ -1164,6 +1624,8 @@ size_t EventList::getNumberEvents() const {
  * Much like stl containers, returns true if there is nothing in the event list.
  */
 bool EventList::empty() const {
+  if (m_columns)
+    return m_columns->tofs.empty();
   switch (eventType) {
   case TOF:
     return this->events.empty();
@@ -1183,6 +1645,8 @@ bool EventList::empty() const {
  * @return :: the memory used by the EventList, in bytes.
  * */
 size_t EventList::getMemorySize() const {
+  if (m_columns)
+    return m_columns->memorySize() + sizeof(EventList);
   switch (eventType) {
   case TOF:
     return this->events.capacity() * sizeof(TofEvent) + sizeof(EventList);
@@ -1577,6 +2041,8 @@ void EventList::compressEventsParallelHelper(
  *be == this.
  */
 void EventList::compressEvents(double tolerance, EventList *destination) {
+  ensureStructStorage();
+  destination->ensureStructStorage();
   this->sortTof();
   switch (eventType) {
   case TOF:
@@ -1640,15 +2106,10 @@ void EventList::compressEvents(double tolerance, EventList *destination) {
 template <class T>
 typename std::vector<T>::const_iterator
 EventList::findFirstEvent(const std::vector<T> &events, const double seek_tof) {
-  auto itev = events.cbegin();
-  auto itev_end = events.cend(); // cache for speed
-
-  // if tof < X[0], that means that you need to skip some events
-  while ((itev != itev_end) && (itev->tof() < seek_tof))
-    itev++;
-  // Better fix would be to use a binary search instead of the linear one used
-  // here.
-  return itev;
+  // The events are sorted by tof so a binary search finds the first event
+  // with tof >= seek_tof
+  return std::lower_bound(events.cbegin(), events.cend(), seek_tof,
+                          compareEventTofWithValue<T>);
 }
 
 // --------------------------------------------------------------------------
@@ -1720,15 +2181,10 @@ typename std::vector<T>::const_iterator EventList::findFirstTimeAtSampleEvent(
 template <class T>
 typename std::vector<T>::iterator
 EventList::findFirstEvent(std::vector<T> &events, const double seek_tof) {
-  auto itev = events.begin();
-  auto itev_end = events.end(); // cache for speed
-
-  // if tof < X[0], that means that you need to skip some events
-  while ((itev != itev_end) && (itev->tof() < seek_tof))
-    itev++;
-  // Better fix would be to use a binary search instead of the linear one used
-  // here.
-  return itev;
+  // The events are sorted by tof so a binary search finds the first event
+  // with tof >= seek_tof
+  return std::lower_bound(events.begin(), events.end(), seek_tof,
+                          compareEventTofWithValue<T>);
 }
 
 // --------------------------------------------------------------------------
@@ -1838,6 +2294,7 @@ void EventList::histogramForWeightsHelper(const std::vector<T> &events,
  */
 void EventList::generateHistogramPulseTime(const MantidVec &X, MantidVec &Y,
                                            MantidVec &E, bool skipError) const {
+  ensureStructStorage();
   // All types of weights need to be sorted by Pulse Time
   this->sortPulseTime();
 
@@ -1875,6 +2332,7 @@ void EventList::generateHistogramTimeAtSample(const MantidVec &X, MantidVec &Y,
                                               const double &tofFactor,
                                               const double &tofOffset,
                                               bool skipError) const {
+  ensureStructStorage();
   // All types of weights need to be sorted by time at sample
   this->sortTimeAtSample(tofFactor, tofOffset);
 
@@ -1908,28 +2366,101 @@ void EventList::generateHistogramTimeAtSample(const MantidVec &X, MantidVec &Y,
  */
 void EventList::generateHistogram(const MantidVec &X, MantidVec &Y,
                                   MantidVec &E, bool skipError) const {
-  // All types of weights need to be sorted by TOF
-
-  this->sortTof();
+  if (m_columns) {
+    this->generateHistogramFromColumns(X, Y, E, skipError);
+    return;
+  }
 
   switch (eventType) {
   case TOF:
-    // Make the single ones
+    // Make the single ones. This sorts by TOF only if it is required.
     this->generateCountsHistogram(X, Y);
     if (!skipError)
       this->generateErrorsHistogram(Y, E);
     break;
 
   case WEIGHTED:
+    // Weights are summed in TOF order so the result does not depend on the
+    // original event order.
+    this->sortTof();
     histogramForWeightsHelper(this->weightedEvents, X, Y, E);
     break;
 
   case WEIGHTED_NOTIME:
+    this->sortTof();
     histogramForWeightsHelper(this->weightedEventsNoTime, X, Y, E);
     break;
   }
 }
 
+// --------------------------------------------------------------------------
+/** Generates the Y and E histograms from the column storage. The events are
+ * binned in the same way as generateCountsHistogram() and
+ * histogramForWeightsHelper() but only the TOF column, and the weight and
+ * error columns for weighted events, are read.
+ *
+ * @param X: x-bins supplied
+ * @param Y: counts returned
+ * @param E: errors returned
+ * @param skipError: skip calculating the error of unweighted events
+ */
+void EventList::generateHistogramFromColumns(const MantidVec &X, MantidVec &Y,
+                                             MantidVec &E,
+                                             bool skipError) const {
+  const size_t x_size = X.size();
+  if (x_size <= 1) {
+    // X was not set. Return an empty array.
+    Y.resize(0, 0);
+    return;
+  }
+
+  const bool weighted = (eventType != TOF);
+  const std::vector<double> &tofs = m_columns->tofs;
+  Y.assign(x_size - 1, 0.0);
+  if (weighted)
+    E.assign(x_size - 1, 0.0);
+
+  // Counts do not depend on the event order so regular bins can be found
+  // without sorting. Weights are summed in TOF order so the result does not
+  // depend on the original event order.
+  RegularBinFinder binFinder(X);
+  if (!weighted && this->order != TOF_SORT && tofs.size() >= x_size &&
+      binFinder.isRegular()) {
+    for (const double tof : tofs) {
+      const size_t bin = binFinder.find(tof);
+      if (bin != RegularBinFinder::OutOfRange)
+        Y[bin]++;
+    }
+  } else {
+    this->sortTof();
+    const std::vector<float> &weights = m_columns->weights;
+    const std::vector<float> &errorSquareds = m_columns->errorSquareds;
+    size_t bin = 0;
+    const size_t first =
+        std::lower_bound(tofs.cbegin(), tofs.cend(), X[0]) - tofs.cbegin();
+    for (size_t i = first; i < tofs.size(); ++i) {
+      // Both the events and X are sorted so the bin never moves back
+      while (bin < x_size - 1 && !(tofs[i] < X[bin + 1]))
+        ++bin;
+      if (bin == x_size - 1)
+        break;
+      if (weighted) {
+        // Convert to double before adding, to preserve precision
+        Y[bin] += double(weights[i]);
+        E[bin] += double(errorSquareds[i]); // square of error
+      } else {
+        Y[bin]++;
+      }
+    }
+  }
+
+  if (weighted)
+    std::transform(E.begin(), E.end(), E.begin(),
+                   static_cast<double (*)(double)>(sqrt));
+  else if (!skipError)
+    this->generateErrorsHistogram(Y, E);
+}
+
 // --------------------------------------------------------------------------
 /** With respect to PulseTime Fill a histogram given specified histogram bounds.
  * Does not modify
@@ -1939,6 +2470,7 @@ void EventList::generateHistogram(const MantidVec &X, MantidVec &Y,
  */
 void EventList::generateCountsHistogramPulseTime(const MantidVec &X,
                                                  MantidVec &Y) const {
+  ensureStructStorage();
   // For slight speed=up.
   size_t x_size = X.size();
 
@@ -2018,7 +2550,7 @@ void EventList::generateCountsHistogramPulseTime(const double &xMin,
                                                  MantidVec &Y,
                                                  const double TOF_min,
                                                  const double TOF_max) const {
-
+  ensureStructStorage();
   if (this->events.empty())
     return;
 
@@ -2053,6 +2585,7 @@ void EventList::generateCountsHistogramPulseTime(const double &xMin,
 void EventList::generateCountsHistogramTimeAtSample(
     const MantidVec &X, MantidVec &Y, const double &tofFactor,
     const double &tofOffset) const {
+  ensureStructStorage();
   // For slight speed=up.
   const size_t x_size = X.size();
 
@@ -2131,6 +2664,25 @@ void EventList::generateCountsHistogram(const MantidVec &X,
     return;
   }
 
+  // Regular bins let each event's bin be computed directly, which is cheaper
+  // than sorting an unsorted list first. The counts do not depend on the
+  // event order so the result is identical. Checking that the bins are
+  // regular costs a pass over the edges (and a log() per edge for
+  // logarithmic bins), so it is only worth it when there are at least as
+  // many events as bins; a short list is cheaper to sort.
+  if (this->order != TOF_SORT && this->events.size() >= x_size) {
+    RegularBinFinder binFinder(X);
+    if (binFinder.isRegular()) {
+      Y.assign(x_size - 1, 0.0);
+      for (const auto &event : this->events) {
+        const size_t bin = binFinder.find(event.tof());
+        if (bin != RegularBinFinder::OutOfRange)
+          Y[bin]++;
+      }
+      return;
+    }
+  }
+
   // Sort the events by tof
   this->sortTof();
   // Clear the Y data, assign all to 0.
@@ -2298,6 +2850,7 @@ double EventList::integrate(const double minX, const double maxX,
 void EventList::integrate(const double minX, const double maxX,
                           const bool entireRange, double &sum,
                           double &error) const {
+  ensureStructStorage();
   sum = 0;
   error = 0;
   if (!entireRange) {
@@ -2349,6 +2902,12 @@ void EventList::convertTof(std::function<double(double)> func,
   if (this->getNumberEvents() <= 0)
     return;
 
+  if (m_columns) {
+    auto &tofs = m_columns->tofs;
+    std::transform(tofs.begin(), tofs.end(), tofs.begin(), func);
+    return;
+  }
+
   // Convert the list
   switch (eventType) {
   case TOF:
@@ -2395,6 +2954,12 @@ void EventList::convertTof(const double factor, const double offset) {
   if (this->getNumberEvents() <= 0)
     return;
 
+  if (m_columns) {
+    for (double &tof : m_columns->tofs)
+      tof = tof * factor + offset;
+    return;
+  }
+
   // Convert the list
   switch (eventType) {
   case TOF:
@@ -2467,6 +3032,12 @@ void EventList::addPulsetime(const double seconds) {
   if (this->getNumberEvents() <= 0)
     return;
 
+  if (m_columns && eventType != WEIGHTED_NOTIME) {
+    for (auto &pulseTime : m_columns->pulseTimes)
+      pulseTime += seconds;
+    return;
+  }
+
   // Convert the list
   switch (eventType) {
   case TOF:
@@ -2546,19 +3117,32 @@ void EventList::maskTof(const double tofMin, const double tofMax) {
   // Convert the list
   size_t numOrig = 0;
   size_t numDel = 0;
-  switch (eventType) {
-  case TOF:
-    numOrig = this->events.size();
-    numDel = this->maskTofHelper(this->events, tofMin, tofMax);
-    break;
-  case WEIGHTED:
-    numOrig = this->weightedEvents.size();
-    numDel = this->maskTofHelper(this->weightedEvents, tofMin, tofMax);
-    break;
-  case WEIGHTED_NOTIME:
-    numOrig = this->weightedEventsNoTime.size();
-    numDel = this->maskTofHelper(this->weightedEventsNoTime, tofMin, tofMax);
-    break;
+  if (m_columns) {
+    // The same range as maskTofHelper(), found from the TOF column alone
+    const auto &tofs = m_columns->tofs;
+    numOrig = tofs.size();
+    const auto first = std::lower_bound(tofs.cbegin(), tofs.cend(), tofMin);
+    if (first != tofs.cend() && *first < tofMax) {
+      const auto last = std::upper_bound(first, tofs.cend(), tofMax);
+      numDel = last - first;
+      m_columns->erase(first - tofs.cbegin(), last - tofs.cbegin());
+    }
+  } else {
+    switch (eventType) {
+    case TOF:
+      numOrig = this->events.size();
+      numDel = this->maskTofHelper(this->events, tofMin, tofMax);
+      break;
+    case WEIGHTED:
+      numOrig = this->weightedEvents.size();
+      numDel = this->maskTofHelper(this->weightedEvents, tofMin, tofMax);
+      break;
+    case WEIGHTED_NOTIME:
+      numOrig = this->weightedEventsNoTime.size();
+      numDel =
+          this->maskTofHelper(this->weightedEventsNoTime, tofMin, tofMax);
+      break;
+    }
   }
 
   if (numDel >= numOrig)
@@ -2574,15 +3158,20 @@ void EventList::maskTof(const double tofMin, const double tofMax) {
 template <class T>
 void EventList::getTofsHelper(const std::vector<T> &events,
                               std::vector<double> &tofs) {
-  tofs.clear();
-  for (auto itev = events.cbegin(); itev != events.cend(); ++itev)
-    tofs.push_back(itev->m_tof);
+  tofs.resize(events.size());
+  std::transform(events.cbegin(), events.cend(), tofs.begin(),
+                 [](const T &event) { return event.tof(); });
 }
 
 /** Fill a vector with the list of TOFs
  *  @param tofs :: A reference to the vector to be filled
  */
 void EventList::getTofs(std::vector<double> &tofs) const {
+  if (m_columns) {
+    tofs = m_columns->tofs;
+    return;
+  }
+
   // Set the capacity of the vector to avoid multiple resizes
   tofs.reserve(this->getNumberEvents());
 
@@ -2619,16 +3208,20 @@ std::vector<double> EventList::getTofs() const {
 template <class T>
 void EventList::getWeightsHelper(const std::vector<T> &events,
                                  std::vector<double> &weights) {
-  weights.clear();
-  for (const auto &event : events) {
-    weights.push_back(event.weight());
-  }
+  weights.resize(events.size());
+  std::transform(events.cbegin(), events.cend(), weights.begin(),
+                 [](const T &event) { return event.weight(); });
 }
 
 /** Fill a vector with the list of Weights
  *  @param weights :: A reference to the vector to be filled
  */
 void EventList::getWeights(std::vector<double> &weights) const {
+  if (m_columns && eventType != TOF) {
+    weights.assign(m_columns->weights.cbegin(), m_columns->weights.cend());
+    return;
+  }
+
   // Set the capacity of the vector to avoid multiple resizes
   weights.reserve(this->getNumberEvents());
 
@@ -2666,16 +3259,25 @@ std::vector<double> EventList::getWeights() const {
 template <class T>
 void EventList::getWeightErrorsHelper(const std::vector<T> &events,
                                       std::vector<double> &weightErrors) {
-  weightErrors.clear();
-  for (const auto &event : events) {
-    weightErrors.push_back(event.error());
-  }
+  weightErrors.resize(events.size());
+  std::transform(events.cbegin(), events.cend(), weightErrors.begin(),
+                 [](const T &event) { return event.error(); });
 }
 
 /** Fill a vector with the list of Weight Errors
  *  @param weightErrors :: A reference to the vector to be filled
  */
 void EventList::getWeightErrors(std::vector<double> &weightErrors) const {
+  if (m_columns && eventType != TOF) {
+    const auto &errorSquareds = m_columns->errorSquareds;
+    weightErrors.resize(errorSquareds.size());
+    std::transform(errorSquareds.cbegin(), errorSquareds.cend(),
+                   weightErrors.begin(), [](const float errorSquared) {
+                     return std::sqrt(double(errorSquared));
+                   });
+    return;
+  }
+
   // Set the capacity of the vector to avoid multiple resizes
   weightErrors.reserve(this->getNumberEvents());
 
@@ -2714,10 +3316,9 @@ template <class T>
 void EventList::getPulseTimesHelper(
     const std::vector<T> &events,
     std::vector<Mantid::Kernel::DateAndTime> &times) {
-  times.clear();
-  for (const auto &event : events) {
-    times.push_back(event.pulseTime());
-  }
+  times.resize(events.size());
+  std::transform(events.cbegin(), events.cend(), times.begin(),
+                 [](const T &event) { return event.pulseTime(); });
 }
 
 /** Get the pulse times of each event in this EventList.
@@ -2725,6 +3326,14 @@ void EventList::getPulseTimesHelper(
  * @return by copy a vector of DateAndTime times
  */
 std::vector<Mantid::Kernel::DateAndTime> EventList::getPulseTimes() const {
+  if (m_columns) {
+    // WeightedEventNoTime's all report a pulse time of 0
+    if (eventType == WEIGHTED_NOTIME)
+      return std::vector<Mantid::Kernel::DateAndTime>(m_columns->tofs.size(),
+                                                      DateAndTime(0));
+    return m_columns->pulseTimes;
+  }
+
   std::vector<Mantid::Kernel::DateAndTime> times;
   // Set the capacity of the vector to avoid multiple resizes
   times.reserve(this->getNumberEvents());
@@ -2756,6 +3365,13 @@ double EventList::getTofMin() const {
   if (this->empty())
     return tMin;
 
+  if (m_columns) {
+    const auto &tofs = m_columns->tofs;
+    if (this->order == TOF_SORT)
+      return tofs.front();
+    return *std::min_element(tofs.cbegin(), tofs.cend());
+  }
+
   // when events are ordered by tof just need the first value
   if (this->order == TOF_SORT) {
     switch (eventType) {
@@ -2802,6 +3418,13 @@ double EventList::getTofMax() const {
   if (this->empty())
     return tMax;
 
+  if (m_columns) {
+    const auto &tofs = m_columns->tofs;
+    if (this->order == TOF_SORT)
+      return tofs.back();
+    return *std::max_element(tofs.cbegin(), tofs.cend());
+  }
+
   // when events are ordered by tof just need the first value
   if (this->order == TOF_SORT) {
     switch (eventType) {
@@ -2840,6 +3463,7 @@ double EventList::getTofMax() const {
  * @return The minimum tof value for the list of the events.
  */
 DateAndTime EventList::getPulseTimeMin() const {
+  ensureStructStorage();
   // set up as the maximum available date time.
   DateAndTime tMin = DateAndTime::maximum();
 
@@ -2884,6 +3508,7 @@ DateAndTime EventList::getPulseTimeMin() const {
  * @return The maximum tof value for the list of events.
  */
 DateAndTime EventList::getPulseTimeMax() const {
+  ensureStructStorage();
   // set up as the minimum available date time.
   DateAndTime tMax = DateAndTime::minimum();
 
@@ -2926,6 +3551,7 @@ DateAndTime EventList::getPulseTimeMax() const {
 
 void EventList::getPulseTimeMinMax(Mantid::Kernel::DateAndTime &tMin,
                                    Mantid::Kernel::DateAndTime &tMax) const {
+  ensureStructStorage();
   // set up as the minimum available date time.
   tMax = DateAndTime::minimum();
   tMin = DateAndTime::maximum();
@@ -2976,6 +3602,7 @@ void EventList::getPulseTimeMinMax(Mantid::Kernel::DateAndTime &tMin,
 
 DateAndTime EventList::getTimeAtSampleMax(const double &tofFactor,
                                           const double &tofOffset) const {
+  ensureStructStorage();
   // set up as the minimum available date time.
   DateAndTime tMax = DateAndTime::minimum();
 
@@ -3023,6 +3650,7 @@ DateAndTime EventList::getTimeAtSampleMax(const double &tofFactor,
 
 DateAndTime EventList::getTimeAtSampleMin(const double &tofFactor,
                                           const double &tofOffset) const {
+  ensureStructStorage();
   // set up as the minimum available date time.
   DateAndTime tMin = DateAndTime::maximum();
 
@@ -3097,6 +3725,13 @@ void EventList::setTofsHelper(std::vector<T> &events,
 void EventList::setTofs(const MantidVec &tofs) {
   this->order = UNSORTED;
 
+  if (m_columns) {
+    // Same checks as setTofsHelper()
+    if (!tofs.empty() && tofs.size() == m_columns->tofs.size())
+      m_columns->tofs = tofs;
+    return;
+  }
+
   // Convert the list
   switch (eventType) {
   case TOF:
@@ -3197,6 +3832,7 @@ EventList &EventList::operator*=(const double value) {
  * @param error: error on 'value'. Can be 0.
  */
 void EventList::multiply(const double value, const double error) {
+  ensureStructStorage();
   // Do nothing if multiplying by exactly one and there is no error
   if ((value == 1.0) && (error == 0.0))
     return;
@@ -3320,6 +3956,7 @@ void EventList::multiplyHistogramHelper(std::vector<T> &events,
  */
 void EventList::multiply(const MantidVec &X, const MantidVec &Y,
                          const MantidVec &E) {
+  ensureStructStorage();
   switch (eventType) {
   case TOF:
     // Switch to weights if needed.
@@ -3457,6 +4094,7 @@ void EventList::divideHistogramHelper(std::vector<T> &events,
  */
 void EventList::divide(const MantidVec &X, const MantidVec &Y,
                        const MantidVec &E) {
+  ensureStructStorage();
   switch (eventType) {
   case TOF:
     // Switch to weights if needed.
@@ -3505,6 +4143,7 @@ EventList &EventList::operator/=(const double value) {
  * @throw std::invalid_argument if value == 0; cannot divide by zero.
  */
 void EventList::divide(const double value, const double error) {
+  ensureStructStorage();
   if (value == 0.0)
     throw std::invalid_argument(
         "EventList::divide() called with value of 0.0. Cannot divide by zero.");
@@ -3604,6 +4243,19 @@ void EventList::filterByPulseTime(DateAndTime start, DateAndTime stop,
   output.setHistogram(m_histogram);
   output.setSortOrder(this->order);
 
+  if (m_columns && eventType != WEIGHTED_NOTIME) {
+    // The events are sorted so the range is found from the pulse times alone
+    const auto &pulseTimes = m_columns->pulseTimes;
+    const auto first =
+        std::lower_bound(pulseTimes.cbegin(), pulseTimes.cend(), start);
+    const auto last = std::lower_bound(first, pulseTimes.cend(), stop);
+    output.switchToColumnStorage();
+    output.m_columns->append(*m_columns, first - pulseTimes.cbegin(),
+                             last - pulseTimes.cbegin());
+    return;
+  }
+  output.ensureStructStorage();
+
   // Iterate through all events (sorted by pulse time)
   switch (eventType) {
   case TOF:
@@ -3624,6 +4276,8 @@ void EventList::filterByTimeAtSample(Kernel::DateAndTime start,
                                      Kernel::DateAndTime stop, double tofFactor,
                                      double tofOffset,
                                      EventList &output) const {
+  ensureStructStorage();
+  output.ensureStructStorage();
   if (this == &output) {
     throw std::invalid_argument("In-place filtering is not allowed");
   }
@@ -3739,6 +4393,7 @@ void EventList::filterInPlaceHelper(Kernel::TimeSplitterType &splitter,
  *     that will be kept. Any other events will be deleted.
  */
 void EventList::filterInPlace(Kernel::TimeSplitterType &splitter) {
+  ensureStructStorage();
   // Start by sorting the event list by pulse time.
   this->sortPulseTime();
 
@@ -3830,6 +4485,7 @@ void EventList::splitByTimeHelper(Kernel::TimeSplitterType &splitter,
  */
 void EventList::splitByTime(Kernel::TimeSplitterType &splitter,
                             std::vector<EventList *> outputs) const {
+  ensureStructStorage();
   if (eventType == WEIGHTED_NOTIME)
     throw std::runtime_error("EventList::splitByTime() called on an EventList "
                              "that no longer has time information.");
@@ -3993,6 +4649,10 @@ void EventList::splitByFullTime(Kernel::TimeSplitterType &splitter,
     // 3A. Copy all events to group workspace = -1
     (*outputs[-1]) = (*this);
     // this->duplicate(outputs[-1]);
+  } else if (m_columns) {
+    // 3B. Split the columns
+    splitColumnsByFullTime(splitter, outputs, docorrection, toffactor,
+                           tofshift);
   } else {
     // 3B. Split
     switch (eventType) {
@@ -4010,6 +4670,71 @@ void EventList::splitByFullTime(Kernel::TimeSplitterType &splitter,
   }
 }
 
+//------------------------------------------------------------------------------------------------
+/** Split the column storage into n outputs by event's full time. The events
+ * are assigned exactly as in splitByFullTimeHelper(), but each run of
+ * consecutive events going to the same output is appended to its columns in
+ * one step.
+ *
+ * @param splitter :: a TimeSplitterType giving where to split
+ * @param outputs :: a map of where the split events will end up
+ * @param docorrection :: flag to determine whether or not to apply correction
+ * @param toffactor :: factor to correct TOF in formula toffactor*tof+tofshift
+ * @param tofshift :: amount to shift (in SECOND) to correct TOF in formula:
+ *toffactor*tof+tofshift
+ */
+void EventList::splitColumnsByFullTime(Kernel::TimeSplitterType &splitter,
+                                       std::map<int, EventList *> &outputs,
+                                       bool docorrection, double toffactor,
+                                       double tofshift) const {
+  const std::vector<double> &tofs = m_columns->tofs;
+  const std::vector<DateAndTime> &pulseTimes = m_columns->pulseTimes;
+  const size_t numEvents = tofs.size();
+
+  // The same expressions as splitByFullTimeHelper() uses before and inside
+  // an interval, so that both storages send every event to the same output
+  auto fullTime = [&](const size_t i, const bool inside) {
+    const int64_t pulseTime = pulseTimes[i].totalNanoseconds();
+    if (!docorrection)
+      return pulseTime + static_cast<int64_t>(tofs[i] * 1000);
+    if (inside)
+      return pulseTime + static_cast<int64_t>(toffactor * tofs[i] * 1000 +
+                                              tofshift * 1.0E9);
+    return pulseTime + static_cast<int64_t>(toffactor * (tofs[i] * 1.0E3) +
+                                            (tofshift * 1.0E9));
+  };
+  auto appendRange = [&](EventList *output, const size_t first,
+                         const size_t last) {
+    if (first == last)
+      return;
+    output->switchToColumnStorage();
+    output->m_columns->append(*m_columns, first, last);
+    output->order = UNSORTED;
+  };
+
+  size_t i = 0;
+  for (auto itspl = splitter.cbegin(); itspl != splitter.cend(); ++itspl) {
+    const int64_t start = itspl->start().totalNanoseconds();
+    const int64_t stop = itspl->stop().totalNanoseconds();
+
+    // Events before the start of the interval go to index -1
+    size_t first = i;
+    while (i < numEvents && fullTime(i, false) < start)
+      ++i;
+    appendRange(outputs[-1], first, i);
+
+    // Events in the interval go to its index
+    first = i;
+    while (i < numEvents && fullTime(i, true) < stop)
+      ++i;
+    appendRange(outputs[itspl->index()], first, i);
+
+    // No need to keep looping through the filter if we are out of events
+    if (i == numEvents)
+      break;
+  }
+}
+
 //------------------------------------------------------------------------------------------------
 /** Split the event list into n outputs, operating on a vector of either
  *TofEvent's or WeightedEvent's
@@ -4201,6 +4926,7 @@ std::string EventList::splitByFullTimeMatrixSplitter(
     const std::vector<int> &vecgroups,
     std::map<int, EventList *> vec_outputEventList, bool docorrection,
     double toffactor, double tofshift) const {
+  ensureStructStorage();
   // Check validity
   if (eventType == WEIGHTED_NOTIME)
     throw std::runtime_error("EventList::splitByTime() called on an EventList "
@@ -4338,6 +5064,7 @@ void EventList::splitByPulseTimeHelper(Kernel::TimeSplitterType &splitter,
  */
 void EventList::splitByPulseTime(Kernel::TimeSplitterType &splitter,
                                  std::map<int, EventList *> outputs) const {
+  ensureStructStorage();
   // Check for supported event type
   if (eventType == WEIGHTED_NOTIME)
     throw std::runtime_error("EventList::splitByTime() called on an EventList "
@@ -4383,6 +5110,7 @@ void EventList::splitByPulseTime(Kernel::TimeSplitterType &splitter,
 void EventList::splitByPulseTimeWithMatrix(
     const std::vector<int64_t> &vec_times, const std::vector<int> &vec_target,
     std::map<int, EventList *> outputs) const {
+  ensureStructStorage();
   // Check for supported event type
   if (eventType == WEIGHTED_NOTIME)
     throw std::runtime_error("EventList::splitByTime() called on an EventList "
@@ -4546,13 +5274,20 @@ template <class T>
 void EventList::convertUnitsViaTofHelper(typename std::vector<T> &events,
                                          Mantid::Kernel::Unit *fromUnit,
                                          Mantid::Kernel::Unit *toUnit) {
-  auto itev = events.begin();
-  auto itev_end = events.end();
-  for (; itev != itev_end; itev++) {
-    // Conver to TOF
-    double tof = fromUnit->singleToTOF(itev->m_tof);
-    // And back from TOF to whatever
-    itev->m_tof = toUnit->singleFromTOF(tof);
+  // Convert blocks of values at a time so the units can use their batched
+  // conversions instead of two virtual calls per event
+  constexpr size_t blockSize = 1024;
+  std::array<double, blockSize> block;
+  for (size_t start = 0; start < events.size(); start += blockSize) {
+    const size_t count = std::min(blockSize, events.size() - start);
+    const auto first = events.begin() + start;
+    std::transform(first, first + count, block.begin(),
+                   [](const T &event) { return event.m_tof; });
+    // Convert to TOF and back from TOF to whatever
+    fromUnit->multipleToTOF(block.data(), block.data() + count);
+    toUnit->multipleFromTOF(block.data(), block.data() + count);
+    for (size_t i = 0; i < count; ++i)
+      first[i].m_tof = block[i];
   }
 }
 
@@ -4577,6 +5312,16 @@ void EventList::convertUnitsViaTof(Mantid::Kernel::Unit *fromUnit,
     throw std::runtime_error(
         "EventList::convertUnitsViaTof(): toUnit is not initialized!");
 
+  if (m_columns) {
+    // The TOF column can be converted in place in one batch
+    auto &tofs = m_columns->tofs;
+    if (!tofs.empty()) {
+      fromUnit->multipleToTOF(tofs.data(), tofs.data() + tofs.size());
+      toUnit->multipleFromTOF(tofs.data(), tofs.data() + tofs.size());
+    }
+    return;
+  }
+
   switch (eventType) {
   case TOF:
     convertUnitsViaTofHelper(this->events, fromUnit, toUnit);
@@ -4614,6 +5359,12 @@ void EventList::convertUnitsQuicklyHelper(typename std::vector<T> &events,
  *  @param power :: the Power b to apply to the conversion
  */
 void EventList::convertUnitsQuickly(const double &factor, const double &power) {
+  if (m_columns) {
+    for (double &tof : m_columns->tofs)
+      tof = factor * std::pow(tof, power);
+    return;
+  }
+
   switch (eventType) {
   case TOF:
     convertUnitsQuicklyHelper(this->events, factor, power);
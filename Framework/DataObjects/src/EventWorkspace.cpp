@@ -420,6 +420,24 @@ void EventWorkspace::switchEventType(const Mantid::API::EventType type) {
     eventList->switchTo(type);
 }
 
+/** Choose how the events of all the event lists are stored. Column storage
+ * keeps the TOF, pulse time, weight and error of the events in separate
+ * arrays so that TOF-only operations read less memory.
+ * @see EventList::switchToColumnStorage()
+ *
+ * @param columns :: If true, hold the events as columns, otherwise as
+ * TofEvent, WeightedEvent or WeightedEventNoTime structures
+ */
+void EventWorkspace::setColumnStorage(const bool columns) {
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int i = 0; i < static_cast<int>(this->data.size()); ++i) {
+    if (columns)
+      data[i]->switchToColumnStorage();
+    else
+      data[i]->switchToStructStorage();
+  }
+}
+
 /// Returns true always - an EventWorkspace always represents histogramm-able
 /// data
 /// @returns If the data is a histogram - always true for an eventWorkspace
@@ -10,6 +10,7 @@
 
 #include <boost/scoped_ptr.hpp>
 #include <cmath>
+#include <numeric>
 
 using namespace Mantid;
 using namespace Mantid::API;
@@ -1153,6 +1154,67 @@ public:
     TS_ASSERT_EQUALS(this->el.ptrX()->size(), NUMBINS + 1);
   }
 
+  void test_histogram_unsorted_regular_bins_matches_sorted() {
+    // Linear, logarithmic and irregular bins, with fewer bins than events so
+    // the unsorted list is histogrammed without sorting
+    MantidVec linearX, logX, irregularX;
+    for (double tof = 100.0; tof < 20e6; tof += 250e3)
+      linearX.push_back(tof);
+    for (double tof = 100.0; tof < 20e6; tof *= 1.25)
+      logX.push_back(tof);
+    for (double tof = 100.0; tof < 20e6; tof += tof / 2.0 + 100.0)
+      irregularX.push_back(tof);
+
+    for (const auto &X : {linearX, logX, irregularX}) {
+      this->fake_data();
+      TS_ASSERT_LESS_THAN(X.size(), el.getNumberEvents());
+      EventList unsorted(el);
+      TS_ASSERT_EQUALS(unsorted.getSortType(), UNSORTED);
+      MantidVec Y, E;
+      unsorted.generateHistogram(X, Y, E);
+
+      el.sortTof();
+      MantidVec sortedY, sortedE;
+      el.generateHistogram(X, sortedY, sortedE);
+      TS_ASSERT_EQUALS(Y, sortedY);
+      TS_ASSERT_EQUALS(E, sortedE);
+    }
+  }
+
+  void test_histogram_unsorted_events_on_bin_edges() {
+    EventList events;
+    for (int i = 10; i >= 0; --i)
+      events += TofEvent(static_cast<double>(i) * 10.0, 0);
+    events += TofEvent(-1.0, 0);
+    events += TofEvent(100.5, 0);
+
+    MantidVec X{0.0,  10.0, 20.0, 30.0, 40.0, 50.0,
+                60.0, 70.0, 80.0, 90.0, 100.0};
+    MantidVec Y, E;
+    events.generateHistogram(X, Y, E);
+    TS_ASSERT_EQUALS(Y.size(), 10);
+    // Every bin gets its lower edge; the event at the last edge is excluded
+    for (const auto y : Y)
+      TS_ASSERT_EQUALS(y, 1.0);
+  }
+
+  void test_histogram_short_unsorted_list_on_many_bins() {
+    // Fewer events than bins: the list is sorted rather than the bins checked
+    EventList events;
+    events += TofEvent(950.5, 0);
+    events += TofEvent(10.5, 0);
+    events += TofEvent(950.0, 0);
+    MantidVec X;
+    for (int i = 0; i <= 1000; ++i)
+      X.push_back(static_cast<double>(i));
+    MantidVec Y, E;
+    events.generateHistogram(X, Y, E);
+    TS_ASSERT_EQUALS(Y.size(), 1000);
+    TS_ASSERT_EQUALS(std::accumulate(Y.begin(), Y.end(), 0.0), 3.0);
+    TS_ASSERT_EQUALS(Y[10], 1.0);
+    TS_ASSERT_EQUALS(Y[950], 2.0);
+  }
+
   //  void test_histogram_static_function()
   //  {
   //    std::vector<WeightedEvent> events;
@@ -1258,6 +1320,189 @@ public:
     }
   }
 
+  //-----------------------------------------------------------------------------------------------
+  void test_column_accessors_match_events_allTypes() {
+    for (int this_type = 0; this_type < 3; this_type++) {
+      this->fake_uniform_data();
+      el.switchTo(static_cast<EventType>(this_type));
+      if (this_type != TOF)
+        el *= 2.0;
+      const size_t numEvents = el.getNumberEvents();
+
+      // Output vectors that already hold more entries than there are events
+      // must be shrunk, not appended to
+      std::vector<double> tofs(numEvents + 10, -1.0);
+      el.getTofs(tofs);
+      std::vector<double> weights(numEvents + 10, -1.0);
+      el.getWeights(weights);
+      std::vector<double> errors(numEvents + 10, -1.0);
+      el.getWeightErrors(errors);
+      TSM_ASSERT_EQUALS(this_type, tofs.size(), numEvents);
+      TSM_ASSERT_EQUALS(this_type, weights.size(), numEvents);
+      TSM_ASSERT_EQUALS(this_type, errors.size(), numEvents);
+      for (size_t i = 0; i < numEvents; ++i) {
+        const auto event = el.getEvent(i);
+        TSM_ASSERT_EQUALS(this_type, tofs[i], event.tof());
+        TSM_ASSERT_EQUALS(this_type, weights[i], event.weight());
+        TSM_ASSERT_EQUALS(this_type, errors[i], event.error());
+      }
+      if (this_type != WEIGHTED_NOTIME) {
+        const auto times = el.getPulseTimes();
+        TSM_ASSERT_EQUALS(this_type, times.size(), numEvents);
+        for (size_t i = 0; i < numEvents; ++i)
+          TSM_ASSERT_EQUALS(this_type, times[i], el.getEvent(i).pulseTime());
+      }
+    }
+  }
+
+  void test_column_accessors_of_empty_list() {
+    EventList empty;
+    std::vector<double> values(5, 1.0);
+    empty.getTofs(values);
+    TS_ASSERT(values.empty());
+    values.assign(5, 1.0);
+    empty.getWeights(values);
+    TS_ASSERT(values.empty());
+    values.assign(5, 1.0);
+    empty.getWeightErrors(values);
+    TS_ASSERT(values.empty());
+    TS_ASSERT(empty.getPulseTimes().empty());
+  }
+
+  //-----------------------------------------------------------------------------------------------
+  void test_column_storage_round_trip_allTypes() {
+    for (int this_type = 0; this_type < 3; this_type++) {
+      const EventList structs =
+          fake_random_data(static_cast<EventType>(this_type));
+      EventList columns(structs);
+      columns.switchToColumnStorage();
+      TS_ASSERT(columns.hasColumnStorage());
+      TS_ASSERT_EQUALS(columns.getEventType(), structs.getEventType());
+      TS_ASSERT_EQUALS(columns.getNumberEvents(), structs.getNumberEvents());
+      TS_ASSERT_EQUALS(columns.getTofs(), structs.getTofs());
+      TS_ASSERT_EQUALS(columns.getWeights(), structs.getWeights());
+      TS_ASSERT_EQUALS(columns.getWeightErrors(), structs.getWeightErrors());
+      TS_ASSERT_EQUALS(columns.getPulseTimes(), structs.getPulseTimes());
+
+      // A copy keeps the column storage
+      const EventList copy(columns);
+      TS_ASSERT(copy.hasColumnStorage());
+
+      columns.switchToStructStorage();
+      TS_ASSERT(!columns.hasColumnStorage());
+      TSM_ASSERT(this_type, columns == structs);
+    }
+  }
+
+  void test_column_storage_operations_match_struct_storage_allTypes() {
+    MantidVec X, Y1, E1, Y2, E2;
+    for (double tof = 0; tof <= 1e7; tof += 1.3e5)
+      X.push_back(tof);
+    for (int this_type = 0; this_type < 3; this_type++) {
+      EventList structs = fake_random_data(static_cast<EventType>(this_type));
+      EventList columns(structs);
+      columns.switchToColumnStorage();
+
+      structs.sortPulseTimeTOF();
+      columns.sortPulseTimeTOF();
+      TS_ASSERT_EQUALS(columns.getTofs(), structs.getTofs());
+      TS_ASSERT_EQUALS(columns.getPulseTimes(), structs.getPulseTimes());
+
+      structs.sortTof();
+      columns.sortTof();
+      TS_ASSERT_EQUALS(columns.getTofs(), structs.getTofs());
+      TS_ASSERT_EQUALS(columns.getWeights(), structs.getWeights());
+
+      structs.convertTof(2.5, 100.0);
+      columns.convertTof(2.5, 100.0);
+      structs.convertTof([](double tof) { return 0.5 * tof; }, 1);
+      columns.convertTof([](double tof) { return 0.5 * tof; }, 1);
+      structs.maskTof(1e6, 2e6);
+      columns.maskTof(1e6, 2e6);
+      TS_ASSERT_EQUALS(columns.getTofs(), structs.getTofs());
+      TS_ASSERT_EQUALS(columns.getTofMin(), structs.getTofMin());
+      TS_ASSERT_EQUALS(columns.getTofMax(), structs.getTofMax());
+
+      structs.generateHistogram(X, Y1, E1);
+      columns.generateHistogram(X, Y2, E2);
+      TSM_ASSERT_EQUALS(this_type, Y2, Y1);
+      TSM_ASSERT_EQUALS(this_type, E2, E1);
+
+      TSM_ASSERT(this_type, columns.hasColumnStorage());
+    }
+  }
+
+  void test_column_storage_filterByPulseTime_matches_struct_storage() {
+    for (int this_type = 0; this_type < 2; this_type++) {
+      const EventList structs =
+          fake_random_data(static_cast<EventType>(this_type));
+      EventList columns(structs);
+      columns.switchToColumnStorage();
+
+      const DateAndTime start(static_cast<int64_t>(200000000));
+      const DateAndTime stop(static_cast<int64_t>(700000000));
+      EventList structsOut, columnsOut;
+      structs.filterByPulseTime(start, stop, structsOut);
+      columns.filterByPulseTime(start, stop, columnsOut);
+      TS_ASSERT(columnsOut.hasColumnStorage());
+      TS_ASSERT(!columnsOut.empty());
+      TS_ASSERT_EQUALS(columnsOut.getPulseTimes(), structsOut.getPulseTimes());
+      TS_ASSERT_EQUALS(columnsOut.getTofs(), structsOut.getTofs());
+      TS_ASSERT_EQUALS(columnsOut.getWeights(), structsOut.getWeights());
+    }
+  }
+
+  void test_column_storage_splitByFullTime_matches_struct_storage() {
+    TimeSplitterType split;
+    for (int i = 1; i < 10; i++)
+      split.push_back(
+          SplittingInterval(i * 100000000, (i + 1) * 100000000, i % 3));
+    for (int this_type = 0; this_type < 2; this_type++) {
+      const EventList structs =
+          fake_random_data(static_cast<EventType>(this_type));
+      EventList columns(structs);
+      columns.switchToColumnStorage();
+
+      std::map<int, EventList *> structsOut, columnsOut;
+      for (int i = -1; i < 3; i++) {
+        structsOut.emplace(i, new EventList());
+        columnsOut.emplace(i, new EventList());
+      }
+      structs.splitByFullTime(split, structsOut, true, 0.5, 1e-4);
+      columns.splitByFullTime(split, columnsOut, true, 0.5, 1e-4);
+      for (int i = -1; i < 3; i++) {
+        TSM_ASSERT_EQUALS(i, columnsOut[i]->getTofs(),
+                          structsOut[i]->getTofs());
+        TSM_ASSERT_EQUALS(i, columnsOut[i]->getPulseTimes(),
+                          structsOut[i]->getPulseTimes());
+        TSM_ASSERT_EQUALS(i, columnsOut[i]->getWeights(),
+                          structsOut[i]->getWeights());
+        delete structsOut[i];
+        delete columnsOut[i];
+      }
+    }
+  }
+
+  void test_column_storage_switches_back_for_other_operations() {
+    const EventList structs = fake_random_data(TOF);
+    EventList columns(structs);
+    columns.switchToColumnStorage();
+    columns.switchTo(WEIGHTED);
+    TS_ASSERT(columns.hasColumnStorage());
+    TS_ASSERT_EQUALS(columns.getWeights(),
+                     std::vector<double>(structs.getNumberEvents(), 1.0));
+
+    // Direct access to the events needs the event structures
+    const auto &events = columns.getWeightedEvents();
+    TS_ASSERT(!columns.hasColumnStorage());
+    TS_ASSERT_EQUALS(events.size(), structs.getNumberEvents());
+    for (size_t i = 0; i < events.size(); ++i) {
+      TS_ASSERT_EQUALS(events[i].tof(), structs.getEvents()[i].tof());
+      TS_ASSERT_EQUALS(events[i].pulseTime(),
+                       structs.getEvents()[i].pulseTime());
+    }
+  }
+
   //-----------------------------------------------------------------------------------------------
   void test_getPulseTimes() {
     this->fake_uniform_time_data();
@@ -1524,6 +1769,81 @@ public:
     }
   }
 
+  void test_sortTof_long_list_matches_stable_sort() {
+    // Long enough for the radix sort. The weights record the original order
+    // of events with equal TOFs.
+    const auto weighted = fake_events_with_repeated_keys();
+    auto expected = weighted;
+    std::stable_sort(expected.begin(), expected.end(),
+                     [](const WeightedEvent &e1, const WeightedEvent &e2) {
+                       return e1.tof() < e2.tof();
+                     });
+
+    EventList weightedList;
+    weightedList += weighted;
+    weightedList.sortTof();
+    TS_ASSERT(weightedList.getWeightedEvents() == expected);
+
+    std::vector<WeightedEventNoTime> noTime(weighted.begin(), weighted.end());
+    std::vector<WeightedEventNoTime> expectedNoTime(expected.begin(),
+                                                    expected.end());
+    EventList noTimeList;
+    noTimeList += noTime;
+    noTimeList.sortTof();
+    TS_ASSERT(noTimeList.getWeightedEventsNoTime() == expectedNoTime);
+
+    // Equal TOFs keep the order of their pulse times
+    std::vector<TofEvent> tofEvents, expectedTof;
+    for (const auto &event : weighted)
+      tofEvents.emplace_back(event.tof(), event.pulseTime());
+    for (const auto &event : expected)
+      expectedTof.emplace_back(event.tof(), event.pulseTime());
+    EventList tofList;
+    tofList += tofEvents;
+    tofList.sortTof();
+    TS_ASSERT(tofList.getEvents() == expectedTof);
+  }
+
+  void test_sortPulseTime_long_list_matches_stable_sort() {
+    const auto weighted = fake_events_with_repeated_keys();
+    auto expected = weighted;
+    std::stable_sort(expected.begin(), expected.end(),
+                     [](const WeightedEvent &e1, const WeightedEvent &e2) {
+                       return e1.pulseTime() < e2.pulseTime();
+                     });
+
+    EventList weightedList;
+    weightedList += weighted;
+    weightedList.sortPulseTime();
+    TS_ASSERT(weightedList.getWeightedEvents() == expected);
+  }
+
+  void test_sortPulseTimeTOF_long_list_matches_stable_sort() {
+    const auto weighted = fake_events_with_repeated_keys();
+    auto expected = weighted;
+    std::stable_sort(expected.begin(), expected.end(),
+                     [](const WeightedEvent &e1, const WeightedEvent &e2) {
+                       if (e1.pulseTime() == e2.pulseTime())
+                         return e1.tof() < e2.tof();
+                       return e1.pulseTime() < e2.pulseTime();
+                     });
+
+    EventList weightedList;
+    weightedList += weighted;
+    weightedList.sortPulseTimeTOF();
+    TS_ASSERT(weightedList.getWeightedEvents() == expected);
+
+    std::vector<TofEvent> tofEvents, expectedTof;
+    for (const auto &event : weighted)
+      tofEvents.emplace_back(event.tof(), event.pulseTime());
+    for (const auto &event : expected)
+      expectedTof.emplace_back(event.tof(), event.pulseTime());
+    EventList tofList;
+    tofList += tofEvents;
+    tofList.sortPulseTimeTOF();
+    TS_ASSERT(tofList.getEvents() == expectedTof);
+  }
+
   //-----------------------------------------------------------------------------------------------
   void test_filterByPulseTime() {
     // Go through each possible EventType (except the no-time one) as the input
@@ -2294,6 +2614,24 @@ public:
     return el;
   }
 
+  /*
+   Make more events than the threshold for sorting with a radix sort, with
+   many repeated, negative and signed zero TOFs and repeated pulse times. The
+   weight of each event is its position in the list.
+   */
+  std::vector<WeightedEvent> fake_events_with_repeated_keys() {
+    std::vector<WeightedEvent> events;
+    srand(1234); // Fixed random seed
+    for (int i = 0; i < 60000; i++) {
+      double tof = 0.5 * static_cast<double>(rand() % 400 - 100);
+      if (tof == 0.0 && i % 2 == 0)
+        tof = -0.0;
+      const DateAndTime pulseTime(static_cast<int64_t>(rand() % 50));
+      events.emplace_back(tof, pulseTime, static_cast<double>(i), 1.0);
+    }
+    return events;
+  }
+
   /*
    Make some uniformly distributed fake event data distributed by pulse time,
    WITH A CONSTANT TOF.
@@ -2332,6 +2670,27 @@ public:
     return el;
   }
 
+  /** Create 2000 events with random TOFs and pulse times, and for weighted
+   * events random weights and errors.
+   */
+  EventList fake_random_data(EventType eventType) {
+    EventList el;
+    srand(1234); // Fixed random seed
+    for (size_t i = 0; i < 2000; ++i) {
+      // Random tof up to 10 ms, random pulse time up to 1 s
+      const TofEvent event(1e7 * (rand() * 1.0 / RAND_MAX),
+                           static_cast<int64_t>(rand() % 1000) * 1000000);
+      if (eventType == TOF)
+        el += event;
+      else
+        el += WeightedEvent(event, 1.0 + (rand() % 10) * 0.25,
+                            0.5 + (rand() % 10) * 0.125);
+    }
+    if (eventType == WEIGHTED_NOTIME)
+      el.switchTo(WEIGHTED_NOTIME);
+    return el;
+  }
+
   /** Create a uniform event list with no weights*/
   void fake_uniform_data(double events_per_bin = 2,
                          bool randomPulseTime = true) {
@@ -2610,12 +2969,16 @@ public:
     // Coarse vector, 1000 bins.
     for (double i = 0; i < 100000; i += 100)
       coarseX.push_back(i);
+    // Logarithmic vector, ~1000 bins.
+    for (double i = 1; i < 100000; i *= 1.0116)
+      logX.push_back(i);
   }
 
   EventList el_random, el_random_source, el_sorted, el_sorted_original,
       el_sorted_weighted, el4, el5;
   MantidVec fineX;
   MantidVec coarseX;
+  MantidVec logX;
 
   void setUp() override {
     // Reset the random event list
@@ -2631,6 +2994,10 @@ public:
 
   void test_sort_tof() { el_random.sortTof(); }
 
+  void test_sort_pulse_time() { el_random.sortPulseTime(); }
+
+  void test_sort_pulse_time_tof() { el_random.sortPulseTimeTOF(); }
+
   void test_compressEvents() {
     EventList out_el;
     el_sorted.compressEvents(10.0, &out_el);
@@ -2664,6 +3031,22 @@ public:
     el_sorted_weighted.generateHistogram(coarseX, Y, E);
   }
 
+  void test_histogram_unsorted_fine() {
+    MantidVec Y, E;
+    el_random.generateHistogram(fineX, Y, E);
+  }
+
+  void test_histogram_unsorted_log() {
+    MantidVec Y, E;
+    el_random.generateHistogram(logX, Y, E);
+  }
+
+  void test_histogram_log() {
+    MantidVec Y, E;
+    el_sorted.generateHistogram(logX, Y, E);
+    el_sorted_weighted.generateHistogram(logX, Y, E);
+  }
+
   void test_maskTof() {
     TS_ASSERT_EQUALS(el_sorted.getNumberEvents(), 10000000);
     el_sorted.maskTof(25e3, 75e3);
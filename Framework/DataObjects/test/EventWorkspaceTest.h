@@ -549,6 +549,28 @@ public:
     }
   }
 
+  void test_sortAll_TOF_with_column_storage() {
+    EventWorkspace_sptr test_in =
+        WorkspaceCreationHelper::createRandomEventWorkspace(NUMBINS, NUMPIXELS);
+    EventWorkspace_sptr structs(test_in->clone());
+    test_in->setColumnStorage(true);
+
+    test_in->sortAll(TOF_SORT, nullptr);
+    structs->sortAll(TOF_SORT, nullptr);
+
+    for (int wi = 0; wi < NUMPIXELS; wi++) {
+      const EventList &el = test_in->getSpectrum(wi);
+      TS_ASSERT(el.hasColumnStorage());
+      TS_ASSERT_EQUALS(el.getTofs(), structs->getSpectrum(wi).getTofs());
+      TS_ASSERT_EQUALS(test_in->y(wi).rawData(), structs->y(wi).rawData());
+    }
+
+    test_in->setColumnStorage(false);
+    TS_ASSERT(!test_in->getSpectrum(0).hasColumnStorage());
+    TS_ASSERT_EQUALS(test_in->getSpectrum(0).getEvents(),
+                     structs->getSpectrum(0).getEvents());
+  }
+
   /** Test sortAll() when there are more cores available than pixels.
    * This test will only work on machines with 2 cores at least.
    */
@@ -29,6 +29,7 @@
 #include <cmath>
 #include <cxxtest/TestSuite.h>
 #include <gmock/gmock.h>
+#include <iostream>
 #include <map>
 #include <memory>
 #include <nexus/NeXusFile.hpp>
@@ -958,6 +959,119 @@ public:
 
   void test_addEvents_inParallel() { do_test_addEvents_inParallel(NULL); }
 
+  //-------------------------------------------------------------------------------------
+  /** Adding a vector of events to a recursively gridded box puts the events in
+   * the same boxes, in the same order, as adding them one by one. */
+  void test_addEvents_with_recursive_gridding_matches_addEvent() {
+    auto batched = MDEventsTestHelper::makeRecursiveMDGridBox<2>(3, 1);
+    auto single = MDEventsTestHelper::makeRecursiveMDGridBox<2>(3, 1);
+    std::vector<MDLeanEvent<2>> events;
+    for (double x = 2.95; x > 0; x -= 0.1)
+      for (double y = 0.05; y < 3; y += 0.1) {
+        coord_t centers[2] = {static_cast<coord_t>(x),
+                              static_cast<coord_t>(y)};
+        events.push_back(MDLeanEvent<2>(static_cast<float>(x + y), 1.0f,
+                                        centers));
+      }
+
+    TS_ASSERT_EQUALS(batched->addEvents(events), 0);
+    for (const auto &event : events)
+      single->addEvent(event);
+    batched->refreshCache();
+    single->refreshCache();
+    TS_ASSERT_EQUALS(batched->getNPoints(), events.size());
+
+    std::vector<API::IMDNode *> batchedBoxes, singleBoxes;
+    batched->getBoxes(batchedBoxes, 1000, true);
+    single->getBoxes(singleBoxes, 1000, true);
+    TS_ASSERT_EQUALS(batchedBoxes.size(), 81);
+    TS_ASSERT_EQUALS(batchedBoxes.size(), singleBoxes.size());
+    for (size_t i = 0; i < batchedBoxes.size(); ++i) {
+      auto batchedBox =
+          dynamic_cast<MDBox<MDLeanEvent<2>, 2> *>(batchedBoxes[i]);
+      auto singleBox = dynamic_cast<MDBox<MDLeanEvent<2>, 2> *>(singleBoxes[i]);
+      const auto &batchedEvents = batchedBox->getConstEvents();
+      const auto &singleEvents = singleBox->getConstEvents();
+      TS_ASSERT_EQUALS(batchedEvents.size(), singleEvents.size());
+      for (size_t j = 0; j < batchedEvents.size(); ++j)
+        TS_ASSERT_EQUALS(batchedEvents[j].getSignal(),
+                         singleEvents[j].getSignal());
+      batchedBox->releaseEvents();
+      singleBox->releaseEvents();
+    }
+
+    BoxController *const bc1 = batched->getBoxController();
+    BoxController *const bc2 = single->getBoxController();
+    delete batched;
+    delete single;
+    delete bc1;
+    delete bc2;
+  }
+
+  /** Events on the upper boundary of the box are kept and go to the last
+   * child box along that dimension, as with addEvent(). */
+  void test_addEvents_on_upper_boundary() {
+    auto b = MDEventsTestHelper::makeRecursiveMDGridBox<2>(3, 1);
+    const coord_t centers[4][2] = {
+        {3.0f, 3.0f}, {3.0f, 0.5f}, {0.5f, 3.0f}, {3.01f, 0.5f}};
+    std::vector<MDLeanEvent<2>> events;
+    for (const auto &center : centers)
+      events.push_back(MDLeanEvent<2>(1.0f, 1.0f, center));
+
+    // Only the last event is outside
+    TS_ASSERT_EQUALS(b->addEvents(events), 1);
+    b->refreshCache();
+    TS_ASSERT_EQUALS(b->getNPoints(), 3);
+
+    std::vector<API::IMDNode *> boxes;
+    b->getBoxes(boxes, 1000, true);
+    size_t numEvents = 0;
+    for (auto node : boxes) {
+      auto box = dynamic_cast<MDBox<MDLeanEvent<2>, 2> *>(node);
+      for (const auto &event : box->getConstEvents()) {
+        ++numEvents;
+        for (size_t d = 0; d < 2; ++d) {
+          TS_ASSERT_LESS_THAN_EQUALS(box->getExtents(d).getMin(),
+                                     event.getCenter(d));
+          TS_ASSERT_LESS_THAN_EQUALS(event.getCenter(d),
+                                     box->getExtents(d).getMax());
+        }
+      }
+      box->releaseEvents();
+    }
+    TS_ASSERT_EQUALS(numEvents, 3);
+
+    BoxController *const bc = b->getBoxController();
+    delete b;
+    delete bc;
+  }
+
+  /** Threads adding their own vectors of events to a recursively gridded box
+   * concurrently do not lose any events. */
+  void test_addEvents_inParallel_with_recursive_gridding() {
+    auto b = MDEventsTestHelper::makeRecursiveMDGridBox<2>(3, 1);
+    const int numRepeat = 200;
+
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int i = 0; i < numRepeat; i++) {
+      std::vector<MDLeanEvent<2>> events;
+      for (double x = 0.05; x < 3; x += 0.1)
+        for (double y = 0.05; y < 3; y += 0.1) {
+          double centers[2] = {x, y};
+          events.push_back(MDLeanEvent<2>(2.0, 2.0, centers));
+        }
+      TS_ASSERT_EQUALS(b->addEvents(events), 0);
+    }
+
+    b->refreshCache();
+    TS_ASSERT_EQUALS(b->getNPoints(), 900 * numRepeat);
+    TS_ASSERT_EQUALS(b->getSignal(), 900 * numRepeat * 2.0);
+
+    BoxController *const bcc = b->getBoxController();
+    delete b;
+    delete bcc;
+  }
+
   /** Disabled because parallel RefreshCache is not implemented. Might not be
    * ever? */
   void xtest_addEvents_inParallel_then_refreshCache_inParallel() {
@@ -1670,6 +1784,47 @@ public:
     }
   }
 
+  /** Events per second added to a recursively split box by several threads,
+   * each adding its own vectors of events, compared with adding the same
+   * events one at a time.
+   */
+  void test_addEvents_inParallel_scaling() {
+    const int maxThreads = PARALLEL_GET_MAX_THREADS;
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+      PARALLEL_SET_NUM_THREADS(threads);
+      std::cout << "\n" << threads << " threads: "
+                << addEventsInParallel(true) << " events/s with addEvents, "
+                << addEventsInParallel(false) << " events/s with addEvent";
+    }
+    PARALLEL_SET_NUM_THREADS(maxThreads);
+  }
+
+private:
+  /// @return the number of events added per second by all the threads
+  double addEventsInParallel(bool batched) {
+    auto box = MDEventsTestHelper::makeRecursiveMDGridBox<3>(5, 1);
+    const int64_t blockSize = 10000;
+    const int64_t numBlocks = static_cast<int64_t>(events.size()) / blockSize;
+    Timer timer;
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int64_t i = 0; i < numBlocks; ++i) {
+      std::vector<MDLeanEvent<3>> block(events.begin() + i * blockSize,
+                                        events.begin() + (i + 1) * blockSize);
+      if (batched) {
+        box->addEvents(block);
+      } else {
+        for (const auto &event : block)
+          box->addEvent(event);
+      }
+    }
+    const double seconds = timer.elapsed();
+    BoxController *const bc = box->getBoxController();
+    delete box;
+    delete bc;
+    return static_cast<double>(numBlocks * blockSize) / seconds;
+  }
+
+public:
   //-----------------------------------------------------------------------------
   /** Do a sphere integration
    *
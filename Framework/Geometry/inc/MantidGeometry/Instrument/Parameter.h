@@ -62,6 +62,15 @@ public:
   const std::string &name() const { return m_name; }
   /// Parameter name
   const char *nameAsCString() const { return m_name.c_str(); }
+  /// Identifier of the parameter name, the same for names differing in case
+  size_t nameId() const { return m_nameId; }
+
+  /// Value of findNameId for a name no parameter has been given
+  static constexpr size_t UNKNOWN_NAME_ID = 0;
+  /// Return the identifier of a name, registering it if it is new
+  static size_t internName(const std::string &name);
+  /// Return the identifier of a name, or UNKNOWN_NAME_ID if it is not known
+  static size_t findNameId(const char *name);
 
   /// type-independent clone method;
   virtual Parameter *clone() const = 0;
@@ -103,13 +112,17 @@ protected:
 
   friend class ParameterFactory;
   /// Constructor
-  Parameter() : m_type(""), m_name(""), m_str_value(""), m_description("") {}
+  Parameter()
+      : m_type(""), m_name(""), m_nameId(internName("")), m_str_value(""),
+        m_description("") {}
 
 private:
   /// The type of the property
   std::string m_type;
   /// The name of the property
   std::string m_name;
+  /// The interned identifier of m_name
+  size_t m_nameId;
   std::string m_str_value; ///< Parameter value as a string
   /// parameter's description -- string containing the description
   /// of this parameter
@@ -239,6 +239,10 @@ public:
   /// a parameter with a specified type.
   boost::shared_ptr<Parameter>
   getRecursiveByType(const IComponent *comp, const std::string &type) const;
+  /// Values of a double parameter for every detector of an instrument, looked
+  /// up recursively, by detector index
+  std::vector<double> getDetectorDoubles(const Instrument &instrument,
+                                         const std::string &name) const;
 
   /** Get the values of a given parameter of all the components that have the
    * name: compName
@@ -364,6 +368,16 @@ private:
   /// the parameter map
   component_map_cit positionOf(const IComponent *comp, const char *name,
                                const char *type) const;
+  /// internal functions to get position of the parameter in the parameter map
+  /// from the identifier of its name
+  component_map_it positionOf(const IComponent *comp, const size_t nameId,
+                              const char *type);
+  component_map_cit positionOf(const IComponent *comp, const size_t nameId,
+                               const char *type) const;
+  /// Get a parameter from the identifier of its name
+  boost::shared_ptr<Parameter> getByNameId(const IComponent *comp,
+                                           const size_t nameId,
+                                           const char *type) const;
 
   /// internal list of parameter files loaded
   std::vector<std::string> m_parameterFileNames;
@@ -0,0 +1,136 @@
+#ifndef MANTID_GEOMETRY_BOUNDINGVOLUMEHIERARCHY_H_
+#define MANTID_GEOMETRY_BOUNDINGVOLUMEHIERARCHY_H_
+
+#include "MantidGeometry/DllConfig.h"
+#include "MantidKernel/V3D.h"
+
+#include <array>
+#include <vector>
+
+namespace Mantid {
+namespace Geometry {
+class BoundingBox;
+
+/** BoundingVolumeHierarchy : A binary tree of axis-aligned boxes built over
+  the bounding boxes of a set of items, used to find the items whose boxes a
+  ray passes through without testing every box.
+
+  Each node holds the box enclosing all the items below it. The tree is built
+  by splitting the items at the median of their centres along the longest
+  axis, so a ray query visits O(log N) nodes for each item it hits. Items with
+  a null bounding box are never returned.
+
+  Copyright &copy; 2017 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_GEOMETRY_DLL BoundingVolumeHierarchy {
+public:
+  /// A ray starting at a point, prepared for repeated tests against boxes
+  class MANTID_GEOMETRY_DLL Ray {
+  public:
+    Ray(const Kernel::V3D &startPoint, const Kernel::V3D &direction);
+    bool intersects(const BoundingBox &box) const;
+    bool intersects(const std::array<double, 3> &lower,
+                    const std::array<double, 3> &upper) const;
+
+  private:
+    std::array<double, 3> m_start;
+    std::array<double, 3> m_inverseDirection;
+    std::array<bool, 3> m_parallel;
+  };
+
+  BoundingVolumeHierarchy() = default;
+  explicit BoundingVolumeHierarchy(const std::vector<BoundingBox> &boxes);
+
+  /// @return true if the hierarchy contains no items
+  bool empty() const { return m_nodes.empty(); }
+
+  template <typename Visitor>
+  void intersect(const Kernel::V3D &startPoint, const Kernel::V3D &direction,
+                 Visitor &&visit) const;
+
+private:
+  /// A node of the tree. The left child of an inner node follows it directly.
+  struct Node {
+    std::array<double, 3> lower;
+    std::array<double, 3> upper;
+    /// Index of the right child, or of the first item of a leaf
+    size_t index;
+    /// Number of items of a leaf, 0 for an inner node
+    size_t count;
+  };
+
+  /// The box of an item
+  struct Item {
+    std::array<double, 3> lower;
+    std::array<double, 3> upper;
+    /// Index of the item given to the constructor
+    size_t index;
+  };
+
+  void build(size_t begin, size_t end);
+
+  /// The nodes, in depth-first order starting from the root
+  std::vector<Node> m_nodes;
+  /// The items, arranged so that each leaf refers to a contiguous range
+  std::vector<Item> m_items;
+};
+
+/**
+ * Call a function for every item whose bounding box is hit by a ray. The
+ * items are not visited in any particular order.
+ * @param startPoint :: start of the ray
+ * @param direction :: direction of the ray
+ * @param visit :: function called with the index of each item hit
+ */
+template <typename Visitor>
+void BoundingVolumeHierarchy::intersect(const Kernel::V3D &startPoint,
+                                        const Kernel::V3D &direction,
+                                        Visitor &&visit) const {
+  if (m_nodes.empty())
+    return;
+  const Ray ray(startPoint, direction);
+  // The tree is balanced so its depth is at most log2 of the number of items
+  std::array<size_t, 64> stack;
+  size_t stackSize = 0;
+  stack[stackSize++] = 0;
+  while (stackSize > 0) {
+    const size_t nodeIndex = stack[--stackSize];
+    const Node &node = m_nodes[nodeIndex];
+    if (!ray.intersects(node.lower, node.upper))
+      continue;
+    if (node.count > 0) {
+      for (size_t i = node.index; i < node.index + node.count; ++i) {
+        const Item &item = m_items[i];
+        if (ray.intersects(item.lower, item.upper))
+          visit(item.index);
+      }
+    } else {
+      stack[stackSize++] = node.index;
+      stack[stackSize++] = nodeIndex + 1;
+    }
+  }
+}
+
+} // namespace Geometry
+} // namespace Mantid
+
+#endif /* MANTID_GEOMETRY_BOUNDINGVOLUMEHIERARCHY_H_ */
@@ -3,9 +3,11 @@
 
 #include "MantidGeometry/IDetector.h"
 #include "MantidGeometry/Instrument.h"
+#include "MantidGeometry/Objects/BoundingVolumeHierarchy.h"
 #include "MantidGeometry/Objects/Track.h"
 #include <deque>
 #include <list>
+#include <vector>
 
 namespace Mantid {
 namespace Kernel {
@@ -22,6 +24,11 @@ This class is responsible for tracking rays and accumulating a list of objects
 that are
 intersected along the way.
 
+A tracer used for a single ray walks the component tree, testing the bounding
+box of each assembly. Once it is reused it builds a bounding volume hierarchy
+over the individual components, so that later rays only test the components
+whose bounding boxes they pass through.
+
 @author Martyn Gigg, Tessella plc
 @date 22/10/2010
 
@@ -54,6 +61,9 @@ public:
   /// and compile a list of results that this track intersects.
   void trace(const Kernel::V3D &dir) const;
   void traceFromSample(const Kernel::V3D &dir) const;
+  /// Trace many tracks from the sample position in parallel
+  std::vector<Links>
+  traceFromSample(const std::vector<Kernel::V3D> &directions) const;
   /// Get the results of the intersection tests that have been updated
   /// since the previous call to trace
   Links getResults() const;
@@ -65,12 +75,34 @@ private:
   InstrumentRayTracer();
   /// Fire the given track at the instrument
   void fireRay(Track &testRay) const;
+  /// Fire the given track using the bounding volume hierarchy
+  void fireRayUsingHierarchy(Track &testRay) const;
+  /// Build the bounding volume hierarchy over the instrument components
+  void buildHierarchy() const;
+
+  /// A component that is tested directly when its bounding box is hit
+  struct Leaf {
+    /// Keeps the (possibly parametrized) component alive
+    IComponent_const_sptr component;
+    /// A component with a shape, or null
+    const IObjComponent *object;
+    /// An assembly that tests its own children, or null
+    const ICompAssembly *assembly;
+  };
 
   /// Pointer to the instrument
   Instrument_const_sptr m_instrument;
   /// Accumulate results in this Track object, aids performance. This is cleared
   /// when getResults is called.
   mutable Track m_resultsTrack;
+  /// Number of tracks traced by walking the component tree
+  mutable size_t m_treeTraces;
+  /// The components in the hierarchy
+  mutable std::vector<Leaf> m_leaves;
+  /// Hierarchy of the bounding boxes of m_leaves, built on reuse
+  mutable BoundingVolumeHierarchy m_hierarchy;
+  /// Whether m_hierarchy has been built
+  mutable bool m_hierarchyBuilt;
 };
 }
 }
@@ -7,8 +7,10 @@
 #include "MantidGeometry/DllConfig.h"
 
 #include "BoundingBox.h"
+#include <atomic>
 #include <map>
 #include <memory>
+#include <mutex>
 
 namespace Mantid {
 //----------------------------------------------------------------------
@@ -225,6 +227,10 @@ private:
   std::unique_ptr<Rule> TopRule;
   /// Object's bounding box
   BoundingBox m_boundingBox;
+  /// Set once getBoundingBox has calculated m_boundingBox
+  mutable std::atomic<bool> m_boundingBoxCached;
+  /// Serialises the calculation of m_boundingBox in getBoundingBox
+  mutable std::mutex m_boundingBoxMutex;
   // -- DEPRECATED --
   mutable double AABBxMax,  ///< xmax of Axis aligned bounding box cache
       AABByMax,             ///< ymax of Axis aligned bounding box cache
@@ -4,6 +4,11 @@
 #include "MantidKernel/Quat.h"
 #include "MantidKernel/RegistrationHelper.h"
 #include "MantidKernel/V3D.h"
+
+#include <boost/algorithm/string/case_conv.hpp>
+#include "tbb/concurrent_unordered_map.h"
+
+#include <atomic>
 #include <sstream>
 
 /* Register classes into the factory
@@ -23,6 +28,47 @@ namespace Geometry {
 // Initialize the static map
 ParameterFactory::FactoryMap ParameterFactory::s_map;
 
+namespace {
+/// The identifiers of all parameter names, keyed by the lower case name
+tbb::concurrent_unordered_map<std::string, size_t> &nameIds() {
+  static tbb::concurrent_unordered_map<std::string, size_t> ids;
+  return ids;
+}
+}
+
+constexpr size_t Parameter::UNKNOWN_NAME_ID;
+
+/**
+ * Return the identifier of a parameter name, registering the name if it has
+ * not been seen before. Names that differ only in case have the same
+ * identifier. This is thread-safe.
+ * @param name :: A parameter name
+ * @return The identifier of the name
+ */
+size_t Parameter::internName(const std::string &name) {
+  static std::atomic<size_t> nextId(UNKNOWN_NAME_ID + 1);
+  auto &ids = nameIds();
+  auto key = boost::algorithm::to_lower_copy(name);
+  const auto known = ids.find(key);
+  if (known != ids.end())
+    return known->second;
+  // If another thread registers the name first its identifier is kept
+  return ids.insert(std::make_pair(std::move(key), nextId++)).first->second;
+}
+
+/**
+ * Return the identifier of a parameter name without registering it. A name
+ * that is not known cannot belong to any parameter.
+ * @param name :: A parameter name
+ * @return The identifier of the name or UNKNOWN_NAME_ID
+ */
+size_t Parameter::findNameId(const char *name) {
+  const auto &ids = nameIds();
+  const auto known =
+      ids.find(boost::algorithm::to_lower_copy(std::string(name)));
+  return known != ids.end() ? known->second : UNKNOWN_NAME_ID;
+}
+
 /**@return short description of the property (e.g. tooltip).
    The short description defined as all in the full description
    up to double LF symbol.
@@ -61,6 +107,7 @@ ParameterFactory::create(const std::string &className,
     throw std::runtime_error("ParameterFactory:" + className +
                              " is not registered.\n");
   p->m_name = name;
+  p->m_nameId = Parameter::internName(name);
   p->m_type = className;
   return p;
 }
@@ -7,6 +7,8 @@
 #include "MantidGeometry/Instrument.h"
 #include "MantidGeometry/Instrument/ParameterFactory.h"
 #include <cstring>
+#include <limits>
+#include <unordered_map>
 #include <nexus/NeXusFile.hpp>
 #include <boost/algorithm/string.hpp>
 
@@ -372,7 +374,7 @@ void ParameterMap::add(const IComponent *comp,
   if (pDescription)
     par->setDescription(*pDescription);
 
-  auto existing_par = positionOf(comp, par->name().c_str(), "");
+  auto existing_par = positionOf(comp, par->nameId(), "");
   // As this is only an add method it should really throw if it already
   // exists.
   // However, this is old behavior and many things rely on this actually be
@@ -732,17 +734,7 @@ bool ParameterMap::contains(const IComponent *comp, const char *name,
   checkIsNotMaskingParameter(name);
   if (m_map.empty())
     return false;
-  const ComponentID id = comp->getComponentID();
-  std::pair<pmap_cit, pmap_cit> components = m_map.equal_range(id);
-  bool anytype = (strlen(type) == 0);
-  for (auto itr = components.first; itr != components.second; ++itr) {
-    const auto &param = itr->second;
-    if (strcasecmp(param->nameAsCString(), name) == 0 &&
-        (anytype || param->type() == type)) {
-      return true;
-    }
-  }
-  return false;
+  return positionOf(comp, Parameter::findNameId(name), type) != m_map.end();
 }
 
 /**
@@ -795,11 +787,23 @@ boost::shared_ptr<Parameter> ParameterMap::get(const IComponent *comp,
                                                const char *name,
                                                const char *type) const {
   checkIsNotMaskingParameter(name);
-  Parameter_sptr result;
   if (!comp)
-    return result;
+    return Parameter_sptr();
+  return getByNameId(comp, Parameter::findNameId(name), type);
+}
 
-  auto itr = positionOf(comp, name, type);
+/** Return a parameter of a given type from its interned name
+ * @param comp :: Component to which parameter is related
+ * @param nameId :: Identifier of the parameter name
+ * @param type :: An optional type string
+ * @returns The named parameter of the given type if it exists or a NULL shared
+ * pointer if not
+ */
+Parameter_sptr ParameterMap::getByNameId(const IComponent *comp,
+                                         const size_t nameId,
+                                         const char *type) const {
+  Parameter_sptr result;
+  auto itr = positionOf(comp, nameId, type);
   if (itr != m_map.end())
     result = boost::atomic_load(&itr->second);
   return result;
@@ -814,23 +818,31 @@ boost::shared_ptr<Parameter> ParameterMap::get(const IComponent *comp,
 */
 component_map_it ParameterMap::positionOf(const IComponent *comp,
                                           const char *name, const char *type) {
+  return positionOf(comp, Parameter::findNameId(name), type);
+}
+
+/**Return an iterator pointing to a parameter of a given type from its
+ * interned name. Comparing the identifiers avoids comparing the strings of
+ * every parameter of the component.
+ * @param comp :: Component to which parameter is related
+ * @param nameId :: Identifier of the parameter name
+ * @param type :: An optional type string. If empty, any type is returned
+ * @returns The iterator parameter of the given type if it exists or end() if
+ * not
+*/
+component_map_it ParameterMap::positionOf(const IComponent *comp,
+                                          const size_t nameId,
+                                          const char *type) {
   auto result = m_map.end();
-  if (!comp)
+  if (!comp || nameId == Parameter::UNKNOWN_NAME_ID || m_map.empty())
     return result;
   const bool anytype = (strlen(type) == 0);
-  if (!m_map.empty()) {
-    const ComponentID id = comp->getComponentID();
-    auto it_found = m_map.find(id);
-    if (it_found != m_map.end()) {
-      auto itrs = m_map.equal_range(id);
-      for (auto itr = itrs.first; itr != itrs.second; ++itr) {
-        const auto &param = itr->second;
-        if (strcasecmp(param->nameAsCString(), name) == 0 &&
-            (anytype || param->type() == type)) {
-          result = itr;
-          break;
-        }
-      }
+  auto itrs = m_map.equal_range(comp->getComponentID());
+  for (auto itr = itrs.first; itr != itrs.second; ++itr) {
+    const auto &param = itr->second;
+    if (param->nameId() == nameId && (anytype || param->type() == type)) {
+      result = itr;
+      break;
     }
   }
   return result;
@@ -846,23 +858,31 @@ component_map_it ParameterMap::positionOf(const IComponent *comp,
 component_map_cit ParameterMap::positionOf(const IComponent *comp,
                                            const char *name,
                                            const char *type) const {
+  return positionOf(comp, Parameter::findNameId(name), type);
+}
+
+/**Return a const iterator pointing to a parameter of a given type from its
+ * interned name. Comparing the identifiers avoids comparing the strings of
+ * every parameter of the component.
+ * @param comp :: Component to which parameter is related
+ * @param nameId :: Identifier of the parameter name
+ * @param type :: An optional type string. If empty, any type is returned
+ * @returns The iterator parameter of the given type if it exists or end() if
+ * not
+*/
+component_map_cit ParameterMap::positionOf(const IComponent *comp,
+                                           const size_t nameId,
+                                           const char *type) const {
   auto result = m_map.end();
-  if (!comp)
+  if (!comp || nameId == Parameter::UNKNOWN_NAME_ID || m_map.empty())
     return result;
   const bool anytype = (strlen(type) == 0);
-  if (!m_map.empty()) {
-    const ComponentID id = comp->getComponentID();
-    auto it_found = m_map.find(id);
-    if (it_found != m_map.end()) {
-      auto itrs = m_map.equal_range(id);
-      for (auto itr = itrs.first; itr != itrs.second; ++itr) {
-        const auto &param = itr->second;
-        if (strcasecmp(param->nameAsCString(), name) == 0 &&
-            (anytype || param->type() == type)) {
-          result = itr;
-          break;
-        }
-      }
+  auto itrs = m_map.equal_range(comp->getComponentID());
+  for (auto itr = itrs.first; itr != itrs.second; ++itr) {
+    const auto &param = itr->second;
+    if (param->nameId() == nameId && (anytype || param->type() == type)) {
+      result = itr;
+      break;
     }
   }
   return result;
@@ -913,6 +933,63 @@ Parameter_sptr ParameterMap::getRecursiveByType(const IComponent *comp,
   return Parameter_sptr();
 }
 
+/**
+ * Return the values of a double parameter for all the detectors of an
+ * instrument, as getRecursive would find them for each detector. The result
+ * for each component above the detectors is looked up only once, which is much
+ * faster than calling getRecursive for every detector.
+ * @param instrument :: The instrument, parametrized or not
+ * @param name :: Parameter name
+ * @returns The values by detector index. Detectors for which the first
+ * parameter found is missing or not a double have NaN.
+ */
+std::vector<double>
+ParameterMap::getDetectorDoubles(const Instrument &instrument,
+                                 const std::string &name) const {
+  checkIsNotMaskingParameter(name);
+  const auto detIDs = instrument.getDetectorIDs(false);
+  std::vector<double> values(detIDs.size(),
+                             std::numeric_limits<double>::quiet_NaN());
+  const size_t nameId = Parameter::findNameId(name.c_str());
+  if (nameId == Parameter::UNKNOWN_NAME_ID || m_map.empty())
+    return values;
+
+  // Lookups are made on the unparametrized components, as in getRecursive
+  const auto baseInstrument = instrument.isParametrized()
+                                  ? instrument.baseInstrument()
+                                  : Instrument_const_sptr(&instrument,
+                                                          NoDeleting());
+  std::unordered_map<ComponentID, double> ancestorValues;
+  std::vector<ComponentID> searched;
+  for (size_t i = 0; i < detIDs.size(); ++i) {
+    boost::shared_ptr<const IComponent> comp =
+        baseInstrument->getDetector(detIDs[i]);
+    double value = std::numeric_limits<double>::quiet_NaN();
+    searched.clear();
+    while (comp) {
+      const ComponentID id = comp->getComponentID();
+      const auto known = ancestorValues.find(id);
+      if (known != ancestorValues.end()) {
+        value = known->second;
+        break;
+      }
+      if (auto param = getByNameId(id, nameId, "")) {
+        if (param->type() == pDouble())
+          value = param->value<double>();
+        searched.push_back(id);
+        break;
+      }
+      searched.push_back(id);
+      comp = comp->getParent();
+    }
+    values[i] = value;
+    // Remember the result for the ancestors; the detector itself is unique
+    for (size_t j = 1; j < searched.size(); ++j)
+      ancestorValues.emplace(searched[j], value);
+  }
+  return values;
+}
+
 /**
  * Find a parameter by name, recursively going up the component tree
  * to higher parents.
@@ -939,13 +1016,17 @@ Parameter_sptr ParameterMap::getRecursive(const IComponent *comp,
                                           const char *name,
                                           const char *type) const {
   checkIsNotMaskingParameter(name);
-  Parameter_sptr result = this->get(comp->getComponentID(), name, type);
+  // Look the name up once rather than for every level of the tree
+  const size_t nameId = Parameter::findNameId(name);
+  if (nameId == Parameter::UNKNOWN_NAME_ID)
+    return Parameter_sptr();
+  Parameter_sptr result = getByNameId(comp->getComponentID(), nameId, type);
   if (result)
     return result;
 
   auto parent = comp->getParent();
   while (parent) {
-    result = this->get(parent->getComponentID(), name, type);
+    result = getByNameId(parent->getComponentID(), nameId, type);
     if (result)
       return result;
     parent = parent->getParent();
@@ -0,0 +1,150 @@
+#include "MantidGeometry/Objects/BoundingVolumeHierarchy.h"
+#include "MantidGeometry/Objects/BoundingBox.h"
+#include "MantidKernel/Tolerance.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace Mantid {
+namespace Geometry {
+
+namespace {
+/// Maximum number of items in a leaf of the tree
+constexpr size_t MAX_LEAF_SIZE = 4;
+}
+
+//----------------------------------------------------------------------------------------------
+/** Constructor
+ * @param startPoint :: start of the ray
+ * @param direction :: direction of the ray. It need not be normalized.
+ */
+BoundingVolumeHierarchy::Ray::Ray(const Kernel::V3D &startPoint,
+                                  const Kernel::V3D &direction) {
+  for (size_t axis = 0; axis < 3; ++axis) {
+    m_start[axis] = startPoint[axis];
+    m_parallel[axis] = direction[axis] == 0.0;
+    m_inverseDirection[axis] = m_parallel[axis] ? 0.0 : 1.0 / direction[axis];
+  }
+}
+
+/** Test the ray against an axis-aligned box enlarged by the geometric
+ * tolerance. A ray starting inside the box intersects it.
+ * @param box :: an axis-aligned bounding box
+ * @return true if the ray passes through the box, false if it does not or
+ * the box is null
+ */
+bool BoundingVolumeHierarchy::Ray::intersects(const BoundingBox &box) const {
+  if (box.isNull())
+    return false;
+  return intersects({{box.xMin(), box.yMin(), box.zMin()}},
+                    {{box.xMax(), box.yMax(), box.zMax()}});
+}
+
+/** Test the ray against an axis-aligned box enlarged by the geometric
+ * tolerance. A ray starting inside the box intersects it.
+ * @param lower :: the minimum corner of the box
+ * @param upper :: the maximum corner of the box
+ * @return true if the ray passes through the box
+ */
+bool BoundingVolumeHierarchy::Ray::intersects(
+    const std::array<double, 3> &lower,
+    const std::array<double, 3> &upper) const {
+  // Slab test: intersect the ranges of distances inside each pair of planes
+  double entryDistance = 0.0;
+  double exitDistance = std::numeric_limits<double>::max();
+  for (size_t axis = 0; axis < 3; ++axis) {
+    const double low = lower[axis] - Kernel::Tolerance - m_start[axis];
+    const double high = upper[axis] + Kernel::Tolerance - m_start[axis];
+    if (m_parallel[axis]) {
+      if (low > 0.0 || high < 0.0)
+        return false;
+      continue;
+    }
+    double toLow = low * m_inverseDirection[axis];
+    double toHigh = high * m_inverseDirection[axis];
+    if (toLow > toHigh)
+      std::swap(toLow, toHigh);
+    entryDistance = std::max(entryDistance, toLow);
+    exitDistance = std::min(exitDistance, toHigh);
+    if (entryDistance > exitDistance)
+      return false;
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------------------------
+/** Build the hierarchy
+ * @param boxes :: the axis-aligned bounding box of each item. Items are
+ * referred to by their index in this vector.
+ */
+BoundingVolumeHierarchy::BoundingVolumeHierarchy(
+    const std::vector<BoundingBox> &boxes) {
+  for (size_t i = 0; i < boxes.size(); ++i) {
+    const auto &box = boxes[i];
+    if (box.isNull())
+      continue;
+    m_items.push_back({{{box.xMin(), box.yMin(), box.zMin()}},
+                       {{box.xMax(), box.yMax(), box.zMax()}},
+                       i});
+  }
+  if (m_items.empty())
+    return;
+  m_nodes.reserve(2 * m_items.size() / MAX_LEAF_SIZE + 1);
+  build(0, m_items.size());
+}
+
+/** Add the node for a range of items, followed by its children
+ * @param begin :: index of the first item of the range in m_items
+ * @param end :: index past the last item of the range in m_items
+ */
+void BoundingVolumeHierarchy::build(const size_t begin, const size_t end) {
+  const size_t nodeIndex = m_nodes.size();
+  m_nodes.emplace_back();
+  Node node;
+  node.lower = m_items[begin].lower;
+  node.upper = m_items[begin].upper;
+  // Centres are doubled, which does not change their order
+  std::array<double, 3> centreMin, centreMax;
+  for (size_t axis = 0; axis < 3; ++axis)
+    centreMin[axis] = centreMax[axis] = node.lower[axis] + node.upper[axis];
+  for (size_t i = begin + 1; i < end; ++i) {
+    const Item &item = m_items[i];
+    for (size_t axis = 0; axis < 3; ++axis) {
+      node.lower[axis] = std::min(node.lower[axis], item.lower[axis]);
+      node.upper[axis] = std::max(node.upper[axis], item.upper[axis]);
+      const double centre = item.lower[axis] + item.upper[axis];
+      centreMin[axis] = std::min(centreMin[axis], centre);
+      centreMax[axis] = std::max(centreMax[axis], centre);
+    }
+  }
+
+  if (end - begin <= MAX_LEAF_SIZE) {
+    node.index = begin;
+    node.count = end - begin;
+    m_nodes[nodeIndex] = node;
+    return;
+  }
+
+  // Split at the median of the centres along their longest extent
+  size_t splitAxis = 0;
+  for (size_t axis = 1; axis < 3; ++axis)
+    if (centreMax[axis] - centreMin[axis] >
+        centreMax[splitAxis] - centreMin[splitAxis])
+      splitAxis = axis;
+  const size_t middle = begin + (end - begin) / 2;
+  std::nth_element(m_items.begin() + begin, m_items.begin() + middle,
+                   m_items.begin() + end,
+                   [splitAxis](const Item &a, const Item &b) {
+                     return a.lower[splitAxis] + a.upper[splitAxis] <
+                            b.lower[splitAxis] + b.upper[splitAxis];
+                   });
+
+  build(begin, middle);
+  node.index = m_nodes.size();
+  node.count = 0;
+  build(middle, end);
+  m_nodes[nodeIndex] = node;
+}
+
+} // namespace Geometry
+} // namespace Mantid
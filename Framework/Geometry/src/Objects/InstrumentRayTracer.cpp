@@ -2,11 +2,14 @@
 // Includes
 //-------------------------------------------------------------
 #include "MantidGeometry/Objects/InstrumentRayTracer.h"
+#include "MantidGeometry/Instrument/RectangularDetector.h"
 #include "MantidGeometry/Objects/BoundingBox.h"
 #include "MantidGeometry/Objects/Track.h"
 #include "MantidKernel/V3D.h"
 #include "MantidKernel/Exception.h"
+#include "MantidKernel/MultiThreaded.h"
 #include <deque>
+#include <exception>
 #include <iterator>
 
 namespace Mantid {
@@ -26,7 +29,7 @@ using Kernel::V3D;
  * have a defined source.
  */
 InstrumentRayTracer::InstrumentRayTracer(Instrument_const_sptr instrument)
-    : m_instrument(instrument) {
+    : m_instrument(instrument), m_treeTraces(0), m_hierarchyBuilt(false) {
   if (!m_instrument) {
     std::ostringstream lexer;
     lexer << "Cannot create a InstrumentRayTracer, invalid instrument given. "
@@ -72,6 +75,38 @@ void InstrumentRayTracer::traceFromSample(const V3D &dir) const {
   fireRay(m_resultsTrack);
 }
 
+/**
+ * Trace tracks from the sample position in each of the given directions. The
+ * tracks are traced in parallel using the bounding volume hierarchy and the
+ * results are returned rather than accumulated within the object.
+ * @param directions :: The directions of the tracks, as unit vectors
+ * @returns The intersection results of each track
+ */
+std::vector<Links> InstrumentRayTracer::traceFromSample(
+    const std::vector<V3D> &directions) const {
+  buildHierarchy();
+  const V3D samplePos = m_instrument->getSample()->getPos();
+  const int64_t numTracks = static_cast<int64_t>(directions.size());
+  std::vector<Links> results(directions.size());
+  std::exception_ptr error;
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int64_t i = 0; i < numTracks; ++i) {
+    try {
+      Track track(samplePos, directions[i]);
+      fireRayUsingHierarchy(track);
+      results[i].assign(track.cbegin(), track.cend());
+    } catch (...) {
+      PARALLEL_CRITICAL(InstrumentRayTracer_traceFromSample) {
+        if (!error)
+          error = std::current_exception();
+      }
+    }
+  }
+  if (error)
+    std::rethrow_exception(error);
+  return results;
+}
+
 /**
  * Return the results of any trace() calls since the last call the getResults.
  * @returns A collection of links defining intersection information
@@ -117,6 +152,14 @@ IDetector_const_sptr InstrumentRayTracer::getDetectorResult() const {
  *        intersection results
  */
 void InstrumentRayTracer::fireRay(Track &testRay) const {
+  // Building the hierarchy only pays off when the tracer is reused
+  if (m_hierarchyBuilt || m_treeTraces > 0) {
+    buildHierarchy();
+    fireRayUsingHierarchy(testRay);
+    return;
+  }
+  ++m_treeTraces;
+
   // Go through the instrument tree and see if we get any hits by
   // (a) first testing the bounding box and if we're inside that then
   // (b) test the lower components.
@@ -144,6 +187,70 @@ void InstrumentRayTracer::fireRay(Track &testRay) const {
   }
 }
 
+/**
+ * Fire the test ray at the components whose bounding boxes it passes through.
+ * The hierarchy must have been built.
+ * @param testRay :: An input/output parameter that defines the track and
+ * accumulates the intersection results
+ */
+void InstrumentRayTracer::fireRayUsingHierarchy(Track &testRay) const {
+  std::deque<IComponent_const_sptr> unusedQueue;
+  m_hierarchy.intersect(
+      testRay.startPoint(), testRay.direction(), [&](const size_t index) {
+        const Leaf &leaf = m_leaves[index];
+        if (leaf.object)
+          leaf.object->interceptSurface(testRay);
+        else
+          leaf.assembly->testIntersectionWithChildren(testRay, unusedQueue);
+      });
+}
+
+/**
+ * Collect the components of the instrument that are tested directly, i.e.
+ * those with a shape and the rectangular detectors, which find the pixel hit
+ * themselves, and build the bounding volume hierarchy over their boxes.
+ */
+void InstrumentRayTracer::buildHierarchy() const {
+  if (m_hierarchyBuilt)
+    return;
+  std::vector<BoundingBox> boxes;
+  std::deque<ICompAssembly_const_sptr> assemblies;
+  assemblies.push_back(m_instrument);
+  while (!assemblies.empty()) {
+    const auto assembly = assemblies.front();
+    assemblies.pop_front();
+    const int nchildren = assembly->nelements();
+    for (int i = 0; i < nchildren; ++i) {
+      IComponent_const_sptr child = assembly->getChild(i);
+      Leaf leaf{child, nullptr, nullptr};
+      if (auto rectangular =
+              dynamic_cast<const RectangularDetector *>(child.get())) {
+        leaf.assembly = rectangular;
+      } else if (auto childAssembly =
+                     boost::dynamic_pointer_cast<const ICompAssembly>(child)) {
+        assemblies.push_back(childAssembly);
+        continue;
+      } else if (auto object =
+                     dynamic_cast<const IObjComponent *>(child.get())) {
+        // Components without a shape cannot be hit
+        if (!object->shape())
+          continue;
+        leaf.object = object;
+      } else {
+        continue;
+      }
+      BoundingBox box;
+      child->getBoundingBox(box);
+      if (box.isNull())
+        continue;
+      m_leaves.push_back(leaf);
+      boxes.push_back(box);
+    }
+  }
+  m_hierarchy = BoundingVolumeHierarchy(boxes);
+  m_hierarchyBuilt = true;
+}
+
 ///**
 // * Perform a quick check as to whether the ray passes through the component
 // * @param component :: The test component
@@ -1,5 +1,6 @@
 #include "MantidGeometry/Objects/Object.h"
 
+#include "MantidGeometry/Objects/BoundingVolumeHierarchy.h"
 #include "MantidGeometry/Objects/Rules.h"
 #include "MantidGeometry/Objects/Track.h"
 #include "MantidGeometry/Rendering/CacheGeometryHandler.h"
@@ -53,8 +54,9 @@ Object::Object() : Object("") {}
 *  @param shapeXML : string with original shape xml.
 */
 Object::Object(const std::string &shapeXML)
-    : TopRule(nullptr), m_boundingBox(), AABBxMax(0), AABByMax(0), AABBzMax(0),
-      AABBxMin(0), AABByMin(0), AABBzMin(0), boolBounded(false), ObjNum(0),
+    : TopRule(nullptr), m_boundingBox(), m_boundingBoxCached(false),
+      AABBxMax(0), AABByMax(0), AABBzMax(0), AABBxMin(0), AABByMin(0),
+      AABBzMin(0), boolBounded(false), ObjNum(0),
       handle(), bGeometryCaching(false),
       vtkCacheReader(boost::shared_ptr<vtkGeometryCacheReader>()),
       vtkCacheWriter(boost::shared_ptr<vtkGeometryCacheWriter>()),
@@ -753,6 +755,14 @@ int Object::procString(const std::string &Line) {
 * @return Number of segments added
 */
 int Object::interceptSurface(Geometry::Track &UT) const {
+  // A track that misses the bounding box cannot cross any surface within the
+  // object, so skip testing every surface.
+  const BoundingBox &boundingBox = getBoundingBox();
+  if (boundingBox.isNonNull() &&
+      !BoundingVolumeHierarchy::Ray(UT.startPoint(), UT.direction())
+           .intersects(boundingBox))
+    return 0;
+
   int cnt = UT.count(); // Number of intersections original track
   // Loop over all the surfaces.
   LineIntersectVisit LI(UT.startPoint(), UT.direction());
@@ -1633,6 +1643,15 @@ double Object::singleShotMonteCarloVolume(const int shotSize,
 * @returns A reference to a bounding box for this shape.
 */
 const BoundingBox &Object::getBoundingBox() const {
+  // Once calculated the box does not change, so it can be read without a lock.
+  // Tracks are intercepted with the same shapes on many threads, so the first
+  // calculation must not happen on several of them at once.
+  if (m_boundingBoxCached.load(std::memory_order_acquire))
+    return m_boundingBox;
+  std::lock_guard<std::mutex> lock(m_boundingBoxMutex);
+  if (m_boundingBoxCached.load(std::memory_order_relaxed))
+    return m_boundingBox;
+
   // This member function is const given that from a user's perspective it is
   // perfectly reasonable to call it on a const object. We need to call a
   // non-const function in places to update the cache, which is where the
@@ -1645,31 +1664,28 @@ const BoundingBox &Object::getBoundingBox() const {
     return m_boundingBox;
   }
 
-  // We have a bounding box already, so just return it
-  if (m_boundingBox.isNonNull())
-    return m_boundingBox;
-
-  // Try to calculate using Rule method first
-  const_cast<Object *>(this)->calcBoundingBoxByRule();
-  if (m_boundingBox.isNonNull())
-    return m_boundingBox;
-
-  // Rule method failed; Try geometric method
-  const_cast<Object *>(this)->calcBoundingBoxByGeometry();
-  if (m_boundingBox.isNonNull())
-    return m_boundingBox;
-
-  // Geometric method failed; try to calculate by vertices
-  const_cast<Object *>(this)->calcBoundingBoxByVertices();
-  if (m_boundingBox.isNonNull())
-    return m_boundingBox;
-
-  // All options failed; give up
-  // Set to a large box so that a) we don't keep trying to calculate a box
-  // every time this is called and b) to serve as a visual indicator that
-  // something went wrong.
-  const_cast<Object *>(this)
-      ->defineBoundingBox(100, 100, 100, -100, -100, -100);
+  // We may have been given a bounding box already
+  if (!m_boundingBox.isNonNull()) {
+    // Try to calculate using Rule method first
+    const_cast<Object *>(this)->calcBoundingBoxByRule();
+  }
+  if (!m_boundingBox.isNonNull()) {
+    // Rule method failed; Try geometric method
+    const_cast<Object *>(this)->calcBoundingBoxByGeometry();
+  }
+  if (!m_boundingBox.isNonNull()) {
+    // Geometric method failed; try to calculate by vertices
+    const_cast<Object *>(this)->calcBoundingBoxByVertices();
+  }
+  if (!m_boundingBox.isNonNull()) {
+    // All options failed; give up
+    // Set to a large box so that a) we don't keep trying to calculate a box
+    // every time this is called and b) to serve as a visual indicator that
+    // something went wrong.
+    const_cast<Object *>(this)
+        ->defineBoundingBox(100, 100, 100, -100, -100, -100);
+  }
+  m_boundingBoxCached.store(true, std::memory_order_release);
   return m_boundingBox;
 }
 
@@ -1946,7 +1962,10 @@ void Object::defineBoundingBox(const double &xMax, const double &yMax,
 /**
 * Set the bounding box to a null box
 */
-void Object::setNullBoundingBox() { m_boundingBox = BoundingBox(); }
+void Object::setNullBoundingBox() {
+  m_boundingBox = BoundingBox();
+  m_boundingBoxCached = false;
+}
 
 /**
 Try to find a point that lies within (or on) the object
@@ -0,0 +1,108 @@
+#ifndef MANTID_GEOMETRY_BOUNDINGVOLUMEHIERARCHYTEST_H_
+#define MANTID_GEOMETRY_BOUNDINGVOLUMEHIERARCHYTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidGeometry/Objects/BoundingBox.h"
+#include "MantidGeometry/Objects/BoundingVolumeHierarchy.h"
+#include "MantidKernel/MersenneTwister.h"
+
+#include <algorithm>
+
+using Mantid::Geometry::BoundingBox;
+using Mantid::Geometry::BoundingVolumeHierarchy;
+using Mantid::Kernel::V3D;
+
+class BoundingVolumeHierarchyTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static BoundingVolumeHierarchyTest *createSuite() {
+    return new BoundingVolumeHierarchyTest();
+  }
+  static void destroySuite(BoundingVolumeHierarchyTest *suite) {
+    delete suite;
+  }
+
+  void test_Ray_hits_box_in_front() {
+    const BoundingBox box(1.0, 1.0, 1.0, -1.0, -1.0, -1.0);
+    TS_ASSERT(BoundingVolumeHierarchy::Ray(V3D(0, 0, -5), V3D(0, 0, 1))
+                  .intersects(box));
+    TS_ASSERT(BoundingVolumeHierarchy::Ray(V3D(-5, -5, -5), V3D(1, 1, 1))
+                  .intersects(box));
+  }
+
+  void test_Ray_misses_box_behind_it() {
+    const BoundingBox box(1.0, 1.0, 1.0, -1.0, -1.0, -1.0);
+    TS_ASSERT(!BoundingVolumeHierarchy::Ray(V3D(0, 0, -5), V3D(0, 0, -1))
+                   .intersects(box));
+  }
+
+  void test_Ray_misses_box_beside_it() {
+    const BoundingBox box(1.0, 1.0, 1.0, -1.0, -1.0, -1.0);
+    TS_ASSERT(!BoundingVolumeHierarchy::Ray(V3D(0, 2, -5), V3D(0, 0, 1))
+                   .intersects(box));
+    TS_ASSERT(!BoundingVolumeHierarchy::Ray(V3D(0, 0, -5), V3D(0, 1, 1))
+                   .intersects(box));
+  }
+
+  void test_Ray_starting_inside_box_hits_it() {
+    const BoundingBox box(1.0, 1.0, 1.0, -1.0, -1.0, -1.0);
+    TS_ASSERT(BoundingVolumeHierarchy::Ray(V3D(0.5, 0, 0), V3D(1, 0, 0))
+                  .intersects(box));
+    TS_ASSERT(BoundingVolumeHierarchy::Ray(V3D(0.5, 0, 0), V3D(0, 0, 0))
+                  .intersects(box));
+    TS_ASSERT(!BoundingVolumeHierarchy::Ray(V3D(2, 0, 0), V3D(0, 0, 0))
+                   .intersects(box));
+  }
+
+  void test_Ray_along_a_face_hits_box() {
+    const BoundingBox box(1.0, 1.0, 1.0, -1.0, -1.0, -1.0);
+    TS_ASSERT(BoundingVolumeHierarchy::Ray(V3D(1, 0, -5), V3D(0, 0, 1))
+                  .intersects(box));
+  }
+
+  void test_Ray_does_not_hit_null_box() {
+    TS_ASSERT(!BoundingVolumeHierarchy::Ray(V3D(0, 0, 0), V3D(0, 0, 1))
+                   .intersects(BoundingBox()));
+  }
+
+  void test_empty_hierarchy_visits_nothing() {
+    BoundingVolumeHierarchy hierarchy(std::vector<BoundingBox>(3));
+    TS_ASSERT(hierarchy.empty());
+    size_t visits(0);
+    hierarchy.intersect(V3D(), V3D(0, 0, 1), [&](size_t) { ++visits; });
+    TS_ASSERT_EQUALS(visits, 0);
+  }
+
+  void test_intersect_visits_the_same_boxes_as_testing_each_box() {
+    Mantid::Kernel::MersenneTwister rng(12345, -10.0, 10.0);
+    std::vector<BoundingBox> boxes;
+    for (size_t i = 0; i < 1000; ++i) {
+      const double x(rng.nextValue()), y(rng.nextValue()), z(rng.nextValue());
+      boxes.emplace_back(x + 0.5, y + 0.5, z + 0.5, x, y, z);
+    }
+    // A null box is never visited
+    boxes[10] = BoundingBox();
+    BoundingVolumeHierarchy hierarchy(boxes);
+
+    for (size_t i = 0; i < 100; ++i) {
+      const V3D start(rng.nextValue(), rng.nextValue(), rng.nextValue());
+      V3D direction(rng.nextValue(), rng.nextValue(), rng.nextValue());
+      direction.normalize();
+      const BoundingVolumeHierarchy::Ray ray(start, direction);
+      std::vector<size_t> expected;
+      for (size_t j = 0; j < boxes.size(); ++j)
+        if (ray.intersects(boxes[j]))
+          expected.push_back(j);
+
+      std::vector<size_t> visited;
+      hierarchy.intersect(start, direction,
+                          [&](size_t index) { visited.push_back(index); });
+      std::sort(visited.begin(), visited.end());
+      TS_ASSERT_EQUALS(visited, expected);
+    }
+  }
+};
+
+#endif /* MANTID_GEOMETRY_BOUNDINGVOLUMEHIERARCHYTEST_H_ */
@@ -211,7 +211,62 @@ public:
     doTestRectangularDetector("Zero-beam", inst, V3D(0.0, 0.0, 0.0), -1, -1);
   }
 
+  void test_Reused_Tracer_Gives_The_Same_Results_As_A_New_Tracer() {
+    Instrument_sptr testInst = setupInstrument();
+    InstrumentRayTracer tracker(testInst);
+    std::vector<V3D> directions;
+    directions.emplace_back(0., 0., 1.);
+    directions.emplace_back(0.010, 0.0, 15.004);
+    directions.emplace_back(0., 1., 0.);
+    for (const auto &dir : directions) {
+      // The reused tracker switches to its bounding volume hierarchy
+      tracker.trace(dir);
+      const Links reused = tracker.getResults();
+      InstrumentRayTracer newTracker(testInst);
+      newTracker.trace(dir);
+      assertSameLinks(reused, newTracker.getResults());
+    }
+  }
+
+  void test_Batched_Trace_From_Sample_Matches_Single_Traces() {
+    Instrument_sptr inst =
+        ComponentCreationHelper::createTestInstrumentRectangular(1, 100);
+    const double w = 0.008;
+    std::vector<V3D> directions;
+    directions.emplace_back(0.0, 0.0, 5.0);
+    directions.emplace_back(w * 1, w * 2, 5.0);
+    directions.emplace_back(w * 99, w * 99, 5.0);
+    directions.emplace_back(w * 0.55, w * 1.55, 5.0);
+    directions.emplace_back(-w, 0.0, 5.0);
+    directions.emplace_back(1.0, 0.0, 0.0);
+    for (auto &dir : directions)
+      dir.normalize();
+
+    InstrumentRayTracer tracker(inst);
+    const auto batched = tracker.traceFromSample(directions);
+    TS_ASSERT_EQUALS(batched.size(), directions.size());
+    for (size_t i = 0; i < directions.size(); ++i) {
+      InstrumentRayTracer newTracker(inst);
+      newTracker.traceFromSample(directions[i]);
+      assertSameLinks(batched[i], newTracker.getResults());
+    }
+  }
+
 private:
+  void assertSameLinks(const Links &actual, const Links &expected) {
+    TS_ASSERT_EQUALS(actual.size(), expected.size());
+    if (actual.size() != expected.size())
+      return;
+    auto expectedItr = expected.cbegin();
+    for (const auto &link : actual) {
+      TS_ASSERT_EQUALS(link.componentID, expectedItr->componentID);
+      TS_ASSERT_DELTA(link.distFromStart, expectedItr->distFromStart, 1e-9);
+      TS_ASSERT_DELTA(link.distInsideObject, expectedItr->distInsideObject,
+                      1e-9);
+      ++expectedItr;
+    }
+  }
+
   /// Setup the shared test instrument
   Instrument_sptr setupInstrument() {
     if (!m_testInst) {
@@ -24,6 +24,7 @@
 #include <vector>
 #include <algorithm>
 #include <ctime>
+#include <thread>
 
 #include "boost/shared_ptr.hpp"
 #include "boost/make_shared.hpp"
@@ -295,6 +296,27 @@ public:
     TS_ASSERT_DELTA(bbox.zMin(), -4.1, tolerance);
   }
 
+  void testInterceptSurfaceOnManyThreadsCalculatesBoundingBoxOnce() {
+    Object_sptr geom_obj = ComponentCreationHelper::createSphere(4.1);
+    std::vector<int> segments(8, 0);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < segments.size(); ++i) {
+      threads.emplace_back([&geom_obj, &segments, i]() {
+        Track track(V3D(-10, 0, 0), V3D(1, 0, 0));
+        segments[i] = geom_obj->interceptSurface(track);
+      });
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+    for (const int count : segments) {
+      TS_ASSERT_EQUALS(count, 1);
+    }
+    const BoundingBox &bbox = geom_obj->getBoundingBox();
+    TS_ASSERT_DELTA(bbox.xMax(), 4.1, 1e-10);
+    TS_ASSERT_DELTA(bbox.xMin(), -4.1, 1e-10);
+  }
+
   void testCalcValidTypeCappedCylinder() {
     Object_sptr geom_obj = createCappedCylinder();
     // entry on the normal
@@ -12,6 +12,8 @@
 #include <boost/function.hpp>
 #include <boost/make_shared.hpp>
 
+#include <cmath>
+
 using Mantid::Geometry::ParameterMap;
 using Mantid::Geometry::ParameterMap_sptr;
 using Mantid::Geometry::Parameter_sptr;
@@ -430,6 +432,26 @@ public:
                fetched);
   }
 
+  void test_Name_Ids_Are_Case_Insensitive() {
+    using Mantid::Geometry::Parameter;
+    const auto id = Parameter::internName("NameIdTest");
+    TS_ASSERT_EQUALS(Parameter::internName("nameidtest"), id);
+    TS_ASSERT_EQUALS(Parameter::findNameId("NAMEIDTEST"), id);
+    TS_ASSERT_DIFFERS(Parameter::internName("NameIdTest2"), id);
+    TS_ASSERT_EQUALS(Parameter::findNameId("NameIdTestNeverAdded"),
+                     Parameter::UNKNOWN_NAME_ID);
+  }
+
+  void test_Unknown_Name_Is_Not_Found() {
+    ParameterMap pmap;
+    pmap.addDouble(m_testInstrument.get(), "known", 1.0);
+    IComponent_sptr comp = m_testInstrument->getChild(0);
+    TS_ASSERT(!pmap.contains(m_testInstrument.get(), "neverAddedAnywhere"));
+    TS_ASSERT(!pmap.get(m_testInstrument.get(), "neverAddedAnywhere"));
+    TS_ASSERT(!pmap.getRecursive(comp.get(), "neverAddedAnywhere"));
+    TS_ASSERT(pmap.getRecursive(comp.get(), "KNOWN"));
+  }
+
   void testRecursive_Parameter_Search_Moves_Up_The_Instrument_Tree() {
     // Attach 2 parameters to the instrument
     const std::string topLevel1("top1"), topLevel2("top2");
@@ -455,6 +477,41 @@ public:
     TS_ASSERT_EQUALS(fetched->value<int>(), value2);
   }
 
+  void test_getDetectorDoubles_Matches_getRecursive() {
+    ParameterMap pmap;
+    pmap.addDouble(m_testInstrument.get(), "detDouble", 1.5);
+    const auto detIDs = m_testInstrument->getDetectorIDs(false);
+    auto det1 = m_testInstrument->getDetector(detIDs[1]);
+    auto det2 = m_testInstrument->getDetector(detIDs[2]);
+    pmap.addDouble(det1.get(), "detDouble", 2.5);
+    pmap.addString(det2.get(), "detDouble", "notADouble");
+
+    const auto values = pmap.getDetectorDoubles(*m_testInstrument, "detDouble");
+    TS_ASSERT_EQUALS(values.size(), detIDs.size());
+    for (size_t i = 0; i < detIDs.size(); ++i) {
+      if (i == 2) {
+        TS_ASSERT(std::isnan(values[i]));
+        continue;
+      }
+      auto det = m_testInstrument->getDetector(detIDs[i]);
+      auto param = pmap.getRecursive(det.get(), "detDouble");
+      TS_ASSERT(param);
+      if (param)
+        TS_ASSERT_EQUALS(values[i], param->value<double>());
+    }
+    TS_ASSERT_EQUALS(values[0], 1.5);
+    TS_ASSERT_EQUALS(values[1], 2.5);
+  }
+
+  void test_getDetectorDoubles_Gives_NaN_For_Missing_Parameter() {
+    ParameterMap pmap;
+    pmap.addDouble(m_testInstrument.get(), "other", 1.5);
+    const auto values = pmap.getDetectorDoubles(*m_testInstrument, "missing");
+    TS_ASSERT_EQUALS(values.size(), m_testInstrument->getNumberDetectors());
+    for (const auto value : values)
+      TS_ASSERT(std::isnan(value));
+  }
+
   void testClearByName_Only_Removes_Named_Parameter() {
     ParameterMap pmap;
     pmap.addDouble(m_testInstrument.get(), "first", 5.4);
@@ -774,6 +831,15 @@ public:
     TS_ASSERT_DELTA(11.0, par_sptr->value<double>(), 1e-12);
   }
 
+  void test_Unknown_Par_Lookup_Via_GetRecursive_And_Leaf_Component() {
+    Mantid::Geometry::Parameter_sptr par_sptr;
+
+    for (size_t i = 0; i < 10000; ++i) {
+      par_sptr = m_pmap.getRecursive(m_leaf->getComponentID(), "notthere");
+    }
+    TS_ASSERT(!par_sptr);
+  }
+
   void test_Leaf_Par_Lookup_Via_Get_And_Leaf_Component() {
     Mantid::Geometry::Parameter_sptr par_sptr;
 
@@ -3,6 +3,7 @@
 
 #include "MantidHistogramData/DllConfig.h"
 #include "MantidKernel/cow_ptr.h"
+#include "MantidKernel/make_cow.h"
 #include "MantidHistogramData/BinEdges.h"
 #include "MantidHistogramData/Counts.h"
 #include "MantidHistogramData/CountStandardDeviations.h"
@@ -127,6 +128,8 @@ public:
   HistogramY &mutableY() & { return m_y.access(); }
   HistogramE &mutableE() & { return m_e.access(); }
   HistogramDx &mutableDx() & { return m_dx.access(); }
+  template <class UnaryOperation> void transformY(UnaryOperation op) & ;
+  template <class UnaryOperation> void transformE(UnaryOperation op) & ;
 
   Kernel::cow_ptr<HistogramX> sharedX() const { return m_x; }
   Kernel::cow_ptr<HistogramY> sharedY() const { return m_y; }
@@ -228,6 +231,29 @@ template <>
 void MANTID_HISTOGRAMDATA_DLL
 Histogram::setUncertainties(const FrequencyStandardDeviations &e);
 
+namespace detail {
+/** Replace every value of copy-on-write data by op(value).
+
+  If the data are shared the results are written to a new array, rather than
+  copying the data and then overwriting the copy, which halves the memory
+  traffic. Unshared data are modified in place. */
+template <class T, class UnaryOperation>
+void transformCowData(Kernel::cow_ptr<T> &data, UnaryOperation op) {
+  if (data.unique()) {
+    auto &values = data.access();
+    for (auto &value : values)
+      value = op(value);
+    return;
+  }
+  const auto &values = data->rawData();
+  std::vector<double> result;
+  result.reserve(values.size());
+  for (const double value : values)
+    result.push_back(op(value));
+  data = Kernel::make_cow<T>(std::move(result));
+}
+}
+
 /** Construct from X data, (optionally) Y data, and (optionally) E data.
 
   @param x X data for the Histogram. Can be BinEdges or Points.
@@ -262,6 +288,24 @@ template <class TE> void Histogram::initE(const TE &e) {
   }
 }
 
+/** Replace every Y value y by op(y).
+
+  Unlike modifying mutableY(), the data are not copied first if they are
+  shared with another Histogram. */
+template <class UnaryOperation>
+void Histogram::transformY(UnaryOperation op) & {
+  detail::transformCowData(m_y, op);
+}
+
+/** Replace every E value e by op(e).
+
+  Unlike modifying mutableE(), the data are not copied first if they are
+  shared with another Histogram. */
+template <class UnaryOperation>
+void Histogram::transformE(UnaryOperation op) & {
+  detail::transformCowData(m_e, op);
+}
+
 /** Sets the Histogram's bin edges.
 
  Any arguments that can be used for constructing a BinEdges object are allowed,
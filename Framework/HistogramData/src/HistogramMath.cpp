@@ -16,8 +16,8 @@ Histogram &operator*=(Histogram &histogram, const double factor) {
   if (factor < 0.0 || !std::isfinite(factor))
     throw std::runtime_error("Invalid operation: Cannot scale Histogram by "
                              "negative or infinite factor");
-  histogram.mutableY() *= factor;
-  histogram.mutableE() *= factor;
+  histogram.transformY([factor](const double y) { return y * factor; });
+  histogram.transformE([factor](const double e) { return e * factor; });
   return histogram;
 }
 
@@ -1108,6 +1108,33 @@ public:
     TS_ASSERT(!h.sharedE());
     TS_ASSERT(!h.sharedDx());
   }
+
+  void test_transformY_and_transformE_of_shared_data_leave_original() {
+    const Histogram original(BinEdges{1, 2, 3}, Counts{4, 9},
+                             CountStandardDeviations{2, 3});
+    Histogram h(original);
+    h.transformY([](const double y) { return 2.0 * y; });
+    h.transformE([](const double e) { return e + 1.0; });
+    TS_ASSERT_EQUALS(h.y()[0], 8.0);
+    TS_ASSERT_EQUALS(h.y()[1], 18.0);
+    TS_ASSERT_EQUALS(h.e()[0], 3.0);
+    TS_ASSERT_EQUALS(h.e()[1], 4.0);
+    TS_ASSERT_EQUALS(original.y()[0], 4.0);
+    TS_ASSERT_EQUALS(original.y()[1], 9.0);
+    TS_ASSERT_EQUALS(original.e()[0], 2.0);
+    TS_ASSERT_EQUALS(original.e()[1], 3.0);
+    TS_ASSERT_DIFFERS(h.sharedY(), original.sharedY());
+    TS_ASSERT_DIFFERS(h.sharedE(), original.sharedE());
+  }
+
+  void test_transformY_of_unique_data_is_in_place() {
+    Histogram h(BinEdges{1, 2, 3}, Counts{4, 9});
+    const auto *y = &h.y();
+    h.transformY([](const double y) { return y - 1.0; });
+    TS_ASSERT_EQUALS(&h.y(), y);
+    TS_ASSERT_EQUALS(h.y()[0], 3.0);
+    TS_ASSERT_EQUALS(h.y()[1], 8.0);
+  }
 };
 
 class HistogramTestPerformance : public CxxTest::TestSuite {
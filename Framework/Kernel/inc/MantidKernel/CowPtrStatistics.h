@@ -0,0 +1,58 @@
+#ifndef MANTID_KERNEL_COWPTRSTATISTICS_H_
+#define MANTID_KERNEL_COWPTRSTATISTICS_H_
+
+#include "MantidKernel/DllConfig.h"
+
+#include <atomic>
+#include <cstddef>
+
+namespace Mantid {
+namespace Kernel {
+
+/** CowPtrStatistics : Counts the deep copies made by cow_ptr::access when the
+  data are shared, and the number of bytes copied. Comparing the counts before
+  and after a piece of work shows how much of its time may be spent copying
+  data that are modified after being shared, e.g. by calling mutableY() on a
+  spectrum of a cloned workspace.
+
+  The counts cover all threads and are never reset, so differences of the
+  counts include the copies made by any other work running at the same time.
+
+  Copyright &copy; 2017 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_KERNEL_DLL CowPtrStatistics {
+public:
+  static void recordCopy(const size_t bytes);
+  static size_t copies();
+  static size_t copiedBytes();
+
+private:
+  /// Number of copies made
+  static std::atomic<size_t> s_copies;
+  /// Number of bytes copied
+  static std::atomic<size_t> s_copiedBytes;
+};
+
+} // namespace Kernel
+} // namespace Mantid
+
+#endif /* MANTID_KERNEL_COWPTRSTATISTICS_H_ */
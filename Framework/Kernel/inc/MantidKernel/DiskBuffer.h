@@ -10,11 +10,16 @@
 #include <boost/multi_index/ordered_index.hpp>
 #include <boost/multi_index/sequenced_index.hpp>
 #endif
+#include <condition_variable>
 #include <cstdint>
+#include <deque>
+#include <exception>
 #include <limits>
 #include <list>
 #include <mutex>
 #include <string>
+#include <thread>
+#include <utility>
 #include <vector>
 
 namespace Mantid {
@@ -32,6 +37,12 @@ class ISaveable;
   It also stores a list of "free" blocks in the output file,
   to allow new blocks to fill them later.
 
+  Objects whose data will not change any more can instead be handed to
+  writeAsync(), which saves them on a background I/O thread so that the
+  caller can carry on (e.g. reading the next block) while the data are
+  written. The memory held by objects waiting to be written is bounded by
+  the write buffer size.
+
   @date 2011-12-30
 
   Copyright &copy; 2011 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
@@ -78,12 +89,16 @@ public:
   DiskBuffer(uint64_t m_writeBufferSize);
   DiskBuffer(const DiskBuffer &) = delete;
   DiskBuffer &operator=(const DiskBuffer &) = delete;
-  virtual ~DiskBuffer() = default;
+  virtual ~DiskBuffer();
 
   void toWrite(ISaveable *item);
   void flushCache();
   void objectDeleted(ISaveable *item);
 
+  // Asynchronous writing
+  void writeAsync(ISaveable *item);
+  void waitForAsyncWrites();
+
   // Free space map methods
   void freeBlock(uint64_t const pos, uint64_t const size);
   void defragFreeBlocks();
@@ -169,6 +184,27 @@ protected:
   mutable uint64_t m_fileLength;
 
 private:
+  void asyncWriterLoop();
+  void waitForAsyncItem(std::unique_lock<std::mutex> &lock,
+                        const ISaveable *item);
+
+  // ----------------------- Asynchronous writing -----------------------------
+  /// Objects waiting for the I/O thread, with the memory they were queued with
+  std::deque<std::pair<ISaveable *, uint64_t>> m_asyncQueue;
+  /// Object being written by the I/O thread
+  ISaveable *m_asyncWriting;
+  /// Memory held by the queued objects and the one being written
+  uint64_t m_asyncMemoryUsed;
+  /// Set to stop the I/O thread once its queue is empty
+  bool m_stopAsyncWriter;
+  /// First error thrown while writing asynchronously
+  std::exception_ptr m_asyncError;
+  /// Mutex for the asynchronous queue
+  std::mutex m_asyncMutex;
+  /// Signals changes of the asynchronous queue
+  std::condition_variable m_asyncCondition;
+  /// The I/O thread, started by the first call to writeAsync
+  std::thread m_asyncWriter;
 };
 
 } // namespace Kernel
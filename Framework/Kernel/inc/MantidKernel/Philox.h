@@ -0,0 +1,115 @@
+#ifndef MANTID_KERNEL_PHILOX_H_
+#define MANTID_KERNEL_PHILOX_H_
+
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+#include "MantidKernel/PseudoRandomNumberGenerator.h"
+
+#include <array>
+#include <cstdint>
+
+namespace Mantid {
+namespace Kernel {
+/**
+  This implements the Philox4x32-10 counter-based pseudo-random number
+  generator as a specialization of the PseudoRandomNumberGenerator interface.
+
+  A counter-based generator computes each block of random numbers directly
+  from a key (the seed) and a counter, so it has no evolving state to share.
+  Besides the seed the generator takes a stream number: every (seed, stream)
+  pair gives an independent sequence, and selecting a stream costs nothing.
+  Giving each independent piece of a calculation its own stream, e.g. the
+  index of the spectrum and point being simulated, makes the results the same
+  whatever the order in which the pieces are computed and so independent of
+  the number of threads.
+
+  Reference: J. K. Salmon, M. A. Moraes, R. O. Dror and D. E. Shaw,
+  "Parallel random numbers: as easy as 1, 2, 3", SC11 (2011).
+
+  Copyright &copy; 2017 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>.
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_KERNEL_DLL Philox final : public PseudoRandomNumberGenerator {
+
+public:
+  /// Construct the generator with a seed and stream, and the range [0, 1)
+  explicit Philox(const size_t seedValue, const uint64_t stream = 0);
+  /// Construct the generator with a seed, a stream and a range
+  Philox(const size_t seedValue, const uint64_t stream, const double start,
+         const double end);
+
+  /// Set the random number seed and restart the current stream
+  void setSeed(const size_t seedValue) override;
+  /// Select a stream and start it from the beginning
+  void setStream(const uint64_t stream);
+  /// Sets the range of the subsequent calls to next
+  void setRange(const double start, const double end) override;
+  /// Generate the next random number in the sequence within the default range
+  inline double nextValue() override { return nextValue(m_start, m_end); }
+  /// Generate the next random number in the sequence within the given range.
+  double nextValue(double start, double end) override;
+  /// Return the next integer in the sequence within the given range
+  int nextInt(int start, int end) override;
+  /// Resets the generator to the start of the current stream
+  void restart() override;
+  /// Saves the current state of the generator
+  void save() override;
+  /// Restores the generator to the last saved point, or the beginning if
+  /// nothing has been saved
+  void restore() override;
+  /// Return the minimum value of the range
+  double min() const override { return m_start; }
+  /// Return the maximum value of the range
+  double max() const override { return m_end; }
+
+private:
+  /// The position within the sequence
+  struct State {
+    /// Index of the next block
+    uint64_t counter;
+    /// The current block of random bits
+    std::array<uint32_t, 4> block;
+    /// Index of the next unused word in block
+    size_t position;
+  };
+
+  uint32_t nextWord();
+
+  /// The key, from the seed
+  std::array<uint32_t, 2> m_key;
+  /// The stream number
+  uint64_t m_stream;
+  /// The current position
+  State m_state;
+  /// The position when save was called
+  State m_savedState;
+  /// Whether save has been called since the stream was started
+  bool m_saved;
+  /// Minimum in range
+  double m_start;
+  /// Maximum in range
+  double m_end;
+};
+}
+}
+
+#endif /* MANTID_KERNEL_PHILOX_H_ */
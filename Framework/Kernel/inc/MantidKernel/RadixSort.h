@@ -0,0 +1,145 @@
+#ifndef MANTID_KERNEL_RADIXSORT_H_
+#define MANTID_KERNEL_RADIXSORT_H_
+
+#include "MantidKernel/MultiThreaded.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace Mantid {
+namespace Kernel {
+
+/** A stable least-significant-digit radix sort for vectors of objects with a
+  64 bit integer sort key, e.g. events sorted by time-of-flight or pulse time.
+
+  The key is processed in 11 bit digits. Passes where every key has the same
+  digit are skipped, which is common for time-of-flight values where the sign
+  and exponent bits rarely change. Large vectors are split into chunks that
+  are counted and scattered in parallel; the result is identical for any
+  number of threads.
+
+  Sorting by several keys is done by sorting by the least significant key
+  first, relying on the sort being stable.
+
+  Copyright &copy; 2017 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+namespace RadixSort {
+
+/// Number of bits sorted in each pass
+constexpr unsigned int DigitBits = 11;
+/// Number of buckets in each pass
+constexpr size_t NumBuckets = size_t(1) << DigitBits;
+/// Number of passes needed to cover a 64 bit key
+constexpr unsigned int NumPasses = (64 + DigitBits - 1) / DigitBits;
+/// Minimum number of items handled by one thread
+constexpr size_t MinimumChunkSize = 1 << 16;
+
+/// Map a double onto an unsigned key with the same ordering
+inline uint64_t orderedKey(const double value) {
+  // -0.0 compares equal to 0.0 so must have the same key
+  const double normalized = value == 0.0 ? 0.0 : value;
+  uint64_t bits;
+  std::memcpy(&bits, &normalized, sizeof(bits));
+  const uint64_t signBit = uint64_t(1) << 63;
+  // Negative values have all bits flipped so larger magnitudes sort first
+  return (bits & signBit) ? ~bits : (bits | signBit);
+}
+
+/// Map a signed integer onto an unsigned key with the same ordering
+inline uint64_t orderedKey(const int64_t value) {
+  return static_cast<uint64_t>(value) ^ (uint64_t(1) << 63);
+}
+
+/**
+ * Stable sort of a vector by an unsigned 64 bit key.
+ * @param items :: The vector to sort
+ * @param key :: Functor returning the uint64_t key for an item
+ */
+template <typename T, typename KeyFunction>
+void sortByKey(std::vector<T> &items, const KeyFunction &key) {
+  const size_t size = items.size();
+  if (size < 2)
+    return;
+
+  const size_t maxChunks = std::max(size / MinimumChunkSize, size_t(1));
+  const int numChunks = static_cast<int>(std::min(
+      maxChunks, static_cast<size_t>(std::max(PARALLEL_GET_MAX_THREADS, 1))));
+  std::vector<size_t> chunkStart(numChunks + 1);
+  for (int chunk = 0; chunk <= numChunks; ++chunk)
+    chunkStart[chunk] = size * static_cast<size_t>(chunk) / numChunks;
+
+  using Histogram = std::array<size_t, NumBuckets>;
+  std::vector<Histogram> offsets(numChunks);
+  std::vector<T> buffer(size);
+
+  for (unsigned int pass = 0; pass < NumPasses; ++pass) {
+    const unsigned int shift = pass * DigitBits;
+    auto digit = [&key, shift](const T &item) {
+      return static_cast<size_t>((key(item) >> shift) & (NumBuckets - 1));
+    };
+
+    PARALLEL_FOR_IF(numChunks > 1)
+    for (int chunk = 0; chunk < numChunks; ++chunk) {
+      auto &counts = offsets[chunk];
+      counts.fill(0);
+      for (size_t i = chunkStart[chunk]; i < chunkStart[chunk + 1]; ++i)
+        ++counts[digit(items[i])];
+    }
+
+    // Turn the counts into output positions. Chunks fill each bucket in order,
+    // which keeps the sort stable.
+    size_t position = 0;
+    bool allInOneBucket = false;
+    for (size_t bucket = 0; bucket < NumBuckets; ++bucket) {
+      const size_t bucketStart = position;
+      for (auto &counts : offsets) {
+        const size_t count = counts[bucket];
+        counts[bucket] = position;
+        position += count;
+      }
+      if (position - bucketStart == size) {
+        allInOneBucket = true;
+        break;
+      }
+    }
+    // This digit is the same for every item so the pass would do nothing
+    if (allInOneBucket)
+      continue;
+
+    PARALLEL_FOR_IF(numChunks > 1)
+    for (int chunk = 0; chunk < numChunks; ++chunk) {
+      auto &positions = offsets[chunk];
+      for (size_t i = chunkStart[chunk]; i < chunkStart[chunk + 1]; ++i)
+        buffer[positions[digit(items[i])]++] = items[i];
+    }
+    items.swap(buffer);
+  }
+}
+
+} // namespace RadixSort
+} // namespace Kernel
+} // namespace Mantid
+
+#endif /* MANTID_KERNEL_RADIXSORT_H_ */
@@ -0,0 +1,87 @@
+#ifndef MANTID_KERNEL_THREADSCHEDULERWORKSTEALING_H_
+#define MANTID_KERNEL_THREADSCHEDULERWORKSTEALING_H_
+
+#include "MantidKernel/DllConfig.h"
+#include "MantidKernel/ThreadScheduler.h"
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Mantid {
+namespace Kernel {
+
+/** ThreadSchedulerWorkStealing : A ThreadScheduler that keeps a separate
+  queue of tasks for each thread instead of a single shared queue.
+
+  A thread takes its own most recently added task first. When its own queue
+  is empty it steals the oldest task from another thread's queue. Tasks
+  pushed from inside a running task (e.g. the recursive box splitting in
+  MDGridBox::splitAllIfNeeded) go to the queue of the thread that is running,
+  so nested tasks normally stay on the same thread and threads only contend
+  when stealing. Tasks pushed from outside the pool are spread round-robin
+  over the queues; pushToThread can be used to give an explicit affinity.
+
+  Copyright &copy; 2017 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_KERNEL_DLL ThreadSchedulerWorkStealing : public ThreadScheduler {
+public:
+  ThreadSchedulerWorkStealing();
+  explicit ThreadSchedulerWorkStealing(size_t numQueues);
+  ~ThreadSchedulerWorkStealing() override;
+
+  void push(Task *newTask) override;
+  void pushToThread(Task *newTask, size_t threadnum);
+  Task *pop(size_t threadnum) override;
+  size_t size() override;
+  bool empty() override;
+  void clear() override;
+  double totalCost() override;
+
+  /// @return the number of per-thread queues
+  size_t numQueues() const { return m_queues.size(); }
+
+private:
+  /// A queue of tasks owned by one thread
+  struct TaskQueue {
+    std::mutex mutex;
+    std::deque<Task *> tasks;
+    /// Total cost of the tasks pushed to the queue since the last clear()
+    double cost = 0.0;
+  };
+
+  size_t queueForCurrentThread();
+
+  /// One queue per thread
+  std::vector<std::unique_ptr<TaskQueue>> m_queues;
+  /// Total number of queued tasks, so size() and empty() need no locking
+  std::atomic<size_t> m_size;
+  /// Next queue for tasks pushed from outside the pool
+  std::atomic<size_t> m_nextQueue;
+};
+
+} // namespace Kernel
+} // namespace Mantid
+
+#endif /* MANTID_KERNEL_THREADSCHEDULERWORKSTEALING_H_ */
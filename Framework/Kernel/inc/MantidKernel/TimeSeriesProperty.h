@@ -93,6 +93,12 @@ public:
 /**
    A specialised Property class for holding a series of time-value pairs.
 
+   The pairs are stored uncompressed, one TimeValueUnit per entry, so a copy
+   of the property (e.g. when a Run is copied) duplicates every entry.
+   valueChangesAsVectors() reads the log as separate time and value columns
+   without building a std::map, but it does not change how the log is
+   stored.
+
    Copyright &copy; 2007-2010 ISIS Rutherford Appleton Laboratory, NScD Oak
    Ridge National Laboratory & European Spallation Source
 
@@ -197,6 +203,10 @@ public:
   std::multimap<DateAndTime, TYPE> valueAsMultiMap() const;
   /// Get filtered values as a vector
   std::vector<TYPE> filteredValuesAsVector() const;
+  /// Return the times at which the value changes and the new values, as in
+  /// valueAsMap but without building a map
+  void valueChangesAsVectors(std::vector<DateAndTime> &times,
+                             std::vector<TYPE> &values) const;
 
   /// Return the time series's times as a vector<DateAndTime>
   std::vector<DateAndTime> timesAsVector() const override;
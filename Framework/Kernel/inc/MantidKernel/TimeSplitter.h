@@ -3,6 +3,8 @@
 
 #include "MantidKernel/DateAndTime.h"
 
+#include <vector>
+
 namespace Mantid {
 namespace Kernel {
 
@@ -55,6 +57,49 @@ private:
  */
 typedef std::vector<SplittingInterval> TimeSplitterType;
 
+/**
+ * An index over the intervals of a TimeSplitterType for finding the interval
+ * containing a time, or the intervals overlapping another interval, without
+ * scanning every interval of the splitter.
+ *
+ * The intervals are kept sorted by start time in the leaves of a segment tree
+ * holding the latest stop time of each subtree (an augmented interval tree).
+ * A point lookup takes O(log n) time and finding the k intervals overlapping
+ * an interval O((k + 1) log n), however long the intervals are. The splitter
+ * may be unsorted and its intervals may overlap.
+ */
+class MANTID_KERNEL_DLL SplittingIntervalIndex {
+public:
+  explicit SplittingIntervalIndex(const TimeSplitterType &splitter);
+
+  /// Destination of the interval containing the time, or -1 if there is none
+  int index(const DateAndTime &time) const;
+  /// Whether any interval contains the time
+  bool contains(const DateAndTime &time) const;
+  /// Positions in the splitter of the intervals overlapping an interval
+  std::vector<size_t> overlapping(const SplittingInterval &interval) const;
+  /// The number of intervals
+  size_t size() const { return m_intervals.size(); }
+
+private:
+  size_t findLastStartingBefore(const DateAndTime &time) const;
+  size_t findLastStoppingAfter(size_t node, size_t first, size_t last,
+                               size_t end, const DateAndTime &time) const;
+  void findStoppingFrom(size_t node, size_t first, size_t last, size_t end,
+                        const SplittingInterval &interval,
+                        std::vector<size_t> &positions) const;
+
+  /// The intervals sorted by start time
+  std::vector<SplittingInterval> m_intervals;
+  /// Positions of the sorted intervals in the splitter
+  std::vector<size_t> m_positions;
+  /// The number of leaves of the tree, a power of 2
+  size_t m_leaves;
+  /// The latest stop time in each node of the tree, the root is node 1 and
+  /// the children of node i are 2i and 2i + 1
+  std::vector<DateAndTime> m_maxStop;
+};
+
 // -------------- Operators ---------------------
 MANTID_KERNEL_DLL TimeSplitterType
 operator+(const TimeSplitterType &a, const TimeSplitterType &b);
@@ -183,6 +183,21 @@ public:
    */
   virtual double singleFromTOF(const double tof) const = 0;
 
+  /** Convert an array of values in this unit to TOF, in place. The unit must
+   * be initialized. Units with a simple conversion override this with a loop
+   * that the compiler can vectorize instead of a virtual call per value.
+   * @param first :: pointer to the first value to convert
+   * @param last :: pointer past the last value to convert
+   */
+  virtual void multipleToTOF(double *first, double *last) const;
+
+  /** Convert an array of tof values to this unit, in place. The unit must be
+   * initialized.
+   * @param first :: pointer to the first value to convert
+   * @param last :: pointer past the last value to convert
+   */
+  virtual void multipleFromTOF(double *first, double *last) const;
+
   /// @return true if the unit was initialized and so can use singleToTOF()
   bool isInitialized() const { return initialized; }
 
@@ -303,6 +318,8 @@ public:
   void init() override;
   double singleToTOF(const double x) const override;
   double singleFromTOF(const double tof) const override;
+  void multipleToTOF(double *first, double *last) const override;
+  void multipleFromTOF(double *first, double *last) const override;
   Unit *clone() const override;
   ///@return -DBL_MAX as ToF convertible to TOF for in any time range
   double conversionTOFMin() const override;
@@ -320,6 +337,8 @@ public:
 
   double singleToTOF(const double x) const override;
   double singleFromTOF(const double tof) const override;
+  void multipleToTOF(double *first, double *last) const override;
+  void multipleFromTOF(double *first, double *last) const override;
   void init() override;
   Unit *clone() const override;
 
@@ -347,6 +366,8 @@ public:
 
   double singleToTOF(const double x) const override;
   double singleFromTOF(const double tof) const override;
+  void multipleToTOF(double *first, double *last) const override;
+  void multipleFromTOF(double *first, double *last) const override;
   void init() override;
   Unit *clone() const override;
 
@@ -394,6 +415,8 @@ public:
 
   double singleToTOF(const double x) const override;
   double singleFromTOF(const double tof) const override;
+  void multipleToTOF(double *first, double *last) const override;
+  void multipleFromTOF(double *first, double *last) const override;
   void init() override;
   Unit *clone() const override;
   double conversionTOFMin() const override;
@@ -444,6 +467,8 @@ public:
 
   double singleToTOF(const double x) const override;
   double singleFromTOF(const double tof) const override;
+  void multipleToTOF(double *first, double *last) const override;
+  void multipleFromTOF(double *first, double *last) const override;
   void init() override;
   Unit *clone() const override;
   double conversionTOFMin() const override;
@@ -489,6 +514,8 @@ public:
 
   double singleToTOF(const double x) const override;
   double singleFromTOF(const double tof) const override;
+  void multipleToTOF(double *first, double *last) const override;
+  void multipleFromTOF(double *first, double *last) const override;
   void init() override;
   Unit *clone() const override;
 
@@ -574,6 +601,8 @@ public:
 
   double singleToTOF(const double x) const override;
   double singleFromTOF(const double tof) const override;
+  void multipleToTOF(double *first, double *last) const override;
+  void multipleFromTOF(double *first, double *last) const override;
   void init() override;
   Unit *clone() const override;
   double conversionTOFMin() const override;
@@ -593,6 +622,8 @@ public:
 
   double singleToTOF(const double x) const override;
   double singleFromTOF(const double tof) const override;
+  void multipleToTOF(double *first, double *last) const override;
+  void multipleFromTOF(double *first, double *last) const override;
   void init() override;
   Unit *clone() const override;
   double conversionTOFMin() const override;
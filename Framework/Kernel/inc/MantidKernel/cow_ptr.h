@@ -2,6 +2,7 @@
 #define MANTIDKERNEL_COW_PTR_H
 
 #include "MultiThreaded.h"
+#include "MantidKernel/CowPtrStatistics.h"
 
 #ifndef Q_MOC_RUN
 #include <boost/shared_ptr.hpp>
@@ -9,10 +10,26 @@
 #endif
 
 #include <mutex>
+#include <type_traits>
 #include <vector>
 
 namespace Mantid {
 namespace Kernel {
+namespace detail {
+/// @return the number of bytes held by a container, for the copy statistics
+template <typename DataType>
+auto cowDataSize(const DataType &data, int) -> decltype(
+    data.size() *
+    sizeof(typename std::decay<decltype(*data.begin())>::type)) {
+  return data.size() *
+         sizeof(typename std::decay<decltype(*data.begin())>::type);
+}
+/// @return the size of an object that is not a container
+template <typename DataType> size_t cowDataSize(const DataType &, long) {
+  return sizeof(DataType);
+}
+}
+
 /**
   \class cow_ptr
   \brief Implements a copy on write data template
@@ -185,6 +202,7 @@ template <typename DataType> DataType &cow_ptr<DataType>::access() {
     // reference count since previous check
     if (!Data.unique()) {
       boost::atomic_store(&Data, boost::make_shared<DataType>(*Data));
+      CowPtrStatistics::recordCopy(detail::cowDataSize(*Data, 0));
     }
   }
   return *Data;
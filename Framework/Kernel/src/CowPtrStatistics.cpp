@@ -0,0 +1,28 @@
+#include "MantidKernel/CowPtrStatistics.h"
+
+namespace Mantid {
+namespace Kernel {
+
+std::atomic<size_t> CowPtrStatistics::s_copies(0);
+std::atomic<size_t> CowPtrStatistics::s_copiedBytes(0);
+
+/** Record a copy made by a cow_ptr
+ * @param bytes :: the size of the data copied
+ */
+void CowPtrStatistics::recordCopy(const size_t bytes) {
+  s_copies.fetch_add(1, std::memory_order_relaxed);
+  s_copiedBytes.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+/// @return the number of copies made by cow_ptrs since the program started
+size_t CowPtrStatistics::copies() {
+  return s_copies.load(std::memory_order_relaxed);
+}
+
+/// @return the number of bytes copied by cow_ptrs since the program started
+size_t CowPtrStatistics::copiedBytes() {
+  return s_copiedBytes.load(std::memory_order_relaxed);
+}
+
+} // namespace Kernel
+} // namespace Mantid
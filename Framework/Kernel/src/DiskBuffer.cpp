@@ -1,5 +1,6 @@
 #include "MantidKernel/DiskBuffer.h"
 #include "MantidKernel/ISaveable.h"
+#include <algorithm>
 #include <sstream>
 #include <utility>
 
@@ -13,7 +14,8 @@ namespace Kernel {
  */
 DiskBuffer::DiskBuffer()
     : m_writeBufferSize(50), m_writeBufferUsed(0), m_nObjectsToWrite(0),
-      m_free(), m_free_bySize(m_free.get<1>()), m_fileLength(0) {
+      m_free(), m_free_bySize(m_free.get<1>()), m_fileLength(0),
+      m_asyncWriting(nullptr), m_asyncMemoryUsed(0), m_stopAsyncWriter(false) {
   m_free.clear();
 }
 
@@ -27,10 +29,24 @@ DiskBuffer::DiskBuffer()
 DiskBuffer::DiskBuffer(uint64_t m_writeBufferSize)
     : m_writeBufferSize(m_writeBufferSize), m_writeBufferUsed(0),
       m_nObjectsToWrite(0), m_free(), m_free_bySize(m_free.get<1>()),
-      m_fileLength(0) {
+      m_fileLength(0), m_asyncWriting(nullptr), m_asyncMemoryUsed(0),
+      m_stopAsyncWriter(false) {
   m_free.clear();
 }
 
+//----------------------------------------------------------------------------------------------
+/** Destructor. Waits for the I/O thread to write any objects still queued.
+ */
+DiskBuffer::~DiskBuffer() {
+  {
+    std::lock_guard<std::mutex> lock(m_asyncMutex);
+    m_stopAsyncWriter = true;
+  }
+  m_asyncCondition.notify_all();
+  if (m_asyncWriter.joinable())
+    m_asyncWriter.join();
+}
+
 //---------------------------------------------------------------------------------------------
 /** Call this method when an object is ready to be written
  * out to disk.
@@ -79,6 +95,12 @@ void DiskBuffer::toWrite(ISaveable *item) {
 void DiskBuffer::objectDeleted(ISaveable *item) {
   if (item == nullptr)
     return;
+  {
+    // An object queued for asynchronous writing must not go away before it is
+    // written
+    std::unique_lock<std::mutex> asyncLock(m_asyncMutex);
+    waitForAsyncItem(asyncLock, item);
+  }
   // have it ever been in the buffer?
   std::unique_lock<std::mutex> uniqueLock(m_mutex);
   auto opt2it = item->getBufPostion();
@@ -188,10 +210,121 @@ void DiskBuffer::writeOldObjects() {
 /** Flush out all the data in the memory; and writes out everything in the
  * to-write cache. */
 void DiskBuffer::flushCache() {
+  waitForAsyncWrites();
   // Now write everything out.
   writeOldObjects();
 }
 
+//---------------------------------------------------------------------------------------------
+/** Queue an object to be saved at its file position by a background I/O
+ * thread, after which its data are cleared from memory. This lets the caller
+ * go on, e.g. to read the data of the next object, while the data are
+ * written.
+ *
+ * The data of the object must not be modified once it is queued. If the
+ * memory of the objects already waiting exceeds the write buffer size, the
+ * call blocks until enough of them have been written.
+ *
+ * @param item :: object whose data are complete and can be written out.
+ * @throw any error raised while writing a previously queued object
+ */
+void DiskBuffer::writeAsync(ISaveable *item) {
+  if (item == nullptr)
+    return;
+  const uint64_t memory = item->getDataMemorySize();
+
+  std::unique_lock<std::mutex> lock(m_asyncMutex);
+  m_asyncCondition.wait(lock, [this, memory] {
+    return m_asyncError || m_asyncMemoryUsed == 0 ||
+           m_asyncMemoryUsed + memory <= m_writeBufferSize;
+  });
+  if (m_asyncError) {
+    auto error = m_asyncError;
+    m_asyncError = nullptr;
+    std::rethrow_exception(error);
+  }
+
+  m_asyncQueue.emplace_back(item, memory);
+  m_asyncMemoryUsed += memory;
+  if (!m_asyncWriter.joinable())
+    m_asyncWriter = std::thread(&DiskBuffer::asyncWriterLoop, this);
+  lock.unlock();
+  m_asyncCondition.notify_all();
+}
+
+//---------------------------------------------------------------------------------------------
+/** Block until the I/O thread has written all the objects queued with
+ * writeAsync().
+ * @throw any error raised while writing the queued objects
+ */
+void DiskBuffer::waitForAsyncWrites() {
+  std::unique_lock<std::mutex> lock(m_asyncMutex);
+  m_asyncCondition.wait(lock, [this] {
+    return m_asyncQueue.empty() && m_asyncWriting == nullptr;
+  });
+  if (m_asyncError) {
+    auto error = m_asyncError;
+    m_asyncError = nullptr;
+    std::rethrow_exception(error);
+  }
+}
+
+//---------------------------------------------------------------------------------------------
+/** Wait until an object is neither queued nor being written asynchronously.
+ * @param lock :: lock holding m_asyncMutex
+ * @param item :: the object to wait for
+ */
+void DiskBuffer::waitForAsyncItem(std::unique_lock<std::mutex> &lock,
+                                  const ISaveable *item) {
+  m_asyncCondition.wait(lock, [this, item] {
+    return m_asyncWriting != item &&
+           std::none_of(m_asyncQueue.cbegin(), m_asyncQueue.cend(),
+                        [item](const std::pair<ISaveable *, uint64_t> &queued) {
+                          return queued.first == item;
+                        });
+  });
+}
+
+//---------------------------------------------------------------------------------------------
+/** Body of the I/O thread: save the queued objects in turn, flushing the file
+ * whenever the queue runs empty, until asked to stop.
+ */
+void DiskBuffer::asyncWriterLoop() {
+  std::unique_lock<std::mutex> lock(m_asyncMutex);
+  while (true) {
+    m_asyncCondition.wait(lock, [this] {
+      return m_stopAsyncWriter || !m_asyncQueue.empty();
+    });
+    if (m_asyncQueue.empty())
+      return;
+
+    ISaveable *item = m_asyncQueue.front().first;
+    const uint64_t memory = m_asyncQueue.front().second;
+    m_asyncQueue.pop_front();
+    m_asyncWriting = item;
+    const bool lastQueued = m_asyncQueue.empty();
+    lock.unlock();
+
+    std::exception_ptr error;
+    try {
+      item->save();
+      item->clearDataFromMemory();
+      // Flush the file once per batch rather than after every object
+      if (lastQueued)
+        item->flushData();
+    } catch (...) {
+      error = std::current_exception();
+    }
+
+    lock.lock();
+    if (error && !m_asyncError)
+      m_asyncError = error;
+    m_asyncWriting = nullptr;
+    m_asyncMemoryUsed -= memory;
+    m_asyncCondition.notify_all();
+  }
+}
+
 //---------------------------------------------------------------------------------------------
 /** This method is called by this->relocate when object that has shrunk
  * and so has left a bit of free space after itself on the file;
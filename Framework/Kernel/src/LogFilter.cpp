@@ -130,10 +130,11 @@ template <typename SrcType> struct ConvertToTimeSeriesDouble {
     if (!srcTypeSeries)
       return nullptr;
     auto converted = new TimeSeriesProperty<double>(prop->name());
-    auto pmap = srcTypeSeries->valueAsMap();
-    for (auto it = pmap.begin(); it != pmap.end(); ++it) {
-      converted->addValue(it->first, double(it->second));
-    }
+    std::vector<DateAndTime> times;
+    std::vector<SrcType> values;
+    srcTypeSeries->valueChangesAsVectors(times, values);
+    converted->addValues(times,
+                         std::vector<double>(values.begin(), values.end()));
     return converted;
   }
 };
@@ -258,12 +258,13 @@ Kernel::TimeSeriesProperty<bool> *LogParser::createPeriodLog(int period) const {
   ostr << period;
   Kernel::TimeSeriesProperty<bool> *p =
       new Kernel::TimeSeriesProperty<bool>("period " + ostr.str());
-  std::map<Kernel::DateAndTime, int> pMap = periods->valueAsMap();
-  auto it = pMap.begin();
-  if (it->second != period)
-    p->addValue(it->first, false);
-  for (; it != pMap.end(); ++it)
-    p->addValue(it->first, (it->second == period));
+  std::vector<Kernel::DateAndTime> times;
+  std::vector<int> values;
+  periods->valueChangesAsVectors(times, values);
+  if (values.front() != period)
+    p->addValue(times.front(), false);
+  for (size_t i = 0; i < times.size(); ++i)
+    p->addValue(times[i], (values[i] == period));
 
   return p;
 }
@@ -0,0 +1,180 @@
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+#include "MantidKernel/Philox.h"
+
+#include <limits>
+
+namespace Mantid {
+namespace Kernel {
+
+namespace {
+// Constants of the Philox4x32 algorithm
+constexpr uint32_t MULTIPLIER_0 = 0xD2511F53;
+constexpr uint32_t MULTIPLIER_1 = 0xCD9E8D57;
+constexpr uint32_t WEYL_0 = 0x9E3779B9;
+constexpr uint32_t WEYL_1 = 0xBB67AE85;
+constexpr int ROUNDS = 10;
+
+/**
+ * Compute the Philox4x32-10 bijection of a counter
+ * @param counter :: The 128-bit counter
+ * @param key :: The 64-bit key
+ * @return The block of random bits for the counter
+ */
+std::array<uint32_t, 4> philox(std::array<uint32_t, 4> counter,
+                               std::array<uint32_t, 2> key) {
+  for (int round = 0; round < ROUNDS; ++round) {
+    if (round > 0) {
+      key[0] += WEYL_0;
+      key[1] += WEYL_1;
+    }
+    const uint64_t product0 = static_cast<uint64_t>(MULTIPLIER_0) * counter[0];
+    const uint64_t product1 = static_cast<uint64_t>(MULTIPLIER_1) * counter[2];
+    counter = {{static_cast<uint32_t>(product1 >> 32) ^ counter[1] ^ key[0],
+                static_cast<uint32_t>(product1),
+                static_cast<uint32_t>(product0 >> 32) ^ counter[3] ^ key[1],
+                static_cast<uint32_t>(product0)}};
+  }
+  return counter;
+}
+}
+
+//------------------------------------------------------------------------------
+// Public member functions
+//------------------------------------------------------------------------------
+
+/**
+ * Constructor taking a seed value and a stream. Sets the range to [0.0,1.0]
+ * @param seedValue :: The seed
+ * @param stream :: The stream to start from
+ */
+Philox::Philox(const size_t seedValue, const uint64_t stream)
+    : Philox(seedValue, stream, 0.0, 1.0) {}
+
+/**
+ * Constructor taking a seed value, a stream and a range
+ * @param seedValue :: The seed
+ * @param stream :: The stream to start from
+ * @param start :: The minimum value a generated number should take
+ * @param end :: The maximum value a generated number should take
+ */
+Philox::Philox(const size_t seedValue, const uint64_t stream,
+               const double start, const double end)
+    : m_key(), m_stream(stream), m_state(), m_savedState(), m_saved(false),
+      m_start(start), m_end(end) {
+  setSeed(seedValue);
+}
+
+/**
+ * (Re-)seed the generator and restart the current stream. This clears the
+ * saved state
+ * @param seedValue :: A seed for the generator
+ */
+void Philox::setSeed(const size_t seedValue) {
+  const auto seed = static_cast<uint64_t>(seedValue);
+  m_key = {{static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)}};
+  restart();
+  m_saved = false;
+}
+
+/**
+ * Select a stream and start it from the beginning. This clears the saved state
+ * @param stream :: The index of the stream
+ */
+void Philox::setStream(const uint64_t stream) {
+  m_stream = stream;
+  restart();
+  m_saved = false;
+}
+
+/**
+ * Sets the range of the subsequent calls to nextValue()
+ * @param start :: The lowest value a call to nextValue() will produce
+ * @param end :: The largest value a call to nextValue() will produce
+ */
+void Philox::setRange(const double start, const double end) {
+  m_start = start;
+  m_end = end;
+}
+
+/**
+ * Returns the next number in the pseudo-random sequence, using 53 random bits,
+ * scaled to the given range
+ * @param start Start of the requested range
+ * @param end End of the requested range
+ * @returns The next number in the pseudo-random sequence
+ */
+double Philox::nextValue(double start, double end) {
+  const uint64_t high = nextWord();
+  const uint64_t bits = (high << 32 | nextWord()) >> 11;
+  const double unit = static_cast<double>(bits) / 9007199254740992.0; // 2^53
+  return start + unit * (end - start);
+}
+
+/**
+ * Returns the next integer in the pseudo-random sequence, uniformly
+ * distributed in the given range.
+ * @param start Start of the requested range
+ * @param end End of the requested range, included in the range
+ * @return An integer in the defined range
+ */
+int Philox::nextInt(int start, int end) {
+  const uint64_t range =
+      static_cast<uint64_t>(static_cast<int64_t>(end) - start) + 1;
+  const uint64_t words =
+      static_cast<uint64_t>(std::numeric_limits<uint32_t>::max()) + 1;
+  // Reject the words above the largest multiple of the range so that every
+  // value is equally likely
+  const uint64_t limit = words - words % range;
+  uint64_t word;
+  do {
+    word = nextWord();
+  } while (word >= limit);
+  return static_cast<int>(start + static_cast<int64_t>(word % range));
+}
+
+/**
+ * Resets the generator to the start of the current stream
+ */
+void Philox::restart() {
+  m_state.counter = 0;
+  m_state.position = m_state.block.size();
+}
+
+/// Saves the current state of the generator
+void Philox::save() {
+  m_savedState = m_state;
+  m_saved = true;
+}
+
+/// Restores the generator to the last saved point, or the beginning of the
+/// stream if nothing has been saved
+void Philox::restore() {
+  if (m_saved) {
+    m_state = m_savedState;
+  } else {
+    restart();
+  }
+}
+
+//------------------------------------------------------------------------------
+// Private member functions
+//------------------------------------------------------------------------------
+
+/// @return The next 32 random bits of the current stream
+uint32_t Philox::nextWord() {
+  if (m_state.position == m_state.block.size()) {
+    const uint64_t counter = m_state.counter++;
+    m_state.block =
+        philox({{static_cast<uint32_t>(counter),
+                 static_cast<uint32_t>(counter >> 32),
+                 static_cast<uint32_t>(m_stream),
+                 static_cast<uint32_t>(m_stream >> 32)}},
+               m_key);
+    m_state.position = 0;
+  }
+  return m_state.block[m_state.position++];
+}
+}
+}
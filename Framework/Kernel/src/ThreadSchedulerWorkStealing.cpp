@@ -0,0 +1,145 @@
+#include "MantidKernel/ThreadSchedulerWorkStealing.h"
+#include "MantidKernel/Task.h"
+#include "MantidKernel/ThreadPool.h"
+
+#include <algorithm>
+
+namespace Mantid {
+namespace Kernel {
+
+namespace {
+/// The scheduler that the current thread last popped a task from
+thread_local const ThreadSchedulerWorkStealing *currentScheduler = nullptr;
+/// The queue owned by the current thread in currentScheduler
+thread_local size_t currentQueue = 0;
+}
+
+/** Constructor. Creates one queue per physical core.
+ */
+ThreadSchedulerWorkStealing::ThreadSchedulerWorkStealing()
+    : ThreadSchedulerWorkStealing(ThreadPool::getNumPhysicalCores()) {}
+
+/** Constructor
+ * @param numQueues :: number of queues. This should match the number of
+ *        threads in the ThreadPool; threads with a higher number share a queue.
+ */
+ThreadSchedulerWorkStealing::ThreadSchedulerWorkStealing(size_t numQueues)
+    : ThreadScheduler(), m_size(0), m_nextQueue(0) {
+  numQueues = std::max(numQueues, size_t(1));
+  m_queues.reserve(numQueues);
+  for (size_t i = 0; i < numQueues; ++i)
+    m_queues.emplace_back(new TaskQueue());
+}
+
+/// Destructor. Deletes any tasks left in the queues.
+ThreadSchedulerWorkStealing::~ThreadSchedulerWorkStealing() { clear(); }
+
+//-------------------------------------------------------------------------------
+/** Add a Task to the queue of the calling thread if it is one of the pool's
+ * threads, otherwise to the next queue in turn.
+ * @param newTask :: Task to add
+ */
+void ThreadSchedulerWorkStealing::push(Task *newTask) {
+  pushToThread(newTask, queueForCurrentThread());
+}
+
+//-------------------------------------------------------------------------------
+/** Add a Task to the queue of a given thread. The task will be run by that
+ * thread unless another thread runs out of work and steals it.
+ * @param newTask :: Task to add
+ * @param threadnum :: ID of the thread that should run the task
+ */
+void ThreadSchedulerWorkStealing::pushToThread(Task *newTask,
+                                               size_t threadnum) {
+  auto &queue = *m_queues[threadnum % m_queues.size()];
+  std::lock_guard<std::mutex> lock(queue.mutex);
+  queue.cost += newTask->cost();
+  queue.tasks.push_back(newTask);
+  ++m_size;
+}
+
+//-------------------------------------------------------------------------------
+/** Retrieve the next Task for a thread: the newest task in its own queue, or
+ * failing that, the oldest task in another thread's queue.
+ * @param threadnum :: ID of the calling thread.
+ * @return a Task pointer to execute, or nullptr if all queues are empty.
+ */
+Task *ThreadSchedulerWorkStealing::pop(size_t threadnum) {
+  const size_t numQueues = m_queues.size();
+  const size_t own = threadnum % numQueues;
+  // Remember which queue belongs to this thread for tasks it pushes
+  currentScheduler = this;
+  currentQueue = own;
+
+  if (m_size == 0)
+    return nullptr;
+
+  for (size_t i = 0; i < numQueues; ++i) {
+    auto &queue = *m_queues[(own + i) % numQueues];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty())
+      continue;
+    Task *task;
+    if (i == 0) {
+      task = queue.tasks.back();
+      queue.tasks.pop_back();
+    } else {
+      // Steal from the other end, which holds the oldest and typically the
+      // largest tasks when they split recursively
+      task = queue.tasks.front();
+      queue.tasks.pop_front();
+    }
+    --m_size;
+    return task;
+  }
+  return nullptr;
+}
+
+//-------------------------------------------------------------------------------
+/// @return the number of tasks in all the queues
+size_t ThreadSchedulerWorkStealing::size() { return m_size; }
+
+/// @return true if all the queues are empty
+bool ThreadSchedulerWorkStealing::empty() { return m_size == 0; }
+
+//-------------------------------------------------------------------------------
+/// Empty out all the queues, deleting the tasks
+void ThreadSchedulerWorkStealing::clear() {
+  for (auto &queue : m_queues) {
+    std::lock_guard<std::mutex> lock(queue->mutex);
+    m_size -= queue->tasks.size();
+    for (auto &task : queue->tasks)
+      delete task;
+    queue->tasks.clear();
+    queue->cost = 0.0;
+  }
+  m_cost = 0;
+  m_costExecuted = 0;
+}
+
+//-------------------------------------------------------------------------------
+/** As for the other schedulers, this includes the tasks that have been popped.
+ * Each queue keeps its own sum so that pushing needs no shared lock.
+ * @return the total cost of the tasks pushed since the last clear()
+ */
+double ThreadSchedulerWorkStealing::totalCost() {
+  double cost = 0.0;
+  for (auto &queue : m_queues) {
+    std::lock_guard<std::mutex> lock(queue->mutex);
+    cost += queue->cost;
+  }
+  return cost;
+}
+
+//-------------------------------------------------------------------------------
+/** @return the queue for a task pushed by the calling thread: its own queue if
+ * it is running tasks from this scheduler, otherwise the next queue in turn.
+ */
+size_t ThreadSchedulerWorkStealing::queueForCurrentThread() {
+  if (currentScheduler == this)
+    return currentQueue;
+  return m_nextQueue++;
+}
+
+} // namespace Kernel
+} // namespace Mantid
@@ -8,6 +8,8 @@
 
 #include <boost/regex.hpp>
 
+#include <algorithm>
+
 namespace Mantid {
 namespace Kernel {
 namespace {
@@ -452,8 +454,11 @@ void TimeSeriesProperty<TYPE>::splitByTime(
 
     int output_index = itspl->index();
     // output workspace index is out of range. go to the next splitter
-    if (output_index < 0 || output_index >= static_cast<int>(numOutputs))
+    if (output_index < 0 || output_index >= static_cast<int>(numOutputs)) {
+      ++itspl;
+      ++counter;
       continue;
+    }
 
     TimeSeriesProperty<TYPE> *myOutput = outputs_tsp[output_index];
     // skip if the input property is of wrong type
@@ -463,9 +468,18 @@ void TimeSeriesProperty<TYPE>::splitByTime(
       continue;
     }
 
-    // Skip the events before the start of the time
-    while (i_property < m_values.size() && m_values[i_property].time() < start)
-      ++i_property;
+    // Skip the events before the start of the time. The gaps between the
+    // intervals can hold many entries of a fast log, so search for the first
+    // entry instead of stepping through them.
+    if (i_property < m_values.size() && m_values[i_property].time() < start) {
+      i_property = static_cast<size_t>(std::distance(
+          m_values.cbegin(),
+          std::lower_bound(m_values.cbegin() + i_property, m_values.cend(),
+                           start, [](const TimeValueUnit<TYPE> &entry,
+                                     const DateAndTime &time) {
+                             return entry.time() < time;
+                           })));
+    }
 
     if (i_property == m_values.size()) {
       // i_property is out of the range. Then use the last entry
@@ -2358,16 +2372,62 @@ std::vector<TYPE> TimeSeriesProperty<TYPE>::filteredValuesAsVector() const {
 
   sortIfNecessary();
 
-  const auto &valueMap = valueAsCorrectMap();
-  for (const auto &entry : valueMap) {
-    if (isTimeFiltered(entry.first)) {
-      filteredValues.push_back(entry.second);
-    }
+  // Walk through the sorted values and filter together, which gives the same
+  // values as calling isTimeFiltered for each entry of valueAsCorrectMap:
+  // only the last of the values at the same time is used.
+  filteredValues.reserve(m_values.size());
+  auto filterEntry = m_filter.cbegin();
+  for (size_t i = 0; i < m_values.size(); ++i) {
+    const DateAndTime time = m_values[i].time();
+    if (i + 1 < m_values.size() && m_values[i + 1].time() == time)
+      continue;
+    // First filter entry at or after the time
+    while (filterEntry != m_filter.cend() && filterEntry->first < time)
+      ++filterEntry;
+    // Then the latest one before the time
+    const auto current =
+        filterEntry == m_filter.cbegin() ? filterEntry : filterEntry - 1;
+    if (current->second)
+      filteredValues.push_back(m_values[i].value());
   }
 
   return filteredValues;
 }
 
+/**
+ * Return the run-length encoding of the series: the times at which the value
+ * changes and the new values, starting with the first entry. This is the
+ * content of valueAsMap, in two columns and without building a map.
+ * @param times :: [output] the times of the changes
+ * @param values :: [output] the values from each change
+ */
+template <typename TYPE>
+void TimeSeriesProperty<TYPE>::valueChangesAsVectors(
+    std::vector<DateAndTime> &times, std::vector<TYPE> &values) const {
+  sortIfNecessary();
+
+  times.clear();
+  values.clear();
+  if (m_values.empty())
+    return;
+
+  times.push_back(m_values[0].time());
+  values.push_back(m_values[0].value());
+  TYPE d = m_values[0].value();
+  for (size_t i = 1; i < m_values.size(); i++) {
+    if (m_values[i].value() != d) {
+      d = m_values[i].value();
+      // A later value at the same time replaces the earlier one
+      if (m_values[i].time() == times.back()) {
+        values.back() = d;
+      } else {
+        times.push_back(m_values[i].time());
+        values.push_back(d);
+      }
+    }
+  }
+}
+
 /**
  * Find out if the given time is included in the filtered data
  * i.e. it does not lie in an excluded region
@@ -1,6 +1,9 @@
 #include "MantidKernel/DateAndTime.h"
 #include "MantidKernel/TimeSplitter.h"
 
+#include <algorithm>
+#include <numeric>
+
 namespace Mantid {
 namespace Kernel {
 
@@ -78,6 +81,142 @@ bool compareSplittingInterval(const SplittingInterval &si1,
   return (si1.start() < si2.start());
 }
 
+//------------------------------------------------------------------------------------------------
+/** Build the index of a splitter
+ *
+ * @param splitter :: TimeSplitterType filter or splitter, in any order.
+ */
+SplittingIntervalIndex::SplittingIntervalIndex(
+    const TimeSplitterType &splitter)
+    : m_positions(splitter.size()), m_leaves(1) {
+  std::iota(m_positions.begin(), m_positions.end(), 0);
+  std::stable_sort(m_positions.begin(), m_positions.end(),
+                   [&splitter](const size_t a, const size_t b) {
+                     return splitter[a].start() < splitter[b].start();
+                   });
+  m_intervals.reserve(splitter.size());
+  for (const auto position : m_positions)
+    m_intervals.push_back(splitter[position]);
+
+  while (m_leaves < m_intervals.size())
+    m_leaves *= 2;
+  // The padding leaves stop before any time that can be looked up
+  m_maxStop.assign(2 * m_leaves, DateAndTime::minimum());
+  for (size_t i = 0; i < m_intervals.size(); ++i)
+    m_maxStop[m_leaves + i] = m_intervals[i].stop();
+  for (size_t node = m_leaves - 1; node > 0; --node)
+    m_maxStop[node] = std::max(m_maxStop[2 * node], m_maxStop[2 * node + 1]);
+}
+
+/** Find the sorted interval after the last one starting at or before a time
+ *
+ * @param time :: the time to look up.
+ * @return One past the position in the sorted intervals of the last interval
+ * with a start at or before the time.
+ */
+size_t
+SplittingIntervalIndex::findLastStartingBefore(const DateAndTime &time) const {
+  auto it = std::upper_bound(m_intervals.cbegin(), m_intervals.cend(), time,
+                             [](const DateAndTime &t,
+                                const SplittingInterval &interval) {
+                               return t < interval.start();
+                             });
+  return static_cast<size_t>(std::distance(m_intervals.cbegin(), it));
+}
+
+/** Find the last of the sorted intervals before end that stops after a time.
+ * Subtrees stopping by the time are skipped, so only the O(log n) nodes along
+ * the boundary at end and the path down to the result are visited.
+ *
+ * @param node :: the node of the tree to search.
+ * @param first :: the first sorted interval under the node.
+ * @param last :: one past the last sorted interval under the node.
+ * @param end :: one past the last sorted interval to consider.
+ * @param time :: the time to look up.
+ * @return The position in the sorted intervals, or the number of intervals
+ * if there is none.
+ */
+size_t SplittingIntervalIndex::findLastStoppingAfter(
+    size_t node, size_t first, size_t last, size_t end,
+    const DateAndTime &time) const {
+  if (first >= end || m_maxStop[node] <= time)
+    return m_intervals.size();
+  if (node >= m_leaves)
+    return first;
+  const size_t middle = (first + last) / 2;
+  const size_t found =
+      findLastStoppingAfter(2 * node + 1, middle, last, end, time);
+  if (found != m_intervals.size())
+    return found;
+  return findLastStoppingAfter(2 * node, first, middle, end, time);
+}
+
+/** Find the destination of a time. An interval contains the times from its
+ * start up to but not including its stop. If several intervals contain the
+ * time, the one starting last wins.
+ *
+ * @param time :: the time to look up.
+ * @return The index of the interval containing the time, or -1.
+ */
+int SplittingIntervalIndex::index(const DateAndTime &time) const {
+  const size_t i = findLastStoppingAfter(1, 0, m_leaves,
+                                         findLastStartingBefore(time), time);
+  return i < m_intervals.size() ? m_intervals[i].index() : -1;
+}
+
+/** Check whether any interval contains a time
+ *
+ * @param time :: the time to look up.
+ * @return True if an interval contains the time.
+ */
+bool SplittingIntervalIndex::contains(const DateAndTime &time) const {
+  return findLastStoppingAfter(1, 0, m_leaves, findLastStartingBefore(time),
+                               time) < m_intervals.size();
+}
+
+/** Collect the sorted intervals before end that stop at or after the start of
+ * an interval and overlap it. Subtrees stopping before the start are skipped.
+ *
+ * @param node :: the node of the tree to search.
+ * @param first :: the first sorted interval under the node.
+ * @param last :: one past the last sorted interval under the node.
+ * @param end :: one past the last sorted interval to consider.
+ * @param interval :: the interval to compare with.
+ * @param positions :: the positions in the splitter of the intervals found.
+ */
+void SplittingIntervalIndex::findStoppingFrom(
+    size_t node, size_t first, size_t last, size_t end,
+    const SplittingInterval &interval, std::vector<size_t> &positions) const {
+  if (first >= end || m_maxStop[node] < interval.start())
+    return;
+  if (node >= m_leaves) {
+    if (m_intervals[first].overlaps(interval))
+      positions.push_back(m_positions[first]);
+    return;
+  }
+  const size_t middle = (first + last) / 2;
+  findStoppingFrom(2 * node, first, middle, end, interval, positions);
+  findStoppingFrom(2 * node + 1, middle, last, end, interval, positions);
+}
+
+/** Find the intervals that overlap an interval, as given by
+ * SplittingInterval::overlaps
+ *
+ * @param interval :: the interval to compare with.
+ * @return The positions in the original splitter of the overlapping
+ * intervals, in increasing order.
+ */
+std::vector<size_t>
+SplittingIntervalIndex::overlapping(const SplittingInterval &interval) const {
+  std::vector<size_t> positions;
+  // Only intervals starting by the stop and stopping from the start can
+  // overlap
+  findStoppingFrom(1, 0, m_leaves, findLastStartingBefore(interval.stop()),
+                   interval, positions);
+  std::sort(positions.begin(), positions.end());
+  return positions;
+}
+
 //------------------------------------------------------------------------------------------------
 /** Return true if the TimeSplitterType provided is a filter,
  * meaning that it only has an output index of 0.
@@ -142,20 +281,16 @@ TimeSplitterType operator&(const TimeSplitterType &a,
   if ((a.empty()) || (b.empty()))
     return out;
 
-  TimeSplitterType::const_iterator ait;
-  TimeSplitterType::const_iterator bit;
-
-  // For now, a simple double iteration. Can be made smarter if a and b are
-  // sorted.
-  for (ait = a.begin(); ait != a.end(); ++ait) {
-    for (bit = b.begin(); bit != b.end(); ++bit) {
-      if (ait->overlaps(*bit)) {
-        // The & operator for SplittingInterval keeps the index of the
-        // left-hand-side (ait in this case)
-        //  meaning that a has to be the splitter because the b index is
-        //  ignored.
-        out.push_back(*ait & *bit);
-      }
+  // Look up the intervals of b overlapping each interval of a in an index,
+  // which gives the same output as comparing every pair of intervals.
+  const SplittingIntervalIndex bIndex(b);
+  for (const auto &interval : a) {
+    for (const auto position : bIndex.overlapping(interval)) {
+      // The & operator for SplittingInterval keeps the index of the
+      // left-hand-side (interval in this case)
+      //  meaning that a has to be the splitter because the b index is
+      //  ignored.
+      out.push_back(interval & b[position]);
     }
   }
   return out;
@@ -5,6 +5,7 @@
 #include "MantidKernel/Unit.h"
 #include "MantidKernel/UnitFactory.h"
 #include "MantidKernel/UnitLabelTypes.h"
+#include <algorithm>
 #include <cfloat>
 
 namespace Mantid {
@@ -138,9 +139,7 @@ void Unit::toTOF(std::vector<double> &xdata, std::vector<double> &ydata,
                  const double &_delta) {
   UNUSED_ARG(ydata);
   this->initialize(_l1, _l2, _twoTheta, _emode, _efixed, _delta);
-  size_t numX = xdata.size();
-  for (size_t i = 0; i < numX; i++)
-    xdata[i] = this->singleToTOF(xdata[i]);
+  this->multipleToTOF(xdata.data(), xdata.data() + xdata.size());
 }
 
 /** Convert a single value to TOF
@@ -169,9 +168,7 @@ void Unit::fromTOF(std::vector<double> &xdata, std::vector<double> &ydata,
                    const double &_efixed, const double &_delta) {
   UNUSED_ARG(ydata);
   this->initialize(_l1, _l2, _twoTheta, _emode, _efixed, _delta);
-  size_t numX = xdata.size();
-  for (size_t i = 0; i < numX; i++)
-    xdata[i] = this->singleFromTOF(xdata[i]);
+  this->multipleFromTOF(xdata.data(), xdata.data() + xdata.size());
 }
 
 /** Convert a single value from TOF
@@ -191,6 +188,21 @@ double Unit::convertSingleFromTOF(const double xvalue, const double &l1,
   return this->singleFromTOF(xvalue);
 }
 
+//---------------------------------------------------------------------------------------
+/** Convert an array of values to TOF one at a time with singleToTOF()
+ */
+void Unit::multipleToTOF(double *first, double *last) const {
+  for (; first != last; ++first)
+    *first = this->singleToTOF(*first);
+}
+
+/** Convert an array of values from TOF one at a time with singleFromTOF()
+ */
+void Unit::multipleFromTOF(double *first, double *last) const {
+  for (; first != last; ++first)
+    *first = this->singleFromTOF(*first);
+}
+
 std::pair<double, double> Unit::conversionRange() const {
   double u1 = this->singleFromTOF(this->conversionTOFMin());
   double u2 = this->singleFromTOF(this->conversionTOFMax());
@@ -287,6 +299,18 @@ double TOF::singleFromTOF(const double tof) const {
   return tof;
 }
 
+void TOF::multipleToTOF(double *first, double *last) const {
+  // Nothing to do
+  UNUSED_ARG(first);
+  UNUSED_ARG(last);
+}
+
+void TOF::multipleFromTOF(double *first, double *last) const {
+  // Nothing to do
+  UNUSED_ARG(first);
+  UNUSED_ARG(last);
+}
+
 Unit *TOF::clone() const { return new TOF(*this); }
 double TOF::conversionTOFMin() const { return -DBL_MAX; }
 ///@return DBL_MAX as ToF convetanble to TOF for in any time range
@@ -395,6 +419,19 @@ double Wavelength::singleFromTOF(const double tof) const {
   x *= factorFrom;
   return x;
 }
+void Wavelength::multipleToTOF(double *first, double *last) const {
+  for (auto x = first; x != last; ++x)
+    *x *= factorTo;
+  // If Direct or Indirect we want to correct TOF values..
+  if (emode == 1 || emode == 2)
+    for (auto x = first; x != last; ++x)
+      *x += sfpTo;
+}
+void Wavelength::multipleFromTOF(double *first, double *last) const {
+  const double offset = do_sfpFrom ? sfpFrom : 0.;
+  for (; first != last; ++first)
+    *first = (*first - offset) * factorFrom;
+}
 ///@return  Minimal time of flight, which can be reversively converted into
 /// wavelength
 double Wavelength::conversionTOFMin() const {
@@ -471,6 +508,20 @@ double Energy::singleFromTOF(const double tof) const {
   return factorFrom / (temp * temp);
 }
 
+void Energy::multipleToTOF(double *first, double *last) const {
+  for (; first != last; ++first) {
+    const double temp = *first == 0.0 ? DBL_MIN : *first;
+    *first = factorTo / sqrt(temp);
+  }
+}
+
+void Energy::multipleFromTOF(double *first, double *last) const {
+  for (; first != last; ++first) {
+    const double temp = *first == 0.0 ? DBL_MIN : *first;
+    *first = factorFrom / (temp * temp);
+  }
+}
+
 Unit *Energy::clone() const { return new Energy(*this); }
 
 // ============================================================================================
@@ -577,6 +628,14 @@ double dSpacing::singleToTOF(const double x) const { return x * factorTo; }
 double dSpacing::singleFromTOF(const double tof) const {
   return tof / factorFrom;
 }
+void dSpacing::multipleToTOF(double *first, double *last) const {
+  for (; first != last; ++first)
+    *first *= factorTo;
+}
+void dSpacing::multipleFromTOF(double *first, double *last) const {
+  for (; first != last; ++first)
+    *first /= factorFrom;
+}
 double dSpacing::conversionTOFMin() const { return 0; }
 double dSpacing::conversionTOFMax() const { return DBL_MAX / factorTo; }
 
@@ -688,6 +747,19 @@ double MomentumTransfer::singleFromTOF(const double tof) const {
   return factorFrom / temp;
 }
 
+void MomentumTransfer::multipleToTOF(double *first, double *last) const {
+  for (; first != last; ++first) {
+    const double temp = *first == 0.0 ? DBL_MIN : *first;
+    *first = factorTo / temp;
+  }
+}
+void MomentumTransfer::multipleFromTOF(double *first, double *last) const {
+  for (; first != last; ++first) {
+    const double temp = *first == 0.0 ? DBL_MIN : *first;
+    *first = factorFrom / temp;
+  }
+}
+
 double MomentumTransfer::conversionTOFMin() const {
   return factorFrom / DBL_MAX;
 }
@@ -861,6 +933,40 @@ double DeltaE::singleFromTOF(const double tof) const {
     return DBL_MAX;
 }
 
+void DeltaE::multipleToTOF(double *first, double *last) const {
+  if (emode != 1 && emode != 2) {
+    std::fill(first, last, DeltaE::conversionTOFMax());
+    return;
+  }
+  // e2 = efixed - x for direct geometry, e1 = efixed + x for indirect
+  const double sign = emode == 1 ? -1. : 1.;
+  const double tofMax = DeltaE::conversionTOFMax();
+  for (; first != last; ++first) {
+    const double e = efixed + sign * (*first / unitScaling);
+    *first = e <= 0.0 ? tofMax : factorTo / sqrt(e) + t_other;
+  }
+}
+
+void DeltaE::multipleFromTOF(double *first, double *last) const {
+  if (emode == 1) {
+    for (; first != last; ++first) {
+      const double this_t = *first - t_otherFrom;
+      *first = this_t <= 0.0
+                   ? -DBL_MAX
+                   : (efixed - factorFrom / (this_t * this_t)) * unitScaling;
+    }
+  } else if (emode == 2) {
+    for (; first != last; ++first) {
+      const double this_t = *first - t_otherFrom;
+      *first = this_t <= 0.0
+                   ? DBL_MAX
+                   : (factorFrom / (this_t * this_t) - efixed) * unitScaling;
+    }
+  } else {
+    std::fill(first, last, DBL_MAX);
+  }
+}
+
 double DeltaE::conversionTOFMin() const {
   double time(
       DBL_MAX); // impossible for elastic, this units do not work for elastic
@@ -1114,6 +1220,14 @@ double SpinEchoLength::singleFromTOF(const double tof) const {
   return x;
 }
 
+void SpinEchoLength::multipleToTOF(double *first, double *last) const {
+  Unit::multipleToTOF(first, last);
+}
+
+void SpinEchoLength::multipleFromTOF(double *first, double *last) const {
+  Unit::multipleFromTOF(first, last);
+}
+
 Unit *SpinEchoLength::clone() const { return new SpinEchoLength(*this); }
 
 // ============================================================================================
@@ -1159,6 +1273,14 @@ double SpinEchoTime::singleFromTOF(const double tof) const {
   return x;
 }
 
+void SpinEchoTime::multipleToTOF(double *first, double *last) const {
+  Unit::multipleToTOF(first, last);
+}
+
+void SpinEchoTime::multipleFromTOF(double *first, double *last) const {
+  Unit::multipleFromTOF(first, last);
+}
+
 Unit *SpinEchoTime::clone() const { return new SpinEchoTime(*this); }
 
 // ================================================================================
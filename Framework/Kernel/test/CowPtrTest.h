@@ -3,9 +3,12 @@
 
 #include <cxxtest/TestSuite.h>
 #include "MantidKernel/cow_ptr.h"
+#include "MantidKernel/CowPtrStatistics.h"
 #include <boost/shared_ptr.hpp>
 #include <boost/make_shared.hpp>
 
+#include <vector>
+
 using namespace Mantid::Kernel;
 
 namespace {
@@ -153,6 +156,32 @@ public:
                        copyResource.value);
   }
 
+  void test_access_counts_copies_of_shared_data() {
+    cow_ptr<std::vector<double>> original{
+        boost::make_shared<std::vector<double>>(10, 1.0)};
+    auto copy = original;
+    const auto copies = CowPtrStatistics::copies();
+    const auto bytes = CowPtrStatistics::copiedBytes();
+
+    copy.access();
+    TS_ASSERT_EQUALS(CowPtrStatistics::copies(), copies + 1);
+    TS_ASSERT_EQUALS(CowPtrStatistics::copiedBytes(),
+                     bytes + 10 * sizeof(double));
+
+    // Neither is shared any more, so no further copies are made
+    copy.access();
+    original.access();
+    TS_ASSERT_EQUALS(CowPtrStatistics::copies(), copies + 1);
+  }
+
+  void test_access_counts_size_of_object_that_is_not_a_container() {
+    cow_ptr<MyType> original{boost::make_shared<MyType>(3)};
+    auto copy = original;
+    const auto bytes = CowPtrStatistics::copiedBytes();
+    copy.access();
+    TS_ASSERT_EQUALS(CowPtrStatistics::copiedBytes(), bytes + sizeof(MyType));
+  }
+
   void test_equals_not_equals() {
     cow_ptr<MyType> cow{nullptr};
     TS_ASSERT(cow == cow);
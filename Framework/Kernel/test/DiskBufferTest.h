@@ -13,6 +13,7 @@
 #include <boost/multi_index/mem_fun.hpp>
 #include <boost/multi_index/sequenced_index.hpp>
 #include <cxxtest/TestSuite.h>
+#include <stdexcept>
 
 using namespace Mantid;
 using namespace Mantid::Kernel;
@@ -98,6 +99,15 @@ public:
 std::string SaveableTesterWithFile::fakeFile;
 std::mutex SaveableTesterWithFile::streamMutex;
 
+/** An ISaveable that fails to save */
+class SaveableTesterThatThrows : public SaveableTesterWithFile {
+public:
+  SaveableTesterThatThrows() : SaveableTesterWithFile(0, 2, 'X', false) {}
+  void save() const override {
+    throw std::runtime_error("Failed to save");
+  }
+};
+
 //====================================================================================
 class DiskBufferTest : public CxxTest::TestSuite {
 public:
@@ -266,6 +276,51 @@ public:
     for (size_t i = 0; i < size_t(bigNum); i++)
       delete bigData[i];
   }
+  //--------------------------------------------------------------------------------
+  /** Objects written asynchronously end up in the file and out of memory */
+  void test_writeAsync() {
+    // Room for 2 objects of size 2 waiting to be written
+    DiskBuffer dbuf(2 * 2);
+    for (size_t i = 0; i < num; i++) {
+      data[i]->setSaved(false);
+      dbuf.writeAsync(data[i]);
+    }
+    TS_ASSERT_THROWS_NOTHING(dbuf.waitForAsyncWrites());
+
+    TS_ASSERT_EQUALS(SaveableTesterWithFile::fakeFile, "AABBCCDDEEFFGGHHIIJJ");
+    for (size_t i = 0; i < num; i++) {
+      TS_ASSERT(data[i]->wasSaved());
+      TS_ASSERT(!data[i]->isLoaded());
+      TS_ASSERT_EQUALS(data[i]->getDataMemorySize(), 0);
+    }
+  }
+
+  /** Flushing the cache and deleting objects wait for asynchronous writes */
+  void test_writeAsync_flushCache_and_objectDeleted_wait() {
+    DiskBuffer dbuf(100);
+    for (size_t i = 0; i < 5; i++) {
+      data[i]->setSaved(false);
+      dbuf.writeAsync(data[i]);
+    }
+    dbuf.objectDeleted(data[4]);
+    TS_ASSERT_EQUALS(SaveableTesterWithFile::fakeFile.substr(8, 2), "EE");
+    dbuf.flushCache();
+    TS_ASSERT_EQUALS(SaveableTesterWithFile::fakeFile, "AABBCCDDEE");
+  }
+
+  /** Errors raised by the I/O thread are passed on to the caller */
+  void test_writeAsync_rethrows_errors() {
+    DiskBuffer dbuf(100);
+    SaveableTesterThatThrows bad;
+    dbuf.writeAsync(&bad);
+    TS_ASSERT_THROWS(dbuf.waitForAsyncWrites(), std::runtime_error);
+    // The error is only reported once
+    data[0]->setSaved(false);
+    dbuf.writeAsync(data[0]);
+    TS_ASSERT_THROWS_NOTHING(dbuf.waitForAsyncWrites());
+    TS_ASSERT(data[0]->wasSaved());
+  }
+
   ////--------------------------------------------------------------------------------
   ////--------------------------------------------------------------------------------
   ////----------TESTS FOR FREE SPACE MAPS
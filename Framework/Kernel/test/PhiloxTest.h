@@ -0,0 +1,152 @@
+#ifndef MANTID_KERNEL_PHILOXTEST_H_
+#define MANTID_KERNEL_PHILOXTEST_H_
+
+#include <cxxtest/TestSuite.h>
+#include "MantidKernel/Philox.h"
+
+#include <climits>
+#include <cstdint>
+#include <vector>
+
+using Mantid::Kernel::Philox;
+
+class PhiloxTest : public CxxTest::TestSuite {
+
+public:
+  void test_That_Object_Construction_Does_Not_Throw() {
+    TS_ASSERT_THROWS_NOTHING(Philox(1));
+  }
+
+  void test_First_Block_Matches_Reference_Implementation() {
+    // Known answer for a zero key and counter from the Random123 library
+    Philox randGen(0, 0);
+    const uint32_t expected[4] = {0x6627e8d5, 0xe169c58d, 0xbc57ac4c,
+                                  0x9b00dbd8};
+    for (const auto word : expected) {
+      // The full integer range maps each 32-bit word to one integer
+      TS_ASSERT_EQUALS(randGen.nextInt(INT_MIN, INT_MAX),
+                       static_cast<int64_t>(word) + INT_MIN);
+    }
+  }
+
+  void test_That_Next_For_Given_Seed_And_Stream_Returns_Same_Value() {
+    Philox gen_1(212437999, 5), gen_2(212437999, 5);
+    TS_ASSERT_EQUALS(gen_1.nextValue(), gen_2.nextValue());
+  }
+
+  void test_That_Next_For_Different_Seeds_Returns_Different_Values() {
+    Philox gen_1(212437999), gen_2(247021340);
+    TS_ASSERT_DIFFERS(gen_1.nextValue(), gen_2.nextValue());
+  }
+
+  void test_That_Different_Streams_Return_Different_Values() {
+    Philox gen_1(212437999, 0), gen_2(212437999, 1);
+    TS_ASSERT_DIFFERS(gen_1.nextValue(), gen_2.nextValue());
+  }
+
+  void test_setStream_Starts_The_Stream_From_The_Beginning() {
+    Philox randGen(39857239, 3);
+    const auto stream3 = doNextValueCalls(10, randGen);
+    randGen.setStream(8);
+    const auto stream8 = doNextValueCalls(10, randGen);
+    randGen.setStream(3);
+    TS_ASSERT_EQUALS(doNextValueCalls(10, randGen), stream3);
+    Philox other(39857239, 8);
+    TS_ASSERT_EQUALS(doNextValueCalls(10, other), stream8);
+  }
+
+  void test_That_A_Restart_Gives_Same_Sequence_Again_From_Start() {
+    Philox randGen(39857239, 2);
+    const auto firstValues = doNextValueCalls(10, randGen);
+    randGen.restart();
+    TS_ASSERT_EQUALS(doNextValueCalls(10, randGen), firstValues);
+  }
+
+  void test_That_A_Restore_Without_Save_Does_The_Same_As_Restart() {
+    Philox randGen(39857239);
+    const auto firstValues = doNextValueCalls(10, randGen);
+    randGen.restore();
+    TS_ASSERT_EQUALS(doNextValueCalls(10, randGen), firstValues);
+  }
+
+  void
+  test_That_Save_Then_Call_Next_Value_And_Restore_Gives_Sequence_From_Saved_Point() {
+    Philox randGen(1);
+    // Move away from start, and within a block, so not the same as reset
+    doNextValueCalls(11, randGen);
+    randGen.nextInt(1, 6);
+
+    randGen.save();
+    const auto firstValues = doNextValueCalls(50, randGen);
+    randGen.restore();
+    TS_ASSERT_EQUALS(doNextValueCalls(50, randGen), firstValues);
+    randGen.restore();
+    TS_ASSERT_EQUALS(doNextValueCalls(50, randGen), firstValues);
+  }
+
+  void test_That_Default_Range_Produces_Numbers_Between_Zero_And_One() {
+    Philox randGen(12345);
+    double sum(0.0);
+    const size_t ncalls(10000);
+    for (std::size_t i = 0; i < ncalls; ++i) {
+      const double r = randGen.nextValue();
+      TS_ASSERT(r >= 0.0 && r < 1.0);
+      sum += r;
+    }
+    TS_ASSERT_DELTA(sum / ncalls, 0.5, 0.01);
+  }
+
+  void test_That_A_Default_Range_Produces_Numbers_Within_This_Range() {
+    const double start(2.5), end(5.);
+    Philox randGen(15423894, 0, start, end);
+    for (std::size_t i = 0; i < 20; ++i) {
+      const double r = randGen.nextValue();
+      TS_ASSERT(r >= start && r <= end);
+    }
+  }
+
+  void
+  test_That_A_Given_Range_Produces_Numbers_Within_That_Range_For_Doubles() {
+    Philox randGen(15423894);
+    for (std::size_t i = 0; i < 20; ++i) {
+      const double localStart(2.5), localEnd(3.5);
+      const double r = randGen.nextValue(localStart, localEnd);
+      TS_ASSERT(r >= localStart && r <= localEnd);
+    }
+  }
+
+  void test_That_Ints_Cover_The_Given_Range_Uniformly() {
+    const int start(1), end(6);
+    Philox randGen(15423894);
+    std::vector<size_t> counts(end - start + 1, 0);
+    const size_t ncalls(60000);
+    for (std::size_t i = 0; i < ncalls; ++i) {
+      const int r = randGen.nextInt(start, end);
+      TS_ASSERT(r >= start && r <= end);
+      if (r >= start && r <= end)
+        ++counts[r - start];
+    }
+    for (const auto count : counts)
+      TS_ASSERT_DELTA(static_cast<double>(count), 10000., 500.);
+  }
+
+  void test_That_nextPoint_returns_1_Value() {
+    Philox randGen(12345);
+    for (std::size_t i = 0; i < 20; ++i) {
+      const std::vector<double> point = randGen.nextPoint();
+      TS_ASSERT_EQUALS(point.size(), 1);
+    }
+  }
+
+private:
+  std::vector<double> doNextValueCalls(const unsigned int ncalls,
+                                       Philox &randGen) {
+    std::vector<double> values(ncalls, 0.0);
+    for (unsigned int i = 0; i < ncalls; ++i) {
+      values[i] = randGen.nextValue();
+    }
+    return values;
+  }
+};
+
+#endif /* MANTID_KERNEL_PHILOXTEST_H_ */
@@ -0,0 +1,129 @@
+#ifndef MANTID_KERNEL_RADIXSORTTEST_H_
+#define MANTID_KERNEL_RADIXSORTTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidKernel/RadixSort.h"
+
+#include <algorithm>
+#include <limits>
+#include <random>
+
+using namespace Mantid::Kernel;
+
+namespace RadixSortTestHelpers {
+struct Item {
+  double value;
+  int64_t time;
+};
+
+uint64_t valueKey(const Item &item) {
+  return RadixSort::orderedKey(item.value);
+}
+uint64_t timeKey(const Item &item) { return RadixSort::orderedKey(item.time); }
+
+std::vector<Item> randomItems(const size_t size) {
+  std::mt19937 generator(1234);
+  std::uniform_real_distribution<double> value(-1e5, 1e5);
+  std::uniform_int_distribution<int64_t> time(-500, 500);
+  std::vector<Item> items(size);
+  for (auto &item : items) {
+    item.value = value(generator);
+    item.time = time(generator);
+  }
+  return items;
+}
+}
+
+using namespace RadixSortTestHelpers;
+
+class RadixSortTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static RadixSortTest *createSuite() { return new RadixSortTest(); }
+  static void destroySuite(RadixSortTest *suite) { delete suite; }
+
+  void test_orderedKey_double_preserves_order() {
+    const std::vector<double> values{-1e300, -2.5, -1e-300, 0.0,
+                                     1e-300, 2.5,  1e300};
+    for (size_t i = 1; i < values.size(); ++i)
+      TS_ASSERT_LESS_THAN(RadixSort::orderedKey(values[i - 1]),
+                          RadixSort::orderedKey(values[i]));
+  }
+
+  void test_orderedKey_double_signed_zeros_are_equal() {
+    TS_ASSERT_EQUALS(RadixSort::orderedKey(-0.0), RadixSort::orderedKey(0.0));
+  }
+
+  void test_orderedKey_int64_preserves_order() {
+    const std::vector<int64_t> values{std::numeric_limits<int64_t>::min(), -1,
+                                      0, 1,
+                                      std::numeric_limits<int64_t>::max()};
+    for (size_t i = 1; i < values.size(); ++i)
+      TS_ASSERT_LESS_THAN(RadixSort::orderedKey(values[i - 1]),
+                          RadixSort::orderedKey(values[i]));
+  }
+
+  void test_empty_and_single_item() {
+    std::vector<Item> items;
+    TS_ASSERT_THROWS_NOTHING(RadixSort::sortByKey(items, valueKey));
+    items.push_back({1.0, 0});
+    RadixSort::sortByKey(items, valueKey);
+    TS_ASSERT_EQUALS(items.size(), 1);
+    TS_ASSERT_EQUALS(items[0].value, 1.0);
+  }
+
+  void test_sort_matches_std_sort() {
+    auto items = randomItems(1000);
+    auto expected = items;
+    std::sort(expected.begin(), expected.end(),
+              [](const Item &a, const Item &b) { return a.value < b.value; });
+    RadixSort::sortByKey(items, valueKey);
+    for (size_t i = 0; i < items.size(); ++i)
+      TS_ASSERT_EQUALS(items[i].value, expected[i].value);
+  }
+
+  void test_sort_is_stable_for_multiple_keys() {
+    // Large enough to be split into several chunks
+    auto items = randomItems(5 * RadixSort::MinimumChunkSize + 17);
+    auto expected = items;
+    std::stable_sort(expected.begin(), expected.end(),
+                     [](const Item &a, const Item &b) {
+                       return a.time < b.time ||
+                              (a.time == b.time && a.value < b.value);
+                     });
+    RadixSort::sortByKey(items, valueKey);
+    RadixSort::sortByKey(items, timeKey);
+    bool matches = true;
+    for (size_t i = 0; i < items.size(); ++i)
+      matches &= (items[i].time == expected[i].time &&
+                  items[i].value == expected[i].value);
+    TS_ASSERT(matches);
+  }
+};
+
+class RadixSortTestPerformance : public CxxTest::TestSuite {
+public:
+  static RadixSortTestPerformance *createSuite() {
+    return new RadixSortTestPerformance();
+  }
+  static void destroySuite(RadixSortTestPerformance *suite) { delete suite; }
+
+  RadixSortTestPerformance() : m_source(randomItems(10000000)) {}
+
+  void setUp() override { m_items = m_source; }
+
+  void test_radix_sort() { RadixSort::sortByKey(m_items, valueKey); }
+
+  void test_std_sort_for_comparison() {
+    std::sort(m_items.begin(), m_items.end(),
+              [](const Item &a, const Item &b) { return a.value < b.value; });
+  }
+
+private:
+  std::vector<Item> m_source;
+  std::vector<Item> m_items;
+};
+
+#endif /* MANTID_KERNEL_RADIXSORTTEST_H_ */
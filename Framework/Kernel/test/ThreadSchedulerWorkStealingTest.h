@@ -0,0 +1,153 @@
+#ifndef MANTID_KERNEL_THREADSCHEDULERWORKSTEALINGTEST_H_
+#define MANTID_KERNEL_THREADSCHEDULERWORKSTEALINGTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidKernel/Task.h"
+#include "MantidKernel/ThreadPool.h"
+#include "MantidKernel/ThreadSchedulerWorkStealing.h"
+#include "MantidKernel/Timer.h"
+
+#include <atomic>
+#include <iostream>
+
+using namespace Mantid::Kernel;
+
+namespace ThreadSchedulerWorkStealingTestHelpers {
+std::atomic<size_t> numRun;
+
+/// Task that does nothing but count
+class TaskCounter : public Task {
+public:
+  explicit TaskCounter(double cost = 1.0) : Task(cost) {}
+  void run() override { ++numRun; }
+};
+
+/// Task that recursively pushes two child tasks until a depth is reached
+class TaskThatSplits : public Task {
+public:
+  TaskThatSplits(ThreadScheduler *scheduler, size_t depth)
+      : Task(), m_scheduler(scheduler), m_depth(depth) {}
+  void run() override {
+    if (m_depth == 0) {
+      ++numRun;
+      return;
+    }
+    m_scheduler->push(new TaskThatSplits(m_scheduler, m_depth - 1));
+    m_scheduler->push(new TaskThatSplits(m_scheduler, m_depth - 1));
+  }
+
+private:
+  ThreadScheduler *m_scheduler;
+  size_t m_depth;
+};
+}
+
+using namespace ThreadSchedulerWorkStealingTestHelpers;
+
+class ThreadSchedulerWorkStealingTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static ThreadSchedulerWorkStealingTest *createSuite() {
+    return new ThreadSchedulerWorkStealingTest();
+  }
+  static void destroySuite(ThreadSchedulerWorkStealingTest *suite) {
+    delete suite;
+  }
+
+  void test_push_pop_size_and_cost() {
+    ThreadSchedulerWorkStealing sc(2);
+    TS_ASSERT_EQUALS(sc.numQueues(), 2);
+    TS_ASSERT(sc.empty());
+    sc.push(new TaskCounter(2.0));
+    sc.push(new TaskCounter(3.0));
+    TS_ASSERT_EQUALS(sc.size(), 2);
+    TS_ASSERT_DELTA(sc.totalCost(), 5.0, 1e-12);
+
+    Task *task = sc.pop(0);
+    TS_ASSERT(task);
+    delete task;
+    TS_ASSERT_EQUALS(sc.size(), 1);
+    task = sc.pop(0);
+    TS_ASSERT(task);
+    delete task;
+    TS_ASSERT(sc.empty());
+    TS_ASSERT(!sc.pop(0));
+    // The cost includes the executed tasks, as for the other schedulers
+    TS_ASSERT_DELTA(sc.totalCost(), 5.0, 1e-12);
+  }
+
+  void test_own_queue_is_lifo_and_stealing_is_fifo() {
+    ThreadSchedulerWorkStealing sc(2);
+    Task *tasks[3] = {new TaskCounter(), new TaskCounter(), new TaskCounter()};
+    for (auto task : tasks)
+      sc.pushToThread(task, 1);
+    // Thread 0 has nothing of its own so steals the oldest task
+    TS_ASSERT_EQUALS(sc.pop(0), tasks[0]);
+    // Thread 1 takes its newest task
+    TS_ASSERT_EQUALS(sc.pop(1), tasks[2]);
+    TS_ASSERT_EQUALS(sc.pop(1), tasks[1]);
+    for (auto task : tasks)
+      delete task;
+  }
+
+  void test_clear_deletes_tasks() {
+    ThreadSchedulerWorkStealing sc(3);
+    for (size_t i = 0; i < 10; ++i)
+      sc.push(new TaskCounter());
+    TS_ASSERT_EQUALS(sc.size(), 10);
+    sc.clear();
+    TS_ASSERT_EQUALS(sc.size(), 0);
+    TS_ASSERT_EQUALS(sc.totalCost(), 0.0);
+  }
+
+  void test_thread_pool_runs_nested_tasks() {
+    auto sc = new ThreadSchedulerWorkStealing();
+    ThreadPool pool(sc, 0);
+    numRun = 0;
+    pool.schedule(new TaskThatSplits(sc, 12));
+    TS_ASSERT_THROWS_NOTHING(pool.joinAll());
+    TS_ASSERT_EQUALS(numRun.load(), 4096);
+  }
+};
+
+class ThreadSchedulerWorkStealingTestPerformance : public CxxTest::TestSuite {
+public:
+  static ThreadSchedulerWorkStealingTestPerformance *createSuite() {
+    return new ThreadSchedulerWorkStealingTestPerformance();
+  }
+  static void destroySuite(ThreadSchedulerWorkStealingTestPerformance *suite) {
+    delete suite;
+  }
+
+  void test_scaling_work_stealing() {
+    for (size_t threads = 1; threads <= maxThreads(); threads *= 2)
+      runNestedTasks(new ThreadSchedulerWorkStealing(threads), threads,
+                     "ThreadSchedulerWorkStealing");
+  }
+
+  void test_scaling_fifo_for_comparison() {
+    for (size_t threads = 1; threads <= maxThreads(); threads *= 2)
+      runNestedTasks(new ThreadSchedulerFIFO(), threads, "ThreadSchedulerFIFO");
+  }
+
+private:
+  size_t maxThreads() const {
+    return std::min(ThreadPool::getNumPhysicalCores(), size_t(64));
+  }
+
+  void runNestedTasks(ThreadScheduler *sc, size_t threads,
+                      const std::string &name) {
+    ThreadPool pool(sc, threads);
+    numRun = 0;
+    Timer timer;
+    pool.schedule(new TaskThatSplits(sc, 20));
+    pool.joinAll();
+    TS_ASSERT_EQUALS(numRun.load(), size_t(1) << 20);
+    std::cout << "\n" << name << " with " << threads << " threads: "
+              << timer.elapsed() << " s";
+  }
+};
+
+#endif /* MANTID_KERNEL_THREADSCHEDULERWORKSTEALINGTEST_H_ */
@@ -680,6 +680,30 @@ public:
     delete outputs[4];
   }
 
+  //----------------------------------------------------------------------------
+  /** Intervals whose destination has no output are skipped
+   */
+  void test_splitByTime_skips_targets_without_output() {
+    TimeSeriesProperty<int> *log = createIntegerTSP(12);
+    std::vector<Property *> outputs{new TimeSeriesProperty<int>("MyIntLog")};
+
+    TimeSplitterType splitter;
+    splitter.push_back(SplittingInterval(DateAndTime("2007-11-30T16:17:10"),
+                                         DateAndTime("2007-11-30T16:17:40"),
+                                         3));
+    splitter.push_back(SplittingInterval(DateAndTime("2007-11-30T16:18:09"),
+                                         DateAndTime("2007-11-30T16:18:21"),
+                                         0));
+
+    log->splitByTime(splitter, outputs, false);
+
+    TS_ASSERT_EQUALS(
+        dynamic_cast<TimeSeriesProperty<int> *>(outputs[0])->realSize(), 3);
+
+    delete log;
+    delete outputs[0];
+  }
+
   //----------------------------------------------------------------------------
   void test_splitByTime_withOverlap() {
     TimeSeriesProperty<int> *log = createIntegerTSP(12);
@@ -2246,6 +2270,40 @@ public:
     TS_ASSERT_EQUALS(filteredValues.size(), 9);
   }
 
+  void test_filteredValuesAsVector_values() {
+    const auto &log = getFilteredTestLog();
+    // The entries at 20s and 100s are filtered out
+    const std::vector<double> expected{1., 2., 4., 5., 6., 7., 8., 9., 10.};
+    TS_ASSERT_EQUALS(log->filteredValuesAsVector(), expected);
+  }
+
+  void test_valueChangesAsVectors_matches_valueAsMap() {
+    TimeSeriesProperty<int> p("intProp");
+    p.addValue("2007-11-30T16:17:00", 1);
+    p.addValue("2007-11-30T16:17:20", 3);
+    p.addValue("2007-11-30T16:17:25", 3);
+    p.addValue("2007-11-30T16:17:10", 2);
+    p.addValue("2007-11-30T16:17:18", 2);
+    p.addValue("2007-11-30T16:17:30", 4);
+    p.addValue("2007-11-30T16:17:30", 5);
+
+    std::vector<DateAndTime> times;
+    std::vector<int> values;
+    p.valueChangesAsVectors(times, values);
+
+    const auto map = p.valueAsMap();
+    TS_ASSERT_EQUALS(times.size(), map.size());
+    TS_ASSERT_EQUALS(values.size(), map.size());
+    size_t i = 0;
+    for (const auto &entry : map) {
+      if (i >= times.size())
+        break;
+      TS_ASSERT_EQUALS(times[i], entry.first);
+      TS_ASSERT_EQUALS(values[i], entry.second);
+      ++i;
+    }
+  }
+
   void test_getSplittingIntervals_noFilter() {
     const auto &log = getTestLog(); // no filter
     const auto &intervals = log->getSplittingIntervals();
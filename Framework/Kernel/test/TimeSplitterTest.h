@@ -538,6 +538,168 @@ public:
     int index2 = int(sit - b.begin());
     TS_ASSERT_EQUALS(index2, 2);
   }
+
+  //----------------------------------------------------------------------------
+  /** Find the intervals of an unsorted splitter overlapping an interval
+   */
+  void test_SplittingIntervalIndex_overlapping() {
+    const DateAndTime t0("2007-11-30T16:17:00");
+    TimeSplitterType splitter;
+    splitter.emplace_back(t0 + 30.0, t0 + 40.0, 3);
+    splitter.emplace_back(t0 + 0.0, t0 + 10.0, 1);
+    splitter.emplace_back(t0 + 10.0, t0 + 20.0, 2);
+
+    SplittingIntervalIndex index(splitter);
+    TS_ASSERT_EQUALS(index.size(), 3);
+    TS_ASSERT(index.overlapping(SplittingInterval(t0 - 2.0, t0 - 1.0)).empty());
+    TS_ASSERT(
+        index.overlapping(SplittingInterval(t0 + 21.0, t0 + 29.0)).empty());
+    const std::vector<size_t> first{1};
+    TS_ASSERT_EQUALS(index.overlapping(SplittingInterval(t0 + 1.0, t0 + 2.0)),
+                     first);
+    // Touching intervals overlap. The positions are in increasing order.
+    const std::vector<size_t> touching{1, 2};
+    TS_ASSERT_EQUALS(index.overlapping(SplittingInterval(t0 + 5.0, t0 + 10.0)),
+                     touching);
+    const std::vector<size_t> all{0, 1, 2};
+    TS_ASSERT_EQUALS(index.overlapping(SplittingInterval(t0, t0 + 40.0)), all);
+  }
+
+  /** Look up the destination of times in an unsorted splitter
+   */
+  void test_SplittingIntervalIndex_index() {
+    const DateAndTime t0("2007-11-30T16:17:00");
+    TimeSplitterType splitter;
+    splitter.emplace_back(t0 + 30.0, t0 + 40.0, 3);
+    splitter.emplace_back(t0, t0 + 10.0, 1);
+    splitter.emplace_back(t0 + 10.0, t0 + 20.0, 2);
+
+    SplittingIntervalIndex index(splitter);
+    TS_ASSERT_EQUALS(index.index(t0 - 1.0), -1);
+    TS_ASSERT_EQUALS(index.index(t0), 1);
+    TS_ASSERT_EQUALS(index.index(t0 + 9.5), 1);
+    // The stop time belongs to the next interval
+    TS_ASSERT_EQUALS(index.index(t0 + 10.0), 2);
+    TS_ASSERT_EQUALS(index.index(t0 + 25.0), -1);
+    TS_ASSERT_EQUALS(index.index(t0 + 35.0), 3);
+    TS_ASSERT_EQUALS(index.index(t0 + 40.0), -1);
+    TS_ASSERT(index.contains(t0 + 15.0));
+    TS_ASSERT(!index.contains(t0 + 20.0));
+    TS_ASSERT(!SplittingIntervalIndex(TimeSplitterType()).contains(t0));
+  }
+
+  /** A long interval spanning shorter ones must be found too
+   */
+  void test_SplittingIntervalIndex_nested_intervals() {
+    const DateAndTime t0("2007-11-30T16:17:00");
+    TimeSplitterType splitter;
+    splitter.emplace_back(t0, t0 + 100.0, 0);
+    splitter.emplace_back(t0 + 10.0, t0 + 20.0, 1);
+    splitter.emplace_back(t0 + 30.0, t0 + 40.0, 2);
+
+    SplittingIntervalIndex index(splitter);
+    TS_ASSERT_EQUALS(index.index(t0 + 15.0), 1);
+    TS_ASSERT_EQUALS(index.index(t0 + 25.0), 0);
+    TS_ASSERT_EQUALS(index.index(t0 + 99.0), 0);
+    const std::vector<size_t> expected{0, 2};
+    TS_ASSERT_EQUALS(
+        index.overlapping(SplittingInterval(t0 + 25.0, t0 + 35.0)), expected);
+    const std::vector<size_t> outer{0};
+    TS_ASSERT_EQUALS(
+        index.overlapping(SplittingInterval(t0 + 90.0, t0 + 95.0)), outer);
+  }
+
+  /** The indexed AND gives the same intervals, in the same order, as
+   * comparing every pair of intervals
+   */
+  void test_AND_matches_pairwise_comparison() {
+    const DateAndTime t0("2007-11-30T16:17:00");
+    TimeSplitterType a, b;
+    unsigned int seed = 12345;
+    auto next = [&seed]() {
+      seed = seed * 1103515245 + 12345;
+      return static_cast<double>((seed / 65536) % 1000);
+    };
+    for (int i = 0; i < 200; ++i) {
+      const double start = next();
+      a.emplace_back(t0 + start, t0 + start + next() / 20.0, i % 5);
+    }
+    for (int i = 0; i < 100; ++i) {
+      const double start = next();
+      b.emplace_back(t0 + start, t0 + start + next() / 10.0, 0);
+    }
+    // Touching intervals count as overlapping
+    b.emplace_back(a[0].stop(), a[0].stop() + 1.0, 0);
+
+    TimeSplitterType expected;
+    for (const auto &ia : a)
+      for (const auto &ib : b)
+        if (ia.overlaps(ib))
+          expected.push_back(ia & ib);
+
+    const TimeSplitterType c = a & b;
+    TS_ASSERT_EQUALS(c.size(), expected.size());
+    for (size_t i = 0; i < std::min(c.size(), expected.size()); ++i) {
+      TS_ASSERT_EQUALS(c[i].start(), expected[i].start());
+      TS_ASSERT_EQUALS(c[i].stop(), expected[i].stop());
+      TS_ASSERT_EQUALS(c[i].index(), expected[i].index());
+    }
+  }
+};
+
+class TimeSplitterTestPerformance : public CxxTest::TestSuite {
+public:
+  static TimeSplitterTestPerformance *createSuite() {
+    return new TimeSplitterTestPerformance();
+  }
+  static void destroySuite(TimeSplitterTestPerformance *suite) {
+    delete suite;
+  }
+
+  TimeSplitterTestPerformance() {
+    // 12 hours of one second intervals, and a filter with a gap every minute
+    const DateAndTime t0("2007-11-30T16:17:00");
+    for (int i = 0; i < 43200; ++i)
+      m_splitter.emplace_back(t0 + static_cast<double>(i),
+                              t0 + static_cast<double>(i) + 0.5, i % 10);
+    for (int i = 0; i < 720; ++i)
+      m_filter.emplace_back(t0 + 60.0 * i, t0 + 60.0 * i + 50.0, 0);
+  }
+
+  void test_AND() {
+    TimeSplitterType out = m_splitter & m_filter;
+    TS_ASSERT_EQUALS(out.size(), 720 * 51);
+  }
+
+  void test_index_lookup() {
+    SplittingIntervalIndex index(m_splitter);
+    const DateAndTime t0("2007-11-30T16:17:00");
+    int found = 0;
+    // Every tenth of a second
+    for (int64_t i = 0; i < 432000; ++i)
+      if (index.index(t0 + i * 100000000) >= 0)
+        ++found;
+    TS_ASSERT_EQUALS(found, 216000);
+  }
+
+  void test_overlapping_with_a_long_first_interval() {
+    // An interval spanning all the others must not make the lookups linear
+    TimeSplitterType splitter(m_splitter);
+    const DateAndTime t0("2007-11-30T16:17:00");
+    splitter.emplace_back(t0 - 1.0, t0 + 43200.0, 10);
+    SplittingIntervalIndex index(splitter);
+    size_t found = 0;
+    for (int i = 0; i < 43200; ++i) {
+      const double second = static_cast<double>(i);
+      found += index.overlapping(SplittingInterval(t0 + second + 0.6,
+                                                   t0 + second + 0.9)).size();
+    }
+    TS_ASSERT_EQUALS(found, 43200);
+  }
+
+private:
+  TimeSplitterType m_splitter;
+  TimeSplitterType m_filter;
 };
 
 #endif /* TIMESPLITTERTEST_H_ */
@@ -8,6 +8,7 @@
 #include "MantidKernel/UnitLabelTypes.h"
 #include <boost/lexical_cast.hpp>
 #include <cfloat>
+#include <cmath>
 #include <limits>
 
 using namespace Mantid::Kernel;
@@ -1384,6 +1385,38 @@ public:
     }
   }
 
+  void test_multipleToTOF_and_multipleFromTOF_match_single_conversions() {
+    std::vector<Unit *> units{&tof, &lambda, &energy, &energyk, &d,  &dp, &q,
+                              &q2,  &dE,     &dEk,    &dEf,     &k_i, &delta,
+                              &tau};
+    std::vector<double> values;
+    for (int i = -10; i < 1000; ++i)
+      values.push_back(0.37 * i);
+    for (const int emode : {0, 1, 2}) {
+      for (auto unit : units) {
+        try {
+          unit->initialize(10.0, 2.0, 0.7, emode, emode == 0 ? 0.0 : 25.0,
+                           0.0);
+        } catch (std::invalid_argument &) {
+          continue; // energy transfer units need an inelastic emode
+        }
+        auto toTof = values;
+        auto fromTof = values;
+        unit->multipleToTOF(toTof.data(), toTof.data() + toTof.size());
+        unit->multipleFromTOF(fromTof.data(), fromTof.data() + fromTof.size());
+        for (size_t i = 0; i < values.size(); ++i) {
+          const double expectedTo = unit->singleToTOF(values[i]);
+          const double expectedFrom = unit->singleFromTOF(values[i]);
+          // NaN results are allowed outside the range of the conversion
+          if (!std::isnan(expectedTo))
+            TSM_ASSERT_EQUALS(unit->unitID(), toTof[i], expectedTo);
+          if (!std::isnan(expectedFrom))
+            TSM_ASSERT_EQUALS(unit->unitID(), fromTof[i], expectedFrom);
+        }
+      }
+    }
+  }
+
   /// Test unit Degress
   void testDegress() {
     TS_ASSERT_EQUALS(degrees.caption(), "Scattering angle");
@@ -1409,4 +1442,44 @@ private:
   Units::Degrees degrees;
 };
 
+class UnitTestPerformance : public CxxTest::TestSuite {
+public:
+  static UnitTestPerformance *createSuite() {
+    return new UnitTestPerformance();
+  }
+  static void destroySuite(UnitTestPerformance *suite) { delete suite; }
+
+  UnitTestPerformance() : m_tofs(10000000) {
+    for (size_t i = 0; i < m_tofs.size(); ++i)
+      m_tofs[i] = 1000. + 0.001 * static_cast<double>(i);
+    m_d.initialize(10.0, 2.0, 1.5, 0, 0.0, 0.0);
+    m_q.initialize(10.0, 2.0, 1.5, 0, 0.0, 0.0);
+  }
+
+  void test_dSpacing_single_conversions() {
+    const Unit &unit = m_d;
+    for (auto &tof : m_tofs)
+      tof = unit.singleFromTOF(tof);
+  }
+
+  void test_dSpacing_multiple_conversions() {
+    m_d.multipleFromTOF(m_tofs.data(), m_tofs.data() + m_tofs.size());
+  }
+
+  void test_MomentumTransfer_single_conversions() {
+    const Unit &unit = m_q;
+    for (auto &tof : m_tofs)
+      tof = unit.singleFromTOF(tof);
+  }
+
+  void test_MomentumTransfer_multiple_conversions() {
+    m_q.multipleFromTOF(m_tofs.data(), m_tofs.data() + m_tofs.size());
+  }
+
+private:
+  std::vector<double> m_tofs;
+  Units::dSpacing m_d;
+  Units::MomentumTransfer m_q;
+};
+
 #endif /*UNITTEST_H_*/
@@ -63,10 +63,27 @@ private:
   template <typename MDE, size_t nd>
   void binByIterating(typename DataObjects::MDEventWorkspace<MDE, nd>::sptr ws);
 
+  /// The arrays the signals, squared errors and numbers of events are summed in
+  struct Histogram {
+    signal_t *signals;
+    signal_t *errors;
+    signal_t *numEvents;
+  };
+
+  /// Method to bin a list of MDBoxes, in parallel if requested
+  template <typename MDE, size_t nd, typename Transform>
+  void binBoxes(const std::vector<API::IMDNode *> &boxes,
+                const Transform &transform, bool doParallel);
+
   /// Method to bin a single MDBox
-  template <typename MDE, size_t nd>
-  void binMDBox(DataObjects::MDBox<MDE, nd> *box, const size_t *const chunkMin,
-                const size_t *const chunkMax);
+  template <typename MDE, size_t nd, typename Transform>
+  void binMDBox(DataObjects::MDBox<MDE, nd> *box, const Transform &transform,
+                const Histogram &histogram) const;
+
+  /// Find the bin of a point in the input workspace
+  template <typename Transform>
+  bool getBinIndex(const Transform &transform, const coord_t *center,
+                   size_t &linearIndex) const;
 
   /// The output MDHistoWorkspace
   Mantid::DataObjects::MDHistoWorkspace_sptr outWS;
@@ -76,10 +93,8 @@ private:
   Mantid::Geometry::MDImplicitFunction *implicitFunction;
 
   /// Cached values for speed up
-  size_t *indexMultiplier;
-  signal_t *signals;
-  signal_t *errors;
-  signal_t *numEvents;
+  std::vector<size_t> indexMultiplier;
+  std::vector<size_t> binCounts;
   bool m_accumulate{false};
 };
 
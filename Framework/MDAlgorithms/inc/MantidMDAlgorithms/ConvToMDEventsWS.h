@@ -63,13 +63,16 @@ public:
 private:
   // function runs the conversion on
   size_t conversionChunk(size_t workspaceIndex) override;
+  // converts a spectrum using the given (per-thread) coordinate converter
+  size_t convertSpectrum(size_t workspaceIndex, MDTransfInterface &qConverter);
   // the pointer to the source event workspace as event ws does not work through
   // the public Matrix WS interface
   DataObjects::EventWorkspace_const_sptr m_EventWS;
 
   /**function converts particular type of events into MD space and add these
    * events to the workspace itself    */
-  template <class T> size_t convertEventList(size_t workspaceIndex);
+  template <class T>
+  size_t convertEventList(size_t workspaceIndex, MDTransfInterface &qConverter);
 };
 
 } // endNamespace DataObjects
@@ -4,10 +4,13 @@
 //----------------------------------------------------------------------
 // Includes
 //----------------------------------------------------------------------
+#include "MantidAPI/CompiledExpression.h"
 #include "MantidAPI/ParamFunction.h"
 #include "MantidAPI/IFunctionMD.h"
 #include "MantidGeometry/muParser_Silent.h"
 
+#include <memory>
+
 namespace Mantid {
 namespace MDAlgorithms {
 /**
@@ -53,6 +56,12 @@ public:
     * the dimensions are known.
     */
   void initDimensions() override;
+  /// Evaluate the compiled formula at all points of the domain at once
+  void function(const API::FunctionDomain &domain,
+                API::FunctionValues &values) const override;
+  /// Derivatives of the compiled formula with respect to the parameters
+  void functionDeriv(const API::FunctionDomain &domain,
+                     API::Jacobian &jacobian) override;
 
 protected:
   /**
@@ -66,6 +75,12 @@ protected:
   @param pufun :: Pointer to the function
   */
   static double *AddVariable(const char *varName, void *pufun);
+  /// The coordinates of the centres of the points of a domain
+  std::vector<std::vector<double>>
+  coordinates(const API::FunctionDomain &domain) const;
+  /// Values of the variables and the parameters for the compiled formula
+  std::vector<API::CompiledExpression::Argument>
+  arguments(const std::vector<std::vector<double>> &coordinates) const;
 
   /**
     * Initializes the mu::Parser.
@@ -79,6 +94,10 @@ private:
   mutable std::vector<double> m_vars;
   std::vector<std::string> m_varNames;
   std::string m_formula;
+  /// The formula compiled for fast evaluation, if it is supported
+  std::unique_ptr<API::CompiledExpression> m_compiled;
+  /// Derivatives of the compiled formula with respect to the parameters
+  std::vector<API::CompiledExpression> m_derivatives;
 };
 
 } // namespace MDAlgorithms
@@ -12,11 +12,15 @@
 #include "MantidGeometry/MDGeometry/MDHistoDimension.h"
 #include "MantidKernel/CPUTimer.h"
 #include "MantidKernel/EnabledWhenProperty.h"
+#include "MantidKernel/Memory.h"
 #include "MantidKernel/Strings.h"
 #include "MantidKernel/System.h"
 #include "MantidKernel/Utils.h"
 #include <boost/algorithm/string.hpp>
 
+#include <array>
+#include <memory>
+
 using Mantid::Kernel::CPUTimer;
 using Mantid::Kernel::EnabledWhenProperty;
 
@@ -31,12 +35,94 @@ using namespace Mantid::API;
 using namespace Mantid::Geometry;
 using namespace Mantid::DataObjects;
 
+namespace {
+/// The transformation to the output bin coordinates of an axis aligned
+/// binning, as done by the CoordTransformAligned of SlicingAlgorithm
+class AlignedTransform {
+public:
+  AlignedTransform(const std::vector<size_t> &dimensionToBinFrom,
+                   const std::vector<MDHistoDimension_sptr> &binDimensions)
+      : m_dimensionToBinFrom(dimensionToBinFrom),
+        m_origin(binDimensions.size()), m_scaling(binDimensions.size()) {
+    for (size_t d = 0; d < binDimensions.size(); d++) {
+      m_origin[d] = binDimensions[d]->getMinimum();
+      m_scaling[d] = 1.0f / binDimensions[d]->getBinWidth();
+    }
+  }
+  /// The coordinate of a point in an output dimension
+  coord_t operator()(const coord_t *inputVector, size_t out) const {
+    return (inputVector[m_dimensionToBinFrom[out]] - m_origin[out]) *
+           m_scaling[out];
+  }
+
+private:
+  std::vector<size_t> m_dimensionToBinFrom;
+  std::vector<coord_t> m_origin;
+  std::vector<coord_t> m_scaling;
+};
+
+/// The transformation to the output bin coordinates of a general binning,
+/// calculated as in CoordTransformAffine with the number of input dimensions
+/// known at compile time
+template <size_t nd> class AffineTransform {
+public:
+  explicit AffineTransform(const Matrix<coord_t> &matrix)
+      : m_rows(matrix.numRows()) {
+    if (matrix.numCols() != nd + 1)
+      throw std::runtime_error("The binning transformation does not match the "
+                               "dimensions of the input workspace.");
+    for (size_t out = 0; out < m_rows.size(); ++out) {
+      for (size_t in = 0; in <= nd; ++in) {
+        m_rows[out][in] = matrix[out][in];
+      }
+    }
+  }
+  /// The coordinate of a point in an output dimension
+  coord_t operator()(const coord_t *inputVector, size_t out) const {
+    const auto &row = m_rows[out];
+    coord_t outVal = 0.0;
+    for (size_t in = 0; in < nd; ++in)
+      outVal += row[in] * inputVector[in];
+    // The last input coordinate is "1" always
+    return outVal + row[nd];
+  }
+
+private:
+  std::vector<std::array<coord_t, nd + 1>> m_rows;
+};
+
+/**
+ * Find the leaf boxes touching an implicit function. The children of the top
+ * box are searched in parallel.
+ * @param topBox :: the top box of the workspace
+ * @param function :: the implicit function
+ * @param doParallel :: true to search in parallel
+ * @return the boxes, in the order given by IMDNode::getBoxes()
+ */
+std::vector<API::IMDNode *> getBoxesTouching(API::IMDNode *topBox,
+                                             MDImplicitFunction *function,
+                                             bool doParallel) {
+  // The children of the top box touching the function
+  std::vector<API::IMDNode *> children;
+  topBox->getBoxes(children, topBox->getDepth() + 1, true, function);
+  // Leaf-only; no depth limit
+  std::vector<std::vector<API::IMDNode *>> childBoxes(children.size());
+  PARALLEL_FOR_IF(doParallel)
+  for (int i = 0; i < static_cast<int>(children.size()); ++i) {
+    children[i]->getBoxes(childBoxes[i], 1000, true, function);
+  }
+  std::vector<API::IMDNode *> boxes;
+  for (const auto &leaves : childBoxes) {
+    boxes.insert(boxes.end(), leaves.begin(), leaves.end());
+  }
+  return boxes;
+}
+}
+
 //----------------------------------------------------------------------------------------------
 /** Constructor
  */
-BinMD::BinMD()
-    : outWS(), implicitFunction(nullptr), indexMultiplier(nullptr),
-      signals(nullptr), errors(nullptr), numEvents(nullptr) {}
+BinMD::BinMD() : outWS(), implicitFunction(nullptr) {}
 
 //----------------------------------------------------------------------------------------------
 /** Initialize the algorithm's properties.
@@ -69,9 +155,10 @@ void BinMD::init() {
 
   declareProperty(
       make_unique<PropertyWithValue<bool>>("Parallel", false, Direction::Input),
-      "Temporary parameter: true to run in parallel. This is ignored for "
-      "file-backed workspaces, where running in parallel makes things slower "
-      "due to disk thrashing.");
+      "Temporary parameter: true to run in parallel. Each thread sums the "
+      "events into its own copy of the output, as far as memory allows. This "
+      "is ignored for file-backed workspaces, where running in parallel makes "
+      "things slower due to disk thrashing.");
   setPropertyGroup("Parallel", grp);
 
   declareProperty(make_unique<WorkspaceProperty<IMDHistoWorkspace>>(
@@ -86,93 +173,74 @@ void BinMD::init() {
                   "A name for the output MDHistoWorkspace.");
 }
 
+//----------------------------------------------------------------------------------------------
+/** Find the bin of a point of the input workspace
+ *
+ * @param transform :: the transformation to the output coordinates
+ * @param center :: the coordinates of the point in the input workspace
+ * @param linearIndex :: set to the linear index of the bin
+ * @return true if the point is within the output workspace
+ */
+template <typename Transform>
+inline bool BinMD::getBinIndex(const Transform &transform,
+                               const coord_t *center,
+                               size_t &linearIndex) const {
+  linearIndex = 0;
+  /// Loop through the dimensions on which we bin
+  for (size_t bd = 0; bd < m_outD; bd++) {
+    // What is the bin index in that dimension
+    coord_t x = transform(center, bd);
+    size_t ix = size_t(x);
+    // Within range?
+    if (!(x >= 0) || ix >= binCounts[bd])
+      return false;
+    // Build up the linear index
+    linearIndex += indexMultiplier[bd] * ix;
+  }
+  return true;
+}
+
 //----------------------------------------------------------------------------------------------
 /** Bin the contents of a MDBox
  *
  * @param box :: pointer to the MDBox to bin
- * @param chunkMin :: the minimum index in each dimension to consider "valid"
- *(inclusive)
- * @param chunkMax :: the maximum index in each dimension to consider "valid"
- *(exclusive)
+ * @param transform :: the transformation to the output coordinates
+ * @param histogram :: the arrays to add the signal, errors and events to
  */
-template <typename MDE, size_t nd>
-inline void BinMD::binMDBox(MDBox<MDE, nd> *box, const size_t *const chunkMin,
-                            const size_t *const chunkMax) {
-  // An array to hold the rotated/transformed coordinates
-  auto outCenter = new coord_t[m_outD];
-
+template <typename MDE, size_t nd, typename Transform>
+inline void BinMD::binMDBox(MDBox<MDE, nd> *box, const Transform &transform,
+                            const Histogram &histogram) const {
   // Evaluate whether the entire box is in the same bin
   if (box->getNPoints() > (1 << nd) * 2) {
     // There is a check that the number of events is enough for it to make sense
     // to do all this processing.
     size_t numVertexes = 0;
-    coord_t *vertexes = box->getVertexesArray(numVertexes);
+    std::unique_ptr<coord_t[]> vertexes(box->getVertexesArray(numVertexes));
 
     // All vertexes have to be within THE SAME BIN = have the same linear index.
     size_t lastLinearIndex = 0;
     bool badOne = false;
 
-    for (size_t i = 0; i < numVertexes; i++) {
-      // Cache the center of the event (again for speed)
-      const coord_t *inCenter = vertexes + i * nd;
-
-      // Now transform to the output dimensions
-      m_transform->apply(inCenter, outCenter);
-      // std::cout << "Input coord " << VMD(nd,inCenter) << " transformed to "
-      // <<  VMD(nd,outCenter) << '\n';
-
-      // To build up the linear index
+    for (size_t i = 0; i < numVertexes && !badOne; i++) {
       size_t linearIndex = 0;
-      // To mark VERTEXES outside range
-      badOne = false;
-
-      /// Loop through the dimensions on which we bin
-      for (size_t bd = 0; bd < m_outD; bd++) {
-        // What is the bin index in that dimension
-        coord_t x = outCenter[bd];
-        size_t ix = size_t(x);
-        // Within range (for this chunk)?
-        if ((x >= 0) && (ix >= chunkMin[bd]) && (ix < chunkMax[bd])) {
-          // Build up the linear index
-          linearIndex += indexMultiplier[bd] * ix;
-        } else {
-          // Outside the range
-          badOne = true;
-          break;
-        }
-      } // (for each dim in MDHisto)
-
-      // Is the vertex at the same place as the last one?
-      if (!badOne) {
-        if ((i > 0) && (linearIndex != lastLinearIndex)) {
-          // Change of index
-          badOne = true;
-          break;
-        }
-        lastLinearIndex = linearIndex;
-      }
-
-      // Was the vertex completely outside the range?
-      if (badOne)
-        break;
+      // Outside the range, or at a different place than the last one?
+      badOne = !getBinIndex(transform, vertexes.get() + i * nd, linearIndex) ||
+               ((i > 0) && (linearIndex != lastLinearIndex));
+      lastLinearIndex = linearIndex;
     } // (for each vertex)
 
-    delete[] vertexes;
-
     if (!badOne) {
       // Yes, the entire box is within a single bin
-      //        std::cout << "Box at " << box->getExtentsStr() << " is within a
-      //        single bin.\n";
       // Add the CACHED signal from the entire box
-      signals[lastLinearIndex] += box->getSignal();
-      errors[lastLinearIndex] += box->getErrorSquared();
+      histogram.signals[lastLinearIndex] += box->getSignal();
+      histogram.errors[lastLinearIndex] += box->getErrorSquared();
       // TODO: If DataObjects get a weight, this would need to get the summed
       // weight.
-      numEvents[lastLinearIndex] += static_cast<signal_t>(box->getNPoints());
+      histogram.numEvents[lastLinearIndex] +=
+          static_cast<signal_t>(box->getNPoints());
 
       // And don't bother looking at each event. This may save lots of time
       // loading from disk.
-      delete[] outCenter;
       return;
     }
   }
@@ -182,46 +250,92 @@ inline void BinMD::binMDBox(MDBox<MDE, nd> *box, const size_t *const chunkMin,
   // So you need to iterate through events.
   const std::vector<MDE> &events = box->getConstEvents();
   for (auto it = events.begin(); it != events.end(); ++it) {
-    // Cache the center of the event (again for speed)
-    const coord_t *inCenter = it->getCenter();
-
-    // Now transform to the output dimensions
-    m_transform->apply(inCenter, outCenter);
-
-    // To build up the linear index
     size_t linearIndex = 0;
-    // To mark events outside range
-    bool badOne = false;
-
-    /// Loop through the dimensions on which we bin
-    for (size_t bd = 0; bd < m_outD; bd++) {
-      // What is the bin index in that dimension
-      coord_t x = outCenter[bd];
-      size_t ix = size_t(x);
-      // Within range (for this chunk)?
-      if ((x >= 0) && (ix >= chunkMin[bd]) && (ix < chunkMax[bd])) {
-        // Build up the linear index
-        linearIndex += indexMultiplier[bd] * ix;
-      } else {
-        // Outside the range
-        badOne = true;
-        break;
-      }
-    } // (for each dim in MDHisto)
-
-    if (!badOne) {
+    if (getBinIndex(transform, it->getCenter(), linearIndex)) {
       // Sum the signals as doubles to preserve precision
-      signals[linearIndex] += static_cast<signal_t>(it->getSignal());
-      errors[linearIndex] += static_cast<signal_t>(it->getErrorSquared());
+      histogram.signals[linearIndex] += static_cast<signal_t>(it->getSignal());
+      histogram.errors[linearIndex] +=
+          static_cast<signal_t>(it->getErrorSquared());
       // TODO: If DataObjects get a weight, this would need to get the summed
       // weight.
-      numEvents[linearIndex] += 1.0;
+      histogram.numEvents[linearIndex] += 1.0;
     }
   }
   // Done with the events list
   box->releaseEvents();
+}
 
-  delete[] outCenter;
+//----------------------------------------------------------------------------------------------
+/** Bin a list of MDBoxes into the output workspace. In parallel, every thread
+ * but the first sums into a histogram of its own, and these are added to the
+ * output workspace at the end, so the threads never write to the same bins.
+ *
+ * @param boxes :: the boxes to bin
+ * @param transform :: the transformation to the output coordinates
+ * @param doParallel :: true to run in parallel
+ */
+template <typename MDE, size_t nd, typename Transform>
+void BinMD::binBoxes(const std::vector<API::IMDNode *> &boxes,
+                     const Transform &transform, bool doParallel) {
+  const size_t nBins = outWS->getNPoints();
+
+  // Limit the number of threads so that the histograms of the threads take at
+  // most a quarter of the available memory (in kiB)
+  size_t nThreads = doParallel ? PARALLEL_GET_MAX_THREADS : 1;
+  if (nThreads > 1) {
+    MemoryStats memory;
+    const size_t histogramSize = 3 * nBins * sizeof(signal_t);
+    const size_t maxHistograms = memory.availMem() / 4 * 1024 / histogramSize;
+    nThreads = std::min(nThreads, maxHistograms + 1);
+  }
+  std::vector<std::vector<signal_t>> buffers(nThreads - 1);
+  std::vector<Histogram> histograms(nThreads);
+  histograms[0] = {outWS->getSignalArray(), outWS->getErrorSquaredArray(),
+                   outWS->getNumEventsArray()};
+
+  const auto numBoxes = static_cast<int64_t>(boxes.size());
+  PRAGMA_OMP(parallel num_threads(static_cast<int>(nThreads)) if (nThreads > 1))
+  {
+    const size_t thread = PARALLEL_THREAD_NUMBER;
+    if (thread > 0) {
+      // Allocated by the thread using it
+      auto &buffer = buffers[thread - 1];
+      buffer.assign(3 * nBins, 0.0);
+      histograms[thread] = {buffer.data(), buffer.data() + nBins,
+                            buffer.data() + 2 * nBins};
+    }
+
+    PRAGMA_OMP(for schedule(dynamic, 1))
+    for (int64_t i = 0; i < numBoxes; ++i) {
+      PARALLEL_START_INTERUPT_REGION
+      MDBox<MDE, nd> *box = dynamic_cast<MDBox<MDE, nd> *>(boxes[i]);
+      // Perform the binning in this separate method.
+      if (box && !box->getIsMasked())
+        this->binMDBox(box, transform, histograms[thread]);
+
+      // Progress reporting
+      if (prog)
+        prog->report();
+      PARALLEL_END_INTERUPT_REGION
+    } // for each box in parallel
+  }
+  PARALLEL_CHECK_INTERUPT_REGION
+
+  // Add the histograms of the other threads to the output
+  if (buffers.empty())
+    return;
+  const Histogram &out = histograms[0];
+  PARALLEL_FOR_IF(doParallel)
+  for (int64_t i = 0; i < static_cast<int64_t>(nBins); ++i) {
+    for (const auto &buffer : buffers) {
+      // Empty if the thread did not run
+      if (!buffer.empty()) {
+        out.signals[i] += buffer[i];
+        out.errors[i] += buffer[nBins + i];
+        out.numEvents[i] += buffer[2 * nBins + i];
+      }
+    }
+  }
 }
 
 //----------------------------------------------------------------------------------------------
@@ -233,133 +347,65 @@ inline void BinMD::binMDBox(MDBox<MDE, nd> *box, const size_t *const chunkMin,
 template <typename MDE, size_t nd>
 void BinMD::binByIterating(typename MDEventWorkspace<MDE, nd>::sptr ws) {
   BoxController_sptr bc = ws->getBoxController();
-  // store exisiting write buffer size for the future
-  // uint64_t writeBufSize =bc->getDiskBuffer().getWriteBufferSize();
-  // and disable write buffer (if any) for input MD Events for this algorithm
-  // purposes;
-  // bc->setCacheParameters(1,0);
 
   // Cache some data to speed up accessing them a bit
-  indexMultiplier = new size_t[m_outD];
+  indexMultiplier.resize(m_outD);
+  binCounts.resize(m_outD);
   for (size_t d = 0; d < m_outD; d++) {
     if (d > 0)
       indexMultiplier[d] = outWS->getIndexMultiplier()[d - 1];
     else
       indexMultiplier[d] = 1;
+    binCounts[d] = m_binDimensions[d]->getNBins();
   }
-  signals = outWS->getSignalArray();
-  errors = outWS->getErrorSquaredArray();
-  numEvents = outWS->getNumEventsArray();
 
   if (!m_accumulate) {
     // Start with signal/error/numEvents at 0.0
     outWS->setTo(0.0, 0.0, 0.0);
   }
 
-  // The dimension (in the output workspace) along which we chunk for parallel
-  // processing
-  // TODO: Find the smartest dimension to chunk against
-  size_t chunkDimension = 0;
-
-  // How many bins (in that dimension) per chunk.
-  // Try to split it so each core will get 2 tasks:
-  int chunkNumBins = int(m_binDimensions[chunkDimension]->getNBins() /
-                         (PARALLEL_GET_MAX_THREADS * 2));
-  if (chunkNumBins < 1)
-    chunkNumBins = 1;
-
   // Do we actually do it in parallel?
   bool doParallel = getProperty("Parallel");
   // Not if file-backed!
   if (bc->isFileBacked())
     doParallel = false;
-  if (!doParallel)
-    chunkNumBins = int(m_binDimensions[chunkDimension]->getNBins());
 
-  // Total number of steps
-  size_t progNumSteps = 0;
+  // Build an implicit function for the whole output workspace (it needs to be
+  // in the space of the MDEventWorkspace) and find the boxes touching it.
+  std::unique_ptr<MDImplicitFunction> function(
+      this->getImplicitFunctionForChunk(nullptr, nullptr));
+  std::vector<API::IMDNode *> boxes =
+      getBoxesTouching(ws->getBox(), function.get(), doParallel);
+
+  // Sort boxes by file position IF file backed. This reduces seeking time,
+  // hopefully.
+  if (bc->isFileBacked())
+    API::IMDNode::sortObjByID(boxes);
+
+  g_log.debug() << "Found " << boxes.size()
+                << " boxes within the implicit function.\n";
   if (prog) {
     prog->setNotifyStep(0.1);
-    prog->resetNumSteps(100, 0.00, 1.0);
+    prog->resetNumSteps(static_cast<int64_t>(boxes.size()), 0.00, 1.0);
   }
 
-  // Run the chunks in parallel. There is no overlap in the output workspace so
-  // it is thread safe to write to it..
-  // cppcheck-suppress syntaxError
-    PRAGMA_OMP( parallel for schedule(dynamic,1) if (doParallel) )
-    for (int chunk = 0;
-         chunk < int(m_binDimensions[chunkDimension]->getNBins());
-         chunk += chunkNumBins) {
-      PARALLEL_START_INTERUPT_REGION
-      // Region of interest for this chunk.
-      std::vector<size_t> chunkMin(m_outD);
-      std::vector<size_t> chunkMax(m_outD);
-      for (size_t bd = 0; bd < m_outD; bd++) {
-        // Same limits in the other dimensions
-        chunkMin[bd] = 0;
-        chunkMax[bd] = m_binDimensions[bd]->getNBins();
-      }
-      // Parcel out a chunk in that single dimension dimension
-      chunkMin[chunkDimension] = size_t(chunk);
-      if (size_t(chunk + chunkNumBins) >
-          m_binDimensions[chunkDimension]->getNBins())
-        chunkMax[chunkDimension] = m_binDimensions[chunkDimension]->getNBins();
-      else
-        chunkMax[chunkDimension] = size_t(chunk + chunkNumBins);
-
-      // Build an implicit function (it needs to be in the space of the
-      // MDEventWorkspace)
-      MDImplicitFunction *function =
-          this->getImplicitFunctionForChunk(chunkMin.data(), chunkMax.data());
-
-      // Use getBoxes() to get an array with a pointer to each box
-      std::vector<API::IMDNode *> boxes;
-      // Leaf-only; no depth limit; with the implicit function passed to it.
-      ws->getBox()->getBoxes(boxes, 1000, true, function);
-
-      // Sort boxes by file position IF file backed. This reduces seeking time,
-      // hopefully.
-      if (bc->isFileBacked())
-        API::IMDNode::sortObjByID(boxes);
-
-      // For progress reporting, the # of boxes
-      if (prog) {
-        PARALLEL_CRITICAL(BinMD_progress) {
-          g_log.debug() << "Chunk " << chunk << ": found " << boxes.size()
-                        << " boxes within the implicit function.\n";
-          progNumSteps += boxes.size();
-          prog->setNumSteps(progNumSteps);
-        }
-      }
-
-      // Go through every box for this chunk.
-      for (auto &boxe : boxes) {
-        MDBox<MDE, nd> *box = dynamic_cast<MDBox<MDE, nd> *>(boxe);
-        // Perform the binning in this separate method.
-        if (box && !box->getIsMasked())
-          this->binMDBox(box, chunkMin.data(), chunkMax.data());
-
-        // Progress reporting
-        if (prog)
-          prog->report();
-        // For early cancelling of the loop
-        if (this->m_cancel)
-          break;
-      } // for each box in the vector
-      PARALLEL_END_INTERUPT_REGION
-    } // for each chunk in parallel
-    PARALLEL_CHECK_INTERUPT_REGION
-
-    // Now the implicit function
-    if (implicitFunction) {
-      if (prog)
-        prog->report("Applying implicit function.");
-      signal_t nan = std::numeric_limits<signal_t>::quiet_NaN();
-      outWS->applyImplicitFunction(implicitFunction, nan, nan);
-    }
-
-    // return the size of the input workspace write buffer to its initial value
-    // bc->setCacheParameters(sizeof(MDE),writeBufSize);
+  // Both kinds of transformation are inlined into the loops over the events
+  if (m_axisAligned)
+    binBoxes<MDE, nd>(boxes, AlignedTransform(m_dimensionToBinFrom,
+                                              m_binDimensions),
+                      doParallel);
+  else
+    binBoxes<MDE, nd>(boxes,
+                      AffineTransform<nd>(m_transform->makeAffineMatrix()),
+                      doParallel);
+
+  // Now the implicit function
+  if (implicitFunction) {
+    if (prog)
+      prog->report("Applying implicit function.");
+    signal_t nan = std::numeric_limits<signal_t>::quiet_NaN();
+    outWS->applyImplicitFunction(implicitFunction, nan, nan);
+  }
 }
 
 //----------------------------------------------------------------------------------------------
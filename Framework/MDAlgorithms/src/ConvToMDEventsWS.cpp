@@ -1,13 +1,23 @@
 #include "MantidMDAlgorithms/ConvToMDEventsWS.h"
+#include "MantidKernel/MultiThreaded.h"
+#include "MantidKernel/ThreadSchedulerWorkStealing.h"
 
 #include "MantidMDAlgorithms/UnitsConversionHelper.h"
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
+
 namespace Mantid {
 namespace MDAlgorithms {
 /**function converts particular list of events of type T into MD workspace and
- * adds these events to the workspace itself  */
+ * adds these events to the workspace itself
+ * @param workspaceIndex -- the index of the spectrum to convert
+ * @param qConverter     -- the coordinate converter, which keeps the state of
+ *                          the spectrum and so must not be shared by threads */
 template <class T>
-size_t ConvToMDEventsWS::convertEventList(size_t workspaceIndex) {
+size_t ConvToMDEventsWS::convertEventList(size_t workspaceIndex,
+                                          MDTransfInterface &qConverter) {
 
   const Mantid::DataObjects::EventList &el =
       m_EventWS->getSpectrum(workspaceIndex);
@@ -24,7 +34,7 @@ size_t ConvToMDEventsWS::convertEventList(size_t workspaceIndex) {
   std::vector<coord_t> locCoord(m_Coord);
   // set up unit conversion and calculate up all coordinates, which depend on
   // spectra index only
-  if (!m_QConverter->calcYDepCoordinates(locCoord, workspaceIndex))
+  if (!qConverter.calcYDepCoordinates(locCoord, workspaceIndex))
     return 0; // skip if any y outsize of the range of interest;
   localUnitConv.updateConversion(workspaceIndex);
   //
@@ -46,12 +56,19 @@ size_t ConvToMDEventsWS::convertEventList(size_t workspaceIndex) {
   getEventsFrom(el, events_ptr);
   const typename std::vector<T> &events = *events_ptr;
 
+  // Convert the units of all the events of the list at once
+  std::vector<double> values(numEvents);
+  std::transform(events.cbegin(), events.cend(), values.begin(),
+                 [](const T &event) { return event.tof(); });
+  localUnitConv.convertUnits(values.data(), values.data() + values.size());
+
   // Iterators to start/end
-  for (auto it = events.cbegin(); it != events.cend(); it++) {
-    double val = localUnitConv.convertUnits(it->tof());
+  auto value = values.cbegin();
+  for (auto it = events.cbegin(); it != events.cend(); it++, value++) {
+    double val = *value;
     double signal = it->weight();
     double errorSq = it->errorSquared();
-    if (!m_QConverter->calcMatrixCoord(val, locCoord, signal, errorSq))
+    if (!qConverter.calcMatrixCoord(val, locCoord, signal, errorSq))
       continue; // skip ND outside the range
 
     sig_err.push_back(static_cast<float>(signal));
@@ -71,17 +88,24 @@ size_t ConvToMDEventsWS::convertEventList(size_t workspaceIndex) {
 /** The method runs conversion for a single event list, corresponding to a
  * particular workspace index */
 size_t ConvToMDEventsWS::conversionChunk(size_t workspaceIndex) {
+  return convertSpectrum(workspaceIndex, *m_QConverter);
+}
+
+/** The method runs conversion for a single event list with the given
+ * coordinate converter */
+size_t ConvToMDEventsWS::convertSpectrum(size_t workspaceIndex,
+                                         MDTransfInterface &qConverter) {
 
   switch (m_EventWS->getSpectrum(workspaceIndex).getEventType()) {
   case Mantid::API::TOF:
-    return this->convertEventList<Mantid::DataObjects::TofEvent>(
-        workspaceIndex);
+    return this->convertEventList<Mantid::DataObjects::TofEvent>(workspaceIndex,
+                                                                 qConverter);
   case Mantid::API::WEIGHTED:
     return this->convertEventList<Mantid::DataObjects::WeightedEvent>(
-        workspaceIndex);
+        workspaceIndex, qConverter);
   case Mantid::API::WEIGHTED_NOTIME:
     return this->convertEventList<Mantid::DataObjects::WeightedEventNoTime>(
-        workspaceIndex);
+        workspaceIndex, qConverter);
   default:
     throw std::runtime_error("EventList had an unexpected data type!");
   }
@@ -125,7 +149,7 @@ void ConvToMDEventsWS::runConversion(API::Progress *pProgress) {
   size_t nValidSpectra = m_NSpectra;
 
   //--->>> Thread control stuff
-  Kernel::ThreadSchedulerFIFO *ts(nullptr);
+  Kernel::ThreadSchedulerWorkStealing *ts(nullptr);
 
   int nThreads(m_NumThreads);
   if (nThreads < 0)
@@ -136,7 +160,10 @@ void ConvToMDEventsWS::runConversion(API::Progress *pProgress) {
     runMultithreaded = true;
     // Create the thread pool that will run all of these. It will be deleted by
     // the threadpool
-    ts = new Kernel::ThreadSchedulerFIFO();
+    // Box splitting tasks push their children from within the pool, which
+    // stay on the same thread with a work stealing scheduler.
+    ts = nThreads > 0 ? new Kernel::ThreadSchedulerWorkStealing(nThreads)
+                      : new Kernel::ThreadSchedulerWorkStealing();
     // it will initiate thread pool with number threads or machine's cores (0 in
     // tp constructor)
     pProgress->resetNumSteps(nValidSpectra, 0, 1);
@@ -149,12 +176,52 @@ void ConvToMDEventsWS::runConversion(API::Progress *pProgress) {
   if (!m_QConverter->calcGenericVariables(m_Coord, m_NDims))
     return;
 
+  // The coordinate converters keep the state of the spectrum being converted,
+  // so each thread gets its own copy
+  const int nConvertThreads =
+      nThreads > 0 ? nThreads : PARALLEL_GET_MAX_THREADS;
+  std::vector<MDTransf_sptr> qConverters(nConvertThreads);
+  for (auto &qConverter : qConverters)
+    qConverter.reset(m_QConverter->clone());
+
   size_t eventsAdded = 0;
-  for (size_t wi = 0; wi < nValidSpectra; wi++) {
+  for (size_t wi = 0; wi < nValidSpectra;) {
+    // Take a block of spectra with about as many events as may be added
+    // before the boxes have to be split again
+    size_t blockEnd = wi;
+    size_t eventsInBlock = 0;
+    while (blockEnd < nValidSpectra &&
+           !bc->shouldSplitBoxes(nEventsInWS, eventsAdded + eventsInBlock,
+                                 lastNumBoxes)) {
+      eventsInBlock += m_EventWS->getSpectrum(blockEnd).getNumberEvents();
+      ++blockEnd;
+    }
+    blockEnd = std::max(blockEnd, wi + 1);
 
-    size_t nConverted = this->conversionChunk(wi);
+    // Convert the spectra of the block concurrently. Each thread fills its own
+    // buffers and adds them to the boxes in one batch.
+    std::atomic<size_t> nConverted(0);
+    std::exception_ptr exception;
+    const auto first = static_cast<int64_t>(wi);
+    const auto last = static_cast<int64_t>(blockEnd);
+    PRAGMA_OMP(parallel for num_threads(nConvertThreads) if (runMultithreaded))
+    for (int64_t i = first; i < last; ++i) {
+      try {
+        nConverted += this->convertSpectrum(
+            static_cast<size_t>(i), *qConverters[PARALLEL_THREAD_NUMBER]);
+      } catch (...) {
+        PARALLEL_CRITICAL(ConvToMDEventsWS_exception) {
+          if (!exception)
+            exception = std::current_exception();
+        }
+      }
+    }
+    if (exception)
+      std::rethrow_exception(exception);
     eventsAdded += nConverted;
     nEventsInWS += nConverted;
+    wi = blockEnd;
+
     // Keep a running total of how many events we've added
     if (bc->shouldSplitBoxes(nEventsInWS, eventsAdded, lastNumBoxes)) {
       if (runMultithreaded) {
@@ -88,11 +88,14 @@ void MDEventWSWrapper::addMDDataND(float *sigErr, uint16_t *runIndex,
           DataObjects::MDEventWorkspace<DataObjects::MDEvent<nd>, nd> *>(
           m_Workspace.get());
   if (pWs) {
+    // Add the events as one batch so that each box is locked only once
+    std::vector<DataObjects::MDEvent<nd>> events;
+    events.reserve(dataSize);
     for (size_t i = 0; i < dataSize; i++) {
-      pWs->addEvent(DataObjects::MDEvent<nd>(
-          *(sigErr + 2 * i), *(sigErr + 2 * i + 1), *(runIndex + i),
-          *(detId + i), (Coord + i * nd)));
+      events.emplace_back(*(sigErr + 2 * i), *(sigErr + 2 * i + 1),
+                          *(runIndex + i), *(detId + i), (Coord + i * nd));
     }
+    pWs->addEvents(events);
   } else {
     DataObjects::MDEventWorkspace<DataObjects::MDLeanEvent<nd>, nd> *const
         pLWs = dynamic_cast<
@@ -104,10 +107,13 @@ void MDEventWSWrapper::addMDDataND(float *sigErr, uint16_t *runIndex,
                                "does not correspond to type of events you try "
                                "to add to it");
 
+    std::vector<DataObjects::MDLeanEvent<nd>> events;
+    events.reserve(dataSize);
     for (size_t i = 0; i < dataSize; i++) {
-      pLWs->addEvent(DataObjects::MDLeanEvent<nd>(
-          *(sigErr + 2 * i), *(sigErr + 2 * i + 1), (Coord + i * nd)));
+      events.emplace_back(*(sigErr + 2 * i), *(sigErr + 2 * i + 1),
+                          (Coord + i * nd));
     }
+    pLWs->addEvents(events);
   }
 }
 
@@ -261,10 +261,9 @@ void MergeMDFiles::doExecByCloning(Mantid::API::IMDEventWorkspace_sptr ws,
     if (DiskBuf) {
       if (box->getDataInMemorySize() >
           0) { // data position has been already pre-calculated
-        box->getISaveable()->save();
-        box->clearDataFromMemory();
-        // Kernel::ISaveable *Saver = box->getISaveable();
-        // DiskBuf->toWrite(Saver);
+        // The box is complete, so it is written by the disk buffer's I/O
+        // thread while the next box is loaded
+        DiskBuf->writeAsync(box->getISaveable());
       }
     }
     // else
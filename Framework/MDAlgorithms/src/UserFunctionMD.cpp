@@ -2,8 +2,13 @@
 // Includes
 //----------------------------------------------------------------------
 #include "MantidMDAlgorithms/UserFunctionMD.h"
+#include "MantidAPI/FunctionDomainMD.h"
 #include "MantidAPI/FunctionFactory.h"
+#include "MantidAPI/FunctionValues.h"
+#include "MantidAPI/IMDIterator.h"
+#include "MantidAPI/Jacobian.h"
 #include "MantidKernel/MultiThreaded.h"
+#include "MantidKernel/make_unique.h"
 
 #include <boost/tokenizer.hpp>
 
@@ -99,6 +104,93 @@ double UserFunctionMD::functionMD(const API::IMDIterator &r) const {
   }
   return val;
 }
+
+/**
+ * Evaluate the function at all points of an MD domain.
+ * @param domain :: A FunctionDomainMD.
+ * @param values :: Receives the values of the function.
+ */
+void UserFunctionMD::function(const API::FunctionDomain &domain,
+                              API::FunctionValues &values) const {
+  if (!m_compiled) {
+    IFunctionMD::function(domain, values);
+    return;
+  }
+  const auto points = coordinates(domain);
+  m_compiled->evaluate(arguments(points), values.getPointerToCalculated(0),
+                       domain.size());
+}
+
+/**
+ * Calculate the derivatives with respect to the parameters.
+ * @param domain :: A FunctionDomainMD.
+ * @param jacobian :: Receives the derivatives.
+ */
+void UserFunctionMD::functionDeriv(const API::FunctionDomain &domain,
+                                   API::Jacobian &jacobian) {
+  if (!m_compiled) {
+    IFunctionMD::functionDeriv(domain, jacobian);
+    return;
+  }
+  const auto points = coordinates(domain);
+  const auto values = arguments(points);
+  std::vector<double> derivative(domain.size());
+  for (size_t ip = 0; ip < m_derivatives.size(); ++ip) {
+    m_derivatives[ip].evaluate(values, derivative.data(), derivative.size());
+    for (size_t i = 0; i < derivative.size(); ++i) {
+      jacobian.set(i, ip, derivative[i]);
+    }
+  }
+}
+
+/**
+ * Collect the centres of the boxes of an MD domain.
+ * @param domain :: A FunctionDomainMD.
+ * @return The coordinates of the centres along each of the used dimensions.
+ */
+std::vector<std::vector<double>>
+UserFunctionMD::coordinates(const API::FunctionDomain &domain) const {
+  const auto dmd = dynamic_cast<const API::FunctionDomainMD *>(&domain);
+  if (!dmd) {
+    throw std::invalid_argument("Unexpected domain in UserFunctionMD");
+  }
+  std::vector<std::vector<double>> result(m_dimensions.size());
+  for (auto &values : result) {
+    values.reserve(domain.size());
+  }
+  dmd->reset();
+  for (auto r = dmd->getNextIterator(); r != nullptr;
+       r = dmd->getNextIterator()) {
+    const Kernel::VMD center = r->getCenter();
+    for (size_t i = 0; i < result.size(); ++i) {
+      result[i].push_back(center[i]);
+    }
+  }
+  return result;
+}
+
+/**
+ * @param coordinates :: The coordinates of the points.
+ * @return The arguments of the compiled formula: the variables followed by
+ * the parameters.
+ */
+std::vector<API::CompiledExpression::Argument> UserFunctionMD::arguments(
+    const std::vector<std::vector<double>> &coordinates) const {
+  std::vector<API::CompiledExpression::Argument> result;
+  for (size_t i = 0; i < m_vars.size(); ++i) {
+    // Variables of dimensions the workspace does not have are 0
+    if (i < coordinates.size()) {
+      result.push_back({coordinates[i].data(), 0.0});
+    } else {
+      result.push_back({nullptr, m_vars[i]});
+    }
+  }
+  for (size_t i = 0; i < nParams(); ++i) {
+    result.push_back({nullptr, getParameter(i)});
+  }
+  return result;
+}
+
 /** Static callback function used by MuParser to initialize variables implicitly
 @param varName :: The name of a new variable
 @param pufun :: Pointer to the function
@@ -147,6 +239,24 @@ void UserFunctionMD::setFormula() {
   }
 
   m_parser.SetExpr(m_formula);
+
+  // Formulas using only the operations CompiledExpression supports are
+  // evaluated for all points at once and get analytical derivatives
+  m_compiled.reset();
+  m_derivatives.clear();
+  auto variables = m_varNames;
+  for (size_t i = 0; i < nParams(); i++) {
+    variables.push_back(parameterName(i));
+  }
+  try {
+    m_compiled =
+        Kernel::make_unique<API::CompiledExpression>(m_formula, variables);
+  } catch (std::invalid_argument &) {
+    return;
+  }
+  for (size_t i = 0; i < nParams(); i++) {
+    m_derivatives.push_back(m_compiled->derivative(m_varNames.size() + i));
+  }
 }
 
 } // namespace MDAlgorithms
@@ -1003,6 +1003,46 @@ public:
                binned->allBasisNormalized());
   }
 
+  void test_parallel_binning_gives_same_result_as_serial() {
+    do_prepare_comparison();
+    for (const std::string parallel : {"0", "1"}) {
+      const std::string aligned = "aligned" + parallel;
+      const std::string rotated = "rotated" + parallel;
+      FrameworkManager::Instance().exec(
+          "BinMD", 12, "InputWorkspace", "mdew", "OutputWorkspace",
+          aligned.c_str(), "AxisAligned", "1", "AlignedDim0", "x, -8, 9, 17",
+          "AlignedDim1", "y, -10, 10, 13", "Parallel", parallel.c_str());
+      FrameworkManager::Instance().exec(
+          "BinMD", 18, "InputWorkspace", "mdew", "OutputWorkspace",
+          rotated.c_str(), "AxisAligned", "0", "BasisVector0",
+          "rx,m, 0.8,0.6", "BasisVector1", "ry,m, -0.6,0.8", "OutputExtents",
+          "-12,12, -12,12", "OutputBins", "15,21", "Parallel",
+          parallel.c_str());
+    }
+    for (const std::string name : {"aligned", "rotated"}) {
+      auto serial =
+          AnalysisDataService::Instance().retrieveWS<MDHistoWorkspace>(name +
+                                                                       "0");
+      auto parallel =
+          AnalysisDataService::Instance().retrieveWS<MDHistoWorkspace>(name +
+                                                                       "1");
+      TS_ASSERT_EQUALS(serial->getNPoints(), parallel->getNPoints());
+      double total = 0.0;
+      for (size_t i = 0; i < serial->getNPoints(); i++) {
+        TS_ASSERT_DELTA(serial->getSignalAt(i), parallel->getSignalAt(i),
+                        1e-10);
+        TS_ASSERT_DELTA(serial->getErrorAt(i), parallel->getErrorAt(i),
+                        1e-10);
+        TS_ASSERT_DELTA(serial->getNumEventsAt(i),
+                        parallel->getNumEventsAt(i), 1e-10);
+        total += serial->getNumEventsAt(i);
+      }
+      TS_ASSERT_LESS_THAN(0.0, total);
+      AnalysisDataService::Instance().remove(name + "0");
+      AnalysisDataService::Instance().remove(name + "1");
+    }
+  }
+
   void test_filebackend_and_unrecognised_instrument() {
     // The algorithm should still successfully execute, even if the workspace is
     // file-backed and the named instrument doesn't exist
@@ -1124,7 +1164,8 @@ public:
     AnalysisDataService::Instance().remove("BinMDTest_ws");
   }
 
-  void do_test(std::string binParams, bool IterateEvents) {
+  void do_test(std::string binParams, bool IterateEvents,
+               bool parallel = false) {
     BinMD alg;
     TS_ASSERT_THROWS_NOTHING(alg.initialize())
     TS_ASSERT(alg.isInitialized())
@@ -1138,6 +1179,7 @@ public:
         alg.setPropertyValue("AlignedDim2", "Axis2," + binParams));
     TS_ASSERT_THROWS_NOTHING(alg.setPropertyValue("AlignedDim3", ""));
     TS_ASSERT_THROWS_NOTHING(alg.setProperty("IterateEvents", IterateEvents));
+    TS_ASSERT_THROWS_NOTHING(alg.setProperty("Parallel", parallel));
     TS_ASSERT_THROWS_NOTHING(
         alg.setPropertyValue("OutputWorkspace", "BinMDTest_ws_histo"));
     TS_ASSERT_THROWS_NOTHING(alg.execute();)
@@ -1158,6 +1200,27 @@ public:
     for (size_t i = 0; i < 1; i++)
       do_test("2.0,8.0, 1", true);
   }
+
+  void test_3D_60cube_IterateEvents_Parallel() {
+    do_test("2.0,8.0, 60", true, true);
+  }
+
+  void test_3D_60cube_nonAligned_Parallel() {
+    BinMD alg;
+    TS_ASSERT_THROWS_NOTHING(alg.initialize())
+    alg.setPropertyValue("InputWorkspace", "BinMDTest_ws");
+    alg.setProperty("AxisAligned", false);
+    alg.setPropertyValue("BasisVector0", "rx,m, 0.8,0.6,0.0");
+    alg.setPropertyValue("BasisVector1", "ry,m, -0.6,0.8,0.0");
+    alg.setPropertyValue("BasisVector2", "rz,m, 0.0,0.0,1.0");
+    alg.setPropertyValue("Translation", "5.0,5.0,5.0");
+    alg.setPropertyValue("OutputExtents", "-3,3, -3,3, -3,3");
+    alg.setPropertyValue("OutputBins", "60,60,60");
+    alg.setProperty("Parallel", true);
+    alg.setPropertyValue("OutputWorkspace", "BinMDTest_ws_histo");
+    TS_ASSERT_THROWS_NOTHING(alg.execute();)
+    TS_ASSERT(alg.isExecuted());
+  }
 };
 
 #endif /* MANTID_MDALGORITHMS_BINTOMDHISTOWORKSPACETEST_H_ */
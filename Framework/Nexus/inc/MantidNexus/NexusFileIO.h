@@ -387,23 +387,17 @@ void NexusFileIO::writeNumericTimeLog(
   if (ipos != std::string::npos)
     logName = logName.substr(ipos + 1);
   // extract values from timeseries
-  std::map<Kernel::DateAndTime, T> dV = timeSeries->valueAsMap();
-  std::vector<double> values;
+  std::vector<Kernel::DateAndTime> changeTimes;
+  std::vector<T> changeValues;
+  timeSeries->valueChangesAsVectors(changeTimes, changeValues);
+  std::vector<double> values(changeValues.begin(), changeValues.end());
   std::vector<double> times;
+  times.reserve(changeTimes.size());
   Kernel::DateAndTime t0;
-  bool first = true;
-  for (typename std::map<Kernel::DateAndTime, T>::const_iterator dv =
-           dV.begin();
-       dv != dV.end(); dv++) {
-    T val = dv->second;
-    Kernel::DateAndTime time = dv->first;
-    values.push_back(val);
-    if (first) {
-      t0 = time; // start time of log
-      first = false;
-    }
+  if (!changeTimes.empty())
+    t0 = changeTimes.front(); // start time of log
+  for (const auto &time : changeTimes)
     times.push_back(Kernel::DateAndTime::secondsFromDuration(time - t0));
-  }
   // create log
   status = NXmakegroup(fileID, logName.c_str(), "NXlog");
   if (status == NX_ERROR)
@@ -4,6 +4,8 @@
 #include "MantidParallel/Communicator.h"
 #include "MantidParallel/DllConfig.h"
 
+#include <utility>
+
 #ifdef MPI_EXPERIMENTAL
 #include <boost/mpi/collectives.hpp>
 #endif
@@ -11,9 +13,9 @@
 namespace Mantid {
 namespace Parallel {
 
-/** Wrapper for boost::mpi::gather and other collective communication. For
-  non-MPI builds an equivalent implementation with reduced functionality is
-  provided.
+/** Wrapper for boost::mpi::gather, boost::mpi::reduce and other collective
+  communication. For non-MPI builds an equivalent implementation with reduced
+  functionality is provided.
 
   @author Simon Heybrock
   @date 2017
@@ -68,6 +70,56 @@ void gather(const Communicator &comm, const T &in_value, int root) {
         "Parallel::gather on root rank without output argument.");
   }
 }
+
+template <typename T, typename Op>
+void reduce(const Communicator &comm, const T &in_value, T &out_value, Op op,
+            int root) {
+  int tag{0};
+  if (comm.rank() != root) {
+    comm.send(root, tag, in_value);
+  } else {
+    // Combine the values in the order of the ranks, like MPI_Reduce
+    T result;
+    for (int rank = 0; rank < comm.size(); ++rank) {
+      T value;
+      if (rank == root)
+        value = in_value;
+      else
+        comm.recv(rank, tag, value);
+      result = rank == 0 ? std::move(value) : op(result, value);
+    }
+    out_value = std::move(result);
+  }
+}
+
+template <typename T, typename Op>
+void reduce(const Communicator &comm, const T &in_value, Op op, int root) {
+  int tag{0};
+  if (comm.rank() != root) {
+    comm.send(root, tag, in_value);
+  } else {
+    throw std::logic_error(
+        "Parallel::reduce on root rank without output argument.");
+  }
+}
+
+template <typename T, typename Op>
+void all_reduce(const Communicator &comm, const T &in_value, T &out_value,
+                Op op) {
+  int tag{0};
+  const int root{0};
+  T result;
+  reduce(comm, in_value, result, op, root);
+  if (comm.rank() == root) {
+    for (int rank = 0; rank < comm.size(); ++rank) {
+      if (rank != root)
+        comm.send(rank, tag, result);
+    }
+  } else {
+    comm.recv(root, tag, result);
+  }
+  out_value = std::move(result);
+}
 }
 
 template <typename... T> void gather(const Communicator &comm, T &&... args) {
@@ -78,6 +130,23 @@ template <typename... T> void gather(const Communicator &comm, T &&... args) {
   detail::gather(comm, std::forward<T>(args)...);
 }
 
+template <typename... T> void reduce(const Communicator &comm, T &&... args) {
+#ifdef MPI_EXPERIMENTAL
+  if (!comm.hasBackend())
+    return boost::mpi::reduce(comm, std::forward<T>(args)...);
+#endif
+  detail::reduce(comm, std::forward<T>(args)...);
+}
+
+template <typename... T>
+void all_reduce(const Communicator &comm, T &&... args) {
+#ifdef MPI_EXPERIMENTAL
+  if (!comm.hasBackend())
+    return boost::mpi::all_reduce(comm, std::forward<T>(args)...);
+#endif
+  detail::all_reduce(comm, std::forward<T>(args)...);
+}
+
 } // namespace Parallel
 } // namespace Mantid
 
@@ -6,6 +6,8 @@
 #include "MantidParallel/Collectives.h"
 #include "MantidTestHelpers/ParallelRunner.h"
 
+#include <boost/serialization/vector.hpp>
+
 using namespace Mantid;
 using namespace Parallel;
 
@@ -39,6 +41,49 @@ void run_gather_short_version(const Communicator &comm) {
     TS_ASSERT_THROWS_NOTHING(Parallel::gather(comm, value, root));
   }
 }
+
+void run_reduce(const Communicator &comm) {
+  int root = 1 % comm.size();
+  std::vector<double> value{1.0, static_cast<double>(comm.rank())};
+  std::vector<double> result;
+  auto add = [](const std::vector<double> &a, const std::vector<double> &b) {
+    return std::vector<double>{a[0] + b[0], a[1] + b[1]};
+  };
+  TS_ASSERT_THROWS_NOTHING(Parallel::reduce(comm, value, result, add, root));
+  if (comm.rank() == root) {
+    TS_ASSERT_EQUALS(result.size(), 2);
+    TS_ASSERT_EQUALS(result[0], comm.size());
+    TS_ASSERT_EQUALS(result[1], comm.size() * (comm.size() - 1) / 2);
+  } else {
+    TS_ASSERT(result.empty());
+  }
+}
+
+void run_reduce_ordering(const Communicator &comm) {
+  // The operation is not commutative, values are combined in rank order
+  std::string value = std::to_string(comm.rank());
+  std::string result;
+  auto concatenate = [](const std::string &a, const std::string &b) {
+    return a + b;
+  };
+  if (comm.rank() == 0) {
+    Parallel::reduce(comm, value, result, concatenate, 0);
+    std::string expected;
+    for (int rank = 0; rank < comm.size(); ++rank)
+      expected += std::to_string(rank);
+    TS_ASSERT_EQUALS(result, expected);
+  } else {
+    TS_ASSERT_THROWS_NOTHING(Parallel::reduce(comm, value, concatenate, 0));
+  }
+}
+
+void run_all_reduce(const Communicator &comm) {
+  int value = comm.rank() + 1;
+  int result{0};
+  TS_ASSERT_THROWS_NOTHING(Parallel::all_reduce(
+      comm, value, result, [](int a, int b) { return std::max(a, b); }));
+  TS_ASSERT_EQUALS(result, comm.size());
+}
 }
 
 class CollectivesTest : public CxxTest::TestSuite {
@@ -53,6 +98,14 @@ public:
   void test_gather_short_version() {
     ParallelTestHelpers::runParallel(run_gather_short_version);
   }
+
+  void test_reduce() { ParallelTestHelpers::runParallel(run_reduce); }
+
+  void test_reduce_ordering() {
+    ParallelTestHelpers::runParallel(run_reduce_ordering);
+  }
+
+  void test_all_reduce() { ParallelTestHelpers::runParallel(run_all_reduce); }
 };
 
 #endif /* MANTID_PARALLEL_COLLECTIVESTEST_H_ */
@@ -6,6 +6,7 @@ from __future__ import (absolute_import, division,
 
 from ._api import (FrameworkManagerImpl, AnalysisDataServiceImpl,
                    AlgorithmFactoryImpl, AlgorithmManagerImpl,
+                   AlgorithmProfilerImpl,
                    FileFinderImpl, FileLoaderRegistryImpl, FunctionFactoryImpl,
                    WorkspaceFactoryImpl, CatalogManagerImpl)
 
@@ -18,6 +19,7 @@ AnalysisDataService = AnalysisDataServiceImpl.Instance()
 mtd = AnalysisDataService #tradition
 AlgorithmFactory = AlgorithmFactoryImpl.Instance()
 AlgorithmManager = AlgorithmManagerImpl.Instance()
+AlgorithmProfiler = AlgorithmProfilerImpl.Instance()
 FileFinder = FileFinderImpl.Instance()
 FileLoaderRegistry = FileLoaderRegistryImpl.Instance()
 FunctionFactory = FunctionFactoryImpl.Instance()
@@ -0,0 +1,62 @@
+#include "MantidAPI/AlgorithmProfiler.h"
+
+#include <boost/python/class.hpp>
+#include <boost/python/dict.hpp>
+#include <boost/python/list.hpp>
+
+using namespace Mantid::API;
+using namespace boost::python;
+
+namespace {
+/**
+ * @param self A reference to the calling object
+ * @return A python list with a dictionary for each recorded execution, in
+ * order of completion
+ */
+list profiles(AlgorithmProfilerImpl &self) {
+  list records;
+  for (const auto &profile : self.profiles()) {
+    dict record;
+    record["name"] = profile.name;
+    record["version"] = profile.version;
+    record["depth"] = profile.depth;
+    record["thread"] = profile.thread;
+    record["start"] = profile.start;
+    record["wall_time"] = profile.wallTime;
+    record["validation_time"] = profile.validationTime;
+    record["exec_time"] = profile.execTime;
+    record["finalise_time"] = profile.finaliseTime;
+    record["memory_change_kib"] = profile.memoryChange;
+    record["peak_memory_increase_kib"] = profile.peakMemoryIncrease;
+    record["cow_copies"] = profile.cowCopies;
+    record["cow_copied_bytes"] = profile.cowCopiedBytes;
+    records.append(record);
+  }
+  return records;
+}
+}
+
+void export_AlgorithmProfiler() {
+  class_<AlgorithmProfilerImpl, boost::noncopyable>("AlgorithmProfilerImpl",
+                                                    no_init)
+      .def("start", &AlgorithmProfilerImpl::start, arg("self"),
+           "Start recording algorithm executions")
+      .def("stop", &AlgorithmProfilerImpl::stop, arg("self"),
+           "Stop recording algorithm executions")
+      .def("clear", &AlgorithmProfilerImpl::clear, arg("self"),
+           "Discard all the recorded executions")
+      .def("isRunning", &AlgorithmProfilerImpl::isRunning, arg("self"),
+           "Returns True if algorithm executions are being recorded")
+      .def("profiles", &profiles, arg("self"),
+           "Returns a list of dictionaries with the name, version, depth, "
+           "thread, start, wall_time, validation_time, exec_time, "
+           "finalise_time, memory_change_kib, peak_memory_increase_kib, "
+           "cow_copies and cow_copied_bytes of each recorded execution")
+      .def("saveChromeTrace", &AlgorithmProfilerImpl::saveChromeTrace,
+           (arg("self"), arg("filename")),
+           "Save the recorded executions as a Chrome trace file")
+      .def("Instance", &AlgorithmProfiler::Instance,
+           return_value_policy<reference_existing_object>(),
+           "Return a reference to the singleton instance")
+      .staticmethod("Instance");
+}
@@ -0,0 +1,63 @@
+from __future__ import (absolute_import, division, print_function)
+
+import unittest
+import json
+import os
+import tempfile
+from mantid.api import AlgorithmProfiler, AnalysisDataService
+from mantid.simpleapi import CreateSampleWorkspace, Rebin
+
+
+class AlgorithmProfilerTest(unittest.TestCase):
+
+    def setUp(self):
+        AlgorithmProfiler.clear()
+
+    def tearDown(self):
+        AlgorithmProfiler.stop()
+        AlgorithmProfiler.clear()
+        AnalysisDataService.clear()
+
+    def test_nothing_is_recorded_when_stopped(self):
+        self.assertFalse(AlgorithmProfiler.isRunning())
+        CreateSampleWorkspace(OutputWorkspace='profiled')
+        self.assertEquals(len(AlgorithmProfiler.profiles()), 0)
+
+    def test_profiles_are_recorded_while_running(self):
+        AlgorithmProfiler.start()
+        self.assertTrue(AlgorithmProfiler.isRunning())
+        CreateSampleWorkspace(OutputWorkspace='profiled')
+        Rebin('profiled', Params=100, OutputWorkspace='profiled')
+        AlgorithmProfiler.stop()
+
+        profiles = AlgorithmProfiler.profiles()
+        names = [profile['name'] for profile in profiles]
+        self.assertTrue('CreateSampleWorkspace' in names)
+        self.assertTrue('Rebin' in names)
+        rebin = profiles[names.index('Rebin')]
+        self.assertEquals(rebin['version'], 1)
+        self.assertEquals(rebin['depth'], 0)
+        self.assertTrue(rebin['wall_time'] >= 0.)
+        phases = rebin['validation_time'] + rebin['exec_time'] + rebin['finalise_time']
+        self.assertAlmostEqual(phases, rebin['wall_time'], places=6)
+        self.assertTrue(rebin['exec_time'] >= 0.)
+        self.assertTrue('memory_change_kib' in rebin)
+        self.assertTrue(rebin['peak_memory_increase_kib'] >= 0)
+        self.assertTrue(rebin['cow_copies'] >= 0)
+        self.assertTrue(rebin['cow_copied_bytes'] >= 0)
+
+    def test_saveChromeTrace(self):
+        AlgorithmProfiler.start()
+        CreateSampleWorkspace(OutputWorkspace='profiled')
+        filename = os.path.join(tempfile.gettempdir(), 'AlgorithmProfilerTest.json')
+        AlgorithmProfiler.saveChromeTrace(filename)
+        try:
+            with open(filename) as trace_file:
+                trace = json.load(trace_file)
+            names = [event['name'] for event in trace['traceEvents']]
+            self.assertTrue('CreateSampleWorkspace' in names)
+        finally:
+            os.remove(filename)
+
+if __name__ == '__main__':
+    unittest.main()